@@ -0,0 +1,149 @@
+# Open-loop load test of a model server (or a pool of servers).
+#
+# Usage:  mix run bench/load.exs [options]
+#
+#   --model NAME        fixture in test/fixtures (default: resnet18)
+#   --backend BACKEND   export | aoti | jit (default: export)
+#   --pool N            number of servers, used in turn (default: 1)
+#   --rates R1,R2,...   target request rates to sweep, in req/s (default: 50)
+#   --duration MS       measured period per rate (default: 10000)
+#   --warmup MS         unrecorded period before each rate (default: 2000)
+#   --arrivals KIND     poisson | uniform (default: poisson)
+#   --output PATH       write the reports as a JSON list
+#
+# Unlike bench/inference.exs, requests are sent on a fixed schedule from
+# many processes and latency is measured from the intended send time (see
+# ExTorch.LoadTest), so the tail reflects queueing once a rate approaches
+# the pool's capacity.
+
+ExTorch.set_grad_enabled(false)
+
+defmodule LoadBench do
+  @fixtures Path.join([__DIR__, "..", "test", "fixtures"])
+
+  @input_shapes %{
+    "alexnet" => {1, 3, 224, 224},
+    "vgg11" => {1, 3, 224, 224},
+    "squeezenet" => {1, 3, 224, 224},
+    "mobilenetv2" => {1, 3, 224, 224},
+    "resnet18" => {1, 3, 224, 224},
+    "resnet50" => {1, 3, 224, 224},
+    "vit_b_16" => {1, 3, 224, 224},
+    "simple_transformer" => {1, 16, 32},
+    "mini_bert" => {1, 16, 32},
+    "autoencoder" => {1, 784},
+    "conv_autoencoder" => {1, 3, 32, 32},
+    "simple_lstm" => {1, 16, 32}
+  }
+
+  @switches [
+    model: :string,
+    backend: :string,
+    pool: :integer,
+    rates: :string,
+    duration: :integer,
+    warmup: :integer,
+    arrivals: :string,
+    output: :string
+  ]
+
+  def run(argv) do
+    {opts, _, _} = OptionParser.parse(argv, strict: @switches)
+    name = Keyword.get(opts, :model, "resnet18")
+    backend = Keyword.get(opts, :backend, "export")
+    pool = Keyword.get(opts, :pool, 1)
+
+    rates =
+      opts
+      |> Keyword.get(:rates, "50")
+      |> String.split(",", trim: true)
+      |> Enum.map(&parse_number/1)
+
+    input =
+      ExTorch.Native.from_binary(
+        File.read!(Path.join(@fixtures, "#{name}_input.bin")),
+        Map.fetch!(@input_shapes, name),
+        :float32
+      )
+
+    servers = for _ <- 1..pool, do: start_server(backend, name)
+
+    IO.puts("== #{name} on #{pool} #{backend} server(s) ==\n")
+
+    IO.puts(
+      :io_lib.format(~c"~10s ~10s ~10s ~10s ~10s ~10s ~8s", [
+        ~c"rate",
+        ~c"tput",
+        ~c"p50(ms)",
+        ~c"p99(ms)",
+        ~c"p999(ms)",
+        ~c"max(ms)",
+        ~c"errors"
+      ])
+    )
+
+    IO.puts(String.duplicate("-", 76))
+
+    reports =
+      for rate <- rates do
+        report =
+          ExTorch.LoadTest.run(servers, [input],
+            rate: rate,
+            duration: Keyword.get(opts, :duration, 10_000),
+            warmup: Keyword.get(opts, :warmup, 2_000),
+            arrivals: String.to_existing_atom(Keyword.get(opts, :arrivals, "poisson"))
+          )
+
+        latency = report.latency_ms
+
+        IO.puts(
+          :io_lib.format(~c"~10.1f ~10.1f ~10s ~10s ~10s ~10s ~8B", [
+            rate / 1,
+            report.throughput / 1,
+            format_ms(latency.p50),
+            format_ms(latency.p99),
+            format_ms(latency.p999),
+            format_ms(latency.max),
+            report.errors + report.timeouts
+          ])
+        )
+
+        Map.merge(report, %{model: name, backend: backend, pool: pool})
+      end
+
+    if path = Keyword.get(opts, :output) do
+      File.write!(path, Jason.encode!(reports, pretty: true))
+      IO.puts("\nWrote #{path}")
+    end
+  end
+
+  defp start_server("export", name) do
+    path = Path.join(@fixtures, "#{name}.pt2")
+    {:ok, pid} = ExTorch.Export.Server.start_link(path: path)
+    {ExTorch.Export.Server, pid}
+  end
+
+  defp start_server("aoti", name) do
+    path = Path.join(@fixtures, "#{name}_aoti.pt2")
+    {:ok, pid} = ExTorch.AOTI.Server.start_link(path: path)
+    {ExTorch.AOTI.Server, pid}
+  end
+
+  defp start_server("jit", name) do
+    path = Path.join(@fixtures, "#{name}.pt")
+    {:ok, pid} = ExTorch.JIT.Server.start_link(path: path)
+    {ExTorch.JIT.Server, pid}
+  end
+
+  defp parse_number(string) do
+    case Float.parse(string) do
+      {value, ""} -> value
+      _ -> raise ArgumentError, "invalid rate: #{string}"
+    end
+  end
+
+  defp format_ms(nil), do: ~c"-"
+  defp format_ms(ms), do: :erlang.float_to_list(ms, decimals: 2)
+end
+
+LoadBench.run(System.argv())
@@ -0,0 +1,58 @@
+# Microbenchmark: per-op NIF calls vs. one ExTorch.Program call.
+#
+# Runs a typical image preprocessing pipeline (permute, cast, scale,
+# normalize, unsqueeze) as:
+#   A. individual ExTorch calls (one NIF crossing + struct encode per op)
+#   B. an interpreted ExTorch.Program (single execute_graph call)
+#   C. a compiled ExTorch.Program (single run_compiled_graph call)
+
+defmodule ProgramOverhead do
+  @iters 2000
+
+  def run do
+    image = ExTorch.randint(0, 255, {224, 224, 3}, dtype: :uint8)
+    mean = ExTorch.tensor([0.485, 0.456, 0.406]) |> ExTorch.view({3, 1, 1})
+    std = ExTorch.tensor([0.229, 0.224, 0.225]) |> ExTorch.view({3, 1, 1})
+    scale = ExTorch.tensor(1.0 / 255.0)
+
+    program =
+      ExTorch.Program.new([:image])
+      |> ExTorch.Program.op(:x, "aten::permute", [:image, [2, 0, 1]])
+      |> ExTorch.Program.op(:x, "aten::to.dtype", [:x, {:dtype, :float32}])
+      |> ExTorch.Program.op(:x, "aten::mul.Tensor", [:x, scale])
+      |> ExTorch.Program.op(:x, "aten::sub.Tensor", [:x, mean])
+      |> ExTorch.Program.op(:x, "aten::div.Tensor", [:x, std])
+      |> ExTorch.Program.op(:x, "aten::unsqueeze", [:x, 0])
+
+    compiled = ExTorch.Program.compile(program)
+
+    per_op = fn ->
+      image
+      |> ExTorch.permute({2, 0, 1})
+      |> ExTorch.Tensor.to(dtype: :float32)
+      |> ExTorch.mul(scale)
+      |> ExTorch.sub(mean)
+      |> ExTorch.tensor_div(std)
+      |> ExTorch.unsqueeze(0)
+    end
+
+    # Warm up
+    for _ <- 1..50 do
+      per_op.()
+      ExTorch.Program.run(program, [image])
+      ExTorch.Program.run(compiled, [image])
+    end
+
+    {us_a, _} = :timer.tc(fn -> for _ <- 1..@iters, do: per_op.() end)
+    {us_b, _} = :timer.tc(fn -> for _ <- 1..@iters, do: ExTorch.Program.run(program, [image]) end)
+    {us_c, _} = :timer.tc(fn -> for _ <- 1..@iters, do: ExTorch.Program.run(compiled, [image]) end)
+
+    IO.puts("\n== preprocessing pipeline (#{@iters} iters, 6 ops) ==\n")
+    IO.puts("  A. per-op NIF calls      : #{:io_lib.format(~c"~7.1f", [us_a / @iters])} us")
+    IO.puts("  B. Program (interpreted) : #{:io_lib.format(~c"~7.1f", [us_b / @iters])} us")
+    IO.puts("  C. Program (compiled)    : #{:io_lib.format(~c"~7.1f", [us_c / @iters])} us")
+    IO.puts("")
+  end
+end
+
+ProgramOverhead.run()
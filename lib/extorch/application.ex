@@ -3,6 +3,10 @@ defmodule ExTorch.Application do
   use Application
 
   def start(_type, _args) do
+    if Application.get_env(:extorch, :cpu_memory_tracking, false) do
+      ExTorch.Memory.enable_cpu_tracking()
+    end
+
     children = [
       {Registry, [name: ExTorch.Registry.DType, keys: :duplicate]},
       {Registry, [name: ExTorch.Registry.Device, keys: :duplicate]},
@@ -0,0 +1,243 @@
+defmodule ExTorch.Export.Bytecode do
+  @moduledoc """
+  Packed binary form of a graph instruction stream.
+
+  `ExTorch.Export.load/2` hands the graph to the native executors as a
+  single binary instead of a list of tagged tuples. The binary holds a
+  string table (value, argument and op names), an op table
+  (`target`/`overload` pairs) and one fixed-width 16-byte record per
+  instruction, so the native side parses it in place without decoding a
+  term, or allocating, per instruction.
+
+  All integers are little-endian:
+
+      header   "EXTG" | u32 version | u64 source_tag |
+               u32 n_strings | u32 n_ops | u32 n_records
+      strings  n_strings x (u32 length | bytes)
+      ops      n_ops x (u32 target string | u32 overload string)
+      records  n_records x (u8 tag | 3 pad | u32 a | u64 b)
+
+  `source_tag` is an opaque caller-chosen value, used to validate bytecode
+  cached on disk next to its `.pt2` archive (see `read_cache/2`).
+  """
+
+  @magic "EXTG"
+  @version 1
+
+  @tag_begin_op 20
+  @tag_output 21
+  @tag_arg_name 23
+  @tag_ref 10
+  @tag_int 1
+  @tag_float 2
+  @tag_bool 3
+  @tag_string 4
+  @tag_none 5
+  @tag_list 7
+  @tag_device 9
+
+  @doc """
+  Encode an instruction stream (as built for `execute_graph`) into bytecode.
+
+  ## Args
+    * `instructions` (`list`) - the flat instruction list.
+    * `source_tag` (`non_neg_integer`) - opaque 64-bit tag stored in the header.
+
+  ## Returns
+  The bytecode binary. Raises `ArgumentError` on instructions that cannot
+  be encoded, such as inline tensors.
+  """
+  @spec encode(list(), non_neg_integer()) :: binary()
+  def encode(instructions, source_tag \\ 0) when is_list(instructions) do
+    state = encode_stream(instructions, %{strings: %{}, ops: %{}, records: [], count: 0})
+
+    strings =
+      state.strings
+      |> Enum.sort_by(&elem(&1, 1))
+      |> Enum.map(fn {s, _} -> <<byte_size(s)::little-32, s::binary>> end)
+
+    ops =
+      state.ops
+      |> Enum.sort_by(&elem(&1, 1))
+      |> Enum.map(fn {{target, overload}, _} -> <<target::little-32, overload::little-32>> end)
+
+    IO.iodata_to_binary([
+      @magic,
+      <<@version::little-32, source_tag::little-64, map_size(state.strings)::little-32,
+        map_size(state.ops)::little-32, state.count::little-32>>,
+      strings,
+      ops,
+      Enum.reverse(state.records)
+    ])
+  end
+
+  @doc """
+  Return the `source_tag` of a bytecode binary, or `nil` if it is not valid
+  bytecode of the current version.
+  """
+  @spec source_tag(binary()) :: non_neg_integer() | nil
+  def source_tag(<<@magic, @version::little-32, tag::little-64, _rest::binary>>), do: tag
+  def source_tag(_), do: nil
+
+  @doc """
+  Path of the bytecode cache for a `.pt2` archive and target device.
+
+      iex> ExTorch.Export.Bytecode.cache_path("/models/vit.pt2", {:cuda, 1})
+      "/models/vit.cuda1.extg"
+  """
+  @spec cache_path(String.t(), atom() | {atom(), non_neg_integer()}) :: String.t()
+  def cache_path(pt2_path, device) do
+    suffix =
+      case device do
+        {type, idx} -> "#{type}#{idx}"
+        type -> "#{type}"
+      end
+
+    Path.rootname(pt2_path) <> ".#{suffix}.extg"
+  end
+
+  @doc """
+  Compute the SHA-256 of an archive's contents, read in 1 MiB chunks.
+  """
+  @spec archive_hash(String.t()) :: binary()
+  def archive_hash(pt2_path) do
+    pt2_path
+    |> File.stream!(1_048_576)
+    |> Enum.reduce(:crypto.hash_init(:sha256), &:crypto.hash_update(&2, &1))
+    |> :crypto.hash_final()
+  end
+
+  @doc """
+  Compute the tag identifying an archive's current contents for a device.
+
+  Based on a hash of the archive contents (see `archive_hash/1`), so a
+  rewritten or copied archive never picks up stale bytecode whatever its
+  size and modification time, and on the ExTorch version, so an upgrade
+  invalidates every cached file.
+  """
+  @spec archive_tag(String.t(), term()) :: non_neg_integer()
+  def archive_tag(pt2_path, device) do
+    <<tag::little-64, _rest::binary>> =
+      :crypto.hash(:sha256, [
+        archive_hash(pt2_path),
+        :erlang.term_to_binary({@version, device, Application.spec(:extorch, :vsn)})
+      ])
+
+    tag
+  end
+
+  @doc """
+  Read cached bytecode, returning it only if its tag matches `expected_tag`.
+  """
+  @spec read_cache(String.t(), non_neg_integer()) :: {:ok, binary()} | :error
+  def read_cache(cache_path, expected_tag) do
+    with {:ok, code} <- File.read(cache_path),
+         ^expected_tag <- source_tag(code) do
+      {:ok, code}
+    else
+      _ -> :error
+    end
+  end
+
+  @doc """
+  Write bytecode to a cache file. Failures (e.g. a read-only model
+  directory) are ignored; the cache is only an optimization.
+  """
+  @spec write_cache(String.t(), binary()) :: :ok
+  def write_cache(cache_path, code) do
+    tmp = cache_path <> ".tmp#{System.unique_integer([:positive])}"
+
+    with :ok <- File.write(tmp, code),
+         :ok <- File.rename(tmp, cache_path) do
+      :ok
+    else
+      _ ->
+        File.rm(tmp)
+        :ok
+    end
+  end
+
+  # -- encoding ---------------------------------------------------------------
+
+  defp encode_stream([], state), do: state
+
+  defp encode_stream([{:begin_op, target, num_args}, {:overload, overload} | rest], state) do
+    encode_stream(rest, begin_op(state, target, overload, num_args))
+  end
+
+  defp encode_stream([{:begin_op, target, num_args} | rest], state) do
+    encode_stream(rest, begin_op(state, target, "", num_args))
+  end
+
+  defp encode_stream([inst | rest], state) do
+    encode_stream(rest, encode_inst(inst, state))
+  end
+
+  defp begin_op(state, target, overload, num_args) do
+    {target_idx, state} = intern(state, target)
+    {overload_idx, state} = intern(state, overload)
+    key = {target_idx, overload_idx}
+
+    {op_idx, state} =
+      case Map.fetch(state.ops, key) do
+        {:ok, idx} -> {idx, state}
+        :error -> {map_size(state.ops), %{state | ops: Map.put(state.ops, key, map_size(state.ops))}}
+      end
+
+    record(state, @tag_begin_op, op_idx, num_args)
+  end
+
+  defp encode_inst({:output, name}, state), do: string_record(state, @tag_output, name)
+  defp encode_inst({:arg_name, name}, state), do: string_record(state, @tag_arg_name, name)
+  defp encode_inst({:ref, name}, state), do: string_record(state, @tag_ref, name)
+  defp encode_inst({:string, s}, state), do: string_record(state, @tag_string, s)
+  defp encode_inst({:int, v}, state) when is_integer(v), do: record(state, @tag_int, 0, v)
+  defp encode_inst({:bool, v}, state) when is_boolean(v),
+    do: record(state, @tag_bool, 0, if(v, do: 1, else: 0))
+  defp encode_inst(:none, state), do: record(state, @tag_none, 0, 0)
+
+  defp encode_inst({:float, v}, state) when is_number(v) do
+    <<bits::little-signed-64>> = <<v * 1.0::float-little-64>>
+    record(state, @tag_float, 0, bits)
+  end
+
+  defp encode_inst({:list, items}, state) when is_list(items) do
+    state = record(state, @tag_list, 0, length(items))
+    Enum.reduce(items, state, &encode_inst/2)
+  end
+
+  defp encode_inst({:device, {type, idx}}, state) do
+    {str_idx, state} = intern(state, type)
+    record(state, @tag_device, str_idx, idx)
+  end
+
+  defp encode_inst({:device, type}, state) when is_binary(type) do
+    {str_idx, state} = intern(state, type)
+    record(state, @tag_device, str_idx, -1)
+  end
+
+  defp encode_inst(other, _state) do
+    raise ArgumentError, "cannot encode graph instruction as bytecode: #{inspect(other)}"
+  end
+
+  defp string_record(state, tag, value) do
+    {idx, state} = intern(state, value)
+    record(state, tag, idx, 0)
+  end
+
+  defp intern(state, value) when is_binary(value) do
+    case Map.fetch(state.strings, value) do
+      {:ok, idx} ->
+        {idx, state}
+
+      :error ->
+        idx = map_size(state.strings)
+        {idx, %{state | strings: Map.put(state.strings, value, idx)}}
+    end
+  end
+
+  defp record(state, tag, a, b) do
+    rec = <<tag::8, 0::24, a::little-32, b::little-signed-64>>
+    %{state | records: [rec | state.records], count: state.count + 1}
+  end
+end
@@ -0,0 +1,92 @@
+defmodule ExTorch.Export.CompileCache do
+  @moduledoc """
+  On-disk cache of natively compiled Export graphs.
+
+  Building the native executors in `ExTorch.Export.load/2` means lowering
+  every graph node to instructions, resolving every op schema, assigning
+  value slots and reordering arguments against the schema. For large
+  models this dominates cold-start time, and it is repeated on every boot
+  (rolling deploys, supervisor restarts).
+
+  With `load(path, compile_cache: dir)` the results are written to `dir`
+  after the first load and read back on later ones:
+
+    * `<key>.extc` - the serialized compiled graph used by
+      `ExTorch.Export.forward_compiled/2`: op names, argument descriptors,
+      slot assignments and literal values. Loading it only looks up the op
+      schemas again.
+    * `<key>.extg` - the graph bytecode (see `ExTorch.Export.Bytecode`),
+      from which `forward_native/2`'s encoded graph is rebuilt.
+
+  Only these native artifacts are cached. Reading the archive, parsing its
+  schema and building the node closures of `ExTorch.Export.forward/2` still
+  happen on every load.
+
+  `key` is derived from a SHA-256 of the archive contents, the target
+  device, the linked libtorch version and the ExTorch version, so a
+  changed archive or an upgrade never picks up a stale entry. Entries are written
+  atomically and can be shared by several nodes; deleting the directory is
+  always safe.
+  """
+
+  @doc """
+  Compute the cache key for an archive and device.
+
+  ## Args
+    * `pt2_path` (`String`) - path to the `.pt2` archive.
+    * `device` - the `:device` the model is loaded on.
+
+  ## Returns
+  `{name, tag}`, where `name` is the file name stem of the cache entries
+  and `tag` the 64-bit value stored inside them and checked on load.
+  """
+  @spec key(String.t(), term()) :: {String.t(), non_neg_integer()}
+  def key(pt2_path, device) do
+    digest =
+      :crypto.hash(:sha256, [
+        ExTorch.Export.Bytecode.archive_hash(pt2_path),
+        :erlang.term_to_binary(
+          {device, ExTorch.Native.libtorch_version(), Application.spec(:extorch, :vsn)}
+        )
+      ])
+
+    <<tag::little-64, _rest::binary>> = digest
+    {Base.encode16(binary_part(digest, 0, 16), case: :lower), tag}
+  end
+
+  @doc """
+  Path of a cache entry inside `dir`. `kind` is `:compiled` or `:bytecode`.
+  """
+  @spec entry_path(String.t(), String.t(), :compiled | :bytecode) :: String.t()
+  def entry_path(dir, name, :compiled), do: Path.join(dir, name <> ".extc")
+  def entry_path(dir, name, :bytecode), do: Path.join(dir, name <> ".extg")
+
+  @doc """
+  Load a cached compiled graph, or `nil` if it is missing or invalid for `tag`.
+  """
+  @spec read_compiled(String.t(), non_neg_integer()) :: ExTorch.Export.CompiledGraph.t() | nil
+  def read_compiled(path, tag) do
+    with {:ok, data} <- File.read(path) do
+      try do
+        ExTorch.Native.deserialize_compiled_graph(data, tag)
+      rescue
+        _ -> nil
+      end
+    else
+      _ -> nil
+    end
+  end
+
+  @doc """
+  Serialize a compiled graph into the cache. Failures are ignored; the
+  cache is only an optimization.
+  """
+  @spec write_compiled(String.t(), ExTorch.Export.CompiledGraph.t(), non_neg_integer()) :: :ok
+  def write_compiled(path, compiled, tag) do
+    data = ExTorch.Native.serialize_compiled_graph(compiled, tag)
+    File.mkdir_p(Path.dirname(path))
+    ExTorch.Export.Bytecode.write_cache(path, data)
+  rescue
+    _ -> :ok
+  end
+end
@@ -0,0 +1,18 @@
+defmodule ExTorch.Export.EncodedGraph do
+  @moduledoc """
+  A graph instruction stream decoded once for repeated native execution.
+
+  Created by `ExTorch.Export.load/2` for `forward_native/2`. Holds the
+  instructions with op schemas resolved and value names interned to integer
+  slots, so each call only passes tensors to C++. Unlike
+  `ExTorch.Export.CompiledGraph`, intermediate and output values may be
+  any IValue (lists, tuples, scalars), as with `execute_graph`.
+  """
+
+  @type t :: %__MODULE__{
+          resource: reference(),
+          reference: reference()
+        }
+
+  defstruct [:resource, :reference]
+end
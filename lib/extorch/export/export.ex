@@ -46,6 +46,9 @@ defmodule ExTorch.Export do
     is a tight loop over closures instead of re-parsing the graph each call.
     `initial_values` holds the pre-built parameter value map so forward
     doesn't re-resolve p_*/b_* names on every inference.
+
+    `native_compiled` and `native_encoded` hold the graph prepared for the
+    native executors used by `forward_compiled/2` and `forward_native/2`.
     """
 
     @type t :: %__MODULE__{
@@ -56,11 +59,13 @@ defmodule ExTorch.Export do
             compiled_graph: [{[String.t()], (map() -> any())}],
             initial_values: map(),
             device: atom() | {atom(), non_neg_integer()},
-            native_compiled: ExTorch.Export.CompiledGraph.t() | nil
+            native_compiled: ExTorch.Export.CompiledGraph.t() | nil,
+            native_encoded: ExTorch.Export.EncodedGraph.t() | nil
           }
 
     defstruct [:schema, :weights, :param_inputs, :user_inputs,
-               :compiled_graph, :initial_values, :native_compiled, device: :cpu]
+               :compiled_graph, :initial_values, :native_compiled,
+               :native_encoded, device: :cpu]
   end
 
   @doc """
@@ -76,6 +81,18 @@ defmodule ExTorch.Export do
         loaded parameter/buffer is moved to the GPU at load time, so
         subsequent `forward/2` calls run entirely on the GPU (as long as
         the user input is also on the GPU).
+      * `:bytecode_cache` (`boolean`) - when `true`, the packed graph
+        bytecode (see `ExTorch.Export.Bytecode`) is cached next to the
+        archive (e.g. `model.cpu.extg`) and reused by later loads while
+        the archive is unchanged. Defaults to `false`.
+      * `:compile_cache` (`String`) - directory in which the natively
+        compiled graph and its bytecode are cached, keyed by the archive
+        contents, device and libtorch version (see
+        `ExTorch.Export.CompileCache`). Later loads of the same archive skip
+        graph lowering and compilation. Only those native steps are cached:
+        every load still reads the archive, parses its schema and builds the
+        node closures used by `forward/2`. Takes precedence over
+        `:bytecode_cache`. Defaults to `nil` (no cache).
 
   ## Returns
   An `%ExTorch.Export.Model{}` struct.
@@ -131,13 +148,41 @@ defmodule ExTorch.Export do
     # Pre-compile the native C++ graph executor for forward_compiled/2.
     # This resolves all op schemas and converts string refs to integer
     # indices at load time, eliminating per-op overhead at inference time.
+    # The graph is sent as packed bytecode, parsed in place by C++.
     all_names = Map.keys(initial_values) ++ user_inputs
-    instructions = compile_graph_instructions(schema.graph, device)
+    cache = graph_cache(path, device, opts)
+
+    # A graph the encoder rejects leaves both native executors unset, like
+    # one the compiler rejects.
+    bytecode = try do
+      graph_bytecode(schema.graph, device, cache)
+    rescue
+      _ -> nil
+    end
+
+    native_compiled =
+      case cached_compiled_graph(cache) do
+        nil ->
+          compiled = try do
+            bytecode && ExTorch.Native.compile_graph_bytecode(bytecode, all_names, schema.outputs)
+          rescue
+            _ -> nil  # Fall back to forward_native if compilation fails
+          end
+
+          store_compiled_graph(cache, compiled)
+          compiled
+
+        compiled ->
+          compiled
+      end
+      |> bind_parameters(initial_values)
 
-    native_compiled = try do
-      ExTorch.Native.compile_graph(instructions, all_names, schema.outputs)
+    # Decode the same bytecode once for forward_native/2, so the dynamic
+    # path doesn't rebuild, re-send and re-resolve it every call.
+    native_encoded = try do
+      bytecode && ExTorch.Native.encode_graph_bytecode(bytecode, all_names, schema.outputs)
     rescue
-      _ -> nil  # Fall back to forward_native if compilation fails
+      _ -> nil  # forward_native rebuilds the instructions per call instead
     end
 
     %Model{
@@ -148,7 +193,8 @@ defmodule ExTorch.Export do
       compiled_graph: compiled_graph,
       initial_values: initial_values,
       device: device,
-      native_compiled: native_compiled
+      native_compiled: native_compiled,
+      native_encoded: native_encoded
     }
   end
 
@@ -206,10 +252,14 @@ defmodule ExTorch.Export do
   Run inference using the pre-compiled graph executor.
 
   The fastest Export inference path. All op schemas were resolved and
-  argument templates pre-built at `load/2` time. This function only
-  passes tensors to C++ and gets tensors back — zero encoding overhead.
+  argument templates pre-built at `load/2` time, and the parameters and
+  buffers are bound into the graph as constants. This function only
+  passes the user input tensors to C++ and gets tensors back — zero
+  encoding overhead.
 
   Falls back to `forward_native/2` if the graph couldn't be pre-compiled.
+  Recurrent models can keep their state in an `ExTorch.Export.Session`
+  instead of passing it on every call.
 
       model = ExTorch.Export.load("model.pt2", device: :cuda)
       output = ExTorch.Export.forward_compiled(model, [input])
@@ -221,15 +271,11 @@ defmodule ExTorch.Export do
     forward_native(model, inputs)
   end
 
-  def forward_compiled(%Model{native_compiled: compiled} = model, inputs)
+  def forward_compiled(%Model{native_compiled: compiled}, inputs)
       when is_list(inputs) do
-    # Build tensor list in the same order as value_names at compile time:
-    # initial_values keys (sorted) ++ user_inputs
-    all_tensors =
-      Enum.map(Map.keys(model.initial_values), &Map.fetch!(model.initial_values, &1)) ++
-        inputs
-
-    result = ExTorch.Native.run_compiled_graph(compiled, all_tensors)
+    # Parameters are bound inside the compiled graph, so only the user
+    # inputs cross the NIF boundary.
+    result = ExTorch.Native.run_compiled_graph(compiled, inputs)
 
     case result do
       [single] -> single
@@ -249,13 +295,18 @@ defmodule ExTorch.Export do
   Falls back gracefully for ops registered via `ExTorch.Export.OpRegistry`
   since those are also dispatched through the same C++ dispatcher.
 
+  The instruction stream is encoded once at `load/2` time (op schemas
+  resolved, value names interned to integer slots), so each call only
+  passes tensors. If encoding failed at load time, the instructions are
+  rebuilt and sent on every call.
+
       model = ExTorch.Export.load("vit_b_16.pt2", device: :cuda)
       input = ExTorch.Tensor.to(input, device: :cuda)
       output = ExTorch.Export.forward_native(model, [input])
   """
   @spec forward_native(Model.t(), [ExTorch.Tensor.t()]) ::
           ExTorch.Tensor.t() | [ExTorch.Tensor.t()]
-  def forward_native(%Model{} = model, inputs) when is_list(inputs) do
+  def forward_native(%Model{native_encoded: nil} = model, inputs) when is_list(inputs) do
     # Build the values map: param names -> tensors
     all_names =
       Map.keys(model.initial_values) ++ model.user_inputs
@@ -277,6 +328,21 @@ defmodule ExTorch.Export do
       model.schema.outputs
     )
 
+    unwrap_native_result(result)
+  end
+
+  def forward_native(%Model{native_encoded: encoded} = model, inputs) when is_list(inputs) do
+    # Same order as the input names given to encode_graph at load time.
+    all_tensors =
+      Enum.map(Map.keys(model.initial_values), &Map.fetch!(model.initial_values, &1)) ++
+        inputs
+
+    encoded
+    |> ExTorch.Native.run_encoded_graph(all_tensors)
+    |> unwrap_native_result()
+  end
+
+  defp unwrap_native_result(result) do
     case result do
       {single} when is_struct(single) -> single
       single when is_struct(single) -> single
@@ -285,6 +351,78 @@ defmodule ExTorch.Export do
     end
   end
 
+  # Resolve where (if anywhere) load-time artifacts are cached:
+  # nil, {:bytecode, path, tag} or {:compiled, dir, name, tag}.
+  defp graph_cache(path, device, opts) do
+    cond do
+      dir = Keyword.get(opts, :compile_cache) ->
+        {name, tag} = ExTorch.Export.CompileCache.key(path, device)
+        File.mkdir_p(dir)
+        {:compiled, dir, name, tag}
+
+      Keyword.get(opts, :bytecode_cache, false) ->
+        {:bytecode, ExTorch.Export.Bytecode.cache_path(path, device),
+         ExTorch.Export.Bytecode.archive_tag(path, device)}
+
+      true ->
+        nil
+    end
+  end
+
+  # Build (or reuse from the on-disk cache) the packed graph bytecode.
+  defp graph_bytecode(graph_nodes, device, nil) do
+    graph_nodes
+    |> compile_graph_instructions(device)
+    |> ExTorch.Export.Bytecode.encode()
+  end
+
+  defp graph_bytecode(graph_nodes, device, {:compiled, dir, name, tag}) do
+    path = ExTorch.Export.CompileCache.entry_path(dir, name, :bytecode)
+    graph_bytecode(graph_nodes, device, {:bytecode, path, tag})
+  end
+
+  defp graph_bytecode(graph_nodes, device, {:bytecode, cache_path, tag}) do
+    case ExTorch.Export.Bytecode.read_cache(cache_path, tag) do
+      {:ok, bytecode} ->
+        bytecode
+
+      :error ->
+        bytecode =
+          graph_nodes
+          |> compile_graph_instructions(device)
+          |> ExTorch.Export.Bytecode.encode(tag)
+
+        ExTorch.Export.Bytecode.write_cache(cache_path, bytecode)
+        bytecode
+    end
+  end
+
+  # Bind parameters/buffers by name as constants of the compiled graph.
+  defp bind_parameters(nil, _initial_values), do: nil
+
+  defp bind_parameters(compiled, initial_values) do
+    {names, tensors} = Enum.unzip(initial_values)
+    ExTorch.Native.bind_graph_constants(compiled, names, tensors)
+  rescue
+    _ -> nil
+  end
+
+  defp cached_compiled_graph({:compiled, dir, name, tag}) do
+    dir
+    |> ExTorch.Export.CompileCache.entry_path(name, :compiled)
+    |> ExTorch.Export.CompileCache.read_compiled(tag)
+  end
+
+  defp cached_compiled_graph(_cache), do: nil
+
+  defp store_compiled_graph({:compiled, dir, name, tag}, compiled) when compiled != nil do
+    dir
+    |> ExTorch.Export.CompileCache.entry_path(name, :compiled)
+    |> ExTorch.Export.CompileCache.write_compiled(compiled, tag)
+  end
+
+  defp store_compiled_graph(_cache, _compiled), do: :ok
+
   # Compile schema graph nodes into a flat instruction stream for execute_graph.
   defp compile_graph_instructions(graph_nodes, device \\ :cpu) do
     Enum.flat_map(graph_nodes, fn node ->
@@ -396,7 +534,8 @@ defmodule ExTorch.Export do
   target so you can see which ops dominate inference time.
 
   Only meant for diagnostics. Adds ~1μs of measurement overhead per node
-  from `:erlang.monotonic_time/1`.
+  from `:erlang.monotonic_time/1`. To profile `forward_compiled/2`, see
+  `start_profiling/2`.
   """
   @spec forward_profiled(Model.t(), [ExTorch.Tensor.t()]) ::
           {ExTorch.Tensor.t() | [ExTorch.Tensor.t()], map()}
@@ -446,6 +585,105 @@ defmodule ExTorch.Export do
     {output, stats}
   end
 
+  @doc """
+  Start profiling `forward_compiled/2` natively.
+
+  Every op the compiled graph executor runs records its wall time, the
+  size of its outputs and the CPU bytes allocated and freed on its thread
+  while it ran. Allocations are only counted while CPU memory tracking is
+  on (see `ExTorch.Memory.enable_cpu_tracking/0`); they read zero
+  otherwise. Samples go to a ring allocated here, so runs keep their
+  speed (when profiling is stopped they only check a pointer); once the
+  ring is full the oldest samples are overwritten. Profiling covers every
+  process running the model until `stop_profiling/1`, and starting again
+  discards the previous samples.
+
+  Wall times are measured around the op call: for CUDA models they cover
+  the kernel launch, not its execution, unless launches are synchronous.
+
+  ## Args
+    * `model` (`ExTorch.Export.Model`) - a model loaded with a compiled graph.
+    * `opts` (`keyword`) - optional arguments:
+      * `:capacity` (`integer`) - the number of samples kept. Default: `65_536`.
+
+  ## Returns
+  `:ok`.
+  """
+  @spec start_profiling(Model.t(), keyword()) :: :ok
+  def start_profiling(model, opts \\ []) do
+    model
+    |> native_compiled!()
+    |> ExTorch.Native.compiled_graph_profile_start(Keyword.get(opts, :capacity, 65_536))
+  end
+
+  @doc """
+  Stop profiling `forward_compiled/2`. The samples are kept for `profile_stats/1`.
+  """
+  @spec stop_profiling(Model.t()) :: :ok
+  def stop_profiling(model) do
+    model
+    |> native_compiled!()
+    |> ExTorch.Native.compiled_graph_profile_stop()
+  end
+
+  @doc """
+  Aggregate the samples recorded since `start_profiling/2`.
+
+  ## Returns
+  A map with:
+    * `:runs` - the number of profiled runs.
+    * `:samples` - the number of op samples aggregated.
+    * `:dropped` - the number of samples overwritten in the ring, or skipped
+      because a concurrent run was writing to the same slot.
+    * `:nodes` - per graph node stats, in execution order.
+    * `:targets` - stats of all the nodes running the same op (e.g.
+      `"aten::addmm.default"`), the slowest first.
+
+  Each stats map holds the `:name` of the node (or target) and its
+  `:target`, the execution `:count`, the `:total_ns`, `:min_ns`, `:p50_ns`,
+  `:p99_ns` and `:max_ns` wall times, and the `:output_bytes`,
+  `:allocated_bytes` and `:freed_bytes` summed over the executions.
+  """
+  @spec profile_stats(Model.t()) :: map()
+  def profile_stats(model) do
+    stats = model |> native_compiled!() |> ExTorch.Native.compiled_graph_profile_stats()
+    Map.update!(stats, :targets, &Enum.sort_by(&1, fn target -> target.total_ns end, :desc))
+  end
+
+  @doc """
+  Write the compiled graph of `model`, its weights and `inputs` to `path`.
+
+  The dump is replayed by the native benchmark of the graph executor, which
+  runs it in a tight loop outside of the BEAM, so executor timings carry no
+  scheduling, NIF marshaling or GC noise:
+
+      cargo bench --manifest-path native/extorch/Cargo.toml \\
+        --bench graph_executor -- /tmp/resnet18.extd --iterations 1000
+
+  The dump is only valid for the libtorch build that wrote it.
+
+  ## Args
+    * `model` (`ExTorch.Export.Model`) - a model loaded with a compiled graph.
+    * `inputs` (`[ExTorch.Tensor]`) - the inputs to benchmark with, as
+      passed to `forward_compiled/2`.
+    * `path` (`Path.t()`) - the file to write.
+
+  ## Returns
+  `:ok`.
+  """
+  @spec dump_compiled(Model.t(), [ExTorch.Tensor.t()], Path.t()) :: :ok
+  def dump_compiled(model, inputs, path) when is_list(inputs) do
+    model
+    |> native_compiled!()
+    |> ExTorch.Native.dump_compiled_graph(inputs, Path.expand(path))
+  end
+
+  defp native_compiled!(%Model{native_compiled: nil}) do
+    raise ArgumentError, "the model has no compiled graph"
+  end
+
+  defp native_compiled!(%Model{native_compiled: compiled}), do: compiled
+
   # ============================================================================
   # Graph pre-compilation (Phase C)
   #
@@ -1438,7 +1676,8 @@ defmodule ExTorch.Export do
   """
   @spec read_schema(String.t()) :: map()
   def read_schema(path) do
-    archive = read_archive(path)
+    # Only the JSON metadata is needed; weight blobs stay on disk.
+    archive = read_archive(path, &json_entry?/1)
     model_name = detect_model_name(archive)
 
     graph_data =
@@ -1504,22 +1743,16 @@ defmodule ExTorch.Export do
   @doc """
   Load weight tensors from an exported `.pt2` archive.
 
+  Tensors are read one at a time straight from the archive (see
+  `ExTorch.NN.Weights.stream/1`), so the archive itself is never held in
+  memory. To load weights into a DSL model without keeping this map
+  around, use `ExTorch.NN.Weights.bind/2`.
+
   Returns a map of `%{fqn => %ExTorch.Tensor{}}`.
   """
   @spec read_weights(String.t()) :: %{String.t() => ExTorch.Tensor.t()}
   def read_weights(path) do
-    archive = read_archive(path)
-    schema = read_schema(path)
-
-    for {fqn, meta} <- schema.weights, into: %{} do
-      weight_path = "#{schema.model_name}/data/weights/#{meta.file}"
-      binary = read_file(archive, weight_path)
-
-      shape = List.to_tuple(meta.shape)
-      tensor = ExTorch.Native.from_binary(binary, shape, meta.dtype)
-
-      {fqn, tensor}
-    end
+    path |> ExTorch.NN.Weights.stream() |> Map.new()
   end
 
   @doc """
@@ -1541,13 +1774,16 @@ defmodule ExTorch.Export do
   # Private: Archive reading
   # ============================================================================
 
-  defp read_archive(path) do
-    {:ok, files} = :zip.extract(String.to_charlist(path), [:memory])
+  defp read_archive(path, filter) do
+    {:ok, files} = :zip.extract(String.to_charlist(path), [:memory, {:file_filter, filter}])
     for {name, data} <- files, into: %{} do
       {List.to_string(name), data}
     end
   end
 
+  # :zip file_filter callback; elem 1 of a #zip_file{} record is its name.
+  defp json_entry?(zip_file), do: zip_file |> elem(1) |> List.to_string() |> String.ends_with?(".json")
+
   defp detect_model_name(archive) do
     archive
     |> Map.keys()
@@ -1566,10 +1802,6 @@ defmodule ExTorch.Export do
     end
   end
 
-  defp read_file(archive, key) do
-    Map.fetch!(archive, key)
-  end
-
   # ============================================================================
   # Private: Graph parsing
   # ============================================================================
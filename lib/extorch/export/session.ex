@@ -0,0 +1,122 @@
+defmodule ExTorch.Export.Session do
+  @moduledoc """
+  Step-wise execution of a compiled export graph with resident state.
+
+  Recurrent and autoregressive models take their state (hidden states,
+  caches) as inputs and return the updated state as outputs. Running them
+  with `ExTorch.Export.forward_compiled/2` sends the state to Elixir and
+  back on every step. A session instead declares, when it is created, which
+  outputs feed which inputs on the next step: the state stays in the native
+  session and each `step/2` only passes the new token or frame.
+
+  ## Example
+
+      model = ExTorch.Export.load("gru_step.pt2")
+      # forward(x, h) returns {y, h}: output 1 becomes input "h".
+      session = ExTorch.Export.Session.new(model, [{"h", 1, ExTorch.zeros({1, 16})}])
+
+      y1 = ExTorch.Export.Session.step(session, [x1])
+      y2 = ExTorch.Export.Session.step(session, [x2])
+
+      :ok = ExTorch.Export.Session.reset(session)
+
+  Steps of one session run one at a time; use a session per sequence to
+  decode several of them concurrently.
+  """
+
+  alias ExTorch.Export.Model
+
+  @type t :: %__MODULE__{
+          resource: reference(),
+          reference: reference(),
+          state_inputs: [String.t()]
+        }
+
+  defstruct [:resource, :reference, :state_inputs]
+
+  @doc """
+  Create a session of a model loaded with a compiled graph.
+
+  ## Args
+    * `model` (`ExTorch.Export.Model`) - a model loaded with a compiled graph.
+    * `state` (`[{input, output, initial}]`) - the state carried across
+      steps: the name of a user input of the model, the output that feeds
+      it on the next step (its index in the model outputs, or its name) and
+      its value for the first step.
+
+  ## Returns
+  The session. Its steps take the remaining user inputs, in order, and
+  return the outputs that are not carried as state.
+  """
+  @spec new(Model.t(), [{String.t(), non_neg_integer() | String.t(), ExTorch.Tensor.t()}]) :: t()
+  def new(%Model{native_compiled: nil}, _state) do
+    raise ArgumentError, "the model has no compiled graph"
+  end
+
+  def new(%Model{native_compiled: compiled, schema: schema}, state) when is_list(state) do
+    {inputs, outputs, initial} =
+      state
+      |> Enum.map(fn {input, output, tensor} -> {input, output_index(schema, output), tensor} end)
+      |> unzip3()
+
+    ExTorch.Native.create_graph_session(compiled, inputs, outputs, initial)
+  end
+
+  @doc """
+  Run one step of the session.
+
+  ## Args
+    * `session` (`ExTorch.Export.Session`) - the session.
+    * `inputs` (`[ExTorch.Tensor]`) - the user inputs not carried as state.
+
+  ## Returns
+  The output tensor (or list of tensors) not carried as state. The state
+  of the session only advances when the step succeeds.
+  """
+  @spec step(t(), [ExTorch.Tensor.t()]) :: ExTorch.Tensor.t() | [ExTorch.Tensor.t()]
+  def step(%__MODULE__{} = session, inputs) when is_list(inputs) do
+    case ExTorch.Native.graph_session_step(session, inputs) do
+      [single] -> single
+      multiple -> multiple
+    end
+  end
+
+  @doc """
+  Restore the initial state of the session.
+  """
+  @spec reset(t()) :: :ok
+  def reset(%__MODULE__{} = session) do
+    ExTorch.Native.graph_session_reset(session)
+  end
+
+  @doc """
+  Get the current state of the session.
+
+  ## Returns
+  A map from state input name to its current tensor.
+  """
+  @spec state(t()) :: %{String.t() => ExTorch.Tensor.t()}
+  def state(%__MODULE__{state_inputs: names} = session) do
+    names
+    |> Enum.zip(ExTorch.Native.graph_session_state(session))
+    |> Map.new()
+  end
+
+  defp output_index(_schema, index) when is_integer(index), do: index
+
+  defp output_index(schema, name) when is_binary(name) do
+    case Enum.find_index(schema.outputs, &(&1 == name)) do
+      nil -> raise ArgumentError, "#{inspect(name)} is not an output of the model"
+      index -> index
+    end
+  end
+
+  defp unzip3(triples) do
+    {a, b, c} =
+      Enum.reduce(triples, {[], [], []}, fn {x, y, z}, {xs, ys, zs} ->
+        {[x | xs], [y | ys], [z | zs]}
+      end)
+
+    {Enum.reverse(a), Enum.reverse(b), Enum.reverse(c)}
+  end
+end
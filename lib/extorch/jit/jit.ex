@@ -22,6 +22,16 @@ defmodule ExTorch.JIT do
     - `path`: Path to the `.pt` file.
     - `opts`: Keyword list of options.
       - `:device` - Device to load the model onto (default: `:cpu`).
+      - `:freeze` - Freeze the model for inference (see `freeze/2`)
+        (default: `false`).
+      - `:optimize_for_inference` - Freeze the model and run
+        `torch.jit.optimize_for_inference` on it (default: `false`).
+      - `:warmup` - Example inputs to run `forward/2` with before
+        returning, so the profiling executor has specialized the graph
+        before the first real request (default: `nil`).
+      - `:warmup_runs` - Number of warm-up calls. Defaults to the
+        executor's `num_profiled_runs` plus one, enough to reach the
+        optimized graph.
 
   ## Returns
   A `%ExTorch.JIT.Model{}` struct.
@@ -30,11 +40,115 @@ defmodule ExTorch.JIT do
 
       model = ExTorch.JIT.load("model.pt")
       model = ExTorch.JIT.load("model.pt", device: {:cuda, 0})
+
+      model =
+        ExTorch.JIT.load("model.pt",
+          optimize_for_inference: true,
+          warmup: [ExTorch.randn({1, 3, 224, 224})]
+        )
   """
   @spec load(String.t(), keyword()) :: Model.t()
   def load(path, opts \\ []) do
     device = Keyword.get(opts, :device, :cpu)
-    ExTorch.Native.jit_load(path, device)
+    model = ExTorch.Native.jit_load(path, device)
+
+    model =
+      cond do
+        Keyword.get(opts, :optimize_for_inference, false) -> freeze(model, optimize: true)
+        Keyword.get(opts, :freeze, false) -> freeze(model)
+        true -> model
+      end
+
+    case Keyword.get(opts, :warmup) do
+      nil ->
+        model
+
+      inputs ->
+        runs = Keyword.get_lazy(opts, :warmup_runs, fn ->
+          executor_options().num_profiled_runs + 1
+        end)
+
+        Enum.each(1..runs//1, fn _ -> forward(model, inputs) end)
+        model
+    end
+  end
+
+  @doc """
+  Freeze a model for inference.
+
+  Runs `torch::jit::freeze` on an eval-mode copy of the model: parameters
+  and attributes are inlined as constants, which enables conv-batchnorm
+  folding, dropout removal and constant propagation. Frozen models can
+  only run inference, and their parameters are no longer listed by
+  `parameters/1`.
+
+  ## Arguments
+    - `model`: The model to freeze. It is left unchanged.
+    - `opts`: Keyword list of options.
+      - `:optimize` - Also run `torch::jit::optimize_for_inference`, which
+        applies further inference-only rewrites (e.g. MKLDNN conversion
+        and conv-add-relu fusion on CPU) (default: `false`).
+
+  ## Returns
+  A new, frozen `%ExTorch.JIT.Model{}`.
+  """
+  @spec freeze(Model.t(), keyword()) :: Model.t()
+  def freeze(%Model{} = model, opts \\ []) do
+    ExTorch.Native.jit_freeze(model, Keyword.get(opts, :optimize, false))
+  end
+
+  @doc """
+  Get the TorchScript graph executor settings.
+
+  ## Returns
+  A map with:
+    - `:profiling_executor` - whether the profiling executor is used.
+    - `:num_profiled_runs` - calls spent profiling before a graph is
+      specialized and optimized.
+    - `:fusion_strategy` - list of `{:static | :dynamic, depth}` tuples:
+      how many shape specializations of each kind are compiled before
+      falling back.
+    - `:cpu_fusion` - whether fusion groups may run on CPU.
+    - `:texpr_fuser` - whether the NNC (TensorExpr) fuser is enabled.
+  """
+  @spec executor_options() :: map()
+  def executor_options do
+    ExTorch.Native.jit_get_executor_options()
+  end
+
+  @doc """
+  Update the TorchScript graph executor settings.
+
+  These settings are process-wide and affect every TorchScript model,
+  including already loaded ones that have not been specialized yet. Keys
+  not given keep their current value (see `executor_options/0`).
+
+  ## Examples
+
+      # Specialize after a single profiling run and fuse on CPU with NNC.
+      ExTorch.JIT.set_executor_options(
+        num_profiled_runs: 1,
+        fusion_strategy: [static: 2],
+        cpu_fusion: true
+      )
+
+  ## Returns
+  The resulting settings map.
+  """
+  @spec set_executor_options(keyword()) :: map()
+  def set_executor_options(opts) when is_list(opts) do
+    current = executor_options()
+    options = Map.merge(current, Map.new(opts))
+
+    ExTorch.Native.jit_set_executor_options(
+      options.profiling_executor,
+      options.num_profiled_runs,
+      Enum.to_list(options.fusion_strategy),
+      options.cpu_fusion,
+      options.texpr_fuser
+    )
+
+    executor_options()
   end
 
   @doc """
@@ -163,4 +277,74 @@ defmodule ExTorch.JIT do
   def to(%Model{} = model, device) do
     ExTorch.Native.jit_to_device(model, device)
   end
+
+  @doc """
+  Move and/or cast a model's parameters and buffers in place.
+
+  Unlike `to/2`, the module is not cloned: each parameter and buffer is
+  converted and swapped into the existing module in turn, so peak memory
+  only grows by the size of one tensor. Every reference to the model
+  observes the change, so only use it on a model you own exclusively
+  (e.g. right after `load/2`).
+
+  ## Arguments
+    - `model`: The model to convert.
+    - `opts`: Keyword list of options.
+      - `:device` - Target device (default: the model's current device).
+      - `:dtype` - Target dtype for floating point parameters and buffers,
+        e.g. `:bfloat16`. Integer and boolean tensors keep their dtype
+        (default: `nil`, keep).
+      - `:non_blocking` - Use asynchronous copies where possible
+        (default: `false`).
+
+  ## Returns
+  The model, with its `device` field updated.
+
+  ## Examples
+
+      model = ExTorch.JIT.load("model.pt") |> ExTorch.JIT.to_inplace(device: :cuda, dtype: :bfloat16)
+  """
+  @spec to_inplace(Model.t(), keyword()) :: Model.t()
+  def to_inplace(%Model{} = model, opts) when is_list(opts) do
+    ExTorch.Native.jit_to_inplace(
+      model,
+      Keyword.get(opts, :device, model.device),
+      Keyword.get(opts, :dtype),
+      Keyword.get(opts, :non_blocking, false)
+    )
+  end
+
+  @doc """
+  Move and/or cast a model in place, one parameter or buffer per native call.
+
+  Takes the same options as `to_inplace/2`, plus:
+    - `:on_tensor` - a `fn name, index, total -> any` callback invoked after
+      each tensor is converted, e.g. for progress reporting.
+
+  Each tensor is converted by its own (dirty) NIF call, so no single call
+  blocks for the duration of a multi-gigabyte migration, and callers can
+  observe progress or interleave other work.
+
+  ## Returns
+  The model, with its `device` field updated.
+  """
+  @spec to_streaming(Model.t(), keyword()) :: Model.t()
+  def to_streaming(%Model{} = model, opts) when is_list(opts) do
+    device = Keyword.get(opts, :device, model.device)
+    dtype = Keyword.get(opts, :dtype)
+    non_blocking = Keyword.get(opts, :non_blocking, false)
+    on_tensor = Keyword.get(opts, :on_tensor, fn _name, _index, _total -> :ok end)
+
+    names = ExTorch.Native.jit_state_names(model)
+    total = length(names)
+
+    names
+    |> Enum.with_index(1)
+    |> Enum.each(fn {name, index} ->
+      ExTorch.Native.jit_state_to(model, name, device, dtype, non_blocking)
+      on_tensor.(name, index, total)
+    end)
+
+    %{model | device: device}
+  end
 end
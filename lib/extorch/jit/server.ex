@@ -59,6 +59,8 @@ defmodule ExTorch.JIT.Server do
     - `:device` - Device to load the model onto (default: `:cpu`).
     - `:name` - Optional registered name for the server.
     - `:eval` - Whether to set the model to eval mode on load (default: `true`).
+    - `:freeze`, `:optimize_for_inference`, `:warmup`, `:warmup_runs` -
+      Passed to `ExTorch.JIT.load/2`.
   """
   @spec start_link(keyword()) :: GenServer.on_start()
   def start_link(opts) do
@@ -104,7 +106,11 @@ defmodule ExTorch.JIT.Server do
 
     model =
       :telemetry.span([:extorch, :jit, :load], metadata, fn ->
-        m = JIT.load(path, device: device)
+        load_opts =
+          [device: device] ++
+            Keyword.take(opts, [:freeze, :optimize_for_inference, :warmup, :warmup_runs])
+
+        m = JIT.load(path, load_opts)
         {m, metadata}
       end)
 
@@ -0,0 +1,258 @@
+defmodule ExTorch.KVCache do
+  @moduledoc """
+  Paged key/value cache for autoregressive decoding.
+
+  A decoder attends every new token to the keys and values of all the
+  tokens before it. Carrying them as growing tensors (as an
+  `ExTorch.Export.Session` state, for instance) reallocates and copies the
+  whole history on every step, and sizing a buffer per sequence for the
+  longest possible output wastes memory on the short ones.
+
+  A cache instead preallocates, for every layer, two pools of fixed-size
+  blocks of `:block_size` tokens. Each sequence holds a table of the
+  blocks it uses: it takes a block from the free list when its last one
+  fills up and gives all of them back when it is freed, so many sequences
+  of any length share the pools and appending a step only writes its new
+  tokens. Attention then reads the blocks of the sequence with one gather
+  per pool, or in place when the sequence holds adjacent blocks.
+
+  Every layer of a sequence keeps its own length. A decoder step appends
+  the new keys and values to layer 0 and attends over it, then layer 1,
+  and so on:
+
+      cache = ExTorch.KVCache.new(num_layers: 2, num_heads: 4, head_dim: 16, num_blocks: 64)
+      seq = ExTorch.KVCache.add_sequence(cache)
+
+      # q, k, v: [1, num_heads, new_tokens, head_dim]
+      out = ExTorch.KVCache.attention(cache, seq, 0, q, k, v)
+      ...
+      :ok = ExTorch.KVCache.free_sequence(cache, seq)
+
+  Appending, gathering and freeing take a lock per cache; the attention
+  itself (`at::scaled_dot_product_attention` over the gathered keys and
+  values) runs outside of it.
+
+  ## Exported graphs
+
+  Creating a cache also registers its `id` for the
+  `extorch::kv_cache_attention` operator, so a model exported with
+  `torch.export` can attend through the cache when its graph is run by
+  `ExTorch.Export.forward_compiled/2` (or an `ExTorch.Export.Session`).
+  On the Python side, declare the operator before exporting:
+
+      @torch.library.custom_op("extorch::kv_cache_attention", mutates_args=())
+      def kv_cache_attention(query: Tensor, key: Tensor, value: Tensor, cache: int,
+                             sequence: Tensor, layer: int,
+                             scale: Optional[float] = None) -> Tensor:
+          ...  # reference implementation, used when tracing
+
+      @kv_cache_attention.register_fake
+      def _(query, key, value, cache, sequence, layer, scale=None):
+          return torch.empty_like(query)
+
+  `cache` is the id given to `new/1` (through `:id`) and `sequence` is a
+  0-dim int64 tensor input of the graph, so the same graph serves every
+  sequence.
+
+  ## Telemetry
+
+  `emit_telemetry/1` executes `[:extorch, :kv_cache, :pool]` once per given
+  cache, with the `stats/1` counters as measurements and `%{cache: name}`
+  as metadata. It is meant to be polled, e.g. with `:telemetry_poller`:
+
+      {:telemetry_poller,
+       measurements: [{ExTorch.KVCache, :emit_telemetry, [[decoder: cache]]}],
+       period: :timer.seconds(10)}
+  """
+
+  @type t :: %__MODULE__{
+          resource: reference(),
+          reference: reference(),
+          id: non_neg_integer(),
+          num_layers: pos_integer(),
+          num_heads: pos_integer(),
+          head_dim: pos_integer(),
+          block_size: pos_integer(),
+          num_blocks: pos_integer()
+        }
+
+  @type sequence :: non_neg_integer()
+
+  defstruct [
+    :resource,
+    :reference,
+    :id,
+    :num_layers,
+    :num_heads,
+    :head_dim,
+    :block_size,
+    :num_blocks
+  ]
+
+  @doc """
+  Create a cache and preallocate its pools.
+
+  ## Args
+    * `opts` (`keyword`) - the cache options:
+      * `:num_layers` (`integer`) - the number of attention layers. Required.
+      * `:num_heads` (`integer`) - the number of key/value heads. Required.
+      * `:head_dim` (`integer`) - the dimension of each head. Required.
+      * `:num_blocks` (`integer`) - the number of blocks in the pool of each
+        layer. Required.
+      * `:block_size` (`integer`) - the number of tokens per block. Default: `16`.
+      * `:dtype` (`ExTorch.DType`) - the dtype of the stored keys and values.
+        Default: `:float32`.
+      * `:device` (`ExTorch.Device`) - the device of the pools. Default: `:cpu`.
+      * `:id` (`integer`) - the id the cache is registered under for the
+        `extorch::kv_cache_attention` operator. Default: a fresh id.
+
+  ## Returns
+  An `ExTorch.KVCache`, holding `2 * num_layers * num_blocks * block_size *
+  num_heads * head_dim` elements. Raises if `:id` is used by another live cache.
+  """
+  @spec new(keyword()) :: t()
+  def new(opts) do
+    ExTorch.Native.kv_cache_new(
+      Keyword.get(opts, :id, -1),
+      Keyword.fetch!(opts, :num_layers),
+      Keyword.fetch!(opts, :num_heads),
+      Keyword.fetch!(opts, :head_dim),
+      Keyword.get(opts, :block_size, 16),
+      Keyword.fetch!(opts, :num_blocks),
+      Atom.to_string(Keyword.get(opts, :dtype, :float32)),
+      Keyword.get(opts, :device, :cpu)
+    )
+  end
+
+  @doc """
+  Start an empty sequence. It holds no blocks until something is appended.
+
+  ## Returns
+  The id of the sequence.
+  """
+  @spec add_sequence(t()) :: sequence()
+  def add_sequence(%__MODULE__{} = cache) do
+    ExTorch.Native.kv_cache_add_sequence(cache)
+  end
+
+  @doc """
+  Free a sequence, returning its blocks to the pool.
+  """
+  @spec free_sequence(t(), sequence()) :: :ok
+  def free_sequence(%__MODULE__{} = cache, sequence) do
+    ExTorch.Native.kv_cache_free_sequence(cache, sequence)
+  end
+
+  @doc """
+  Get the number of tokens appended to a layer of a sequence.
+  """
+  @spec length(t(), sequence(), non_neg_integer()) :: non_neg_integer()
+  def length(%__MODULE__{} = cache, sequence, layer) do
+    ExTorch.Native.kv_cache_sequence_length(cache, sequence, layer)
+  end
+
+  @doc """
+  Append the keys and values of new tokens to a layer of a sequence.
+
+  ## Args
+    * `cache` (`ExTorch.KVCache`) - the cache.
+    * `sequence` (`integer`) - the sequence id.
+    * `layer` (`integer`) - the layer index.
+    * `key` (`ExTorch.Tensor`) - the `[1, num_heads, n, head_dim]` (or
+      `[num_heads, n, head_dim]`) keys of `n` new tokens.
+    * `value` (`ExTorch.Tensor`) - their values, of the same shape.
+
+  ## Returns
+  `:ok`. Raises, appending nothing, if the pool has no blocks left.
+  """
+  @spec append(t(), sequence(), non_neg_integer(), ExTorch.Tensor.t(), ExTorch.Tensor.t()) ::
+          :ok
+  def append(%__MODULE__{} = cache, sequence, layer, key, value) do
+    ExTorch.Native.kv_cache_append(cache, sequence, layer, key, value)
+  end
+
+  @doc """
+  Gather the cached keys and values of a layer of a sequence.
+
+  ## Returns
+  A `{keys, values}` tuple of contiguous `[1, num_heads, length, head_dim]`
+  tensors, copied out of the blocks of the sequence.
+  """
+  @spec keys_values(t(), sequence(), non_neg_integer()) :: {ExTorch.Tensor.t(), ExTorch.Tensor.t()}
+  def keys_values(%__MODULE__{} = cache, sequence, layer) do
+    ExTorch.Native.kv_cache_gather(cache, sequence, layer)
+  end
+
+  @doc """
+  Append the keys and values of new tokens to a layer of a sequence and
+  attend their queries over every cached token.
+
+  ## Args
+    * `cache` (`ExTorch.KVCache`) - the cache.
+    * `sequence` (`integer`) - the sequence id.
+    * `layer` (`integer`) - the layer index.
+    * `query` (`ExTorch.Tensor`) - the `[1, num_heads, n, head_dim]` queries
+      of `n` new tokens.
+    * `key` (`ExTorch.Tensor`) - their keys, as in `append/5`.
+    * `value` (`ExTorch.Tensor`) - their values, as in `append/5`.
+    * `opts` (`keyword`) - optional arguments:
+      * `:scale` (`float`) - the attention scale. Default: `1 / sqrt(head_dim)`.
+
+  ## Returns
+  The `[1, num_heads, n, head_dim]` attention output. The new tokens attend
+  to the tokens before them and causally to each other, so a prefill of the
+  whole prompt and a single-token decode step go through the same call.
+  """
+  @spec attention(
+          t(),
+          sequence(),
+          non_neg_integer(),
+          ExTorch.Tensor.t(),
+          ExTorch.Tensor.t(),
+          ExTorch.Tensor.t(),
+          keyword()
+        ) :: ExTorch.Tensor.t()
+  def attention(%__MODULE__{} = cache, sequence, layer, query, key, value, opts \\ []) do
+    {scale, has_scale} =
+      case Keyword.get(opts, :scale) do
+        nil -> {0.0, false}
+        scale -> {scale / 1, true}
+      end
+
+    ExTorch.Native.kv_cache_attention(cache, sequence, layer, query, key, value, scale, has_scale)
+  end
+
+  @doc """
+  Get the pool occupancy of a cache.
+
+  ## Returns
+  A map with:
+    * `:num_blocks` - the blocks in the pool of each layer.
+    * `:used_blocks` - the blocks held by sequences.
+    * `:free_blocks` - the blocks left.
+    * `:peak_used_blocks` - the most blocks held at once.
+    * `:block_size` - the tokens per block.
+    * `:sequences` - the live sequences.
+    * `:tokens` - the tokens cached over all sequences (the longest layer of each).
+    * `:pool_bytes` - the bytes preallocated for keys and values.
+  """
+  @spec stats(t()) :: %{atom() => non_neg_integer()}
+  def stats(%__MODULE__{} = cache), do: ExTorch.Native.kv_cache_stats(cache)
+
+  @doc """
+  Emit `[:extorch, :kv_cache, :pool]` telemetry events. See the module docs.
+
+  ## Args
+    * `caches` (`[{name, ExTorch.KVCache}]` or map) - the caches to report,
+      each with the name put in the event metadata.
+
+  ## Returns
+  `:ok`.
+  """
+  @spec emit_telemetry([{term(), t()}] | map()) :: :ok
+  def emit_telemetry(caches) do
+    Enum.each(caches, fn {name, cache} ->
+      :telemetry.execute([:extorch, :kv_cache, :pool], stats(cache), %{cache: name})
+    end)
+  end
+end
@@ -0,0 +1,348 @@
+defmodule ExTorch.LoadTest do
+  @moduledoc """
+  Open-loop load generation against model servers.
+
+  `run/3` sends requests to `ExTorch.Export.Server`, `ExTorch.AOTI.Server`,
+  `ExTorch.JIT.Server` (or a pool of them) at a target rate, from several
+  generator processes, and reports throughput and latency percentiles.
+
+  Requests follow a schedule fixed in advance (Poisson arrivals by default)
+  and never wait for earlier ones to finish: each one runs in its own
+  process. Latency is measured from the time the schedule *intended* to
+  send the request, not from when it was actually sent, so a stalled
+  server or a late generator shows up in the tail instead of silently
+  lowering the offered load (the "coordinated omission" of closed-loop
+  benchmarks such as `bench/inference.exs`).
+
+  Latencies are kept in the same log-linear histogram as
+  `ExTorch.Metrics`, so percentiles are within about 3% of the exact ones.
+
+  ## Example
+
+      {:ok, pid} = ExTorch.Export.Server.start_link(path: "resnet18.pt2")
+
+      report =
+        ExTorch.LoadTest.run({ExTorch.Export.Server, pid}, [input],
+          rate: 200,
+          duration: 30_000,
+          warmup: 5_000,
+          output: "resnet18_200rps.json"
+        )
+
+      report.latency_ms.p99
+  """
+
+  alias ExTorch.Metrics
+
+  @typedoc """
+  Where requests are sent: a `{server_module, server}` pair whose module
+  exports `predict/3`, a one-argument function called with the inputs, or
+  a list of those, used in turn (a pool).
+  """
+  @type target ::
+          {module(), GenServer.server()}
+          | ([ExTorch.Tensor.t()] -> term())
+          | [{module(), GenServer.server()} | ([ExTorch.Tensor.t()] -> term())]
+
+  # :counters slots
+  @sent 1
+  @completed 2
+  @errors 3
+  @timeouts 4
+  @total_latency 5
+  @first_bucket 6
+
+  # :atomics slots
+  @min_latency 1
+  @max_latency 2
+  @max_send_lag 3
+  @in_flight 4
+  @next_target 5
+  @closed 6
+  @atomic_slots 6
+
+  # The resolution of `Process.sleep/1`, in microseconds.
+  @timer_slack 1000
+
+  @int64_max Bitwise.bsl(1, 63) - 1
+
+  @doc """
+  Drive `target` with `inputs` at a fixed request rate and report the
+  results.
+
+  ## Args
+    * `target` (`t:target/0`) - the server(s) or function under load.
+    * `inputs` (`[ExTorch.Tensor]`) - the inputs sent with every request.
+    * `opts` (`keyword`) - optional arguments:
+      * `:rate` (`number`) - the target rate, in requests per second.
+        Required.
+      * `:duration` (`integer`) - the measured period, in milliseconds.
+        Default: `10_000`.
+      * `:warmup` (`integer`) - a period before the measured one, at the
+        same rate, whose requests are not recorded. Default: `0`.
+      * `:arrivals` (`:poisson | :uniform`) - exponentially distributed or
+        constant gaps between requests. Default: `:poisson`.
+      * `:generators` (`integer`) - the number of generator processes,
+        each sending `rate / generators` requests per second.
+        Default: `System.schedulers_online()`.
+      * `:timeout` (`timeout`) - the timeout of each server call, in
+        milliseconds. The report waits for the calls still running when
+        the measured period ends, up to one second past this timeout.
+        Default: `5_000`.
+      * `:output` (`Path.t()`) - also write the report to this file as
+        JSON.
+
+  ## Returns
+  A map with the offered and achieved rates, the request counts
+  (`:sent`, `:completed`, `:errors` and `:timeouts`), the latencies of
+  the completed requests in `:latency_ms` (`:min`, `:mean`, `:p50`,
+  `:p90`, `:p99`, `:p999` and `:max`), and `:max_send_lag_ms`, how late
+  the generators sent a request compared to its schedule.
+  """
+  @spec run(target(), [ExTorch.Tensor.t()], keyword()) :: map()
+  def run(target, inputs, opts) when is_list(inputs) do
+    rate = Keyword.fetch!(opts, :rate)
+    duration = Keyword.get(opts, :duration, 10_000)
+    warmup = Keyword.get(opts, :warmup, 0)
+    arrivals = Keyword.get(opts, :arrivals, :poisson)
+    generators = Keyword.get(opts, :generators, System.schedulers_online())
+    timeout = Keyword.get(opts, :timeout, 5_000)
+
+    unless rate > 0 and arrivals in [:poisson, :uniform] and generators > 0 do
+      raise ArgumentError, "expected a positive :rate and :generators, and :poisson or :uniform :arrivals"
+    end
+
+    counters = :counters.new(@first_bucket + Metrics.bucket_count() - 1, [:write_concurrency])
+    atomics = :atomics.new(@atomic_slots, signed: true)
+    :atomics.put(atomics, @min_latency, @int64_max)
+
+    start = now()
+    measure_from = start + warmup * 1000
+    stop = measure_from + duration * 1000
+
+    state = %{
+      call: caller(target, timeout, atomics),
+      inputs: inputs,
+      counters: counters,
+      atomics: atomics,
+      measure_from: measure_from,
+      stop: stop,
+      arrivals: arrivals,
+      interval: generators * 1_000_000 / rate
+    }
+
+    1..generators
+    |> Enum.map(fn generator ->
+      first =
+        case arrivals do
+          :poisson -> start + gap(state)
+          :uniform -> start + state.interval * generator / generators
+        end
+
+      Task.async(fn -> generate(state, first) end)
+    end)
+    |> Task.await_many(:infinity)
+
+    drain(atomics, drain_deadline(timeout))
+    # Requests still running are reported as :in_flight, and no longer
+    # recorded when they end.
+    :atomics.put(atomics, @closed, 1)
+    elapsed = max(now(), stop) - measure_from
+
+    report = report(counters, atomics, rate, arrivals, generators, duration, warmup, elapsed)
+
+    case Keyword.get(opts, :output) do
+      nil -> :ok
+      path -> File.write!(path, to_json(report))
+    end
+
+    report
+  end
+
+  @doc """
+  Encode a report of `run/3` as JSON.
+  """
+  @spec to_json(map()) :: String.t()
+  def to_json(report) do
+    Jason.encode!(report, pretty: true)
+  end
+
+  # ============================================================================
+  # Generators
+  # ============================================================================
+
+  defp caller(targets, timeout, atomics) when is_list(targets) and targets != [] do
+    calls = targets |> Enum.map(&caller(&1, timeout, atomics)) |> List.to_tuple()
+    size = tuple_size(calls)
+
+    fn inputs ->
+      index = rem(:atomics.add_get(atomics, @next_target, 1), size)
+      elem(calls, index).(inputs)
+    end
+  end
+
+  defp caller({module, server}, timeout, _atomics) when is_atom(module) do
+    fn inputs -> module.predict(server, inputs, timeout) end
+  end
+
+  defp caller(fun, _timeout, _atomics) when is_function(fun, 1), do: fun
+
+  defp caller(target, _timeout, _atomics) do
+    raise ArgumentError, "invalid load test target: #{inspect(target)}"
+  end
+
+  # `intended` is the scheduled send time, in (fractional) microseconds.
+  # Timers have millisecond resolution, so a request due within
+  # `@timer_slack` is sent right away instead of spinning a scheduler until
+  # its exact time: it may leave up to that much early.
+  defp generate(%{stop: stop}, intended) when intended >= stop, do: :ok
+
+  defp generate(state, intended) do
+    wait = intended - now()
+
+    if wait >= @timer_slack do
+      Process.sleep(trunc(wait / 1000))
+      generate(state, intended)
+    else
+      send_request(state, intended, -wait)
+      generate(state, intended + gap(state))
+    end
+  end
+
+  defp gap(%{arrivals: :uniform, interval: interval}), do: interval
+  defp gap(%{arrivals: :poisson, interval: interval}), do: -interval * :math.log(1.0 - :rand.uniform())
+
+  defp send_request(state, intended, lag) do
+    %{call: call, inputs: inputs, counters: counters, atomics: atomics} = state
+    measured = intended >= state.measure_from
+    # Early requests are timed from when they were actually sent.
+    start = intended + min(lag, 0)
+
+    if measured do
+      :counters.add(counters, @sent, 1)
+      raise_to(atomics, @max_send_lag, round(max(lag, 0)))
+    end
+
+    :atomics.add(atomics, @in_flight, 1)
+
+    spawn(fn ->
+      outcome =
+        try do
+          call.(inputs)
+          @completed
+        catch
+          :exit, {:timeout, _} -> @timeouts
+          _kind, _reason -> @errors
+        end
+
+      if measured and :atomics.get(atomics, @closed) == 0 do
+        :counters.add(counters, outcome, 1)
+        if outcome == @completed, do: record(counters, atomics, round(now() - start))
+      end
+
+      :atomics.sub(atomics, @in_flight, 1)
+    end)
+  end
+
+  defp record(counters, atomics, latency) do
+    :counters.add(counters, @total_latency, latency)
+    :counters.add(counters, @first_bucket + Metrics.bucket_index(latency), 1)
+    lower(atomics, @min_latency, latency)
+    raise_to(atomics, @max_latency, latency)
+  end
+
+  # Server calls end within their timeout (in ms, the clock is in µs); the
+  # extra second covers the calls sent last.
+  defp drain_deadline(:infinity), do: :infinity
+  defp drain_deadline(timeout), do: now() + timeout * 1000 + 1_000_000
+
+  defp drain(atomics, deadline) do
+    if :atomics.get(atomics, @in_flight) > 0 and (deadline == :infinity or now() < deadline) do
+      Process.sleep(1)
+      drain(atomics, deadline)
+    else
+      :ok
+    end
+  end
+
+  defp lower(atomics, index, value) do
+    current = :atomics.get(atomics, index)
+
+    if value < current do
+      case :atomics.compare_exchange(atomics, index, current, value) do
+        :ok -> :ok
+        _ -> lower(atomics, index, value)
+      end
+    else
+      :ok
+    end
+  end
+
+  defp raise_to(atomics, index, value) do
+    current = :atomics.get(atomics, index)
+
+    if value > current do
+      case :atomics.compare_exchange(atomics, index, current, value) do
+        :ok -> :ok
+        _ -> raise_to(atomics, index, value)
+      end
+    else
+      :ok
+    end
+  end
+
+  defp now, do: System.monotonic_time(:microsecond)
+
+  # ============================================================================
+  # Report
+  # ============================================================================
+
+  defp report(counters, atomics, rate, arrivals, generators, duration, warmup, elapsed) do
+    sent = :counters.get(counters, @sent)
+    completed = :counters.get(counters, @completed)
+    min_latency = :atomics.get(atomics, @min_latency)
+    max_latency = :atomics.get(atomics, @max_latency)
+
+    [p50, p90, p99, p999] =
+      Metrics.quantiles(counters, @first_bucket, completed, min_latency, max_latency, [
+        0.5,
+        0.9,
+        0.99,
+        0.999
+      ])
+
+    latency =
+      if completed == 0 do
+        %{min: nil, mean: nil, p50: nil, p90: nil, p99: nil, p999: nil, max: nil}
+      else
+        %{
+          min: to_ms(min_latency),
+          mean: to_ms(:counters.get(counters, @total_latency) / completed),
+          p50: p50,
+          p90: p90,
+          p99: p99,
+          p999: p999,
+          max: to_ms(max_latency)
+        }
+      end
+
+    %{
+      target_rate: rate,
+      arrivals: arrivals,
+      generators: generators,
+      duration_ms: duration,
+      warmup_ms: warmup,
+      sent: sent,
+      completed: completed,
+      errors: :counters.get(counters, @errors),
+      timeouts: :counters.get(counters, @timeouts),
+      in_flight: :atomics.get(atomics, @in_flight),
+      send_rate: sent * 1000 / duration,
+      throughput: completed * 1_000_000 / elapsed,
+      latency_ms: latency,
+      max_send_lag_ms: to_ms(:atomics.get(atomics, @max_send_lag))
+    }
+  end
+
+  defp to_ms(microseconds), do: microseconds / 1000
+end
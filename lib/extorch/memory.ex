@@ -0,0 +1,126 @@
+defmodule ExTorch.Memory do
+  @moduledoc """
+  CPU memory accounting for model serving.
+
+  `enable_cpu_tracking/0` replaces the libtorch CPU allocator with one that
+  counts the bytes it hands out, for the whole process (`cpu_stats/0`) and
+  per model (`model_stats/1`): the executors of compiled export graphs,
+  AOTI and JIT models charge every CPU allocation made on the thread
+  running a forward pass to that model, until it is freed. The peak of the
+  bytes a single request held at once approximates its activation memory,
+  and the weight bytes of a model are reported next to it, which is what
+  sizing replicas per host needs.
+
+  Tracking is off by default. Only allocations made while it is on are
+  counted, so enable it before loading models, either by calling
+  `enable_cpu_tracking/0` or with:
+
+      config :extorch, cpu_memory_tracking: true
+
+  Counting costs a few atomic operations per allocation and adds a
+  64-byte header to each block. Allocations made by intra-op worker
+  threads are counted in the process totals but not in model accounts.
+
+  ## Telemetry
+
+  `emit_telemetry/1` executes
+
+    * `[:extorch, :memory, :cpu]` with the `cpu_stats/0` counters as
+      measurements.
+    * `[:extorch, :memory, :model]` once per given model, with the
+      `model_stats/1` counters as measurements and `%{model: name}` as
+      metadata.
+
+  It is meant to be polled, e.g. with `:telemetry_poller`:
+
+      {:telemetry_poller,
+       measurements: [{ExTorch.Memory, :emit_telemetry, [[resnet: model]]}],
+       period: :timer.seconds(10)}
+  """
+
+  @type model :: ExTorch.Export.Model.t() | ExTorch.AOTI.Model.t() | ExTorch.JIT.Model.t()
+
+  @doc """
+  Start counting CPU allocations. Does nothing if tracking is already on.
+  """
+  @spec enable_cpu_tracking() :: :ok
+  def enable_cpu_tracking, do: ExTorch.Native.cpu_memory_tracking(true)
+
+  @doc """
+  Put back the CPU allocator replaced by `enable_cpu_tracking/0`. Blocks
+  allocated while tracking was on are still counted when freed.
+  """
+  @spec disable_cpu_tracking() :: :ok
+  def disable_cpu_tracking, do: ExTorch.Native.cpu_memory_tracking(false)
+
+  @doc """
+  Process-wide CPU allocator counters.
+
+  ## Returns
+  A map with:
+    * `:enabled` - whether tracking is on.
+    * `:live_bytes` - bytes allocated and not yet freed.
+    * `:peak_bytes` - the most bytes live at once, see `reset_cpu_peak/0`.
+    * `:allocations` and `:frees` - the number of blocks allocated and freed.
+  """
+  @spec cpu_stats() :: map()
+  def cpu_stats, do: ExTorch.Native.cpu_memory_stats()
+
+  @doc """
+  Restart the process-wide peak from the bytes currently live.
+  """
+  @spec reset_cpu_peak() :: :ok
+  def reset_cpu_peak, do: ExTorch.Native.cpu_memory_reset_peak()
+
+  @doc """
+  CPU memory charged to a model.
+
+  ## Args
+    * `model` (`ExTorch.Export.Model | ExTorch.AOTI.Model | ExTorch.JIT.Model`) -
+      the model. Export models are accounted when run with
+      `ExTorch.Export.forward_compiled/2`.
+
+  ## Returns
+  A map with:
+    * `:live_bytes` - bytes allocated by its forward passes and still alive,
+      such as outputs held by the caller.
+    * `:peak_bytes` - the most of those bytes live at once, over all
+      concurrent requests.
+    * `:allocations` and `:frees` - the number of blocks allocated and freed.
+    * `:requests` - the number of forward passes accounted.
+    * `:last_request_peak_bytes` and `:max_request_peak_bytes` - the most
+      bytes a single forward pass held at once, for the last one and over
+      all of them.
+    * `:weight_bytes` - the bytes of its parameters, buffers and constants,
+      on any device.
+  """
+  @spec model_stats(model()) :: map()
+  def model_stats(%ExTorch.Export.Model{native_compiled: nil}) do
+    raise ArgumentError, "the model has no compiled graph to account"
+  end
+
+  def model_stats(%ExTorch.Export.Model{native_compiled: compiled}),
+    do: ExTorch.Native.compiled_graph_memory_stats(compiled)
+
+  def model_stats(%ExTorch.AOTI.Model{} = model), do: ExTorch.Native.aoti_memory_stats(model)
+  def model_stats(%ExTorch.JIT.Model{} = model), do: ExTorch.Native.jit_memory_stats(model)
+
+  @doc """
+  Emit the CPU and per-model memory telemetry events.
+
+  ## Args
+    * `models` (`[{term, model}]`) - the models to report, by name.
+
+  ## Returns
+  `:ok`.
+  """
+  @spec emit_telemetry([{term(), model()}] | map()) :: :ok
+  def emit_telemetry(models \\ []) do
+    {_enabled, cpu} = Map.pop(cpu_stats(), :enabled)
+    :telemetry.execute([:extorch, :memory, :cpu], cpu, %{})
+
+    Enum.each(models, fn {name, model} ->
+      :telemetry.execute([:extorch, :memory, :model], model_stats(model), %{model: name})
+    end)
+  end
+end
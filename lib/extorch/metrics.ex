@@ -1,9 +1,10 @@
 defmodule ExTorch.Metrics do
   @moduledoc """
-  ETS-backed metrics collection for ExTorch model serving.
+  Lock-free metrics collection for ExTorch model serving.
 
-  Automatically attaches to telemetry events emitted by `ExTorch.JIT.Server`
-  and maintains per-model inference statistics.
+  Attaches to the `:load` and `:forward` telemetry events emitted by
+  `ExTorch.JIT.Server`, `ExTorch.AOTI.Server` and `ExTorch.Export.Server`,
+  and keeps per-model inference statistics, including latency percentiles.
 
   ## Setup
 
@@ -18,16 +19,58 @@ defmodule ExTorch.Metrics do
 
       ExTorch.Metrics.get("model.pt")
       # => %{inference_count: 150, error_count: 2, total_duration_ms: 4523.1,
-      #      min_duration_ms: 12.3, max_duration_ms: 89.2, last_inference_at: ~U[...]}
+      #      min_duration_ms: 12.3, max_duration_ms: 89.2, p50_duration_ms: 27.9,
+      #      p95_duration_ms: 51.2, p99_duration_ms: 77.8, p999_duration_ms: 89.2,
+      #      backend: :jit, last_inference_at: 1718000000000, ...}
 
       ExTorch.Metrics.all()
       # => [{"model.pt", %{...}}, {"other.pt", %{...}}]
 
+  ## Histograms
+
+  Forward latencies are recorded in microseconds into a log-linear (HDR
+  style) histogram: values below 64 microseconds get a bucket each, and
+  every power of two above is split into 32 buckets, so a reported
+  percentile is within about 3% of the exact one. Values above roughly 19
+  hours fall into the last bucket.
+
+  Each model owns a `:counters` array (buckets, counts and sums) and an
+  `:atomics` array (min, max, load time, last inference time), created on
+  its first event. Telemetry handlers only increment them, so concurrent
+  requests never contend on an ETS row or lose updates.
   """
 
+  import Bitwise
+
   @table __MODULE__
   @handler_id "extorch-metrics"
 
+  @backends [:jit, :aoti, :export]
+
+  # Log-linear buckets: values below 2^@precision_bits are exact, and each
+  # power of two above is split into 2^(@precision_bits - 1) buckets.
+  @precision_bits 6
+  @half_bucket_count 1 <<< (@precision_bits - 1)
+  @max_shift 30
+  @bucket_count (@max_shift + 2) * @half_bucket_count
+  @max_value (1 <<< (@max_shift + @precision_bits)) - 1
+
+  # :counters slots
+  @inference_count 1
+  @error_count 2
+  @total_duration 3
+  @first_bucket 4
+  @counter_slots @first_bucket + @bucket_count - 1
+
+  # :atomics slots
+  @min_duration 1
+  @max_duration 2
+  @load_duration 3
+  @last_inference_at 4
+  @atomic_slots 4
+
+  @int64_max (1 <<< 63) - 1
+
   @doc """
   Initialize the metrics ETS table and attach telemetry handlers.
 
@@ -39,13 +82,13 @@ defmodule ExTorch.Metrics do
       :ets.new(@table, [:named_table, :public, :set, read_concurrency: true])
     end
 
-    events = [
-      [:extorch, :jit, :forward, :stop],
-      [:extorch, :jit, :forward, :exception],
-      [:extorch, :jit, :load, :stop]
-    ]
+    events =
+      for backend <- @backends,
+          suffix <- [[:forward, :stop], [:forward, :exception], [:load, :stop]] do
+        [:extorch, backend | suffix]
+      end
 
-    :telemetry.attach_many(@handler_id, events, &handle_event/4, nil)
+    :telemetry.attach_many(@handler_id, events, &__MODULE__.handle_event/4, nil)
     :ok
   end
 
@@ -60,12 +103,13 @@ defmodule ExTorch.Metrics do
   @doc """
   Get metrics for a specific model path.
 
-  Returns a map of metrics or `nil` if no data exists.
+  Returns a map of metrics or `nil` if no data exists. Durations are in
+  milliseconds; the percentiles are `nil` until the first inference.
   """
   @spec get(String.t()) :: map() | nil
   def get(path) do
     case :ets.lookup(@table, path) do
-      [{^path, metrics}] -> metrics
+      [{^path, counters, atomics}] -> snapshot(path, counters, atomics)
       [] -> nil
     end
   end
@@ -77,7 +121,54 @@ defmodule ExTorch.Metrics do
   """
   @spec all() :: [{String.t(), map()}]
   def all do
-    :ets.tab2list(@table)
+    # Only the series rows are 3-tuples; model info rows are pairs.
+    @table
+    |> :ets.match({:"$1", :"$2", :"$3"})
+    |> Enum.map(fn [path, counters, atomics] -> {path, snapshot(path, counters, atomics)} end)
+  end
+
+  @doc """
+  Get a forward latency percentile of a model, in milliseconds.
+
+  ## Args
+    * `path` (`String.t()`) - the model path.
+    * `quantile` (`float`) - the quantile, between `0.0` and `1.0`
+      (e.g. `0.99` for p99).
+
+  ## Returns
+  The latency, or `nil` if the model has no recorded inference.
+  """
+  @spec percentile(String.t(), float()) :: float() | nil
+  def percentile(path, quantile) when quantile >= 0 and quantile <= 1 do
+    case :ets.lookup(@table, path) do
+      [{^path, counters, atomics}] ->
+        [value] = percentiles(counters, atomics, [quantile])
+        value
+
+      [] ->
+        nil
+    end
+  end
+
+  @doc """
+  Get the forward latency histogram of a model.
+
+  ## Returns
+  The non-empty buckets as `{upper_bound_ms, count}` tuples, in increasing
+  order, or `nil` if no data exists.
+  """
+  @spec histogram(String.t()) :: [{float(), pos_integer()}] | nil
+  def histogram(path) do
+    case :ets.lookup(@table, path) do
+      [{^path, counters, _atomics}] ->
+        0..(@bucket_count - 1)
+        |> Enum.map(&{&1, :counters.get(counters, @first_bucket + &1)})
+        |> Enum.filter(fn {_index, count} -> count > 0 end)
+        |> Enum.map(fn {index, count} -> {to_ms(bucket_upper_bound(index)), count} end)
+
+      [] ->
+        nil
+    end
   end
 
   @doc """
@@ -86,6 +177,7 @@ defmodule ExTorch.Metrics do
   @spec reset(String.t()) :: :ok
   def reset(path) do
     :ets.delete(@table, path)
+    :ets.delete(@table, {:info, path})
     :ok
   end
 
@@ -103,65 +195,193 @@ defmodule ExTorch.Metrics do
   # ============================================================================
 
   @doc false
-  def handle_event([:extorch, :jit, :forward, :stop], measurements, metadata, _config) do
-    path = metadata.path
-    duration_ms = System.convert_time_unit(measurements.duration, :native, :microsecond) / 1000
-
-    update_metrics(path, fn metrics ->
-      count = metrics.inference_count + 1
-
-      %{
-        metrics
-        | inference_count: count,
-          total_duration_ms: metrics.total_duration_ms + duration_ms,
-          min_duration_ms: min(metrics.min_duration_ms, duration_ms),
-          max_duration_ms: max(metrics.max_duration_ms, duration_ms),
-          last_inference_at: System.system_time(:millisecond)
-      }
+  def handle_event([:extorch, _backend, :forward, :stop], measurements, metadata, _config) do
+    duration = System.convert_time_unit(measurements.duration, :native, :microsecond)
+
+    with_series(metadata.path, fn counters, atomics ->
+      :counters.add(counters, @inference_count, 1)
+      :counters.add(counters, @total_duration, duration)
+      :counters.add(counters, @first_bucket + bucket_index(duration), 1)
+      lower(atomics, @min_duration, duration)
+      raise_to(atomics, @max_duration, duration)
+      :atomics.put(atomics, @last_inference_at, System.system_time(:millisecond))
     end)
   end
 
-  def handle_event([:extorch, :jit, :forward, :exception], _measurements, metadata, _config) do
-    update_metrics(metadata.path, fn metrics ->
-      %{metrics | error_count: metrics.error_count + 1}
+  def handle_event([:extorch, _backend, :forward, :exception], _measurements, metadata, _config) do
+    with_series(metadata.path, fn counters, _atomics ->
+      :counters.add(counters, @error_count, 1)
     end)
   end
 
-  def handle_event([:extorch, :jit, :load, :stop], measurements, metadata, _config) do
+  def handle_event([:extorch, backend, :load, :stop], measurements, metadata, _config) do
     path = metadata.path
-    duration_ms = System.convert_time_unit(measurements.duration, :native, :microsecond) / 1000
+    duration = System.convert_time_unit(measurements.duration, :native, :microsecond)
 
-    update_metrics(path, fn metrics ->
-      %{metrics | load_duration_ms: duration_ms, device: metadata.device}
+    with_series(path, fn _counters, atomics ->
+      :atomics.put(atomics, @load_duration, duration)
     end)
+
+    # Loads are rare, so the last one simply overwrites the row.
+    if :ets.whereis(@table) != :undefined do
+      :ets.insert(@table, {{:info, path}, {backend, Map.get(metadata, :device, :cpu)}})
+    end
   end
 
-  defp update_metrics(path, update_fn) do
+  defp with_series(path, update_fn) do
     # Guard against the ETS table not existing. The table is created by
     # setup/0 and owned by its caller; if that process exits the table is
     # destroyed, but the telemetry handler persists. Silently skip the
     # update rather than crashing the handler with :badarg.
-    if :ets.whereis(@table) == :undefined, do: :ok, else: do_update_metrics(path, update_fn)
-  end
-
-  defp do_update_metrics(path, update_fn) do
-    default = %{
-      inference_count: 0,
-      error_count: 0,
-      total_duration_ms: 0.0,
-      min_duration_ms: :infinity,
-      max_duration_ms: 0.0,
-      load_duration_ms: 0.0,
-      device: :cpu,
-      last_inference_at: nil
-    }
+    if :ets.whereis(@table) == :undefined do
+      :ok
+    else
+      {counters, atomics} = series(path)
+      update_fn.(counters, atomics)
+      :ok
+    end
+  end
 
-    current =
-      case :ets.lookup(@table, path) do
-        [{^path, metrics}] -> metrics
-        [] -> default
+  defp series(path) do
+    case :ets.lookup(@table, path) do
+      [{^path, counters, atomics}] ->
+        {counters, atomics}
+
+      [] ->
+        counters = :counters.new(@counter_slots, [:write_concurrency])
+        atomics = :atomics.new(@atomic_slots, signed: true)
+        :atomics.put(atomics, @min_duration, @int64_max)
+
+        # Another handler may have created the series first; keep its arrays.
+        if :ets.insert_new(@table, {path, counters, atomics}) do
+          {counters, atomics}
+        else
+          case :ets.lookup(@table, path) do
+            [{^path, existing_counters, existing_atomics}] -> {existing_counters, existing_atomics}
+            [] -> {counters, atomics}
+          end
+        end
+    end
+  end
+
+  defp lower(atomics, index, value) do
+    current = :atomics.get(atomics, index)
+
+    if value < current do
+      case :atomics.compare_exchange(atomics, index, current, value) do
+        :ok -> :ok
+        _ -> lower(atomics, index, value)
+      end
+    else
+      :ok
+    end
+  end
+
+  defp raise_to(atomics, index, value) do
+    current = :atomics.get(atomics, index)
+
+    if value > current do
+      case :atomics.compare_exchange(atomics, index, current, value) do
+        :ok -> :ok
+        _ -> raise_to(atomics, index, value)
+      end
+    else
+      :ok
+    end
+  end
+
+  # ============================================================================
+  # Histogram
+  # ============================================================================
+
+  @doc false
+  def bucket_index(value) when value < 1 <<< @precision_bits, do: max(value, 0)
+
+  def bucket_index(value) do
+    value = min(value, @max_value)
+    shift = bit_length(value) - @precision_bits
+    (shift <<< (@precision_bits - 1)) + (value >>> shift)
+  end
+
+  @doc false
+  def bucket_upper_bound(index) when index < 1 <<< @precision_bits, do: index
+
+  def bucket_upper_bound(index) do
+    shift = div(index, @half_bucket_count) - 1
+    mantissa = index - (shift <<< (@precision_bits - 1))
+    ((mantissa + 1) <<< shift) - 1
+  end
+
+  defp bit_length(value, acc \\ 0)
+  defp bit_length(0, acc), do: acc
+  defp bit_length(value, acc), do: bit_length(value >>> 1, acc + 1)
+
+  @doc false
+  def bucket_count, do: @bucket_count
+
+  # Values at the given quantiles, in milliseconds, of a histogram laid out
+  # from `first` in `counters`: the upper bound of the bucket holding the
+  # rank, clamped to the exact min and max (in microseconds).
+  @doc false
+  def quantiles(counters, first, count, min_value, max_value, quantiles) do
+    if count == 0 do
+      Enum.map(quantiles, fn _ -> nil end)
+    else
+      ranks = Enum.map(quantiles, &max(ceil(&1 * count), 1))
+      buckets = Enum.map(0..(@bucket_count - 1), &:counters.get(counters, first + &1))
+
+      Enum.map(ranks, fn rank ->
+        index = rank_bucket(buckets, rank, 0, 0)
+        index |> bucket_upper_bound() |> max(min_value) |> min(max_value) |> to_ms()
+      end)
+    end
+  end
+
+  defp percentiles(counters, atomics, quantiles) do
+    quantiles(
+      counters,
+      @first_bucket,
+      :counters.get(counters, @inference_count),
+      :atomics.get(atomics, @min_duration),
+      :atomics.get(atomics, @max_duration),
+      quantiles
+    )
+  end
+
+  defp rank_bucket([], _rank, _seen, index), do: index - 1
+
+  defp rank_bucket([count | rest], rank, seen, index) do
+    if seen + count >= rank, do: index, else: rank_bucket(rest, rank, seen + count, index + 1)
+  end
+
+  defp snapshot(path, counters, atomics) do
+    {backend, device} =
+      case :ets.lookup(@table, {:info, path}) do
+        [{_, info}] -> info
+        [] -> {nil, :cpu}
       end
 
-    :ets.insert(@table, {path, update_fn.(current)})
+    count = :counters.get(counters, @inference_count)
+    [p50, p95, p99, p999] = percentiles(counters, atomics, [0.5, 0.95, 0.99, 0.999])
+    last_inference_at = :atomics.get(atomics, @last_inference_at)
+
+    %{
+      backend: backend,
+      device: device,
+      inference_count: count,
+      error_count: :counters.get(counters, @error_count),
+      total_duration_ms: to_ms(:counters.get(counters, @total_duration)),
+      min_duration_ms:
+        if(count == 0, do: :infinity, else: to_ms(:atomics.get(atomics, @min_duration))),
+      max_duration_ms: to_ms(:atomics.get(atomics, @max_duration)),
+      p50_duration_ms: p50,
+      p95_duration_ms: p95,
+      p99_duration_ms: p99,
+      p999_duration_ms: p999,
+      load_duration_ms: to_ms(:atomics.get(atomics, @load_duration)),
+      last_inference_at: if(last_inference_at == 0, do: nil, else: last_inference_at)
+    }
   end
+
+  defp to_ms(microseconds), do: microseconds / 1000
 end
@@ -20,9 +20,70 @@ defmodule ExTorch.Native.Dispatcher do
       def compile_graph(_graph, _value_names, _output_names),
         do: :erlang.nif_error(:nif_not_loaded)
 
+      @doc false
+      def bind_graph_constants(_compiled, _names, _tensors),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def compiled_graph_inputs(_compiled), do: :erlang.nif_error(:nif_not_loaded)
+
       @doc false
       def run_compiled_graph(_compiled, _tensors),
         do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def create_graph_session(_compiled, _state_inputs, _state_outputs, _initial),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def graph_session_step(_session, _tensors), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def graph_session_reset(_session), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def graph_session_state(_session), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def compiled_graph_profile_start(_compiled, _capacity),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def compiled_graph_profile_stop(_compiled), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def compiled_graph_profile_stats(_compiled), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def compile_graph_bytecode(_code, _value_names, _output_names),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def serialize_compiled_graph(_compiled, _source_tag),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def deserialize_compiled_graph(_data, _source_tag),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def libtorch_version, do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def dump_compiled_graph(_compiled, _inputs, _path),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def encode_graph(_graph, _input_names, _output_names),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def encode_graph_bytecode(_code, _input_names, _output_names),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def run_encoded_graph(_encoded, _tensors),
+        do: :erlang.nif_error(:nif_not_loaded)
     end
   end
 end
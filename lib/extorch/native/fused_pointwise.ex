@@ -0,0 +1,10 @@
+defmodule ExTorch.Native.FusedPointwise do
+  @moduledoc false
+
+  defmacro __using__(_opts) do
+    quote do
+      @doc false
+      def fused_pointwise(_inputs, _consts, _program), do: :erlang.nif_error(:nif_not_loaded)
+    end
+  end
+end
@@ -36,6 +36,32 @@ defmodule ExTorch.Native.JIT do
       @doc false
       def jit_to_device(_model, _device), do: :erlang.nif_error(:nif_not_loaded)
 
+      @doc false
+      def jit_to_inplace(_model, _device, _dtype, _non_blocking),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def jit_state_names(_model), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def jit_state_to(_model, _name, _device, _dtype, _non_blocking),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      # Inference optimization
+      @doc false
+      def jit_freeze(_model, _optimize), do: :erlang.nif_error(:nif_not_loaded)
+      @doc false
+      def jit_get_executor_options, do: :erlang.nif_error(:nif_not_loaded)
+      @doc false
+      def jit_set_executor_options(
+            _profiling_executor,
+            _num_profiled_runs,
+            _fusion_strategy,
+            _cpu_fusion,
+            _texpr_fuser
+          ),
+          do: :erlang.nif_error(:nif_not_loaded)
+
       # IR Introspection
       @doc false
       def jit_graph_str(_model), do: :erlang.nif_error(:nif_not_loaded)
@@ -0,0 +1,44 @@
+defmodule ExTorch.Native.KVCache do
+  @moduledoc false
+
+  defmacro __using__(_opts) do
+    quote do
+      @doc false
+      def kv_cache_new(
+            _id,
+            _num_layers,
+            _num_heads,
+            _head_dim,
+            _block_size,
+            _num_blocks,
+            _dtype,
+            _device
+          ),
+          do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def kv_cache_add_sequence(_cache), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def kv_cache_free_sequence(_cache, _sequence), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def kv_cache_sequence_length(_cache, _sequence, _layer),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def kv_cache_append(_cache, _sequence, _layer, _key, _value),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def kv_cache_gather(_cache, _sequence, _layer), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def kv_cache_attention(_cache, _sequence, _layer, _query, _key, _value, _scale, _has_scale),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def kv_cache_stats(_cache), do: :erlang.nif_error(:nif_not_loaded)
+    end
+  end
+end
@@ -0,0 +1,25 @@
+defmodule ExTorch.Native.MemoryStats do
+  @moduledoc false
+
+  defmacro __using__(_opts) do
+    quote do
+      @doc false
+      def cpu_memory_tracking(_enabled), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def cpu_memory_stats(), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def cpu_memory_reset_peak(), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def compiled_graph_memory_stats(_compiled), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def aoti_memory_stats(_model), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def jit_memory_stats(_model), do: :erlang.nif_error(:nif_not_loaded)
+    end
+  end
+end
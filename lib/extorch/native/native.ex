@@ -20,6 +20,13 @@ defmodule ExTorch.Native do
   use ExTorch.Native.NN
   use ExTorch.Native.AOTI
   use ExTorch.Native.Dispatcher
+  use ExTorch.Native.PinnedPool
+  use ExTorch.Native.FusedPointwise
+  use ExTorch.Native.TopK
+  use ExTorch.Native.VectorIndex
+  use ExTorch.Native.KVCache
+  use ExTorch.Native.Tracing
+  use ExTorch.Native.MemoryStats
 
   use ExTorch.Utils.DownloadTorch
   use Rustler, otp_app: :extorch, crate: "extorch", env: [{"CARGO_TERM_VERBOSE", "true"}]
@@ -105,7 +105,17 @@ defmodule ExTorch.Native.NN do
       @doc false
       def nn_copy_parameters(_module, _params), do: :erlang.nif_error(:nif_not_loaded)
       @doc false
+      def nn_bind_parameters(_module, _params), do: :erlang.nif_error(:nif_not_loaded)
+      @doc false
       def nn_to_device(_module, _device), do: :erlang.nif_error(:nif_not_loaded)
+      @doc false
+      def nn_forward_many(_module, _inputs), do: :erlang.nif_error(:nif_not_loaded)
+
+      # Whole-model pipelines
+      @doc false
+      def nn_pipeline_new(_steps, _num_inputs, _outputs), do: :erlang.nif_error(:nif_not_loaded)
+      @doc false
+      def nn_pipeline_run(_pipeline, _inputs), do: :erlang.nif_error(:nif_not_loaded)
 
       # Direct ATen functional ops (Phase A)
       @doc false
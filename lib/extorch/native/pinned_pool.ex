@@ -0,0 +1,22 @@
+defmodule ExTorch.Native.PinnedPool do
+  @moduledoc false
+
+  defmacro __using__(_opts) do
+    quote do
+      @doc false
+      def from_binary_pinned(_data, _shape, _dtype), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def from_binaries_pinned(_entries), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def pinned_pool_stats(), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def pinned_pool_empty_cache(), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def pinned_pool_set_max_cached_bytes(_max_bytes), do: :erlang.nif_error(:nif_not_loaded)
+    end
+  end
+end
@@ -979,15 +979,7 @@ defmodule ExTorch.Native.Tensor.Creation do
         list,
         opts \\ %ExTorch.Tensor.Options{dtype: :auto}
       ),
-      list: ExTorch.Utils.to_list_wrapper(list),
-      opts:
-        case opts.dtype do
-          :auto ->
-            struct(opts, dtype: list.dtype)
-
-          _ ->
-            opts
-        end
+      list: ExTorch.Utils.to_tensor_data(list)
     )
 
     @doc """
@@ -402,6 +402,21 @@ defmodule ExTorch.Native.Tensor.Info do
     @spec from_binary(binary(), tuple(), ExTorch.DType.dtype()) :: ExTorch.Tensor.t()
     defbinding(from_binary(data, shape, dtype \\ :float32))
 
+    @doc """
+    Create a tensor by reading its raw data from a file.
+
+    Reads `shape`/`dtype` worth of bytes starting at `offset` directly into
+    libtorch-managed memory, without staging them in an Erlang binary.
+
+    ## Args
+      - `path` - Path of the file to read.
+      - `offset` - Byte offset of the tensor data in the file.
+      - `shape` - Tensor dimensions as a tuple.
+      - `dtype` - Data type of the elements.
+    """
+    @spec from_file(String.t(), non_neg_integer(), tuple(), ExTorch.DType.dtype()) :: ExTorch.Tensor.t()
+    defbinding(from_file(path, offset, shape, dtype \\ :float32))
+
     @doc """
     Create a tensor from a raw data pointer (zero-copy).
 
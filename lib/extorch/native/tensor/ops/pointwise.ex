@@ -75,13 +75,23 @@ defmodule ExTorch.Native.Tensor.Ops.PointWise do
       * `input` (`ExTorch.Tensor`) - the first input tensor.
       * `other` (`ExTorch.Tensor`) - the second input tensor.
       * `alpha` (`number`) - the multiplier for `other`. Default: `1`.
+      * `out` (`ExTorch.Tensor` or `nil`) - an optional pre-allocated tensor to write the
+        result into, which is then returned. Default: `nil`.
 
     ## Shape
       * Input: `{*}` (any shape, must be broadcastable).
       * Output: same shape as broadcasted input.
     """
-    @spec add(ExTorch.Tensor.t(), ExTorch.Tensor.t(), number()) :: ExTorch.Tensor.t()
-    defbinding(add(input, other, alpha \\ 1))
+    @spec add(ExTorch.Tensor.t(), ExTorch.Tensor.t(), number(), ExTorch.Tensor.t() | nil) ::
+            ExTorch.Tensor.t()
+    defbinding(add(input, other, alpha \\ 1, out \\ nil))
+
+    @doc """
+    In-place version of `ExTorch.add/4`: writes the result into `input` and
+    returns it. The returned tensor shares its storage with `input`.
+    """
+    @spec add_(ExTorch.Tensor.t(), ExTorch.Tensor.t(), number()) :: ExTorch.Tensor.t()
+    defbinding(add_(input, other, alpha \\ 1))
 
     @doc """
     Subtracts `other` from `input`, scaled by `alpha`: $out = input - alpha \\times other$.
@@ -90,9 +100,19 @@ defmodule ExTorch.Native.Tensor.Ops.PointWise do
       * `input` (`ExTorch.Tensor`) - the first input tensor.
       * `other` (`ExTorch.Tensor`) - the second input tensor.
       * `alpha` (`number`) - the multiplier for `other`. Default: `1`.
+      * `out` (`ExTorch.Tensor` or `nil`) - an optional pre-allocated tensor to write the
+        result into, which is then returned. Default: `nil`.
     """
-    @spec sub(ExTorch.Tensor.t(), ExTorch.Tensor.t(), number()) :: ExTorch.Tensor.t()
-    defbinding(sub(input, other, alpha \\ 1))
+    @spec sub(ExTorch.Tensor.t(), ExTorch.Tensor.t(), number(), ExTorch.Tensor.t() | nil) ::
+            ExTorch.Tensor.t()
+    defbinding(sub(input, other, alpha \\ 1, out \\ nil))
+
+    @doc """
+    In-place version of `ExTorch.sub/4`: writes the result into `input` and
+    returns it. The returned tensor shares its storage with `input`.
+    """
+    @spec sub_(ExTorch.Tensor.t(), ExTorch.Tensor.t(), number()) :: ExTorch.Tensor.t()
+    defbinding(sub_(input, other, alpha \\ 1))
 
     @doc """
     Multiplies `input` by `other` element-wise: $out_i = input_i \\times other_i$.
@@ -100,9 +120,19 @@ defmodule ExTorch.Native.Tensor.Ops.PointWise do
     ## Args
       * `input` (`ExTorch.Tensor`) - the first input tensor.
       * `other` (`ExTorch.Tensor`) - the second input tensor.
+      * `out` (`ExTorch.Tensor` or `nil`) - an optional pre-allocated tensor to write the
+        result into, which is then returned. Default: `nil`.
+    """
+    @spec mul(ExTorch.Tensor.t(), ExTorch.Tensor.t(), ExTorch.Tensor.t() | nil) ::
+            ExTorch.Tensor.t()
+    defbinding(mul(input, other, out \\ nil))
+
+    @doc """
+    In-place version of `ExTorch.mul/3`: writes the result into `input` and
+    returns it. The returned tensor shares its storage with `input`.
     """
-    @spec mul(ExTorch.Tensor.t(), ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
-    defbinding(mul(input, other))
+    @spec mul_(ExTorch.Tensor.t(), ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
+    defbinding(mul_(input, other))
 
     @doc """
     Divides `input` by `other` element-wise: $out_i = \\frac{input_i}{other_i}$.
@@ -110,21 +140,55 @@ defmodule ExTorch.Native.Tensor.Ops.PointWise do
     ## Args
       * `input` (`ExTorch.Tensor`) - the dividend tensor.
       * `other` (`ExTorch.Tensor`) - the divisor tensor.
+      * `out` (`ExTorch.Tensor` or `nil`) - an optional pre-allocated tensor to write the
+        result into, which is then returned. Default: `nil`.
     """
-    @spec tensor_div(ExTorch.Tensor.t(), ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
-    defbinding(tensor_div(input, other))
+    @spec tensor_div(ExTorch.Tensor.t(), ExTorch.Tensor.t(), ExTorch.Tensor.t() | nil) ::
+            ExTorch.Tensor.t()
+    defbinding(tensor_div(input, other, out \\ nil))
+
+    @doc """
+    In-place version of `ExTorch.tensor_div/3`: writes the result into `input` and
+    returns it. The returned tensor shares its storage with `input`.
+    """
+    @spec tensor_div_(ExTorch.Tensor.t(), ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
+    defbinding(tensor_div_(input, other))
 
     @doc """
     Returns the negative of `input` element-wise: $out = -input$.
+
+    ## Args
+      * `input` (`ExTorch.Tensor`) - the input tensor.
+      * `out` (`ExTorch.Tensor` or `nil`) - an optional pre-allocated tensor to write the
+        result into, which is then returned. Default: `nil`.
     """
-    @spec neg(ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
-    defbinding(neg(input))
+    @spec neg(ExTorch.Tensor.t(), ExTorch.Tensor.t() | nil) :: ExTorch.Tensor.t()
+    defbinding(neg(input, out \\ nil))
+
+    @doc """
+    In-place version of `ExTorch.neg/2`: writes the result into `input` and
+    returns it. The returned tensor shares its storage with `input`.
+    """
+    @spec neg_(ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
+    defbinding(neg_(input))
 
     @doc """
     Computes the absolute value of each element: $out_i = |input_i|$.
+
+    ## Args
+      * `input` (`ExTorch.Tensor`) - the input tensor.
+      * `out` (`ExTorch.Tensor` or `nil`) - an optional pre-allocated tensor to write the
+        result into, which is then returned. Default: `nil`.
     """
-    @spec tensor_abs(ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
-    defbinding(tensor_abs(input))
+    @spec tensor_abs(ExTorch.Tensor.t(), ExTorch.Tensor.t() | nil) :: ExTorch.Tensor.t()
+    defbinding(tensor_abs(input, out \\ nil))
+
+    @doc """
+    In-place version of `ExTorch.tensor_abs/2`: writes the result into `input` and
+    returns it. The returned tensor shares its storage with `input`.
+    """
+    @spec tensor_abs_(ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
+    defbinding(tensor_abs_(input))
 
     @doc """
     Takes the power of each element by `exponent`: $out_i = input_i^{exponent}$.
@@ -132,39 +196,108 @@ defmodule ExTorch.Native.Tensor.Ops.PointWise do
     ## Args
       * `input` (`ExTorch.Tensor`) - the input tensor.
       * `exponent` (`number`) - the exponent value.
+      * `out` (`ExTorch.Tensor` or `nil`) - an optional pre-allocated tensor to write the
+        result into, which is then returned. Default: `nil`.
+    """
+    @spec pow_tensor(ExTorch.Tensor.t(), number(), ExTorch.Tensor.t() | nil) :: ExTorch.Tensor.t()
+    defbinding(pow_tensor(input, exponent, out \\ nil))
+
+    @doc """
+    In-place version of `ExTorch.pow_tensor/3`: writes the result into `input` and
+    returns it. The returned tensor shares its storage with `input`.
     """
-    @spec pow_tensor(ExTorch.Tensor.t(), number()) :: ExTorch.Tensor.t()
-    defbinding(pow_tensor(input, exponent))
+    @spec pow_tensor_(ExTorch.Tensor.t(), number()) :: ExTorch.Tensor.t()
+    defbinding(pow_tensor_(input, exponent))
 
     @doc """
     Returns a new tensor with the exponential: $out_i = e^{input_i}$.
+
+    ## Args
+      * `input` (`ExTorch.Tensor`) - the input tensor.
+      * `out` (`ExTorch.Tensor` or `nil`) - an optional pre-allocated tensor to write the
+        result into, which is then returned. Default: `nil`.
+    """
+    @spec tensor_exp(ExTorch.Tensor.t(), ExTorch.Tensor.t() | nil) :: ExTorch.Tensor.t()
+    defbinding(tensor_exp(input, out \\ nil))
+
+    @doc """
+    In-place version of `ExTorch.tensor_exp/2`: writes the result into `input` and
+    returns it. The returned tensor shares its storage with `input`.
     """
-    @spec tensor_exp(ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
-    defbinding(tensor_exp(input))
+    @spec tensor_exp_(ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
+    defbinding(tensor_exp_(input))
 
     @doc """
     Returns a new tensor with the natural logarithm: $out_i = \\ln(input_i)$.
+
+    ## Args
+      * `input` (`ExTorch.Tensor`) - the input tensor.
+      * `out` (`ExTorch.Tensor` or `nil`) - an optional pre-allocated tensor to write the
+        result into, which is then returned. Default: `nil`.
     """
-    @spec tensor_log(ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
-    defbinding(tensor_log(input))
+    @spec tensor_log(ExTorch.Tensor.t(), ExTorch.Tensor.t() | nil) :: ExTorch.Tensor.t()
+    defbinding(tensor_log(input, out \\ nil))
+
+    @doc """
+    In-place version of `ExTorch.tensor_log/2`: writes the result into `input` and
+    returns it. The returned tensor shares its storage with `input`.
+    """
+    @spec tensor_log_(ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
+    defbinding(tensor_log_(input))
 
     @doc """
     Returns a new tensor with the square root: $out_i = \\sqrt{input_i}$.
+
+    ## Args
+      * `input` (`ExTorch.Tensor`) - the input tensor.
+      * `out` (`ExTorch.Tensor` or `nil`) - an optional pre-allocated tensor to write the
+        result into, which is then returned. Default: `nil`.
     """
-    @spec tensor_sqrt(ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
-    defbinding(tensor_sqrt(input))
+    @spec tensor_sqrt(ExTorch.Tensor.t(), ExTorch.Tensor.t() | nil) :: ExTorch.Tensor.t()
+    defbinding(tensor_sqrt(input, out \\ nil))
+
+    @doc """
+    In-place version of `ExTorch.tensor_sqrt/2`: writes the result into `input` and
+    returns it. The returned tensor shares its storage with `input`.
+    """
+    @spec tensor_sqrt_(ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
+    defbinding(tensor_sqrt_(input))
 
     @doc """
     Returns a new tensor with the sine: $out_i = \\sin(input_i)$.
+
+    ## Args
+      * `input` (`ExTorch.Tensor`) - the input tensor.
+      * `out` (`ExTorch.Tensor` or `nil`) - an optional pre-allocated tensor to write the
+        result into, which is then returned. Default: `nil`.
     """
-    @spec tensor_sin(ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
-    defbinding(tensor_sin(input))
+    @spec tensor_sin(ExTorch.Tensor.t(), ExTorch.Tensor.t() | nil) :: ExTorch.Tensor.t()
+    defbinding(tensor_sin(input, out \\ nil))
+
+    @doc """
+    In-place version of `ExTorch.tensor_sin/2`: writes the result into `input` and
+    returns it. The returned tensor shares its storage with `input`.
+    """
+    @spec tensor_sin_(ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
+    defbinding(tensor_sin_(input))
 
     @doc """
     Returns a new tensor with the cosine: $out_i = \\cos(input_i)$.
+
+    ## Args
+      * `input` (`ExTorch.Tensor`) - the input tensor.
+      * `out` (`ExTorch.Tensor` or `nil`) - an optional pre-allocated tensor to write the
+        result into, which is then returned. Default: `nil`.
     """
-    @spec tensor_cos(ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
-    defbinding(tensor_cos(input))
+    @spec tensor_cos(ExTorch.Tensor.t(), ExTorch.Tensor.t() | nil) :: ExTorch.Tensor.t()
+    defbinding(tensor_cos(input, out \\ nil))
+
+    @doc """
+    In-place version of `ExTorch.tensor_cos/2`: writes the result into `input` and
+    returns it. The returned tensor shares its storage with `input`.
+    """
+    @spec tensor_cos_(ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
+    defbinding(tensor_cos_(input))
 
     @doc """
     Clamps all elements in `input` into the range `[min, max]`.
@@ -175,9 +308,19 @@ defmodule ExTorch.Native.Tensor.Ops.PointWise do
       * `input` (`ExTorch.Tensor`) - the input tensor.
       * `min` (`number`) - lower bound of the range.
       * `max` (`number`) - upper bound of the range.
+      * `out` (`ExTorch.Tensor` or `nil`) - an optional pre-allocated tensor to write the
+        result into, which is then returned. Default: `nil`.
+    """
+    @spec clamp(ExTorch.Tensor.t(), number(), number(), ExTorch.Tensor.t() | nil) ::
+            ExTorch.Tensor.t()
+    defbinding(clamp(input, min_val, max_val, out \\ nil))
+
+    @doc """
+    In-place version of `ExTorch.clamp/4`: writes the result into `input` and
+    returns it. The returned tensor shares its storage with `input`.
     """
-    @spec clamp(ExTorch.Tensor.t(), number(), number()) :: ExTorch.Tensor.t()
-    defbinding(clamp(input, min_val, max_val))
+    @spec clamp_(ExTorch.Tensor.t(), number(), number()) :: ExTorch.Tensor.t()
+    defbinding(clamp_(input, min_val, max_val))
 
     @doc """
     Matrix product of two tensors.
@@ -242,7 +385,8 @@ defmodule ExTorch.Native.Tensor.Ops.PointWise do
       * `x` (`ExTorch.Tensor`) - values selected where condition is `true`.
       * `y` (`ExTorch.Tensor`) - values selected where condition is `false`.
     """
-    @spec tensor_where(ExTorch.Tensor.t(), ExTorch.Tensor.t(), ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
+    @spec tensor_where(ExTorch.Tensor.t(), ExTorch.Tensor.t(), ExTorch.Tensor.t()) ::
+            ExTorch.Tensor.t()
     defbinding(tensor_where(condition, x, y))
 
     @doc """
@@ -277,6 +421,21 @@ defmodule ExTorch.Native.Tensor.Ops.PointWise do
     @spec detach(ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
     defbinding(detach(input))
 
+    @doc """
+    Copies the elements of `src` into `input` and returns `input`.
+
+    `src` is broadcast to the shape of `input` and may have a different dtype
+    or device. The returned tensor shares its storage with `input`.
+
+    ## Args
+      * `input` (`ExTorch.Tensor`) - the destination tensor.
+      * `src` (`ExTorch.Tensor`) - the tensor to copy from.
+      * `non_blocking` (`boolean`) - if `true` and the copy is between CPU and
+        GPU, it may run asynchronously with respect to the host. Default: `false`.
+    """
+    @spec copy_(ExTorch.Tensor.t(), ExTorch.Tensor.t(), boolean()) :: ExTorch.Tensor.t()
+    defbinding(copy_(input, src, non_blocking \\ false))
+
     @doc """
     Returns a new tensor with the same data but of a different shape.
 
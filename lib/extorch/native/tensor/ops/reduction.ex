@@ -153,6 +153,7 @@ defmodule ExTorch.Native.Tensor.Ops.Reduction do
     ## Optional arguments
     - `dim` (`nil | integer()`) - the dimension to reduce. Default: `nil`
     - `keepdim` (`boolean()`) - whether the output tensor has dim retained or not. Default: `false`
+    - `out` (`ExTorch.Tensor | nil`) - the optional output pre-allocated tensor. Default: `nil`
 
     ## Notes
     If there are multiple maximal values then the indices of the first maximal value are returned.
@@ -200,8 +201,9 @@ defmodule ExTorch.Native.Tensor.Ops.Reduction do
         ]>
 
     """
-    @spec argmax(ExTorch.Tensor.t(), integer() | nil, boolean()) :: ExTorch.Tensor.t()
-    defbinding(argmax(input, dim \\ nil, keepdim \\ false))
+    @spec argmax(ExTorch.Tensor.t(), integer() | nil, boolean(), ExTorch.Tensor.t() | nil) ::
+            ExTorch.Tensor.t()
+    defbinding(argmax(input, dim \\ nil, keepdim \\ false, out \\ nil))
 
     @doc """
     Returns the indices of the minimum value of all elements (or elements in a dimension)
@@ -216,6 +218,7 @@ defmodule ExTorch.Native.Tensor.Ops.Reduction do
     ## Optional arguments
     - `dim` (`nil | integer()`) - the dimension to reduce. Default: `nil`
     - `keepdim` (`boolean()`) - whether the output tensor has dim retained or not. Default: `false`
+    - `out` (`ExTorch.Tensor | nil`) - the optional output pre-allocated tensor. Default: `nil`
 
     ## Notes
     If there are multiple minimal values then the indices of the first minimal value are returned.
@@ -263,8 +266,9 @@ defmodule ExTorch.Native.Tensor.Ops.Reduction do
         ]>
 
     """
-    @spec argmin(ExTorch.Tensor.t(), integer() | nil, boolean()) :: ExTorch.Tensor.t()
-    defbinding(argmin(input, dim \\ nil, keepdim \\ false))
+    @spec argmin(ExTorch.Tensor.t(), integer() | nil, boolean(), ExTorch.Tensor.t() | nil) ::
+            ExTorch.Tensor.t()
+    defbinding(argmin(input, dim \\ nil, keepdim \\ false, out \\ nil))
 
     @doc """
     Returns the maximum value of all elements (or elements in a dimension) in the
@@ -790,6 +794,7 @@ defmodule ExTorch.Native.Tensor.Ops.Reduction do
     - `dtype` (`ExTorch.DType` or `nil`) - the desired data type of returned tensor.
     If specified, the `input` tensor is casted to `dtype` before the operation
     is performed. This is useful for preventing data type overflows. Default: `nil`.
+    - `out` (`ExTorch.Tensor | nil`) - the optional output pre-allocated tensor. Default: `nil`
 
     ## Examples
         iex> a = ExTorch.rand({3, 3})
@@ -823,9 +828,15 @@ defmodule ExTorch.Native.Tensor.Ops.Reduction do
           requires_grad: false
         ]>
     """
-    @spec sum(ExTorch.Tensor.t(), integer() | tuple() | nil, boolean(), ExTorch.DType.dtype()) ::
+    @spec sum(
+            ExTorch.Tensor.t(),
+            integer() | tuple() | nil,
+            boolean(),
+            ExTorch.DType.dtype(),
+            ExTorch.Tensor.t() | nil
+          ) ::
             ExTorch.Tensor.t()
-    defbinding(sum(input, dim \\ nil, keepdim \\ false, dtype \\ nil),
+    defbinding(sum(input, dim \\ nil, keepdim \\ false, dtype \\ nil, out \\ nil),
       input:
         if dtype do
           ExTorch.Tensor.to(input, dtype: dtype)
@@ -1225,6 +1236,7 @@ defmodule ExTorch.Native.Tensor.Ops.Reduction do
     - `dtype` (`ExTorch.DType` or `nil`) - the desired data type of returned tensor.
     If specified, the `input` tensor is casted to `dtype` before the operation
     is performed. This is useful for preventing data type overflows. Default: `nil`.
+    - `out` (`ExTorch.Tensor | nil`) - the optional output pre-allocated tensor. Default: `nil`
 
     ## Examples
         iex> input =
@@ -1256,9 +1268,15 @@ defmodule ExTorch.Native.Tensor.Ops.Reduction do
         ]>
 
     """
-    @spec nansum(ExTorch.Tensor.t(), integer() | tuple() | nil, boolean(), ExTorch.DType.dtype()) ::
+    @spec nansum(
+            ExTorch.Tensor.t(),
+            integer() | tuple() | nil,
+            boolean(),
+            ExTorch.DType.dtype(),
+            ExTorch.Tensor.t() | nil
+          ) ::
             ExTorch.Tensor.t()
-    defbinding(nansum(input, dim \\ nil, keepdim \\ false, dtype \\ nil),
+    defbinding(nansum(input, dim \\ nil, keepdim \\ false, dtype \\ nil, out \\ nil),
       input:
         if dtype do
           ExTorch.Tensor.to(input, dtype: dtype)
@@ -1282,6 +1300,7 @@ defmodule ExTorch.Native.Tensor.Ops.Reduction do
     - `dtype` (`ExTorch.DType` or `nil`) - the desired data type of returned tensor.
     If specified, the `input` tensor is casted to `dtype` before the operation
     is performed. This is useful for preventing data type overflows. Default: `nil`.
+    - `out` (`ExTorch.Tensor | nil`) - the optional output pre-allocated tensor. Default: `nil`
 
     ## Notes
     * `keepdim` does not apply when `dim = nil`.
@@ -1318,9 +1337,15 @@ defmodule ExTorch.Native.Tensor.Ops.Reduction do
           requires_grad: false
         ]>
     """
-    @spec prod(ExTorch.Tensor.t(), integer() | tuple() | nil, boolean(), ExTorch.DType.dtype()) ::
+    @spec prod(
+            ExTorch.Tensor.t(),
+            integer() | tuple() | nil,
+            boolean(),
+            ExTorch.DType.dtype(),
+            ExTorch.Tensor.t() | nil
+          ) ::
             ExTorch.Tensor.t()
-    defbinding(prod(input, dim \\ nil, keepdim \\ false, dtype \\ nil),
+    defbinding(prod(input, dim \\ nil, keepdim \\ false, dtype \\ nil, out \\ nil),
       input:
         if dtype do
           ExTorch.Tensor.to(input, dtype: dtype)
@@ -0,0 +1,22 @@
+defmodule ExTorch.Native.TopK do
+  @moduledoc false
+
+  defmacro __using__(_opts) do
+    quote do
+      @doc false
+      def chunked_topk(_input, _k, _dim, _largest, _chunk_size),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def topk_chunked_path(_input, _k, _dim), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def topk_matmul(_query, _keys, _k, _largest, _chunk_size),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def topk_merge(_state, _chunk, _offset, _k, _largest),
+        do: :erlang.nif_error(:nif_not_loaded)
+    end
+  end
+end
@@ -0,0 +1,19 @@
+defmodule ExTorch.Native.Tracing do
+  @moduledoc false
+
+  defmacro __using__(_opts) do
+    quote do
+      @doc false
+      def trace_compiled_graph(_compiled, _inputs, _requests, _path, _record_shapes, _profile_memory),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def trace_aoti(_model, _inputs, _requests, _path, _record_shapes, _profile_memory),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def trace_jit(_model, _inputs, _requests, _path, _record_shapes, _profile_memory),
+        do: :erlang.nif_error(:nif_not_loaded)
+    end
+  end
+end
@@ -0,0 +1,47 @@
+defmodule ExTorch.Native.VectorIndex do
+  @moduledoc false
+
+  defmacro __using__(_opts) do
+    quote do
+      @doc false
+      def vector_index_new(
+            _kind,
+            _metric,
+            _dim,
+            _nlist,
+            _nprobe,
+            _m,
+            _ef_construction,
+            _ef_search,
+            _seed
+          ),
+          do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def vector_index_train(_index, _sample, _iterations),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def vector_index_add(_index, _vectors), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def vector_index_search(_index, _queries, _k, _effort),
+        do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def vector_index_size(_index), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def vector_index_is_trained(_index), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def vector_index_vectors(_index), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def vector_index_save(_index, _path), do: :erlang.nif_error(:nif_not_loaded)
+
+      @doc false
+      def vector_index_load(_path, _mmap), do: :erlang.nif_error(:nif_not_loaded)
+    end
+  end
+end
@@ -37,6 +37,12 @@ defmodule ExTorch.NN.Module do
   directly, using the pre-trained weights. The DSL definition serves as a
   structural contract that is validated against the `.pt` file's submodules.
 
+  `compile/2` traces `forward/2` into an `ExTorch.NN.Pipeline` that runs
+  every layer in a single native call:
+
+      pipeline = MyMLP.compile(model)
+      output = MyMLP.predict(pipeline, [input])
+
   `deflayer` declares a layer at compile time. `layer/3` is a runtime
   function that looks up and applies a named layer during forward.
   """
@@ -171,6 +177,17 @@ defmodule ExTorch.NN.Module do
         input
       end
 
+      def layer(input, %ExTorch.NN.Pipeline.Trace{layers: layers} = trace, name) when is_atom(name) do
+        # Tracing for compile/2: record the layer instead of running it
+        case Map.fetch!(layers, name) do
+          %ExTorch.NN.Layer{} = layer_instance ->
+            ExTorch.NN.Pipeline.trace_layer(layer_instance, input)
+
+          {sub_module, sub_model} when is_atom(sub_module) and is_map(sub_model) ->
+            sub_module.forward(%{trace | layers: sub_model}, input)
+        end
+      end
+
       def layer(input, model, name) when is_map(model) and is_atom(name) do
         case Map.fetch!(model, name) do
           # A C++ nn layer -- run forward directly
@@ -183,6 +200,22 @@ defmodule ExTorch.NN.Module do
         end
       end
 
+      @doc """
+      Compile this module's `forward/2` into a native pipeline that runs
+      all layers in a single NIF call.
+
+      See `ExTorch.NN.Pipeline.compile/3` for the options. Models whose
+      `forward/2` cannot be traced keep running layer by layer.
+
+      ## Example
+
+          pipeline = MyMLP.new() |> MyMLP.compile()
+          output = MyMLP.predict(pipeline, [input])
+      """
+      def compile(model, opts \\ []) when is_map(model) do
+        ExTorch.NN.Pipeline.compile(__MODULE__, model, opts)
+      end
+
       @doc """
       Run the forward pass. For JIT-backed models, delegates to the JIT model's
       forward method. For DSL models, calls the user-defined `forward/2`.
@@ -191,6 +224,14 @@ defmodule ExTorch.NN.Module do
         ExTorch.JIT.forward(jit_model, inputs)
       end
 
+      def predict(%ExTorch.NN.Pipeline{num_inputs: 1} = pipeline, [input | _]) do
+        ExTorch.NN.Pipeline.run(pipeline, input)
+      end
+
+      def predict(%ExTorch.NN.Pipeline{} = pipeline, inputs) when is_list(inputs) do
+        ExTorch.NN.Pipeline.run(pipeline, List.to_tuple(inputs))
+      end
+
       def predict(model, inputs) when is_map(model) and is_list(inputs) do
         # For single-tensor input convenience
         [input | _] = inputs
@@ -205,8 +246,9 @@ defmodule ExTorch.NN.Module do
       @doc """
       Load pre-trained weights from a TorchScript file into a DSL model.
 
-      Creates the DSL model via `new/0`, loads the JIT model, then copies
-      matching parameters from the JIT model into the DSL layers.
+      Creates the DSL model via `new/0`, loads the JIT model, then binds
+      matching parameters from the JIT model to the DSL layers, sharing
+      their storage instead of copying it.
 
       ## Arguments
         - `path` - Path to the `.pt` TorchScript file.
@@ -254,7 +296,8 @@ defmodule ExTorch.NN.Module do
               {layer_name, layer_instance}
 
             layer_params ->
-              ExTorch.NN.copy_parameters(layer_instance, layer_params)
+              # The JIT model is dropped after loading, so share its storage
+              ExTorch.NN.bind_parameters(layer_instance, layer_params)
               {layer_name, layer_instance}
           end
         end
@@ -264,9 +307,10 @@ defmodule ExTorch.NN.Module do
       Load pre-trained weights from a `torch.export.save` `.pt2` archive
       into a DSL model.
 
-      Creates the DSL model via `new/0`, reads the weights from the `.pt2`
-      archive using `ExTorch.Export.read_weights/1`, then copies matching
-      parameters into the DSL layers.
+      Creates the DSL model via `new/0`, then streams the weights out of
+      the `.pt2` archive layer by layer and binds them to the matching
+      layers without copying (see `ExTorch.NN.Weights.bind/2`), so the
+      checkpoint is never resident twice.
 
       This is the JIT-free path for loading pre-trained weights.
 
@@ -284,35 +328,24 @@ defmodule ExTorch.NN.Module do
           output = MyMLP.forward(model, input)
       """
       def load_weights_from_export(path, opts \\ []) do
-        weights = ExTorch.Export.read_weights(path)
-        model = new(opts)
+        opts |> new() |> ExTorch.NN.Weights.bind(path)
+      end
 
-        grouped =
-          Enum.group_by(
-            weights,
-            fn {name, _tensor} -> name |> String.split(".") |> hd() end,
-            fn {name, tensor} ->
-              param_name = name |> String.split(".") |> tl() |> Enum.join(".")
-              {param_name, tensor}
-            end
-          )
+      @doc """
+      Load pre-trained weights from a `.safetensors` file into a DSL model.
 
-        for {layer_name, layer_instance} <- model, into: %{} do
-          layer_key = Atom.to_string(layer_name)
+      Like `load_weights_from_export/2`, tensors are read one layer at a
+      time and bound to the layers without copying.
 
-          case Map.get(grouped, layer_key) do
-            nil ->
-              {layer_name, layer_instance}
+      ## Arguments
+        - `path` - Path to the `.safetensors` file.
+        - `opts` - Keyword options passed to `new/1`.
 
-            layer_params ->
-              case layer_instance do
-                %ExTorch.NN.Layer{} ->
-                  ExTorch.NN.copy_parameters(layer_instance, layer_params)
-                _ -> :ok
-              end
-              {layer_name, layer_instance}
-          end
-        end
+      ## Returns
+      The DSL model map with pre-trained weights.
+      """
+      def load_weights_from_safetensors(path, opts \\ []) do
+        opts |> new() |> ExTorch.NN.Weights.bind(path)
       end
 
       def parameters(%ExTorch.NN.JITBackedModel{jit_model: jit_model}) do
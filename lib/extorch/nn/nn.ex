@@ -915,6 +915,11 @@ defmodule ExTorch.NN do
   ## Returns
   The output tensor.
 
+  Recurrent and attention layers take and return tuples, as in PyTorch:
+  `lstm` returns `{output, {h_n, c_n}}` and accepts `{input, {h_0, c_0}}`,
+  `gru` returns `{output, h_n}` and `multihead_attention` takes
+  `{query, key, value}` and returns `{attn_output, attn_weights}`.
+
   ## Examples
 
       iex> m = ExTorch.NN.linear(10, 5)
@@ -923,11 +928,18 @@ defmodule ExTorch.NN do
       iex> output.size
       {1, 5}
   """
-  @spec forward(ExTorch.Tensor.t(), Layer.t()) :: ExTorch.Tensor.t()
-  def forward(%ExTorch.Tensor{} = input, %Layer{} = layer) do
+  @spec forward(ExTorch.Tensor.t() | tuple(), Layer.t()) :: ExTorch.Tensor.t() | tuple()
+  def forward(%ExTorch.Tensor{} = input, %Layer{type_name: type_name} = layer)
+      when type_name not in ["LSTM", "GRU", "MultiheadAttention"] do
     ExTorch.Native.nn_forward(layer, input)
   end
 
+  def forward(input, %Layer{type_name: type_name} = layer) do
+    inputs = ExTorch.NN.Pipeline.flatten_inputs(input)
+    outputs = ExTorch.Native.nn_forward_many(layer, inputs)
+    ExTorch.NN.Pipeline.structure_outputs(type_name, outputs)
+  end
+
   @doc """
   Get named parameters of a layer.
 
@@ -985,6 +997,27 @@ defmodule ExTorch.NN do
     :ok
   end
 
+  @doc """
+  Bind tensors from a list of `{name, tensor}` tuples as a layer's
+  parameters and buffers, without copying.
+
+  Unlike `copy_parameters/2`, each parameter is pointed at the source
+  tensor's storage, so the weights are never resident twice. The layer and
+  the source tensors share memory afterwards. A source whose dtype or device
+  differs from the parameter's is converted first. Names that do not match
+  a parameter or buffer are ignored; a shape mismatch raises before any
+  parameter is bound.
+
+  ## Args
+    * `layer` (`ExTorch.NN.Layer`) - destination layer.
+    * `params` (`[{String.t(), ExTorch.Tensor.t()}]`) - source tensors.
+  """
+  @spec bind_parameters(Layer.t(), [{String.t(), ExTorch.Tensor.t()}]) :: :ok
+  def bind_parameters(%Layer{} = layer, params) do
+    ExTorch.Native.nn_bind_parameters(layer, params)
+    :ok
+  end
+
   @doc """
   Move a layer to a different device.
 
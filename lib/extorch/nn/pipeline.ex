@@ -0,0 +1,228 @@
+defmodule ExTorch.NN.Pipeline do
+  @moduledoc """
+  Whole-model native execution for `ExTorch.NN.Module` models.
+
+  A DSL model's `forward/2` normally runs each `layer/3` call as its own
+  NIF call, so an N-layer network crosses the NIF boundary N times and
+  wraps N intermediate tensors as Elixir terms. `compile/3` (also available
+  as `MyModel.compile/2`) traces `forward/2` once and turns the layers it
+  touches into a native pipeline that runs the whole chain in a single
+  dirty NIF call.
+
+  Tracing calls `forward/2` with placeholder values instead of tensors and
+  records every `layer/3` call. Sequential chains and simple DAGs trace
+  fine: a value can feed several layers, and `forward/2` can return a
+  tuple or list of values. Multi-input and multi-output layers use the
+  same shapes as in PyTorch:
+
+      {out, {h_n, c_n}} = layer(x, model, :lstm)
+      {out, {h_n, c_n}} = layer({x, {h_0, c_0}}, model, :lstm)
+      {out, h_n} = layer(x, model, :gru)
+      {attn, weights} = layer({q, k, v}, model, :attention)
+
+  A `forward/2` that does anything else with a value (such as calling an
+  `ExTorch` tensor op on it, or branching on its shape) cannot be traced.
+  `compile/3` then keeps the model on the per-layer path, so a compiled
+  pipeline always runs, natively or not.
+
+  ## Example
+
+      model = MyMLP.new()
+      pipeline = MyMLP.compile(model)
+      output = ExTorch.NN.Pipeline.run(pipeline, input)
+  """
+
+  alias ExTorch.NN.Layer
+
+  @type t :: %__MODULE__{
+          module: module(),
+          model: map(),
+          native: ExTorch.NN.Pipeline.Native.t() | nil,
+          num_inputs: pos_integer(),
+          outputs: term(),
+          fallback_reason: String.t() | nil
+        }
+
+  defstruct [:module, :model, :native, :outputs, num_inputs: 1, fallback_reason: nil]
+
+  defmodule Native do
+    @moduledoc false
+    @type t :: %__MODULE__{resource: any(), reference: reference(), num_steps: non_neg_integer()}
+    defstruct [:resource, :reference, :num_steps]
+  end
+
+  defmodule Value do
+    @moduledoc false
+    # A placeholder for a tensor while tracing `forward/2`.
+    @type t :: %__MODULE__{slot: non_neg_integer()}
+    defstruct [:slot]
+  end
+
+  defmodule Trace do
+    @moduledoc false
+    # Passed to `forward/2` in place of the model map while tracing.
+    @type t :: %__MODULE__{layers: map()}
+    defstruct [:layers]
+  end
+
+  @trace_key {__MODULE__, :trace}
+
+  @doc """
+  Compile a DSL model's `forward/2` into a native pipeline.
+
+  ## Args
+    * `module` (`module`) - the `ExTorch.NN.Module` that defines `forward/2`.
+    * `model` (`map`) - a model map, as returned by `module.new/1`.
+    * `opts` (`keyword`) - optional arguments:
+      * `:inputs` (`pos_integer`) - number of tensors `forward/2` takes. With
+        more than one, the input is passed as a tuple. Default: `1`.
+      * `:strict` (`boolean`) - raise `ArgumentError` instead of falling back
+        to the per-layer path when `forward/2` cannot be traced. Default: `false`.
+
+  ## Returns
+  An `%ExTorch.NN.Pipeline{}`. Its `:native` field is `nil` when the model
+  fell back to the per-layer path, with the cause in `:fallback_reason`.
+  """
+  @spec compile(module(), map(), keyword()) :: t()
+  def compile(module, model, opts \\ []) when is_atom(module) and is_map(model) do
+    num_inputs = Keyword.get(opts, :inputs, 1)
+    pipeline = %__MODULE__{module: module, model: model, num_inputs: num_inputs}
+
+    case trace(module, model, num_inputs) do
+      {:ok, steps, outputs, template} ->
+        native = ExTorch.Native.nn_pipeline_new(steps, num_inputs, outputs)
+        %{pipeline | native: native, outputs: template}
+
+      {:error, reason} ->
+        if Keyword.get(opts, :strict, false) do
+          raise ArgumentError, "cannot compile #{inspect(module)}.forward/2: #{reason}"
+        end
+
+        %{pipeline | fallback_reason: reason}
+    end
+  end
+
+  @doc """
+  Run a compiled pipeline.
+
+  ## Args
+    * `pipeline` (`ExTorch.NN.Pipeline`) - a pipeline from `compile/3`.
+    * `input` - an `ExTorch.Tensor`, or a tuple of `:inputs` tensors.
+
+  ## Returns
+  The same value `forward/2` returns for this input.
+  """
+  @spec run(t(), ExTorch.Tensor.t() | tuple()) :: term()
+  def run(%__MODULE__{native: nil, module: module, model: model}, input) do
+    module.forward(model, input)
+  end
+
+  def run(%__MODULE__{native: native, num_inputs: num_inputs, outputs: template}, input) do
+    inputs = if num_inputs == 1, do: [input], else: Tuple.to_list(input)
+    results = ExTorch.Native.nn_pipeline_run(native, inputs) |> List.to_tuple()
+    rebuild(template, results)
+  end
+
+  @doc """
+  Return `true` if the pipeline runs natively in a single call.
+  """
+  @spec native?(t()) :: boolean()
+  def native?(%__MODULE__{native: native}), do: native != nil
+
+  # -- layer values -----------------------------------------------------------
+
+  @doc false
+  # Flatten a (possibly nested) tuple of layer inputs into a list.
+  def flatten_inputs(input) when is_tuple(input) do
+    input |> Tuple.to_list() |> Enum.flat_map(&flatten_inputs/1)
+  end
+
+  def flatten_inputs(input), do: [input]
+
+  @doc false
+  # Number of values a layer returns, once tuple outputs are flattened.
+  def output_arity("LSTM"), do: 3
+  def output_arity("GRU"), do: 2
+  def output_arity("MultiheadAttention"), do: 2
+  def output_arity(_type_name), do: 1
+
+  @doc false
+  # Restore a layer's flattened outputs to the shape PyTorch returns.
+  def structure_outputs("LSTM", [out, h, c]), do: {out, {h, c}}
+  def structure_outputs("GRU", [out, h]), do: {out, h}
+  def structure_outputs("MultiheadAttention", [out, weights]), do: {out, weights}
+  def structure_outputs(_type_name, [out]), do: out
+
+  @doc false
+  # Called by the DSL's `layer/3` while tracing.
+  def trace_layer(%Layer{type_name: type_name} = layer, input) do
+    %{steps: steps, next_slot: next_slot} = state = Process.get(@trace_key)
+
+    inputs =
+      for value <- flatten_inputs(input) do
+        case value do
+          %Value{slot: slot} -> slot
+          other -> raise ArgumentError, "layer input is not a traced value: #{inspect(other)}"
+        end
+      end
+
+    arity = output_arity(type_name)
+    outputs = Enum.to_list(next_slot..(next_slot + arity - 1))
+
+    Process.put(@trace_key, %{state | steps: [{layer, inputs, outputs} | steps], next_slot: next_slot + arity})
+    structure_outputs(type_name, Enum.map(outputs, &%Value{slot: &1}))
+  end
+
+  # -- tracing ----------------------------------------------------------------
+
+  defp trace(module, model, num_inputs) do
+    input_values = Enum.map(0..(num_inputs - 1), &%Value{slot: &1})
+    input = if num_inputs == 1, do: hd(input_values), else: List.to_tuple(input_values)
+
+    previous = Process.put(@trace_key, %{steps: [], next_slot: num_inputs})
+
+    try do
+      result = module.forward(%Trace{layers: model}, input)
+      %{steps: steps} = Process.get(@trace_key)
+      {template, outputs} = output_template(result, [])
+      {:ok, Enum.reverse(steps), Enum.reverse(outputs), template}
+    catch
+      :error, reason ->
+        {:error, Exception.message(Exception.normalize(:error, reason, __STACKTRACE__))}
+
+      kind, reason ->
+        {:error, Exception.format_banner(kind, reason, __STACKTRACE__)}
+    after
+      if previous, do: Process.put(@trace_key, previous), else: Process.delete(@trace_key)
+    end
+  end
+
+  # Replace every traced value in forward/2's result with its position in
+  # the pipeline's output list.
+  defp output_template(%Value{slot: slot}, outputs) do
+    {%Value{slot: length(outputs)}, [slot | outputs]}
+  end
+
+  defp output_template(result, outputs) when is_tuple(result) do
+    {items, outputs} = output_template(Tuple.to_list(result), outputs)
+    {List.to_tuple(items), outputs}
+  end
+
+  defp output_template(result, outputs) when is_list(result) do
+    Enum.map_reduce(result, outputs, &output_template/2)
+  end
+
+  defp output_template(other, _outputs) do
+    raise ArgumentError, "forward/2 returned a value that is not a traced tensor: #{inspect(other)}"
+  end
+
+  defp rebuild(%Value{slot: idx}, results), do: elem(results, idx)
+
+  defp rebuild(template, results) when is_tuple(template) do
+    template |> Tuple.to_list() |> Enum.map(&rebuild(&1, results)) |> List.to_tuple()
+  end
+
+  defp rebuild(template, results) when is_list(template) do
+    Enum.map(template, &rebuild(&1, results))
+  end
+end
@@ -0,0 +1,205 @@
+defmodule ExTorch.NN.Weights do
+  @moduledoc """
+  Streaming weight loading for `ExTorch.NN.Module` models.
+
+  Reading a checkpoint with `ExTorch.Export.read_weights/1` and copying it
+  into a model with `ExTorch.NN.copy_parameters/2` holds every weight
+  twice: once as loaded tensors and once as the model's own parameters.
+  This module reads the tensors one layer at a time, straight from the
+  file into libtorch memory (`ExTorch.from_file/4`), and binds them as the
+  layer's parameters with `ExTorch.NN.bind_parameters/2`, so peak memory
+  stays at the model size plus one layer.
+
+  Two formats are supported:
+
+    * `.pt2` archives written by `torch.export.save`. Weights stored
+      uncompressed (the default) are read in place; compressed entries are
+      inflated one at a time.
+    * `.safetensors` files.
+
+  ## Example
+
+      model = MyModel.new() |> ExTorch.NN.Weights.bind("model.safetensors")
+  """
+
+  require Record
+
+  Record.defrecordp(:zip_file, Record.extract(:zip_file, from_lib: "stdlib/include/zip.hrl"))
+
+  alias ExTorch.NN.Layer
+
+  @type entry :: %{
+          name: String.t(),
+          shape: [non_neg_integer()],
+          dtype: ExTorch.DType.dtype(),
+          offset: non_neg_integer() | nil,
+          zip_entry: String.t() | nil
+        }
+
+  @safetensors_dtypes %{
+    "F64" => :float64,
+    "F32" => :float32,
+    "F16" => :float16,
+    "BF16" => :bfloat16,
+    "I64" => :int64,
+    "I32" => :int32,
+    "I16" => :int16,
+    "I8" => :int8,
+    "U8" => :uint8,
+    "BOOL" => :bool
+  }
+
+  @doc """
+  List the tensors stored in a weights file, ordered by their position in it.
+
+  Only metadata is read.
+
+  ## Args
+    * `path` (`String`) - path to a `.pt2` archive or a `.safetensors` file.
+
+  ## Returns
+  A list of entry maps with the tensor `:name`, `:shape` and `:dtype`.
+  """
+  @spec entries(String.t()) :: [entry()]
+  def entries(path) do
+    if Path.extname(path) == ".safetensors" do
+      safetensors_entries(path)
+    else
+      pt2_entries(path)
+    end
+  end
+
+  @doc """
+  Lazily read the tensors of a weights file, one at a time.
+
+  ## Args
+    * `path` (`String`) - path to a `.pt2` archive or a `.safetensors` file.
+
+  ## Returns
+  A stream of `{name, tensor}` tuples.
+  """
+  @spec stream(String.t()) :: Enumerable.t()
+  def stream(path) do
+    path |> entries() |> Stream.map(&{&1.name, read_entry(path, &1)})
+  end
+
+  @doc """
+  Read a single entry returned by `entries/1`.
+  """
+  @spec read_entry(String.t(), entry()) :: ExTorch.Tensor.t()
+  def read_entry(path, %{offset: offset, shape: shape, dtype: dtype}) when is_integer(offset) do
+    ExTorch.from_file(path, offset, List.to_tuple(shape), dtype)
+  end
+
+  def read_entry(path, %{zip_entry: zip_entry, shape: shape, dtype: dtype}) do
+    {:ok, [{_name, data}]} =
+      :zip.extract(String.to_charlist(path), [:memory, {:file_list, [String.to_charlist(zip_entry)]}])
+
+    ExTorch.Native.from_binary(data, List.to_tuple(shape), dtype)
+  end
+
+  @doc """
+  Bind the weights in a file to a DSL model, layer by layer.
+
+  Tensor names are resolved against the model's layers, including nested
+  DSL modules (`"encoder.fc1.weight"`). Each layer's tensors are read and
+  bound with `ExTorch.NN.bind_parameters/2` before the next layer is read.
+  Tensors that match no layer are skipped without being read.
+
+  ## Args
+    * `model` (`map`) - a DSL model map, as returned by `new/1`.
+    * `path` (`String`) - path to a `.pt2` archive or a `.safetensors` file.
+
+  ## Returns
+  The model, whose layers now hold the loaded weights.
+  """
+  @spec bind(map(), String.t()) :: map()
+  def bind(model, path) when is_map(model) do
+    path
+    |> entries()
+    |> Enum.flat_map(fn entry ->
+      case resolve(model, String.split(entry.name, "."), []) do
+        nil -> []
+        {layer_key, layer, param_name} -> [{layer_key, layer, param_name, entry}]
+      end
+    end)
+    |> Enum.group_by(&elem(&1, 0))
+    |> Enum.sort_by(fn {_layer_key, [{_, _, _, entry} | _]} -> entry.offset || 0 end)
+    |> Enum.each(fn {_layer_key, [{_, layer, _, _} | _] = items} ->
+      params = for {_, _, param_name, entry} <- items, do: {param_name, read_entry(path, entry)}
+      ExTorch.NN.bind_parameters(layer, params)
+    end)
+
+    model
+  end
+
+  # Walk a dotted tensor name down the model map to the layer that owns it.
+  defp resolve(_model, [_param], _prefix), do: nil
+
+  defp resolve(model, [segment | rest], prefix) do
+    case Enum.find(model, fn {name, _} -> Atom.to_string(name) == segment end) do
+      {_name, %Layer{} = layer} -> {Enum.reverse([segment | prefix]), layer, Enum.join(rest, ".")}
+      {_name, {_module, sub_model}} when is_map(sub_model) -> resolve(sub_model, rest, [segment | prefix])
+      _ -> nil
+    end
+  end
+
+  defp resolve(_model, [], _prefix), do: nil
+
+  # -- formats ----------------------------------------------------------------
+
+  defp safetensors_entries(path) do
+    File.open!(path, [:read, :binary], fn file ->
+      {:ok, <<header_size::little-64>>} = :file.pread(file, 0, 8)
+      {:ok, header} = :file.pread(file, 8, header_size)
+      data_start = 8 + header_size
+
+      header
+      |> Jason.decode!()
+      |> Map.delete("__metadata__")
+      |> Enum.map(fn {name, %{"dtype" => dtype, "shape" => shape, "data_offsets" => [first, _last]}} ->
+        %{
+          name: name,
+          shape: shape,
+          dtype: Map.fetch!(@safetensors_dtypes, dtype),
+          offset: data_start + first,
+          zip_entry: nil
+        }
+      end)
+      |> Enum.sort_by(& &1.offset)
+    end)
+  end
+
+  defp pt2_entries(path) do
+    schema = ExTorch.Export.read_schema(path)
+    {:ok, [_comment | files]} = :zip.list_dir(String.to_charlist(path))
+    headers = for zip_file(name: name, offset: offset) <- files, into: %{}, do: {List.to_string(name), offset}
+
+    File.open!(path, [:read, :binary], fn file ->
+      schema.weights
+      |> Enum.map(fn {name, meta} ->
+        zip_entry = "#{schema.model_name}/data/weights/#{meta.file}"
+
+        %{
+          name: name,
+          shape: meta.shape,
+          dtype: meta.dtype,
+          offset: stored_data_offset(file, Map.fetch!(headers, zip_entry)),
+          zip_entry: zip_entry
+        }
+      end)
+      |> Enum.sort_by(&(&1.offset || 0))
+    end)
+  end
+
+  # Data offset of a zip entry from its local file header, or nil if the
+  # entry is compressed and cannot be read in place.
+  defp stored_data_offset(file, header_offset) do
+    {:ok, header} = :file.pread(file, header_offset, 30)
+
+    <<0x04034B50::little-32, _version::16, _flags::16, method::little-16, _time::32, _crc::32,
+      _compressed::32, _size::32, name_len::little-16, extra_len::little-16>> = header
+
+    if method == 0, do: header_offset + 30 + name_len + extra_len, else: nil
+  end
+end
@@ -43,6 +43,8 @@ if Code.ensure_loaded?(Phoenix.LiveDashboard.PageBuilder) do
             min_ms:
               if(m.min_duration_ms == :infinity, do: "-", else: "#{Float.round(m.min_duration_ms, 2)}"),
             max_ms: "#{Float.round(m.max_duration_ms, 2)}",
+            p50_ms: format_ms(m.p50_duration_ms),
+            p99_ms: format_ms(m.p99_duration_ms),
             load_ms: "#{Float.round(m.load_duration_ms, 2)}"
           }
         end)
@@ -57,14 +59,14 @@ if Code.ensure_loaded?(Phoenix.LiveDashboard.PageBuilder) do
       <p>CUDA: <%= if @cuda_available, do: "Available", else: "Not available" %></p>
 
       <%= if @rows == [] do %>
-        <p>No models loaded. Start an ExTorch.JIT.Server to see metrics.</p>
+        <p>No models loaded. Start an ExTorch.JIT.Server, ExTorch.AOTI.Server or ExTorch.Export.Server to see metrics.</p>
       <% else %>
         <table>
           <thead>
             <tr>
               <th>Model</th><th>Device</th><th>Inferences</th>
               <th>Errors</th><th>Avg (ms)</th><th>Min (ms)</th>
-              <th>Max (ms)</th><th>Load (ms)</th>
+              <th>Max (ms)</th><th>p50 (ms)</th><th>p99 (ms)</th><th>Load (ms)</th>
             </tr>
           </thead>
           <tbody>
@@ -77,6 +79,8 @@ if Code.ensure_loaded?(Phoenix.LiveDashboard.PageBuilder) do
                 <td><%= row.avg_ms %></td>
                 <td><%= row.min_ms %></td>
                 <td><%= row.max_ms %></td>
+                <td><%= row.p50_ms %></td>
+                <td><%= row.p99_ms %></td>
                 <td><%= row.load_ms %></td>
               </tr>
             <% end %>
@@ -85,5 +89,8 @@ if Code.ensure_loaded?(Phoenix.LiveDashboard.PageBuilder) do
       <% end %>
       """
     end
+
+    defp format_ms(nil), do: "-"
+    defp format_ms(ms), do: "#{Float.round(ms, 2)}"
   end
 end
@@ -0,0 +1,273 @@
+defmodule ExTorch.Program do
+  @moduledoc """
+  Batched tensor op programs executed in a single native call.
+
+  Every tensor function in `ExTorch` crosses the NIF boundary once: it
+  decodes the argument structs, calls one libtorch function and encodes a
+  fresh `%ExTorch.Tensor{}` for the result. For pre/post-processing
+  pipelines made of many small ops (normalize, resize, permute, unsqueeze)
+  that per-call overhead dominates the actual compute.
+
+  An `ExTorch.Program` describes a short sequence of dispatcher ops over
+  named values. It is encoded once, using the same instruction stream as
+  `ExTorch.Export.forward_native/2`, and then runs as a whole inside one
+  NIF. Intermediate values never leave C++, so only the requested outputs
+  are encoded back into `%ExTorch.Tensor{}` structs.
+
+  ## Example
+
+      mean = ExTorch.tensor([0.485, 0.456, 0.406]) |> ExTorch.view({3, 1, 1})
+      std = ExTorch.tensor([0.229, 0.224, 0.225]) |> ExTorch.view({3, 1, 1})
+
+      program =
+        ExTorch.Program.new([:image])
+        |> ExTorch.Program.op(:x, "aten::permute", [:image, [2, 0, 1]])
+        |> ExTorch.Program.op(:x, "aten::to.dtype", [:x, {:dtype, :float32}])
+        |> ExTorch.Program.op(:x, "aten::div.Scalar", [:x, 255.0])
+        |> ExTorch.Program.op(:x, "aten::sub.Tensor", [:x, mean])
+        |> ExTorch.Program.op(:x, "aten::div.Tensor", [:x, std])
+        |> ExTorch.Program.op(:batch, "aten::unsqueeze", [:x, 0])
+        |> ExTorch.Program.compile()
+
+      batch = ExTorch.Program.run(program, [image])
+
+  ## Arguments
+
+  Op arguments are given positionally, in schema order. Keyword arguments
+  (matched by schema name, e.g. `dim:`) may be passed as the optional last
+  argument of `op/5`. Each argument can be:
+
+    - an atom naming a program input or a previous op output;
+    - an `%ExTorch.Tensor{}`, embedded as a constant;
+    - an integer, float, boolean or `nil`;
+    - a list of integers, floats, booleans, tensors or value names;
+    - `{:dtype, dtype}`, encoded as a libtorch `ScalarType`;
+    - `{:device, device}`, with `device` being `:cpu`, `:cuda` or `{:cuda, index}`.
+  """
+
+  @type value_name :: atom()
+
+  @type t :: %__MODULE__{
+          inputs: [String.t()],
+          chunks: [list()],
+          outputs: [String.t()] | nil,
+          last_outputs: [String.t()],
+          instructions: list() | nil,
+          compiled: ExTorch.Export.CompiledGraph.t() | nil
+        }
+
+  defstruct inputs: [],
+            chunks: [],
+            outputs: nil,
+            last_outputs: [],
+            instructions: nil,
+            compiled: nil
+
+  # c10::ScalarType enum values for the dtypes accepted in {:dtype, _} args.
+  @scalar_types %{
+    uint8: 0,
+    byte: 0,
+    int8: 1,
+    char: 1,
+    int16: 2,
+    short: 2,
+    int32: 3,
+    int: 3,
+    int64: 4,
+    long: 4,
+    float16: 5,
+    half: 5,
+    float32: 6,
+    float: 6,
+    float64: 7,
+    double: 7,
+    complex32: 8,
+    chalf: 8,
+    complex64: 9,
+    cfloat: 9,
+    complex_float: 9,
+    complex128: 10,
+    cdouble: 10,
+    complex_double: 10,
+    bool: 11,
+    bfloat16: 15
+  }
+
+  @doc """
+  Create an empty program over the given input names.
+
+  ## Args
+    - `inputs` - names of the tensors passed to `run/2`, in order.
+
+  ## Returns
+  An `%ExTorch.Program{}`.
+  """
+  @spec new([value_name()]) :: t()
+  def new(inputs) when is_list(inputs) do
+    %__MODULE__{inputs: Enum.map(inputs, &Atom.to_string/1)}
+  end
+
+  @doc """
+  Append a dispatcher op to the program.
+
+  ## Args
+    - `program` - the program to extend.
+    - `output` - name (or list of names, for multi-output ops) under which
+      the op result is stored. Names may be reused to overwrite a value.
+    - `target` - the operator, e.g. `"aten::sub"` or `"aten::sub.Tensor"`.
+      A `.overload` suffix selects the overload; none selects the default.
+    - `args` - positional arguments (see the module documentation).
+    - `kwargs` - keyword arguments, matched by schema argument name.
+
+  ## Returns
+  The extended program. Any previous `compile/1` result is discarded.
+  """
+  @spec op(t(), value_name() | [value_name()], String.t(), list(), keyword()) :: t()
+  def op(%__MODULE__{} = program, output, target, args, kwargs \\ [])
+      when is_binary(target) and is_list(args) and is_list(kwargs) do
+    {op_name, overload} = parse_target(target)
+    out_names = output |> List.wrap() |> Enum.map(&Atom.to_string/1)
+
+    header = [
+      {:begin_op, op_name, length(args) + length(kwargs)},
+      {:overload, overload}
+      | Enum.map(out_names, &{:output, &1})
+    ]
+
+    positional = Enum.map(args, &encode_arg/1)
+
+    named =
+      Enum.flat_map(kwargs, fn {name, value} ->
+        [{:arg_name, Atom.to_string(name)}, encode_arg(value)]
+      end)
+
+    %{
+      program
+      | chunks: [header ++ positional ++ named | program.chunks],
+        last_outputs: out_names,
+        instructions: nil,
+        compiled: nil
+    }
+  end
+
+  @doc """
+  Select the values returned by `run/2`.
+
+  By default a program returns the outputs of its last op.
+  """
+  @spec output(t(), value_name() | [value_name()]) :: t()
+  def output(%__MODULE__{} = program, names) do
+    outputs = names |> List.wrap() |> Enum.map(&Atom.to_string/1)
+    %{program | outputs: outputs, compiled: nil}
+  end
+
+  @doc """
+  Encode the program once so that repeated `run/2` calls only pass tensors.
+
+  The instruction stream is flattened and handed to the native graph
+  compiler, which resolves every op schema up front. If an op cannot be
+  pre-compiled, the program still runs through the interpreted
+  instruction stream.
+
+  ## Returns
+  The compiled program.
+  """
+  @spec compile(t()) :: t()
+  def compile(%__MODULE__{} = program) do
+    instructions = flatten(program)
+    outputs = outputs(program)
+
+    compiled =
+      try do
+        ExTorch.Native.compile_graph(instructions, program.inputs, outputs)
+      rescue
+        _ -> nil
+      end
+
+    %{program | instructions: instructions, compiled: compiled}
+  end
+
+  @doc """
+  Run the program in a single native call.
+
+  ## Args
+    - `program` - the program, ideally prepared with `compile/1`.
+    - `inputs` - one tensor per input name given to `new/1`.
+
+  ## Returns
+  A tensor when the program has a single output, or a list of outputs.
+  """
+  @spec run(t(), [ExTorch.Tensor.t()]) :: ExTorch.Tensor.t() | [term()]
+  def run(%__MODULE__{compiled: nil} = program, inputs) when is_list(inputs) do
+    check_arity!(program, inputs)
+    instructions = program.instructions || flatten(program)
+
+    result =
+      ExTorch.Native.execute_graph(instructions, program.inputs, inputs, outputs(program))
+
+    case result do
+      {single} -> single
+      multiple when is_tuple(multiple) -> Tuple.to_list(multiple)
+      single -> single
+    end
+  end
+
+  def run(%__MODULE__{compiled: compiled} = program, inputs) when is_list(inputs) do
+    check_arity!(program, inputs)
+
+    case ExTorch.Native.run_compiled_graph(compiled, inputs) do
+      [single] -> single
+      multiple -> multiple
+    end
+  end
+
+  defp check_arity!(program, inputs) do
+    if length(inputs) != length(program.inputs) do
+      raise ArgumentError,
+            "program expects #{length(program.inputs)} inputs, got #{length(inputs)}"
+    end
+  end
+
+  defp flatten(%__MODULE__{chunks: chunks}) do
+    chunks |> Enum.reverse() |> Enum.concat()
+  end
+
+  defp outputs(%__MODULE__{outputs: nil, last_outputs: last}), do: last
+  defp outputs(%__MODULE__{outputs: outputs}), do: outputs
+
+  defp parse_target(target) do
+    case String.split(target, "::", parts: 2) do
+      [ns, rest] ->
+        case String.split(rest, ".", parts: 2) do
+          [op, overload] -> {"#{ns}::#{op}", overload}
+          [op] -> {"#{ns}::#{op}", ""}
+        end
+
+      _ ->
+        raise ArgumentError, "op target must be namespaced, e.g. \"aten::add\", got: #{target}"
+    end
+  end
+
+  defp encode_arg(nil), do: :none
+  defp encode_arg(v) when is_boolean(v), do: {:bool, v}
+  defp encode_arg(v) when is_atom(v), do: {:ref, Atom.to_string(v)}
+  defp encode_arg(v) when is_integer(v), do: {:int, v}
+  defp encode_arg(v) when is_float(v), do: {:float, v}
+  defp encode_arg(%ExTorch.Tensor{} = t), do: {:tensor, t}
+  defp encode_arg(items) when is_list(items), do: {:list, Enum.map(items, &encode_arg/1)}
+
+  defp encode_arg({:dtype, dtype}) do
+    case Map.fetch(@scalar_types, dtype) do
+      {:ok, code} -> {:int, code}
+      :error -> raise ArgumentError, "unsupported program dtype: #{inspect(dtype)}"
+    end
+  end
+
+  defp encode_arg({:device, :cpu}), do: {:device, "cpu"}
+  defp encode_arg({:device, :cuda}), do: {:device, {"cuda", 0}}
+  defp encode_arg({:device, {:cuda, idx}}), do: {:device, {"cuda", idx}}
+
+  defp encode_arg(other) do
+    raise ArgumentError, "unsupported program argument: #{inspect(other)}"
+  end
+end
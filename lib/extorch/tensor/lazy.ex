@@ -0,0 +1,205 @@
+defmodule ExTorch.Tensor.Lazy do
+  @moduledoc """
+  Lazy, fused evaluation of pointwise tensor expressions.
+
+  Every pointwise call in `ExTorch` (`ExTorch.add/3`, `ExTorch.mul/2`,
+  `ExTorch.tensor_exp/1`, ...) is its own NIF call and materializes a full
+  intermediate tensor. Long pointwise chains over large tensors, such as
+  input normalization or score calibration, spend most of their time
+  writing and re-reading those intermediates.
+
+  The functions in this module build an expression instead of computing
+  it. `eval/1` sends the whole expression to libtorch in a single call,
+  where it runs as one vectorized kernel: each block of elements is read
+  from the inputs once, goes through every operation while it is still in
+  cache, and is written to the result once. Operands broadcast as in
+  PyTorch, and may be tensors, lazy values or numbers. Shared
+  subexpressions and repeated inputs are computed and read only once.
+
+  Integer and boolean inputs are promoted to the default floating point
+  dtype. Fusion applies to CPU `:float32` and `:float64` tensors that do not
+  require grad; any other expression is still evaluated in a single NIF
+  call, one ATen operation at a time.
+
+  ## Example
+
+      alias ExTorch.Tensor.Lazy
+
+      normalized =
+        images
+        |> Lazy.wrap()
+        |> Lazy.mul(1 / 255)
+        |> Lazy.sub(mean)
+        |> Lazy.div(std)
+        |> Lazy.eval()
+  """
+
+  import Kernel, except: [abs: 1, div: 2]
+
+  @type expr ::
+          {:input, ExTorch.Tensor.t()}
+          | {:const, float()}
+          | {atom(), expr()}
+          | {atom(), expr(), expr()}
+
+  @type t :: %__MODULE__{expr: expr()}
+
+  @type operand :: t() | ExTorch.Tensor.t() | number()
+
+  defstruct [:expr]
+
+  # Opcodes understood by the native kernel (see fused_pointwise.cc).
+  @binary_ops [add: 0, sub: 1, mul: 2, div: 3, maximum: 4, minimum: 5, pow: 6]
+  @unary_ops [
+    neg: 10,
+    abs: 11,
+    exp: 12,
+    log: 13,
+    sqrt: 14,
+    rsqrt: 15,
+    sigmoid: 16,
+    tanh: 17,
+    relu: 18,
+    reciprocal: 19
+  ]
+  @opcodes Map.new(@binary_ops ++ @unary_ops)
+
+  @doc """
+  Wrap a tensor (or a number) as a lazy value.
+
+  ## Args
+    * `operand` (`ExTorch.Tensor | ExTorch.Tensor.Lazy | number`) - the value to wrap.
+      Lazy values are returned unchanged.
+
+  ## Returns
+  An `ExTorch.Tensor.Lazy` value.
+  """
+  @spec wrap(operand()) :: t()
+  def wrap(%__MODULE__{} = lazy), do: lazy
+  def wrap(%ExTorch.Tensor{} = tensor), do: %__MODULE__{expr: {:input, tensor}}
+  def wrap(value) when is_number(value), do: %__MODULE__{expr: {:const, value * 1.0}}
+
+  for {name, _code} <- @binary_ops do
+    @doc """
+    Lazy element-wise `#{name}` of `a` and `b`, with broadcasting.
+    """
+    @spec unquote(name)(operand(), operand()) :: t()
+    def unquote(name)(a, b), do: %__MODULE__{expr: {unquote(name), expr(a), expr(b)}}
+  end
+
+  for {name, _code} <- @unary_ops do
+    @doc """
+    Lazy element-wise `#{name}` of `a`.
+    """
+    @spec unquote(name)(operand()) :: t()
+    def unquote(name)(a), do: %__MODULE__{expr: {unquote(name), expr(a)}}
+  end
+
+  @doc """
+  Lazily clamp `a` to the range `[min_val, max_val]`.
+
+  Either bound may be `nil` to leave that side unbounded.
+  """
+  @spec clamp(operand(), operand() | nil, operand() | nil) :: t()
+  def clamp(a, min_val, max_val) do
+    a = if min_val == nil, do: wrap(a), else: maximum(a, min_val)
+    if max_val == nil, do: a, else: minimum(a, max_val)
+  end
+
+  @doc """
+  Evaluate a lazy expression in a single NIF call.
+
+  ## Args
+    * `value` (`ExTorch.Tensor.Lazy | ExTorch.Tensor`) - the expression to
+      evaluate. Tensors are returned unchanged.
+
+  ## Returns
+  An `ExTorch.Tensor` with the broadcast shape of the expression's inputs.
+  """
+  @spec eval(t() | ExTorch.Tensor.t()) :: ExTorch.Tensor.t()
+  def eval(%ExTorch.Tensor{} = tensor), do: tensor
+  def eval(%__MODULE__{expr: {:input, tensor}}), do: tensor
+
+  def eval(%__MODULE__{expr: expr}) do
+    {inputs, consts, program} = compile(expr)
+    ExTorch.Native.fused_pointwise(inputs, consts, program)
+  end
+
+  @doc false
+  # Flatten an expression into the native program format: the distinct
+  # input tensors, the distinct constants and a list of (op, a, b) triples
+  # whose registers number the inputs first, then the constants, then one
+  # per instruction.
+  @spec compile(expr()) :: {[ExTorch.Tensor.t()], [float()], [integer()]}
+  def compile(expr) do
+    state = %{inputs: %{}, consts: %{}, nodes: %{}, insts: []}
+    {_ref, state} = emit(expr, state)
+
+    num_inputs = map_size(state.inputs)
+    first_temp = num_inputs + map_size(state.consts)
+
+    register = fn
+      {:input, idx} -> idx
+      {:const, idx} -> num_inputs + idx
+      {:temp, idx} -> first_temp + idx
+    end
+
+    program =
+      state.insts
+      |> Enum.reverse()
+      |> Enum.flat_map(fn {op, a, b} -> [op, register.(a), register.(b)] end)
+
+    {ordered_values(state.inputs), ordered_values(state.consts), program}
+  end
+
+  # Emit the instructions for `expr` (post-order), reusing the register of
+  # any identical subexpression emitted before.
+  defp emit({:input, %ExTorch.Tensor{reference: reference} = tensor}, state) do
+    case state.inputs do
+      %{^reference => {idx, _tensor}} ->
+        {{:input, idx}, state}
+
+      inputs ->
+        idx = map_size(inputs)
+        {{:input, idx}, %{state | inputs: Map.put(inputs, reference, {idx, tensor})}}
+    end
+  end
+
+  defp emit({:const, value}, state) do
+    case state.consts do
+      %{^value => {idx, _value}} ->
+        {{:const, idx}, state}
+
+      consts ->
+        idx = map_size(consts)
+        {{:const, idx}, %{state | consts: Map.put(consts, value, {idx, value})}}
+    end
+  end
+
+  defp emit(node, %{nodes: nodes} = state) when is_map_key(nodes, node) do
+    {Map.fetch!(nodes, node), state}
+  end
+
+  defp emit({op, a}, state) do
+    {a_ref, state} = emit(a, state)
+    push({op, a}, {Map.fetch!(@opcodes, op), a_ref, a_ref}, state)
+  end
+
+  defp emit({op, a, b}, state) do
+    {a_ref, state} = emit(a, state)
+    {b_ref, state} = emit(b, state)
+    push({op, a, b}, {Map.fetch!(@opcodes, op), a_ref, b_ref}, state)
+  end
+
+  defp push(node, inst, %{nodes: nodes, insts: insts} = state) do
+    ref = {:temp, map_size(nodes)}
+    {ref, %{state | nodes: Map.put(nodes, node, ref), insts: [inst | insts]}}
+  end
+
+  defp ordered_values(map) do
+    map |> Map.values() |> Enum.sort() |> Enum.map(&elem(&1, 1))
+  end
+
+  defp expr(%__MODULE__{expr: expr}), do: expr
+  defp expr(operand), do: operand |> wrap() |> expr()
+end
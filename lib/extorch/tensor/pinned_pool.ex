@@ -0,0 +1,123 @@
+defmodule ExTorch.Tensor.PinnedPool do
+  @moduledoc """
+  Pooled host staging buffers for tensor ingest.
+
+  `ExTorch.Native.from_binary/3` allocates a fresh host buffer for every
+  tensor it creates. When a server ingests many request payloads per second,
+  that allocation (and, on CUDA hosts, the page-locking needed for
+  asynchronous copies) dominates the cost of moving data into libtorch.
+
+  The functions in this module copy the binary into a block taken from a
+  process-wide pool instead. Blocks are bucketed by power-of-two capacity
+  and return to the pool as soon as the tensor (and every view of it) is
+  garbage collected, so steady-state ingest performs no allocations.
+
+  When CUDA is available the blocks are page-locked (pinned), which lets
+  `ExTorch.Tensor.to/2` with `non_blocking: true` overlap the host-to-device
+  copy with compute. A released block is only handed out again once the
+  copies enqueued from it have completed on the device, so dropping the
+  host tensor while its upload is in flight is safe. Nothing waits for
+  those copies: a block the pool gives up while they run is kept aside
+  and freed by a later pool call, once they are done. On CPU-only hosts
+  the pool recycles pageable blocks.
+
+  ## Example
+
+      tensor = ExTorch.Tensor.PinnedPool.from_binary(payload, {8, 3, 224, 224}, :float32)
+      gpu = ExTorch.Tensor.to(tensor, device: :cuda, non_blocking: true)
+
+      ExTorch.Tensor.PinnedPool.stats()
+      # %{requests: 1200, hits: 1196, reuse_rate: 0.996, ...}
+  """
+
+  @type entry :: {binary(), tuple(), ExTorch.DType.dtype()}
+
+  @doc """
+  Create a tensor from raw binary data, staged in a pooled host buffer.
+
+  ## Arguments
+    - `data` - Raw tensor bytes, in native byte order.
+    - `shape` - Tensor shape as a tuple.
+    - `dtype` - Element data type (default `:float32`).
+
+  ## Returns
+  An `%ExTorch.Tensor{}` on the CPU. Raises if `byte_size(data)` does not
+  match the size implied by `shape` and `dtype`.
+  """
+  @spec from_binary(binary(), tuple(), ExTorch.DType.dtype()) :: ExTorch.Tensor.t()
+  def from_binary(data, shape, dtype \\ :float32) do
+    ExTorch.Native.from_binary_pinned(data, shape, dtype)
+  end
+
+  @doc """
+  Create several tensors in a single native call.
+
+  ## Arguments
+    - `entries` - A list of `{data, shape, dtype}` tuples.
+
+  ## Returns
+  A list of `%ExTorch.Tensor{}`, in the same order as `entries`.
+  """
+  @spec from_binaries([entry()]) :: [ExTorch.Tensor.t()]
+  def from_binaries(entries) when is_list(entries) do
+    ExTorch.Native.from_binaries_pinned(entries)
+  end
+
+  @doc """
+  Return the pool counters.
+
+  ## Returns
+  A map with the following keys:
+    - `:pinned` - Whether pool blocks are page-locked.
+    - `:requests` - Number of tensors staged through the pool.
+    - `:hits` / `:misses` - Requests served from / not served from a cached block.
+    - `:releases` - Blocks returned by garbage-collected tensors.
+    - `:blocks_in_use` / `:blocks_cached` - Live and free block counts.
+    - `:bytes_in_use` - Bytes requested by live tensors.
+    - `:capacity_in_use` - Capacity of the blocks backing live tensors.
+    - `:bytes_cached` - Capacity held in the free lists.
+    - `:bytes_reserved` - Total capacity allocated by the pool, including
+      evicted blocks whose copies are still in flight.
+    - `:max_cached_bytes` - Limit on `:bytes_cached`.
+    - `:reuse_rate` - `hits / requests` (`0.0` before the first request).
+    - `:fragmentation` - Fraction of in-use capacity lost to bucket rounding.
+  """
+  @spec stats() :: map()
+  def stats do
+    stats = ExTorch.Native.pinned_pool_stats()
+
+    reuse_rate =
+      if stats.requests > 0, do: stats.hits / stats.requests, else: 0.0
+
+    fragmentation =
+      if stats.capacity_in_use > 0,
+        do: 1.0 - stats.bytes_in_use / stats.capacity_in_use,
+        else: 0.0
+
+    Map.merge(stats, %{reuse_rate: reuse_rate, fragmentation: fragmentation})
+  end
+
+  @doc """
+  Free every cached block. Blocks backing live tensors are unaffected, and
+  blocks whose copies are still in flight are freed once they complete.
+
+  ## Returns
+  The number of bytes removed from the cache.
+  """
+  @spec empty_cache() :: non_neg_integer()
+  def empty_cache do
+    ExTorch.Native.pinned_pool_empty_cache()
+  end
+
+  @doc """
+  Bound the number of bytes the pool keeps in its free lists.
+
+  Blocks released while the cache is at the limit are freed as soon as
+  their copies are done.
+  The default limit is 1 GiB.
+  """
+  @spec set_max_cached_bytes(non_neg_integer()) :: non_neg_integer()
+  def set_max_cached_bytes(max_bytes) when is_integer(max_bytes) and max_bytes >= 0 do
+    ExTorch.Native.pinned_pool_set_max_cached_bytes(max_bytes)
+  end
+end
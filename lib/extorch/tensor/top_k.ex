@@ -0,0 +1,124 @@
+defmodule ExTorch.Tensor.TopK do
+  @moduledoc """
+  Top-k selection over very large score rows.
+
+  `ExTorch.topk/6` parallelizes across rows, so a single row of millions of
+  scores (a retrieval query against a large corpus) is scanned by one
+  thread. The functions in this module split long rows into cache-sized
+  chunks that are scanned in parallel, each thread keeping a bounded heap
+  of candidates, and merge the per-thread candidates at the end.
+  `ExTorch.topk/6` itself switches to this path for long CPU rows when no
+  `out` tensors are given and there are fewer rows than threads.
+
+  They also avoid materializing the full score row: `matmul/4` scores the
+  keys block by block, and `stream/3` folds score chunks produced one at a
+  time (for example, by scoring batches of a corpus read from disk).
+
+  All functions return a `{values, indices}` tuple, like `ExTorch.topk/6`,
+  sorted from best to worst.
+
+  ## Example
+
+      {scores, ids} = ExTorch.Tensor.TopK.matmul(query, corpus, 100)
+  """
+
+  @default_chunk_size 65_536
+
+  @doc """
+  Select the `k` largest (or smallest) values of `input` along `dim`.
+
+  ## Args
+    * `input` (`ExTorch.Tensor`) - the scores.
+    * `k` (`integer`) - the number of values to keep.
+    * `opts` (`keyword`) - optional arguments:
+      * `:dim` (`integer`) - the dimension to select along. Default: `-1`.
+      * `:largest` (`boolean`) - select the largest values, or the smallest
+        if `false`. Default: `true`.
+      * `:chunk_size` (`integer`) - the number of elements each parallel
+        task scans at a time. Default: `#{@default_chunk_size}`.
+
+  ## Returns
+  A `{values, indices}` tuple.
+  """
+  @spec chunked(ExTorch.Tensor.t(), non_neg_integer(), keyword()) ::
+          {ExTorch.Tensor.t(), ExTorch.Tensor.t()}
+  def chunked(input, k, opts \\ []) do
+    ExTorch.Native.chunked_topk(
+      input,
+      k,
+      Keyword.get(opts, :dim, -1),
+      Keyword.get(opts, :largest, true),
+      Keyword.get(opts, :chunk_size, @default_chunk_size)
+    )
+  end
+
+  @doc """
+  Whether `ExTorch.topk/6` (without `out` tensors) selects the top `k` of
+  `input` along `dim` with `chunked/3`: its rows must be long enough to
+  split and fewer than the intra-op threads.
+  """
+  @spec chunked_path?(ExTorch.Tensor.t(), non_neg_integer(), integer()) :: boolean()
+  def chunked_path?(input, k, dim \\ -1), do: ExTorch.Native.topk_chunked_path(input, k, dim)
+
+  @doc """
+  Select the top `k` scores of `query @ ExTorch.transpose(keys, 0, 1)`
+  for every query row, without materializing the `[q, n]` score matrix.
+
+  ## Args
+    * `query` (`ExTorch.Tensor`) - a `[q, d]` tensor.
+    * `keys` (`ExTorch.Tensor`) - a `[n, d]` tensor.
+    * `k` (`integer`) - the number of keys to keep per query.
+    * `opts` (`keyword`) - optional arguments:
+      * `:largest` (`boolean`) - keep the highest scores, or the lowest
+        if `false`. Default: `true`.
+      * `:chunk_size` (`integer`) - the number of keys scored at a time.
+        Default: `16384`.
+
+  ## Returns
+  A `{values, indices}` tuple of `[q, k]` tensors, where `indices` are rows
+  of `keys`.
+  """
+  @spec matmul(ExTorch.Tensor.t(), ExTorch.Tensor.t(), non_neg_integer(), keyword()) ::
+          {ExTorch.Tensor.t(), ExTorch.Tensor.t()}
+  def matmul(query, keys, k, opts \\ []) do
+    ExTorch.Native.topk_matmul(
+      query,
+      keys,
+      k,
+      Keyword.get(opts, :largest, true),
+      Keyword.get(opts, :chunk_size, 16_384)
+    )
+  end
+
+  @doc """
+  Select the top `k` scores from a sequence of score chunks.
+
+  Each chunk holds the scores for the next slice of the last dimension;
+  the leading dimensions of every chunk must match. Only the running top
+  `k` is kept between chunks.
+
+  ## Args
+    * `chunks` (`Enumerable`) - the score chunks, in order.
+    * `k` (`integer`) - the number of values to keep.
+    * `opts` (`keyword`) - optional arguments:
+      * `:largest` (`boolean`) - keep the largest values, or the smallest
+        if `false`. Default: `true`.
+
+  ## Returns
+  A `{values, indices}` tuple, where `indices` are positions in the
+  concatenation of all chunks. Raises `ArgumentError` if `chunks` is empty.
+  """
+  @spec stream(Enumerable.t(), non_neg_integer(), keyword()) ::
+          {ExTorch.Tensor.t(), ExTorch.Tensor.t()}
+  def stream(chunks, k, opts \\ []) do
+    largest = Keyword.get(opts, :largest, true)
+
+    {result, _offset} =
+      Enum.reduce(chunks, {nil, 0}, fn %ExTorch.Tensor{size: size} = chunk, {state, offset} ->
+        state = ExTorch.Native.topk_merge(state, chunk, offset, k, largest)
+        {state, offset + elem(size, tuple_size(size) - 1)}
+      end)
+
+    result || raise(ArgumentError, "cannot select the top-k of an empty sequence of chunks")
+  end
+end
@@ -0,0 +1,74 @@
+defmodule ExTorch.Trace do
+  @moduledoc """
+  Chrome traces of native inference.
+
+  `trace/4` runs a model several times with the libtorch (Kineto) profiler
+  enabled and writes what it recorded to a JSON file that can be opened in
+  `chrome://tracing` or [Perfetto](https://ui.perfetto.dev). Every run is a
+  `request#<i>` range; inside it are the aten ops the model called and, for
+  compiled export graphs, one range per graph node named after its first
+  output.
+
+  The profiler only records the thread that enabled it, so all the runs
+  happen inside a single native call on one scheduler thread. Tracing is
+  meant for offline inspection of where a request spends its time, not for
+  production traffic: use `ExTorch.Export.start_profiling/2` for that.
+
+  ## Example
+
+      model = ExTorch.Export.load("resnet18.pt2")
+      :ok = ExTorch.Trace.trace(model, [input], "/tmp/resnet18.json", requests: 5)
+  """
+
+  alias ExTorch.Export
+
+  @doc """
+  Run `model` on `inputs` `:requests` times under the profiler and write a
+  Chrome trace to `path`.
+
+  ## Args
+    * `model` (`ExTorch.Export.Model | ExTorch.AOTI.Model | ExTorch.JIT.Model`) -
+      the model. Export models must be loaded with a compiled graph.
+    * `inputs` (`[ExTorch.Tensor]`) - the model inputs, as passed to its
+      `forward` function (`ExTorch.Export.forward_compiled/2` for export
+      models).
+    * `path` (`Path.t()`) - the trace file to write.
+    * `opts` (`keyword`) - optional arguments:
+      * `:requests` (`integer`) - the number of runs traced. Default: `10`.
+      * `:record_shapes` (`boolean`) - record the input shapes of every op.
+        Default: `false`.
+      * `:profile_memory` (`boolean`) - record allocator events.
+        Default: `false`.
+
+  ## Returns
+  `:ok`.
+  """
+  @spec trace(
+          Export.Model.t() | ExTorch.AOTI.Model.t() | ExTorch.JIT.Model.t(),
+          [ExTorch.Tensor.t()],
+          Path.t(),
+          keyword()
+        ) :: :ok
+  def trace(model, inputs, path, opts \\ []) when is_list(inputs) do
+    requests = Keyword.get(opts, :requests, 10)
+    record_shapes = Keyword.get(opts, :record_shapes, false)
+    profile_memory = Keyword.get(opts, :profile_memory, false)
+    path = Path.expand(path)
+
+    case model do
+      %Export.Model{native_compiled: nil} ->
+        raise ArgumentError, "the model has no compiled graph to trace"
+
+      %Export.Model{native_compiled: compiled} ->
+        ExTorch.Native.trace_compiled_graph(
+          compiled, inputs, requests, path, record_shapes, profile_memory
+        )
+
+      %ExTorch.AOTI.Model{} ->
+        ExTorch.Native.trace_aoti(model, inputs, requests, path, record_shapes, profile_memory)
+
+      %ExTorch.JIT.Model{} ->
+        ExTorch.Native.trace_jit(model, inputs, requests, path, record_shapes, profile_memory)
+    end
+  end
+end
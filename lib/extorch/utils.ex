@@ -20,6 +20,24 @@ defmodule ExTorch.Utils do
               dtype: nil
   end
 
+  defmodule TensorData do
+    @typedoc """
+    This struct holds a (nested) list of elements to be decoded into an
+    ExTorch.Tensor by the native side, along with the default floating point
+    type of the calling process.
+    """
+    @type t :: %__MODULE__{
+            data: ExTorch.Scalar.scalar_or_list(),
+            float_dtype: :float32 | :float64
+          }
+
+    @moduledoc """
+    Struct used to pass a list of elements or lists of elements to `ExTorch.tensor/2`.
+    """
+    defstruct data: [],
+              float_dtype: :float32
+  end
+
   @doc """
   Given a list of elements or a list with lists with elements, this function
   returns a ExTorch.Utils.ListWrapper structure.
@@ -61,6 +79,23 @@ defmodule ExTorch.Utils do
     to_list_wrapper([input])
   end
 
+  @doc """
+  Given a number, a list of elements or a list with lists with elements, this
+  function returns a ExTorch.Utils.TensorData structure. Unlike
+  `to_list_wrapper/1`, the input is not traversed: its shape and type are
+  inferred while the native side decodes it.
+  """
+  @spec to_tensor_data(ExTorch.Scalar.scalar_or_list()) :: __MODULE__.TensorData.t()
+  def to_tensor_data(input) do
+    float_dtype =
+      case ExTorch.get_default_dtype() do
+        :float64 -> :float64
+        _ -> :float32
+      end
+
+    %__MODULE__.TensorData{data: input, float_dtype: float_dtype}
+  end
+
   defp size(x) do
     size(x, [0])
   end
@@ -0,0 +1,207 @@
+defmodule ExTorch.VectorIndex do
+  @moduledoc """
+  In-process approximate nearest-neighbour search over float vectors.
+
+  Brute-force retrieval (`ExTorch.matmul/2` followed by `ExTorch.topk/6`,
+  or `ExTorch.Tensor.TopK.matmul/4`) scores every vector of the corpus for
+  every query. An index only scores a small part of it:
+
+    * `:ivf_flat` clusters the vectors around `:nlist` k-means centroids
+      (see `train/3`) and a search scans the `:nprobe` clusters closest to
+      the query. It has to be trained on a sample before vectors are added.
+    * `:hnsw` links every vector to its `:m` closest neighbours (on several
+      levels of a hierarchical graph) as it is inserted, and a search walks
+      the graph keeping the `:ef_search` best candidates. It needs no
+      training, and inserts are slower than IVF ones.
+
+  Larger `:nprobe` and `:ef_search` values trade speed for recall; both can
+  also be set per search.
+
+  The vectors are stored in a float32 tensor inside the index (row `i` is
+  the vector with id `i`), returned by `vectors/1`. Distances are computed
+  with SIMD kernels and batched searches run their queries in parallel.
+  Searches can run concurrently with each other; `add/2` waits for running
+  searches.
+
+  `save/2` writes the index to a single file whose vectors can be mapped
+  into memory by `load/2` instead of being read.
+
+  ## Metrics
+    * `:l2` - squared euclidean distance, smaller is closer.
+    * `:ip` - inner product, larger is closer. For cosine similarity,
+      normalize the vectors and queries and use `:ip`.
+
+  ## Example
+
+      index = ExTorch.VectorIndex.new(:hnsw, 384, metric: :ip)
+      ExTorch.VectorIndex.add(index, embeddings)
+      {scores, ids} = ExTorch.VectorIndex.search(index, queries, 10)
+  """
+
+  @type kind :: :ivf_flat | :hnsw
+  @type metric :: :l2 | :ip
+
+  @type t :: %__MODULE__{
+          resource: reference(),
+          reference: reference(),
+          kind: String.t(),
+          metric: String.t(),
+          dim: pos_integer()
+        }
+
+  defstruct [:resource, :reference, :kind, :metric, :dim]
+
+  @doc """
+  Create an empty index for `dim`-dimensional vectors.
+
+  ## Args
+    * `kind` (`:ivf_flat | :hnsw`) - the index structure.
+    * `dim` (`integer`) - the vector dimension.
+    * `opts` (`keyword`) - optional arguments:
+      * `:metric` (`:l2 | :ip`) - the distance metric. Default: `:l2`.
+      * `:nlist` (`integer`) - IVF only, the number of clusters. Default: `100`.
+      * `:nprobe` (`integer`) - IVF only, the number of clusters scanned per
+        query. Default: `8`.
+      * `:m` (`integer`) - HNSW only, the number of links per node
+        (twice as many on the bottom level). Default: `16`.
+      * `:ef_construction` (`integer`) - HNSW only, the number of
+        candidates considered when linking a new vector. Default: `200`.
+      * `:ef_search` (`integer`) - HNSW only, the number of candidates kept
+        while searching. Default: `64`.
+      * `:seed` (`integer`) - seed for k-means initialization and HNSW
+        levels. Default: `0`.
+
+  ## Returns
+  An `ExTorch.VectorIndex`.
+  """
+  @spec new(kind(), pos_integer(), keyword()) :: t()
+  def new(kind, dim, opts \\ []) when kind in [:ivf_flat, :hnsw] do
+    ExTorch.Native.vector_index_new(
+      Atom.to_string(kind),
+      opts |> Keyword.get(:metric, :l2) |> Atom.to_string(),
+      dim,
+      Keyword.get(opts, :nlist, 100),
+      Keyword.get(opts, :nprobe, 8),
+      Keyword.get(opts, :m, 16),
+      Keyword.get(opts, :ef_construction, 200),
+      Keyword.get(opts, :ef_search, 64),
+      Keyword.get(opts, :seed, 0)
+    )
+  end
+
+  @doc """
+  Train the clusters of an IVF index with k-means. Must be called once,
+  before any vector is added; does nothing for HNSW indices.
+
+  ## Args
+    * `index` (`ExTorch.VectorIndex`) - the index.
+    * `sample` (`ExTorch.Tensor`) - a `[n, dim]` tensor of representative
+      vectors, with at least `:nlist` rows.
+    * `opts` (`keyword`) - optional arguments:
+      * `:iterations` (`integer`) - the number of k-means iterations.
+        Default: `20`.
+
+  ## Returns
+  `:ok`.
+  """
+  @spec train(t(), ExTorch.Tensor.t(), keyword()) :: :ok
+  def train(index, sample, opts \\ []) do
+    ExTorch.Native.vector_index_train(index, sample, Keyword.get(opts, :iterations, 20))
+    :ok
+  end
+
+  @doc """
+  Add vectors to the index.
+
+  ## Args
+    * `index` (`ExTorch.VectorIndex`) - the index.
+    * `vectors` (`ExTorch.Tensor`) - a `[n, dim]` tensor. Vectors are
+      converted to float32.
+
+  ## Returns
+  The range of ids assigned to the vectors.
+  """
+  @spec add(t(), ExTorch.Tensor.t()) :: Range.t()
+  def add(index, %ExTorch.Tensor{size: {n, _}} = vectors) do
+    first = ExTorch.Native.vector_index_add(index, vectors)
+    first..(first + n - 1)//1
+  end
+
+  @doc """
+  Search the `k` nearest neighbours of every query.
+
+  ## Args
+    * `index` (`ExTorch.VectorIndex`) - the index.
+    * `queries` (`ExTorch.Tensor`) - a `[q, dim]` tensor.
+    * `k` (`integer`) - the number of neighbours per query.
+    * `opts` (`keyword`) - optional arguments:
+      * `:nprobe` (`integer`) - IVF only, overrides the index `:nprobe`.
+      * `:ef_search` (`integer`) - HNSW only, overrides the index `:ef_search`.
+
+  ## Returns
+  A `{scores, ids}` tuple of `[q, k]` tensors, closest first. Scores are
+  squared distances for `:l2` and inner products for `:ip`. When fewer than
+  `k` neighbours are found, the remaining ids are `-1`.
+  """
+  @spec search(t(), ExTorch.Tensor.t(), non_neg_integer(), keyword()) ::
+          {ExTorch.Tensor.t(), ExTorch.Tensor.t()}
+  def search(index, queries, k, opts \\ []) do
+    effort = Keyword.get(opts, :nprobe) || Keyword.get(opts, :ef_search) || 0
+    ExTorch.Native.vector_index_search(index, queries, k, effort)
+  end
+
+  @doc """
+  Number of vectors in the index.
+  """
+  @spec size(t()) :: non_neg_integer()
+  def size(index), do: ExTorch.Native.vector_index_size(index)
+
+  @doc """
+  Whether the index can accept vectors: IVF indices must be trained first.
+  """
+  @spec trained?(t()) :: boolean()
+  def trained?(index), do: ExTorch.Native.vector_index_is_trained(index)
+
+  @doc """
+  A `[size, dim]` float32 copy of the indexed vectors, where row `i` is the
+  vector with id `i`. Later calls to `add/2` do not change the result.
+  """
+  @spec vectors(t()) :: ExTorch.Tensor.t()
+  def vectors(index), do: ExTorch.Native.vector_index_vectors(index)
+
+  @doc """
+  Write the index to `path`.
+
+  The file is written to a temporary file next to `path`, unique to the
+  call, and renamed over `path` once complete, so readers never see a
+  partial file, concurrent saves do not interfere, and an index mapped from
+  `path` can be saved back to it.
+
+  ## Returns
+  `:ok`.
+  """
+  @spec save(t(), Path.t()) :: :ok
+  def save(index, path) do
+    ExTorch.Native.vector_index_save(index, Path.expand(path))
+    :ok
+  end
+
+  @doc """
+  Read an index written by `save/2`.
+
+  ## Args
+    * `path` (`Path.t()`) - the index file.
+    * `opts` (`keyword`) - optional arguments:
+      * `:mmap` (`boolean`) - map the vectors into memory instead of reading
+        them, so that they are paged in on demand. The mapping is private:
+        the file is never modified, and adding vectors copies them out.
+        Default: `false`.
+
+  ## Returns
+  An `ExTorch.VectorIndex`.
+  """
+  @spec load(Path.t(), keyword()) :: t()
+  def load(path, opts \\ []) do
+    ExTorch.Native.vector_index_load(Path.expand(path), Keyword.get(opts, :mmap, false))
+  end
+end
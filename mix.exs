@@ -172,10 +172,13 @@ defmodule ExTorch.MixProject do
         "Export Reader": [
           ExTorch.Export,
           ExTorch.Export.Model,
+          ExTorch.Export.Session,
+          ExTorch.KVCache,
           ExTorch.Export.Server
         ],
         "Observability": [
           ExTorch.Metrics,
+          ExTorch.LoadTest,
           ExTorch.Observer.Dashboard
         ],
         "Exchange types": [
@@ -0,0 +1,185 @@
+//! Native benchmark of the compiled graph executor.
+//!
+//! Replays a dump written by `ExTorch.Export.dump_compiled/3` (a compiled
+//! graph, its weights and a set of inputs) in a tight loop, without the
+//! BEAM, and reports the latency distribution of a forward pass, the
+//! CPU allocations it makes and the time spent in each op:
+//!
+//! ```text
+//! cargo bench --bench graph_executor -- <dump> [--warmup N] [--iterations N] [--top N]
+//! ```
+//!
+//! Comparing these numbers with the Elixir benchmarks under `bench/` tells
+//! executor regressions apart from BEAM-side ones.
+
+use extorch::torch;
+
+struct Options {
+    path: String,
+    warmup: u64,
+    iterations: u64,
+    top: usize,
+}
+
+fn usage() -> ! {
+    eprintln!(
+        "usage: graph_executor <dump> [--warmup N] [--iterations N] [--top N]\n\
+         Write a dump with ExTorch.Export.dump_compiled/3."
+    );
+    std::process::exit(2)
+}
+
+fn parse_args() -> Options {
+    let mut options = Options {
+        path: String::new(),
+        warmup: 20,
+        iterations: 200,
+        top: 15,
+    };
+
+    let mut args = std::env::args().skip(1);
+    while let Some(arg) = args.next() {
+        let mut value = || {
+            args.next()
+                .and_then(|v| v.parse::<u64>().ok())
+                .unwrap_or_else(|| usage())
+        };
+        match arg.as_str() {
+            "--warmup" => options.warmup = value(),
+            "--iterations" => options.iterations = value().max(1),
+            "--top" => options.top = value() as usize,
+            // Passed by `cargo bench` to every bench target.
+            "--bench" => {}
+            "-h" | "--help" => usage(),
+            _ if options.path.is_empty() && !arg.starts_with("--") => options.path = arg,
+            _ => usage(),
+        }
+    }
+    if options.path.is_empty() {
+        usage();
+    }
+    options
+}
+
+/// A fresh list of the dumped inputs for one call (cxx lists are moved).
+fn inputs(dump: &torch::CompiledGraphDump) -> torch::TensorList {
+    let values = dump
+        .inputs
+        .values
+        .iter()
+        .map(|t| torch::TensorOut {
+            tensor: t.tensor.clone(),
+            used: true,
+        })
+        .collect();
+    torch::TensorList { values, used: true }
+}
+
+/// Nearest-rank percentile of sorted samples.
+fn percentile(sorted: &[i64], quantile: f64) -> i64 {
+    let rank = (quantile * sorted.len() as f64).ceil() as usize;
+    sorted[rank.clamp(1, sorted.len()) - 1]
+}
+
+fn format_ns(ns: i64) -> String {
+    if ns >= 1_000_000 {
+        format!("{:.3} ms", ns as f64 / 1e6)
+    } else if ns >= 1_000 {
+        format!("{:.2} us", ns as f64 / 1e3)
+    } else {
+        format!("{} ns", ns)
+    }
+}
+
+fn format_bytes(bytes: i64) -> String {
+    if bytes >= 1 << 20 {
+        format!("{:.2} MiB", bytes as f64 / (1 << 20) as f64)
+    } else if bytes >= 1 << 10 {
+        format!("{:.2} KiB", bytes as f64 / (1 << 10) as f64)
+    } else {
+        format!("{} B", bytes)
+    }
+}
+
+fn main() {
+    let options = parse_args();
+
+    let dump = torch::load_compiled_graph_dump(options.path.clone()).unwrap_or_else(|err| {
+        eprintln!("graph_executor: {}", err.what());
+        std::process::exit(1)
+    });
+
+    let result = torch::benchmark_compiled_graph(
+        &dump.graph,
+        inputs(&dump),
+        options.warmup,
+        options.iterations,
+    )
+    .unwrap_or_else(|err| {
+        eprintln!("graph_executor: {}", err.what());
+        std::process::exit(1)
+    });
+
+    let mut latencies = result.latencies_ns;
+    latencies.sort_unstable();
+    let total: i64 = latencies.iter().sum();
+
+    println!("graph dump     {}", options.path);
+    println!("libtorch       {}", torch::libtorch_version().unwrap_or_default());
+    println!("iterations     {} (+{} warmup)", options.iterations, options.warmup);
+    println!();
+    println!("forward latency");
+    println!("  mean         {}", format_ns(total / latencies.len() as i64));
+    println!("  min          {}", format_ns(latencies[0]));
+    for (label, quantile) in [("p50", 0.5), ("p90", 0.9), ("p99", 0.99), ("p999", 0.999)] {
+        println!("  {:<12} {}", label, format_ns(percentile(&latencies, quantile)));
+    }
+    println!("  max          {}", format_ns(latencies[latencies.len() - 1]));
+    println!();
+    println!("allocations per forward");
+    println!("  count        {}", result.allocations);
+    println!("  allocated    {}", format_bytes(result.allocated_bytes));
+    println!("  freed        {}", format_bytes(result.freed_bytes));
+
+    // The per-op breakdown comes from separate runs: profiling adds two
+    // clock reads and a sample write per op, kept out of the timings above.
+    // Per-op allocations are counted by the counting CPU allocator.
+    torch::cpu_memory_tracking(true);
+    let profile = torch::compiled_graph_profile_start(&dump.graph, 1 << 20)
+        .and_then(|_| {
+            for _ in 0..options.iterations {
+                torch::run_compiled_graph(&dump.graph, inputs(&dump))?;
+            }
+            torch::compiled_graph_profile_stop(&dump.graph)?;
+            torch::compiled_graph_profile_stats(&dump.graph)
+        })
+        .unwrap_or_else(|err| {
+            eprintln!("graph_executor: {}", err.what());
+            std::process::exit(1)
+        });
+
+    let mut targets = profile.targets;
+    targets.sort_unstable_by_key(|target| std::cmp::Reverse(target.total_ns));
+    let profiled_ns: i64 = targets.iter().map(|target| target.total_ns).sum::<i64>().max(1);
+
+    println!();
+    println!(
+        "per-op breakdown ({} profiled runs, {} samples, {} dropped)",
+        profile.runs, profile.samples, profile.dropped
+    );
+    println!(
+        "  {:<40} {:>8} {:>7} {:>12} {:>12} {:>12}",
+        "target", "count", "share", "p50", "p99", "allocated"
+    );
+    for target in targets.iter().take(options.top) {
+        println!(
+            "  {:<40} {:>8} {:>6.1}% {:>12} {:>12} {:>12}",
+            target.target,
+            target.count,
+            100.0 * target.total_ns as f64 / profiled_ns as f64,
+            format_ns(target.p50_ns),
+            format_ns(target.p99_ns),
+            format_bytes(target.allocated_bytes / target.count.max(1) as i64),
+        );
+    }
+}
@@ -374,6 +374,13 @@ fn main() {
         .file("src/csrc/aoti.cc")
         .file("src/csrc/ivalue_utils.cc")
         .file("src/csrc/dispatcher.cc")
+        .file("src/csrc/pinned_pool.cc")
+        .file("src/csrc/fused_pointwise.cc")
+        .file("src/csrc/top_k.cc")
+        .file("src/csrc/vector_index.cc")
+        .file("src/csrc/kv_cache.cc")
+        .file("src/csrc/tracing.cc")
+        .file("src/csrc/memory_stats.cc")
         .flag_if_supported("-std=c++17")
         // .flag_if_supported("-std=gnu++14")
         .define("_GLIBCXX_USE_CXX11_ABI", "1")
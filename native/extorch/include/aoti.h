@@ -1,6 +1,7 @@
 #pragma once
 #include "common.h"
 #include "utils.h"
+#include "memory_stats.h"
 
 #if !defined(TORCH_STABLE_ONLY) && !defined(TORCH_TARGET_VERSION) && !defined(C10_MOBILE) && !defined(ANDROID)
 #include <torch/csrc/inductor/aoti_package/model_package_loader.h>
@@ -12,6 +13,8 @@
 // Always define the struct so cxx bridge can reference it.
 // The loader pointer is null when AOTI is not available.
 struct CrossAOTILoaderImpl {
+    // CPU memory allocated by the forward passes of this model.
+    std::shared_ptr<MemoryAccount> memory = std::make_shared<MemoryAccount>();
 #if EXTORCH_AOTI_AVAILABLE
     std::unique_ptr<torch::inductor::AOTIModelPackageLoader> loader;
     CrossAOTILoaderImpl(std::unique_ptr<torch::inductor::AOTIModelPackageLoader> l)
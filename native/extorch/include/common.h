@@ -11,6 +11,14 @@ struct TorchSlice;
 struct TorchIndex;
 struct PrintOptions;
 struct SortResult;
+struct VectorIndexOptions;
+struct KVCacheOptions;
+struct KVCacheStats;
+struct GraphProfileStats;
+struct CompiledGraphDump;
+struct GraphBenchResult;
+struct CpuMemoryStats;
+struct ModelMemoryStats;
 struct OptionalInt;
 struct TensorOut;
 struct TensorTuple;
@@ -19,13 +27,24 @@ struct TensorOrInt;
 struct IntListOrInt;
 struct IValueNode;
 struct IValueFlat;
+struct IValuePacked;
 struct NamedTensor;
 using CrossTensor = torch::Tensor;
 struct CrossModuleImpl;
 using CrossModule = CrossModuleImpl;
 struct CrossNNModuleImpl;
 using CrossNNModule = CrossNNModuleImpl;
+struct CrossNNPipelineImpl;
+using CrossNNPipeline = CrossNNPipelineImpl;
 struct CrossAOTILoaderImpl;
 using CrossAOTILoader = CrossAOTILoaderImpl;
 struct CrossCompiledGraphImpl;
 using CrossCompiledGraph = CrossCompiledGraphImpl;
+struct CrossGraphSessionImpl;
+using CrossGraphSession = CrossGraphSessionImpl;
+struct CrossEncodedGraphImpl;
+using CrossEncodedGraph = CrossEncodedGraphImpl;
+struct CrossVectorIndexImpl;
+using CrossVectorIndex = CrossVectorIndexImpl;
+struct CrossKVCacheImpl;
+using CrossKVCache = CrossKVCacheImpl;
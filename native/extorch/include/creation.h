@@ -113,8 +113,15 @@ std::shared_ptr<CrossTensor> logspace(
     bool pin_memory,
     rust::String s_mem_fmt);
 
-std::shared_ptr<CrossTensor> tensor(
-    struct ScalarList list,
+std::shared_ptr<CrossTensor> tensor_buffer(
+    rust::Vec<int64_t> shape,
+    rust::String s_buffer_dtype,
+    bool pin_memory);
+
+uint8_t *tensor_buffer_data(const std::shared_ptr<CrossTensor> &buffer);
+
+std::shared_ptr<CrossTensor> tensor_from_buffer(
+    const std::shared_ptr<CrossTensor> &buffer,
     rust::String s_dtype,
     rust::String s_layout,
     struct Device s_device,
@@ -47,15 +47,123 @@ std::shared_ptr<CrossCompiledGraph> compile_graph(
     rust::Vec<rust::String> value_names,
     rust::Vec<rust::String> output_names);
 
+/// Compile a graph from packed bytecode (see dispatcher.cc for the layout).
+///
+/// Equivalent to compile_graph, but the instruction stream arrives as one
+/// binary with an op table, a string table and fixed-width records, which
+/// is parsed in place without allocating per instruction.
+std::shared_ptr<CrossCompiledGraph> compile_graph_bytecode(
+    rust::Slice<const uint8_t> code,
+    rust::Vec<rust::String> value_names,
+    rust::Vec<rust::String> output_names);
+
+/// Bind graph inputs (typically parameters and buffers) as constants owned
+/// by the graph, matched by name against `value_names` of compile_graph.
+///
+/// Returns a new compiled graph whose slots for `names` are preloaded on
+/// every run, so run_compiled_graph only takes the remaining inputs. The
+/// original graph is left unchanged.
+std::shared_ptr<CrossCompiledGraph> bind_graph_constants(
+    const std::shared_ptr<CrossCompiledGraph> &compiled,
+    rust::Vec<rust::String> names,
+    TensorList tensors);
+
+/// Names of the inputs run_compiled_graph still expects, in call order.
+rust::Vec<rust::String> compiled_graph_inputs(
+    const std::shared_ptr<CrossCompiledGraph> &compiled);
+
 /// Run a pre-compiled graph. Only passes tensors — all op resolution,
 /// arg templates, and index mapping were done at compile time.
 ///
 /// `tensors` must be in the same order as `value_names` passed to
-/// compile_graph.
+/// compile_graph, skipping any inputs bound with bind_graph_constants.
 TensorList run_compiled_graph(
     const std::shared_ptr<CrossCompiledGraph> &compiled,
     TensorList tensors);
 
+/// Create a session that runs `compiled` step by step, feeding output
+/// `state_outputs[i]` of each step back as input `state_inputs[i]` of the
+/// next one. `initial` holds the state of the first step (and after
+/// graph_session_reset).
+std::shared_ptr<CrossGraphSession> create_graph_session(
+    const std::shared_ptr<CrossCompiledGraph> &compiled,
+    rust::Vec<rust::String> state_inputs,
+    rust::Vec<uint64_t> state_outputs,
+    TensorList initial);
+
+/// Run one step of a session. `tensors` are the graph inputs not carried
+/// as state, in call order; the outputs not carried as state are returned.
+TensorList graph_session_step(
+    const std::shared_ptr<CrossGraphSession> &session,
+    TensorList tensors);
+
+/// Restore the initial state of a session.
+void graph_session_reset(const std::shared_ptr<CrossGraphSession> &session);
+
+/// Current state tensors of a session, in `state_inputs` order.
+TensorList graph_session_state(const std::shared_ptr<CrossGraphSession> &session);
+
+/// Start profiling the runs of a compiled graph: every op execution records
+/// its wall time, the bytes of its outputs and the CPU bytes allocated and
+/// freed on the running thread while it ran (counted only while CPU memory
+/// tracking is on) into a ring of `capacity` samples, allocated here.
+/// Restarting discards the previous samples. When profiling is off, runs
+/// only check a pointer.
+void compiled_graph_profile_start(
+    const std::shared_ptr<CrossCompiledGraph> &compiled,
+    uint64_t capacity);
+
+/// Stop profiling a compiled graph. The recorded samples are kept.
+void compiled_graph_profile_stop(
+    const std::shared_ptr<CrossCompiledGraph> &compiled);
+
+/// Aggregate the samples of the last profiling session per graph node and
+/// per op target. Throws if the graph was never profiled.
+GraphProfileStats compiled_graph_profile_stats(
+    const std::shared_ptr<CrossCompiledGraph> &compiled);
+
+/// Serialize a compiled graph so it can be cached across restarts.
+///
+/// Operator handles are stored by qualified name, together with the
+/// argument descriptors, slot assignments and literal values. The blob
+/// records `source_tag` (an opaque caller-chosen key, e.g. derived from the
+/// archive contents) and the libtorch version it was written by.
+rust::Vec<uint8_t> serialize_compiled_graph(
+    const std::shared_ptr<CrossCompiledGraph> &compiled,
+    uint64_t source_tag);
+
+/// Rebuild a compiled graph from serialize_compiled_graph output. Only the
+/// op schemas are looked up again. Throws if the blob is malformed, its
+/// `source_tag` differs or it was written by another libtorch version.
+std::shared_ptr<CrossCompiledGraph> deserialize_compiled_graph(
+    rust::Slice<const uint8_t> data,
+    uint64_t source_tag);
+
+/// Version string of the libtorch build the NIF is linked against.
+rust::String libtorch_version();
+
+/// Write a bound compiled graph, its constants and a set of inputs to
+/// `path`, for load_compiled_graph_dump.
+void dump_compiled_graph(
+    const std::shared_ptr<CrossCompiledGraph> &compiled,
+    TensorList inputs,
+    rust::String path);
+
+/// Read a dump_compiled_graph file: the graph comes back with its
+/// constants bound, next to the dumped inputs.
+CompiledGraphDump load_compiled_graph_dump(rust::String path);
+
+/// Run a compiled graph `warmup` times, then `iterations` more times timing
+/// each run, in a tight loop with no marshaling between runs. When an
+/// input is on CUDA, each timed run waits for the device to finish. CPU
+/// allocations are counted on one additional run, with CPU memory tracking
+/// turned on for its duration.
+GraphBenchResult benchmark_compiled_graph(
+    const std::shared_ptr<CrossCompiledGraph> &compiled,
+    TensorList inputs,
+    uint64_t warmup,
+    uint64_t iterations);
+
 /// Execute an entire computation graph in a single C++ call.
 ///
 /// The graph is encoded as a flat instruction stream using IValueNode with
@@ -78,3 +186,34 @@ IValueFlat execute_graph(
     rust::Vec<rust::String> initial_names,
     TensorList initial_tensors,
     rust::Vec<rust::String> output_names);
+
+// ============================================================================
+// Encoded Graph — decoded instruction stream reused across calls
+// ============================================================================
+
+/// Decode a graph instruction stream once for repeated execution.
+///
+/// Resolves every op schema (through the process-wide schema cache),
+/// interns value names to integer slots and fixes each op's argument
+/// order. Unlike compile_graph, values may be any IValue and outputs are
+/// returned as a flattened IValue tree, exactly as execute_graph does.
+///
+/// `graph` is the same instruction stream as execute_graph.
+/// `input_names` are the names bound to the tensors passed to
+///   run_encoded_graph, in order.
+/// `output_names` specifies which values to return.
+std::shared_ptr<CrossEncodedGraph> encode_graph(
+    rust::Vec<IValueNode> graph,
+    rust::Vec<rust::String> input_names,
+    rust::Vec<rust::String> output_names);
+
+/// Encode a graph from packed bytecode (same layout as compile_graph_bytecode).
+std::shared_ptr<CrossEncodedGraph> encode_graph_bytecode(
+    rust::Slice<const uint8_t> code,
+    rust::Vec<rust::String> input_names,
+    rust::Vec<rust::String> output_names);
+
+/// Run an encoded graph. `tensors` must match `input_names` of encode_graph.
+IValueFlat run_encoded_graph(
+    const std::shared_ptr<CrossEncodedGraph> &encoded,
+    TensorList tensors);
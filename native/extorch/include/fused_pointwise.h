@@ -0,0 +1,22 @@
+#pragma once
+#include "common.h"
+#include "utils.h"
+
+/// Evaluate a pointwise expression over broadcast inputs in a single call.
+///
+/// Registers are numbered: the `inputs` first, then the `consts`, then one
+/// per instruction. `program` is a flat list of `(opcode, a, b)` triples;
+/// each instruction reads registers `a` and `b` (`b` is ignored by unary
+/// ops) and writes the next register. The last instruction's register is
+/// the result. Integer and boolean inputs are promoted to the default
+/// floating point dtype.
+///
+/// For CPU float/double inputs that do not require grad, the whole program
+/// runs as one vectorized TensorIterator kernel over cache-sized blocks, so
+/// no intermediate tensor is ever materialized. Anything else (other
+/// devices or dtypes, autograd) falls back to one ATen call per
+/// instruction, still within the same NIF call.
+std::shared_ptr<CrossTensor> fused_pointwise(
+    TensorList inputs,
+    rust::Vec<double> consts,
+    rust::Vec<int64_t> program);
@@ -42,6 +42,12 @@ std::shared_ptr<CrossTensor> from_binary(
     rust::Vec<int64_t> shape,
     rust::String s_dtype);
 
+std::shared_ptr<CrossTensor> from_file(
+    rust::String path,
+    int64_t offset,
+    rust::Vec<int64_t> shape,
+    rust::String s_dtype);
+
 std::shared_ptr<CrossTensor> from_blob(
     int64_t ptr,
     rust::Vec<int64_t> shape,
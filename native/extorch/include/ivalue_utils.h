@@ -3,6 +3,7 @@
 
 struct IValueNode;
 struct IValueFlat;
+struct IValuePacked;
 
 /// Flatten a c10::IValue into a pre-order IValueFlat node list.
 ///
@@ -12,3 +13,13 @@ struct IValueFlat;
 /// This is the canonical serialization used for crossing the
 /// CXX bridge between Rust NIFs and C++ libtorch code.
 IValueFlat flatten_ivalue(const c10::IValue &ivalue);
+
+/// Encode a c10::IValue compactly for returning large structured results.
+///
+/// Uses the same tags as flatten_ivalue plus 11=int list, 12=float list,
+/// 13=bool list and 14-17 for dicts from str or int keys to int or float
+/// values. Nodes carry a tag and a single integer, and these lists and dicts
+/// are written as packed arrays, so results such as token id lists or
+/// per-class scores cost one array copy instead of one IValueNode per
+/// element. Tensors are passed by handle only.
+IValuePacked pack_ivalue(const c10::IValue &ivalue);
@@ -1,15 +1,19 @@
 #pragma once
 #include "common.h"
 #include "utils.h"
+#include "memory_stats.h"
 #include <torch/script.h>
 
 struct CrossModuleImpl {
     torch::jit::script::Module module;
+    // CPU memory allocated by the forward passes and method calls.
+    std::shared_ptr<MemoryAccount> memory = std::make_shared<MemoryAccount>();
     CrossModuleImpl(torch::jit::script::Module m) : module(std::move(m)) {}
 };
 
 struct IValueNode;
 struct IValueFlat;
+struct IValuePacked;
 struct NamedTensor;
 
 // Load/save
@@ -21,12 +25,13 @@ void jit_save(
     const std::shared_ptr<CrossModule> &module,
     rust::String path);
 
-// Forward pass / method invocation
-IValueFlat jit_forward(
+// Forward pass / method invocation. Results use the compact encoding
+// (see pack_ivalue in ivalue_utils.h).
+IValuePacked jit_forward(
     const std::shared_ptr<CrossModule> &module,
     TensorList inputs);
 
-IValueFlat jit_invoke_method(
+IValuePacked jit_invoke_method(
     const std::shared_ptr<CrossModule> &module,
     rust::String method_name,
     TensorList inputs);
@@ -56,6 +61,44 @@ std::shared_ptr<CrossModule> jit_to_device(
     const std::shared_ptr<CrossModule> &module,
     struct Device s_device);
 
+// Inference optimization
+struct JitExecutorOptions;
+
+// Freeze a copy of the module in eval mode: parameters and attributes are
+// inlined as constants, and conv-bn folding and dropout removal run. With
+// `optimize`, torch::jit::optimize_for_inference is applied on top.
+std::shared_ptr<CrossModule> jit_freeze(
+    const std::shared_ptr<CrossModule> &module,
+    bool optimize);
+
+// Process-wide graph executor settings (profiling executor, number of
+// profiling runs, fusion strategy and CPU fusers).
+JitExecutorOptions jit_get_executor_options();
+
+void jit_set_executor_options(JitExecutorOptions options);
+
+// In-place device/dtype migration. Parameters and buffers are converted
+// one at a time and swapped into the existing module (no clone), so peak
+// memory grows by at most one tensor. `s_dtype` may be empty to keep each
+// tensor's dtype; it only applies to floating point tensors.
+void jit_to_inplace(
+    const std::shared_ptr<CrossModule> &module,
+    struct Device s_device,
+    rust::String s_dtype,
+    bool non_blocking);
+
+// Qualified names of all parameters followed by all buffers.
+rust::Vec<rust::String> jit_state_names(
+    const std::shared_ptr<CrossModule> &module);
+
+// Convert a single parameter or buffer in place (see jit_to_inplace).
+void jit_state_to(
+    const std::shared_ptr<CrossModule> &module,
+    rust::String name,
+    struct Device s_device,
+    rust::String s_dtype,
+    bool non_blocking);
+
 // IValue flattening — see ivalue_utils.h for the shared implementation.
 
 // IR introspection
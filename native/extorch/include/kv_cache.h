@@ -0,0 +1,105 @@
+#pragma once
+#include "common.h"
+#include "utils.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+struct KVCacheOptions;
+struct KVCacheStats;
+
+// CrossKVCache is a paged key/value cache for decoder attention. Keys and
+// values of every layer live in two preallocated pools of fixed-size
+// blocks, `[num_layers, num_heads, num_blocks, block_size, head_dim]`.
+// A sequence owns a table of blocks, taken from the free list as it grows
+// and given back when it is freed, so sequences of any length share the
+// pools without fragmentation and appending a step writes only the new
+// tokens into their block. Attention reads the blocks of a sequence with a
+// single gather per pool, or in place when they are adjacent.
+//
+// Each layer of a sequence keeps its own length: a decoder step appends
+// to layer 0, then layer 1, and so on, and every layer sees the tokens
+// appended to it so far.
+//
+// Caches are also registered under an integer id, which the
+// `extorch::kv_cache_attention` op takes, so graphs run by the compiled
+// graph executor can attend through a cache.
+struct CrossKVCacheImpl {
+    struct Sequence {
+        std::vector<int64_t> blocks;
+        std::vector<int64_t> lengths;
+    };
+
+    int64_t id = -1;
+    int64_t num_layers;
+    int64_t num_heads;
+    int64_t head_dim;
+    int64_t block_size;
+    int64_t num_blocks;
+    torch::Tensor keys;
+    torch::Tensor values;
+
+    // Guarded by `mutex`.
+    std::vector<int64_t> free_blocks;
+    std::unordered_map<int64_t, Sequence> sequences;
+    int64_t next_sequence = 0;
+    int64_t peak_used_blocks = 0;
+    mutable std::mutex mutex;
+
+    ~CrossKVCacheImpl();
+};
+
+/// Preallocate a cache. `options.id` registers it under that id, or under
+/// a fresh one when negative; ids of live caches are unique.
+std::shared_ptr<CrossKVCache> kv_cache_new(KVCacheOptions options);
+
+/// Start an empty sequence and return its id.
+int64_t kv_cache_add_sequence(const std::shared_ptr<CrossKVCache> &cache);
+
+/// Free a sequence, returning its blocks to the pool.
+void kv_cache_free_sequence(const std::shared_ptr<CrossKVCache> &cache, int64_t sequence);
+
+/// Number of tokens appended to `layer` of a sequence.
+int64_t kv_cache_sequence_length(
+    const std::shared_ptr<CrossKVCache> &cache,
+    int64_t sequence,
+    int64_t layer);
+
+/// Append the `[num_heads, n, head_dim]` (or `[1, num_heads, n, head_dim]`)
+/// `key` and `value` of `n` new tokens to `layer` of a sequence, taking
+/// new blocks from the pool as needed. Throws, appending nothing, if the
+/// pool runs out of blocks.
+void kv_cache_append(
+    const std::shared_ptr<CrossKVCache> &cache,
+    int64_t sequence,
+    int64_t layer,
+    const std::shared_ptr<CrossTensor> &key,
+    const std::shared_ptr<CrossTensor> &value);
+
+/// The keys and values of `layer` of a sequence, copied out of its blocks
+/// as two `[1, num_heads, length, head_dim]` tensors.
+TensorList kv_cache_gather(
+    const std::shared_ptr<CrossKVCache> &cache,
+    int64_t sequence,
+    int64_t layer);
+
+/// Append `key` and `value` to `layer` of a sequence, then run
+/// at::scaled_dot_product_attention of the `[1, num_heads, n, head_dim]`
+/// `query` over every cached token. The `n` new tokens attend causally to
+/// each other. `scale` defaults to `1 / sqrt(head_dim)` when `has_scale`
+/// is false. The inputs are converted to the dtype and device of the pools
+/// and checked before anything is appended: on error the sequence is left
+/// unchanged.
+std::shared_ptr<CrossTensor> kv_cache_attention(
+    const std::shared_ptr<CrossKVCache> &cache,
+    int64_t sequence,
+    int64_t layer,
+    const std::shared_ptr<CrossTensor> &query,
+    const std::shared_ptr<CrossTensor> &key,
+    const std::shared_ptr<CrossTensor> &value,
+    double scale,
+    bool has_scale);
+
+/// Pool occupancy of a cache.
+KVCacheStats kv_cache_stats(const std::shared_ptr<CrossKVCache> &cache);
@@ -0,0 +1,90 @@
+#pragma once
+#include "common.h"
+#include "utils.h"
+
+#include <atomic>
+#include <vector>
+
+// CPU memory attributed to one model: the bytes handed out by the CPU
+// allocator on a thread running the model (inside a MemoryScope), until
+// they are freed, wherever that happens. Accounts are shared by all the
+// concurrent runs of a model and outlive it while its outputs are alive.
+struct MemoryAccount {
+    std::atomic<int64_t> live_bytes{0};
+    std::atomic<int64_t> peak_bytes{0};
+    std::atomic<int64_t> allocations{0};
+    std::atomic<int64_t> frees{0};
+    std::atomic<int64_t> requests{0};
+    std::atomic<int64_t> last_request_peak_bytes{0};
+    std::atomic<int64_t> max_request_peak_bytes{0};
+};
+
+// Set by the executors around a forward pass: while it is alive, CPU
+// allocations made on this thread are charged to `account`, and the peak
+// of the bytes the request holds at once is recorded when it ends.
+//
+// Does nothing while CPU memory tracking is off. Allocations made by
+// intra-op worker threads are only counted in the process-wide totals.
+class MemoryScope {
+public:
+    explicit MemoryScope(const std::shared_ptr<MemoryAccount> &account);
+    ~MemoryScope();
+
+    MemoryScope(const MemoryScope &) = delete;
+    MemoryScope &operator=(const MemoryScope &) = delete;
+
+    // Null when tracking was off as the scope was entered.
+    std::shared_ptr<MemoryAccount> account;
+    uint64_t request = 0;
+    int64_t live_bytes = 0;
+    int64_t peak_bytes = 0;
+    MemoryScope *previous;
+};
+
+// Counts the CPU allocations and frees made on this thread while it is
+// alive, for the per-op profiler of the compiled graph executor. Tallies
+// nest: when one ends, its counts are added to the enclosing one.
+//
+// Only the counting CPU allocator feeds tallies, so they count nothing
+// while CPU memory tracking is off.
+class AllocationTally {
+public:
+    AllocationTally();
+    ~AllocationTally();
+
+    AllocationTally(const AllocationTally &) = delete;
+    AllocationTally &operator=(const AllocationTally &) = delete;
+
+    int64_t allocations = 0;
+    int64_t allocated = 0;
+    int64_t freed = 0;
+    AllocationTally *previous;
+};
+
+/// Bytes of the distinct storages behind `tensors`, on any device. Used
+/// for the weight bytes of a model.
+int64_t storage_bytes(const std::vector<torch::Tensor> &tensors);
+
+/// Snapshot of a model account, with the bytes of its weights.
+ModelMemoryStats model_memory_stats(const MemoryAccount &account, int64_t weight_bytes);
+
+/// Route CPU allocations through the counting allocator (or back to the
+/// one it replaced). Only allocations made while it is installed are
+/// counted, and their frees are counted even after it is removed.
+void cpu_memory_tracking(bool enabled);
+
+/// Process-wide counters of the counting CPU allocator.
+CpuMemoryStats cpu_memory_stats();
+
+/// Restart the process-wide peak from the bytes currently live.
+void cpu_memory_reset_peak();
+
+/// Memory accounts of each kind of model, implemented by its executor.
+ModelMemoryStats compiled_graph_memory_stats(
+    const std::shared_ptr<CrossCompiledGraph> &compiled);
+
+ModelMemoryStats aoti_memory_stats(
+    const std::shared_ptr<CrossAOTILoader> &loader);
+
+ModelMemoryStats jit_memory_stats(
+    const std::shared_ptr<CrossModule> &module);
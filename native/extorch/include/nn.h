@@ -13,8 +13,28 @@ struct CrossNNModuleImpl {
         : module(std::move(m)), type_name(std::move(name)) {}
 };
 
+// CrossNNPipeline runs a fixed DAG of nn modules in a single call.
+// Values live in numbered slots: the pipeline inputs occupy the first
+// slots, and every step reads its inputs from earlier slots and writes its
+// outputs (tuple outputs flattened, e.g. LSTM -> output, h_n, c_n) to new
+// ones. Slots are released after their last reader.
+struct CrossNNPipelineImpl {
+    struct Step {
+        std::shared_ptr<CrossNNModule> module;
+        std::vector<size_t> inputs;
+        std::vector<size_t> outputs;
+        std::vector<size_t> release;
+    };
+
+    std::vector<Step> steps;
+    size_t num_inputs = 0;
+    size_t num_slots = 0;
+    std::vector<size_t> outputs;
+};
+
 struct CrossNNModuleRef;
 struct NNModuleParam;
+struct NNPipelineStep;
 
 // Layer factory functions
 std::shared_ptr<CrossNNModule> nn_linear(
@@ -136,10 +156,31 @@ void nn_copy_parameters(
     const std::shared_ptr<CrossNNModule> &dst,
     rust::Vec<NamedTensor> params);
 
+void nn_bind_parameters(
+    const std::shared_ptr<CrossNNModule> &dst,
+    rust::Vec<NamedTensor> params);
+
 std::shared_ptr<CrossNNModule> nn_to_device(
     const std::shared_ptr<CrossNNModule> &module,
     Device s_device);
 
+// Multi-input / multi-output forward (LSTM, GRU, MultiheadAttention).
+TensorList nn_forward_many(
+    const std::shared_ptr<CrossNNModule> &module,
+    TensorList inputs);
+
+// Whole-model pipelines
+std::shared_ptr<CrossNNPipeline> nn_pipeline_new(
+    rust::Vec<NNPipelineStep> steps,
+    uint64_t num_inputs,
+    rust::Vec<uint64_t> outputs);
+
+TensorList nn_pipeline_run(
+    const std::shared_ptr<CrossNNPipeline> &pipeline,
+    TensorList inputs);
+
+uint64_t nn_pipeline_num_steps(const std::shared_ptr<CrossNNPipeline> &pipeline);
+
 // ============================================================================
 // Direct ATen functional ops (Phase A)
 //
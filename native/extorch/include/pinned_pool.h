@@ -0,0 +1,33 @@
+#pragma once
+#include "common.h"
+#include "utils.h"
+
+struct PinnedPoolStats;
+
+/// Create a tensor from raw binary data, staging it in a block taken from
+/// the process-wide host buffer pool.
+///
+/// Blocks are bucketed by power-of-two capacity and returned to the pool
+/// when the tensor (and every view of it) is released. On hosts with CUDA
+/// the blocks are page-locked, so `to(..., non_blocking=true)` can overlap
+/// the host-to-device copy with compute; a released block is only reused
+/// once the copies enqueued from it on the device streams are done. On
+/// CPU-only hosts the pool still recycles pageable blocks, which keeps its
+/// behaviour observable.
+std::shared_ptr<CrossTensor> pinned_from_binary(
+    rust::Slice<const uint8_t> data,
+    rust::Vec<int64_t> shape,
+    rust::String s_dtype);
+
+/// Snapshot of the pool counters (allocations, reuse, cached/in-use bytes).
+PinnedPoolStats pinned_pool_stats();
+
+/// Release every cached (free) block back to the system allocator; blocks
+/// with copies in flight are freed by a later pool call once those are
+/// done. Returns the number of bytes removed from the cache.
+int64_t pinned_pool_empty_cache();
+
+/// Bound the number of bytes the pool keeps cached once blocks are freed.
+/// Blocks released above the limit are returned to the system allocator
+/// once their copies are done.
+void pinned_pool_set_max_cached_bytes(int64_t max_bytes);
@@ -8,23 +8,37 @@ std::shared_ptr<CrossTensor> real(
 std::shared_ptr<CrossTensor> imag(
     const std::shared_ptr<CrossTensor> &input);
 
-// Arithmetic
-std::shared_ptr<CrossTensor> add(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other, Scalar alpha);
-std::shared_ptr<CrossTensor> sub(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other, Scalar alpha);
-std::shared_ptr<CrossTensor> mul(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other);
-std::shared_ptr<CrossTensor> tensor_div(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other);
-std::shared_ptr<CrossTensor> neg(const std::shared_ptr<CrossTensor> &input);
-std::shared_ptr<CrossTensor> tensor_abs(const std::shared_ptr<CrossTensor> &input);
-std::shared_ptr<CrossTensor> pow_tensor(const std::shared_ptr<CrossTensor> &input, Scalar exponent);
-
-std::shared_ptr<CrossTensor> clamp(const std::shared_ptr<CrossTensor> &input, Scalar min_val, Scalar max_val);
+// Arithmetic. When `out` is used the result is written into it.
+std::shared_ptr<CrossTensor> add(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other, Scalar alpha, TensorOut out);
+std::shared_ptr<CrossTensor> sub(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other, Scalar alpha, TensorOut out);
+std::shared_ptr<CrossTensor> mul(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other, TensorOut out);
+std::shared_ptr<CrossTensor> tensor_div(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other, TensorOut out);
+std::shared_ptr<CrossTensor> neg(const std::shared_ptr<CrossTensor> &input, TensorOut out);
+std::shared_ptr<CrossTensor> tensor_abs(const std::shared_ptr<CrossTensor> &input, TensorOut out);
+std::shared_ptr<CrossTensor> pow_tensor(const std::shared_ptr<CrossTensor> &input, Scalar exponent, TensorOut out);
+std::shared_ptr<CrossTensor> clamp(const std::shared_ptr<CrossTensor> &input, Scalar min_val, Scalar max_val, TensorOut out);
 
 // Math
-std::shared_ptr<CrossTensor> tensor_exp(const std::shared_ptr<CrossTensor> &input);
-std::shared_ptr<CrossTensor> tensor_log(const std::shared_ptr<CrossTensor> &input);
-std::shared_ptr<CrossTensor> tensor_sqrt(const std::shared_ptr<CrossTensor> &input);
-std::shared_ptr<CrossTensor> tensor_sin(const std::shared_ptr<CrossTensor> &input);
-std::shared_ptr<CrossTensor> tensor_cos(const std::shared_ptr<CrossTensor> &input);
+std::shared_ptr<CrossTensor> tensor_exp(const std::shared_ptr<CrossTensor> &input, TensorOut out);
+std::shared_ptr<CrossTensor> tensor_log(const std::shared_ptr<CrossTensor> &input, TensorOut out);
+std::shared_ptr<CrossTensor> tensor_sqrt(const std::shared_ptr<CrossTensor> &input, TensorOut out);
+std::shared_ptr<CrossTensor> tensor_sin(const std::shared_ptr<CrossTensor> &input, TensorOut out);
+std::shared_ptr<CrossTensor> tensor_cos(const std::shared_ptr<CrossTensor> &input, TensorOut out);
+
+// In-place variants: modify and return `input`.
+std::shared_ptr<CrossTensor> add_(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other, Scalar alpha);
+std::shared_ptr<CrossTensor> sub_(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other, Scalar alpha);
+std::shared_ptr<CrossTensor> mul_(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other);
+std::shared_ptr<CrossTensor> tensor_div_(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other);
+std::shared_ptr<CrossTensor> neg_(const std::shared_ptr<CrossTensor> &input);
+std::shared_ptr<CrossTensor> tensor_abs_(const std::shared_ptr<CrossTensor> &input);
+std::shared_ptr<CrossTensor> pow_tensor_(const std::shared_ptr<CrossTensor> &input, Scalar exponent);
+std::shared_ptr<CrossTensor> clamp_(const std::shared_ptr<CrossTensor> &input, Scalar min_val, Scalar max_val);
+std::shared_ptr<CrossTensor> tensor_exp_(const std::shared_ptr<CrossTensor> &input);
+std::shared_ptr<CrossTensor> tensor_log_(const std::shared_ptr<CrossTensor> &input);
+std::shared_ptr<CrossTensor> tensor_sqrt_(const std::shared_ptr<CrossTensor> &input);
+std::shared_ptr<CrossTensor> tensor_sin_(const std::shared_ptr<CrossTensor> &input);
+std::shared_ptr<CrossTensor> tensor_cos_(const std::shared_ptr<CrossTensor> &input);
 
 // Linear algebra
 std::shared_ptr<CrossTensor> matmul(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other);
@@ -39,6 +53,7 @@ std::shared_ptr<CrossTensor> masked_fill(const std::shared_ptr<CrossTensor> &inp
 std::shared_ptr<CrossTensor> contiguous(const std::shared_ptr<CrossTensor> &input);
 std::shared_ptr<CrossTensor> clone(const std::shared_ptr<CrossTensor> &input);
 std::shared_ptr<CrossTensor> detach(const std::shared_ptr<CrossTensor> &input);
+std::shared_ptr<CrossTensor> copy_(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &src, bool non_blocking);
 std::shared_ptr<CrossTensor> view(const std::shared_ptr<CrossTensor> &input, rust::Vec<int64_t> shape);
 std::shared_ptr<CrossTensor> expand(const std::shared_ptr<CrossTensor> &input, rust::Vec<int64_t> shape);
 
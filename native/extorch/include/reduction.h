@@ -12,11 +12,11 @@ std::shared_ptr<CrossTensor> any(
 
 std::shared_ptr<CrossTensor> argmax(
         const std::shared_ptr<CrossTensor> &input,
-        OptionalInt opt_dim, bool keepdim);
+        OptionalInt opt_dim, bool keepdim, TensorOut opt_out);
 
 std::shared_ptr<CrossTensor> argmin(
         const std::shared_ptr<CrossTensor> &input,
-        OptionalInt opt_dim, bool keepdim);
+        OptionalInt opt_dim, bool keepdim, TensorOut opt_out);
 
 TensorTuple max(
         const std::shared_ptr<CrossTensor> &input,
@@ -54,12 +54,14 @@ std::shared_ptr<CrossTensor> logsumexp(
 
 std::shared_ptr<CrossTensor> sum(
         const std::shared_ptr<CrossTensor> &input,
-        rust::Vec<int64_t> dims, bool keepdim
+        rust::Vec<int64_t> dims, bool keepdim,
+        TensorOut opt_out
 );
 
 std::shared_ptr<CrossTensor> nansum(
         const std::shared_ptr<CrossTensor> &input,
-        rust::Vec<int64_t> dims, bool keepdim
+        rust::Vec<int64_t> dims, bool keepdim,
+        TensorOut opt_out
 );
 
 std::shared_ptr<CrossTensor> mean(
@@ -91,7 +93,7 @@ TensorTuple mode(
 
 std::shared_ptr<CrossTensor> prod(
         const std::shared_ptr<CrossTensor> &input,
-        OptionalInt opt_dim, bool keepdim
+        OptionalInt opt_dim, bool keepdim, TensorOut opt_out
 );
 
 std::shared_ptr<CrossTensor> quantile(
@@ -0,0 +1,57 @@
+#pragma once
+#include "common.h"
+#include "utils.h"
+
+struct SortResult;
+
+/// Select the `k` largest (or smallest) values of `input` along `dim`,
+/// splitting each row into blocks of `chunk_size` elements that are scanned
+/// in parallel, each thread keeping its own bounded heap, and merging the
+/// per-thread candidates at the end.
+///
+/// Intended for a few very long rows (millions of scores), where
+/// `torch::topk` only parallelizes across rows. Results are always sorted.
+/// Rows too short to split, non-CPU tensors, tensors that require grad and
+/// unsupported dtypes are forwarded to `torch::topk`.
+SortResult chunked_topk(
+    const std::shared_ptr<CrossTensor> &input,
+    int64_t k,
+    int64_t dim,
+    bool largest,
+    int64_t chunk_size);
+
+/// Top-k of the scores `query @ keys.T` without materializing them.
+///
+/// `query` is `[q, d]` and `keys` `[n, d]`. Keys are scored `chunk_size` rows
+/// at a time (in parallel on CPU), and only each block's top-k candidates
+/// are kept. Returns `[q, k]` values and indices into `keys`.
+SortResult topk_matmul(
+    const std::shared_ptr<CrossTensor> &query,
+    const std::shared_ptr<CrossTensor> &keys,
+    int64_t k,
+    bool largest,
+    int64_t chunk_size);
+
+/// Fold one chunk of scores into a running top-k along the last dimension.
+///
+/// `state` holds the current values and indices (or is unused for the
+/// first chunk). The chunk's indices are shifted by `offset`, the chunk
+/// position in the full score row, before merging.
+SortResult topk_merge(
+    SortResult state,
+    const std::shared_ptr<CrossTensor> &chunk,
+    int64_t offset,
+    int64_t k,
+    bool largest);
+
+/// Whether `chunked_topk` would split rows of `input` along `dim`, rather
+/// than forward to `torch::topk`.
+bool use_chunked_topk(const torch::Tensor &input, int64_t k, int64_t dim, int64_t chunk_size);
+
+/// Whether `topk` (without `out` tensors) hands `input` to `chunked_topk`
+/// with the default `chunk_size`: the rows must be long enough to split and
+/// fewer than the intra-op threads.
+bool topk_chunked_path(const std::shared_ptr<CrossTensor> &input, int64_t k, int64_t dim);
+
+/// Default `chunk_size`: 64K elements, a few hundred KB that stay in L2.
+constexpr int64_t kTopKChunkSize = 1 << 16;
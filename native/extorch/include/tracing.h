@@ -0,0 +1,39 @@
+#pragma once
+#include "common.h"
+#include "utils.h"
+
+/// Run `requests` forward passes of a model under the Kineto profiler (CPU
+/// activities) and write the result to `path` as a Chrome trace, viewable
+/// in chrome://tracing or Perfetto.
+///
+/// Every request runs inside a `request#<i>` record_function range, and
+/// the ops of a compiled graph inside a range named after their graph
+/// node. The passes run back to back on the calling thread, which is the
+/// one the profiler is enabled on; ops on intra-op threads are recorded
+/// too. `record_shapes` adds the input shapes of every op and
+/// `profile_memory` the allocator events.
+void trace_compiled_graph(
+    const std::shared_ptr<CrossCompiledGraph> &compiled,
+    TensorList inputs,
+    int64_t requests,
+    rust::String path,
+    bool record_shapes,
+    bool profile_memory);
+
+/// Same as trace_compiled_graph, for aoti_forward.
+void trace_aoti(
+    const std::shared_ptr<CrossAOTILoader> &loader,
+    TensorList inputs,
+    int64_t requests,
+    rust::String path,
+    bool record_shapes,
+    bool profile_memory);
+
+/// Same as trace_compiled_graph, for jit_forward.
+void trace_jit(
+    const std::shared_ptr<CrossModule> &module,
+    TensorList inputs,
+    int64_t requests,
+    rust::String path,
+    bool record_shapes,
+    bool profile_memory);
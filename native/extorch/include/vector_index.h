@@ -0,0 +1,113 @@
+#pragma once
+#include "common.h"
+#include "utils.h"
+
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+struct SortResult;
+struct VectorIndexOptions;
+
+// CrossVectorIndex is an approximate nearest-neighbour index over float32
+// vectors. The vectors themselves live in `storage`, a `[capacity, dim]`
+// tensor whose first `count` rows are the indexed vectors (row i has id i),
+// so they can be handed back to Elixir as an ordinary tensor view.
+//
+// Two index structures are supported:
+//   * IVF-flat: vectors are assigned to the nearest of `nlist` k-means
+//     centroids, and a search scans the lists of the `nprobe` centroids
+//     closest to the query.
+//   * HNSW: a hierarchical proximity graph with at most `m` links per node
+//     (2 * m on the bottom layer), searched greedily with a beam of
+//     `ef_search` candidates.
+//
+// Searches take a shared lock and run queries in parallel; inserts take an
+// exclusive lock.
+struct CrossVectorIndexImpl {
+    enum class Kind : int64_t { IVFFlat = 0, HNSW = 1 };
+    enum class Metric : int64_t { L2 = 0, InnerProduct = 1 };
+
+    Kind kind;
+    Metric metric;
+    int64_t dim;
+    int64_t count = 0;
+    torch::Tensor storage;
+
+    // IVF-flat
+    int64_t nlist = 0;
+    int64_t nprobe = 0;
+    torch::Tensor centroids;
+    std::vector<std::vector<int64_t>> lists;
+
+    // HNSW
+    int64_t m = 0;
+    int64_t ef_construction = 0;
+    int64_t ef_search = 0;
+    int64_t max_level = -1;
+    int64_t entry_point = -1;
+    std::vector<int64_t> levels;
+    std::vector<std::vector<std::vector<int64_t>>> links;
+
+    int64_t seed = 0;
+    std::mt19937_64 rng;
+
+    mutable std::shared_mutex mutex;
+
+    const float *row(int64_t id) const {
+        return storage.data_ptr<float>() + id * dim;
+    }
+};
+
+/// Create an empty index. `options.kind` is `"ivf_flat"` or `"hnsw"` and
+/// `options.metric` is `"l2"` (squared euclidean distance) or `"ip"`
+/// (inner product).
+std::shared_ptr<CrossVectorIndex> vector_index_new(VectorIndexOptions options);
+
+/// Train the IVF centroids with k-means over the `[s, dim]` `sample`
+/// (`s >= nlist`). A no-op for HNSW indices.
+void vector_index_train(
+    const std::shared_ptr<CrossVectorIndex> &index,
+    const std::shared_ptr<CrossTensor> &sample,
+    int64_t iterations);
+
+/// Append the `[n, dim]` `vectors` to the index, returning the id of the
+/// first one; the others follow consecutively.
+int64_t vector_index_add(
+    const std::shared_ptr<CrossVectorIndex> &index,
+    const std::shared_ptr<CrossTensor> &vectors);
+
+/// Search the `k` nearest neighbours of every row of the `[q, dim]`
+/// `queries`. `effort` overrides `nprobe` (IVF) or `ef_search` (HNSW) when
+/// positive.
+///
+/// Returns `[q, k]` scores and ids, best first. Scores are squared
+/// distances for L2 and inner products for IP; slots without a neighbour
+/// have id -1.
+SortResult vector_index_search(
+    const std::shared_ptr<CrossVectorIndex> &index,
+    const std::shared_ptr<CrossTensor> &queries,
+    int64_t k,
+    int64_t effort);
+
+/// Number of vectors in the index.
+int64_t vector_index_size(const std::shared_ptr<CrossVectorIndex> &index);
+
+/// Whether the index can accept vectors (IVF indices must be trained).
+bool vector_index_is_trained(const std::shared_ptr<CrossVectorIndex> &index);
+
+/// The options the index was created with.
+VectorIndexOptions vector_index_options(const std::shared_ptr<CrossVectorIndex> &index);
+
+/// A `[size, dim]` copy of the indexed vectors.
+std::shared_ptr<CrossTensor> vector_index_vectors(const std::shared_ptr<CrossVectorIndex> &index);
+
+/// Write the index to `path`. The vectors are stored as a raw, 64-byte
+/// aligned float32 block so that `vector_index_load` can map them.
+void vector_index_save(const std::shared_ptr<CrossVectorIndex> &index, rust::String path);
+
+/// Read an index written by `vector_index_save`. With `mmap`, the vector
+/// block is mapped copy-on-write instead of read into memory, and is only
+/// copied out when vectors are added.
+std::shared_ptr<CrossVectorIndex> vector_index_load(rust::String path, bool mmap);
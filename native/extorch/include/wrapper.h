@@ -12,3 +12,10 @@
 #include "aoti.h"
 #include "ivalue_utils.h"
 #include "dispatcher.h"
+#include "pinned_pool.h"
+#include "fused_pointwise.h"
+#include "top_k.h"
+#include "vector_index.h"
+#include "kv_cache.h"
+#include "tracing.h"
+#include "memory_stats.h"
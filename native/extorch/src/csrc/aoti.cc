@@ -25,6 +25,7 @@ TensorList aoti_forward(
     const std::shared_ptr<CrossAOTILoader> &loader,
     TensorList inputs)
 {
+    MemoryScope memory_scope(loader->memory);
     auto input_tensors = unpack_tensor_list(inputs);
     auto outputs = loader->loader->run(input_tensors);
     return pack_tensor_list(outputs);
@@ -65,6 +66,16 @@ rust::Vec<rust::String> aoti_get_constant_fqns(
     return result;
 }
 
+ModelMemoryStats aoti_memory_stats(
+    const std::shared_ptr<CrossAOTILoader> &loader)
+{
+    std::vector<torch::Tensor> weights;
+    for (const auto &constant : loader->loader->get_runner()->extract_constants_map(false)) {
+        weights.push_back(constant.second);
+    }
+    return model_memory_stats(*loader->memory, storage_bytes(weights));
+}
+
 #else
 
 std::shared_ptr<CrossAOTILoader> aoti_load(rust::String, rust::String, int64_t) {
@@ -82,5 +93,8 @@ rust::String aoti_get_metadata_value(const std::shared_ptr<CrossAOTILoader>&, ru
 rust::Vec<rust::String> aoti_get_constant_fqns(const std::shared_ptr<CrossAOTILoader>&) {
     throw std::runtime_error("AOTI support is not available");
 }
+ModelMemoryStats aoti_memory_stats(const std::shared_ptr<CrossAOTILoader>&) {
+    throw std::runtime_error("AOTI support is not available");
+}
 
 #endif
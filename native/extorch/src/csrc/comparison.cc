@@ -1,5 +1,6 @@
 #include "extorch/src/native.rs.h"
 #include "extorch/include/comparison.h"
+#include "extorch/include/top_k.h"
 
 bool allclose(
         const std::shared_ptr<CrossTensor> &input,
@@ -346,6 +347,11 @@ SortResult topk(
     CrossTensor indices_tensor;
 
     CrossTensor in_tensor = *input.get();
+    if(!out_r.used && topk_chunked_path(input, k, dim)) {
+        // A few very long rows: scan them in parallel blocks instead.
+        return chunked_topk(input, k, dim, largest, kTopKChunkSize);
+    }
+
     if(out_r.used) {
         values_tensor = *out_r.values.get();
         indices_tensor = *out_r.indices.get();
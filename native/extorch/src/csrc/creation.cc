@@ -192,8 +192,24 @@ std::shared_ptr<CrossTensor> logspace(
     return std::make_shared<CrossTensor>(std::move(tensor));
 }
 
-std::shared_ptr<CrossTensor> tensor(
-    ScalarList list,
+std::shared_ptr<CrossTensor> tensor_buffer(
+    rust::Vec<int64_t> shape,
+    rust::String s_buffer_dtype,
+    bool pin_memory)
+{
+    std::string buffer_dtype(s_buffer_dtype);
+    torch::Tensor buffer = torch::empty(
+        torch::IntArrayRef{shape.data(), shape.size()},
+        torch::TensorOptions().dtype(type_mapping[buffer_dtype]).pinned_memory(pin_memory));
+    return std::make_shared<CrossTensor>(std::move(buffer));
+}
+
+uint8_t *tensor_buffer_data(const std::shared_ptr<CrossTensor> &buffer) {
+    return static_cast<uint8_t *>(buffer->data_ptr());
+}
+
+std::shared_ptr<CrossTensor> tensor_from_buffer(
+    const std::shared_ptr<CrossTensor> &buffer,
     rust::String s_dtype,
     rust::String s_layout,
     struct Device s_device,
@@ -202,25 +218,13 @@ std::shared_ptr<CrossTensor> tensor(
     rust::String s_mem_fmt
 )
 {
-    const int64_t *ptr = list.size.data();
     torch::TensorOptions opts = get_tensor_options(s_dtype, s_layout, s_device, requires_grad, pin_memory, s_mem_fmt);
-    auto scalar_type = opts.dtype().toScalarType();
-    torch::detail::TensorDataContainer scalar_list;
-
-    if(torch::isComplexType(scalar_type)) {
-        scalar_list = get_complex_tensor_parts(std::move(list.list), scalar_type, opts, ptr);
-    } else {
-        scalar_list = get_scalar_list(std::move(list.list));
-    }
-
-    opts = opts.requires_grad(torch::nullopt);
-    torch::Tensor tensor = torch::tensor(scalar_list, opts);
-    torch::Tensor reshaped_tensor = tensor;
-    if(tensor.numel() > 0) {
-        reshaped_tensor = tensor.reshape(torch::IntArrayRef{ptr, list.size.size()}).contiguous();
-        reshaped_tensor.set_requires_grad(requires_grad);
-    }
-    return std::make_shared<CrossTensor>(std::move(reshaped_tensor));
+
+    // No forced copy: when the buffer already has the requested dtype and
+    // device, it is returned as the tensor.
+    torch::Tensor tensor = buffer->to(opts.requires_grad(torch::nullopt), false, false);
+    tensor.set_requires_grad(requires_grad);
+    return std::make_shared<CrossTensor>(std::move(tensor));
 }
 
 std::shared_ptr<CrossTensor> complex(
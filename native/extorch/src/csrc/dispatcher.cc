@@ -1,9 +1,25 @@
 #include "extorch/src/native.rs.h"
 #include "extorch/include/dispatcher.h"
 #include "extorch/include/ivalue_utils.h"
+#include "extorch/include/memory_stats.h"
 
 #include <ATen/core/dispatch/Dispatcher.h>
+#include <ATen/record_function.h>
+#include <torch/csrc/jit/serialization/pickle.h>
+#include <torch/version.h>
 #include <dlfcn.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <shared_mutex>
+#include <string_view>
 
 // ============================================================================
 // Library loading
@@ -215,6 +231,237 @@ rust::Vec<rust::String> list_registered_ops(rust::String ns_prefix) {
     return result;
 }
 
+// ============================================================================
+// Schema cache — resolved operator handles shared by all graph executors
+// ============================================================================
+
+// Keyed by the interned "target.overload" string. Only successful lookups
+// are cached, so ops registered later through load_torch_library still
+// resolve. Handles stay valid while their op is registered, and op
+// libraries are never unloaded.
+static std::shared_mutex schema_cache_mutex;
+static std::unordered_map<std::string, c10::OperatorHandle> schema_cache;
+
+static c10::OperatorHandle resolve_schema(
+    const std::string &target,
+    const std::string &overload,
+    const char *caller)
+{
+    std::string key = target + "." + overload;
+    {
+        std::shared_lock<std::shared_mutex> lock(schema_cache_mutex);
+        auto it = schema_cache.find(key);
+        if (it != schema_cache.end()) {
+            return it->second;
+        }
+    }
+
+    auto &dispatcher = c10::Dispatcher::singleton();
+    auto schema = dispatcher.findSchema({target.c_str(), overload.c_str()});
+    if (!schema.has_value() && overload == "default") {
+        schema = dispatcher.findSchema({target.c_str(), ""});
+    }
+    if (!schema.has_value()) {
+        throw std::runtime_error(
+            std::string(caller) + ": no schema for " + target + "." + overload);
+    }
+
+    std::unique_lock<std::shared_mutex> lock(schema_cache_mutex);
+    schema_cache.emplace(std::move(key), *schema);
+    return *schema;
+}
+
+// ============================================================================
+// Instruction views — one decoded form for every graph transport
+// ============================================================================
+
+// A borrowed view of one graph instruction. Both the IValueNode stream
+// and packed bytecode are turned into these, so the executors below read
+// a single representation. Strings point into the caller's buffers and
+// are only valid for the duration of the call.
+struct InstView {
+    int64_t tag = 5;
+    int64_t int_val = 0;
+    double float_val = 0.0;
+    bool bool_val = false;
+    std::string_view str;
+    int64_t child_count = 0;
+    const CrossTensor *tensor = nullptr;
+};
+
+static std::string_view as_view(const rust::String &s) {
+    return std::string_view(s.data(), s.size());
+}
+
+static std::vector<InstView> view_nodes(const rust::Vec<IValueNode> &graph) {
+    std::vector<InstView> views;
+    views.reserve(graph.size());
+    for (const auto &node : graph) {
+        InstView v;
+        v.tag = node.tag;
+        v.int_val = node.int_val;
+        v.float_val = node.float_val;
+        v.bool_val = node.bool_val;
+        v.str = as_view(node.string_val);
+        v.child_count = node.child_count;
+        v.tensor = node.tensor.get();
+        views.push_back(v);
+    }
+    return views;
+}
+
+static std::vector<std::string_view> view_names(const rust::Vec<rust::String> &names) {
+    std::vector<std::string_view> views;
+    views.reserve(names.size());
+    for (const auto &name : names) {
+        views.push_back(as_view(name));
+    }
+    return views;
+}
+
+// Packed graph bytecode (all integers little-endian):
+//
+//   header   "EXTG" | u32 version | u64 source_tag |
+//            u32 n_strings | u32 n_ops | u32 n_records
+//   strings  n_strings x (u32 length | bytes)
+//   ops      n_ops x (u32 target string | u32 overload string)
+//   records  n_records x 16 bytes: u8 tag | 3 pad | u32 a | u64 b
+//
+// Record fields per tag:
+//   20 BEGIN_OP  a=op index       b=num_args
+//   21 OUTPUT    a=string index
+//   23 ARG_NAME  a=string index
+//   10 REF       a=string index
+//    1 INT                        b=value
+//    2 FLOAT                      b=IEEE-754 bits
+//    3 BOOL                       b=0|1
+//    4 STRING    a=string index
+//    5 NONE
+//    7 LIST                       b=child count
+//    9 DEVICE    a=string index   b=device index (-1 for none)
+//
+// `source_tag` is opaque to the native side; callers use it to validate
+// cached bytecode against its source archive. Inline tensors cannot be
+// encoded.
+namespace bytecode {
+
+constexpr uint32_t kVersion = 1;
+constexpr size_t kHeaderSize = 28;
+constexpr size_t kRecordSize = 16;
+
+static uint32_t read_u32(const uint8_t *p) {
+    return static_cast<uint32_t>(p[0]) |
+           (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static uint64_t read_u64(const uint8_t *p) {
+    return static_cast<uint64_t>(read_u32(p)) |
+           (static_cast<uint64_t>(read_u32(p + 4)) << 32);
+}
+
+[[noreturn]] static void malformed(const std::string &what) {
+    throw std::runtime_error("graph bytecode: " + what);
+}
+
+static std::vector<InstView> parse(rust::Slice<const uint8_t> code) {
+    const uint8_t *data = code.data();
+    const size_t size = code.size();
+
+    if (size < kHeaderSize || std::memcmp(data, "EXTG", 4) != 0) {
+        malformed("bad magic");
+    }
+    uint32_t version = read_u32(data + 4);
+    if (version != kVersion) {
+        malformed("unsupported version " + std::to_string(version));
+    }
+    uint32_t n_strings = read_u32(data + 16);
+    uint32_t n_ops = read_u32(data + 20);
+    uint32_t n_records = read_u32(data + 24);
+
+    size_t pos = kHeaderSize;
+    std::vector<std::string_view> strings;
+    strings.reserve(n_strings);
+    for (uint32_t i = 0; i < n_strings; i++) {
+        if (pos + 4 > size) malformed("truncated string table");
+        uint32_t len = read_u32(data + pos);
+        pos += 4;
+        if (pos + len > size) malformed("truncated string table");
+        strings.emplace_back(reinterpret_cast<const char *>(data + pos), len);
+        pos += len;
+    }
+
+    auto string_at = [&strings](uint32_t idx) {
+        if (idx >= strings.size()) malformed("string index out of range");
+        return strings[idx];
+    };
+
+    std::vector<std::pair<std::string_view, std::string_view>> ops;
+    ops.reserve(n_ops);
+    if (pos + static_cast<size_t>(n_ops) * 8 > size) malformed("truncated op table");
+    for (uint32_t i = 0; i < n_ops; i++) {
+        ops.emplace_back(string_at(read_u32(data + pos)), string_at(read_u32(data + pos + 4)));
+        pos += 8;
+    }
+
+    if (pos + static_cast<size_t>(n_records) * kRecordSize != size) {
+        malformed("record section size mismatch");
+    }
+
+    std::vector<InstView> views;
+    views.reserve(static_cast<size_t>(n_records) + n_ops);
+    for (uint32_t i = 0; i < n_records; i++, pos += kRecordSize) {
+        const uint8_t *rec = data + pos;
+        int64_t tag = rec[0];
+        uint32_t a = read_u32(rec + 4);
+        uint64_t b = read_u64(rec + 8);
+
+        InstView v;
+        v.tag = tag;
+        switch (tag) {
+        case 20: { // BEGIN_OP, followed by its OVERLOAD from the op table
+            if (a >= ops.size()) malformed("op index out of range");
+            v.str = ops[a].first;
+            v.child_count = static_cast<int64_t>(b);
+            views.push_back(v);
+            InstView ov;
+            ov.tag = 22;
+            ov.str = ops[a].second;
+            views.push_back(ov);
+            continue;
+        }
+        case 21: case 23: case 10: case 4:
+            v.str = string_at(a);
+            break;
+        case 1:
+            v.int_val = static_cast<int64_t>(b);
+            break;
+        case 2:
+            std::memcpy(&v.float_val, &b, sizeof(double));
+            break;
+        case 3:
+            v.bool_val = b != 0;
+            break;
+        case 5:
+            break;
+        case 7:
+            v.child_count = static_cast<int64_t>(b);
+            break;
+        case 9:
+            v.str = string_at(a);
+            v.int_val = static_cast<int64_t>(b);
+            break;
+        default:
+            malformed("unsupported record tag " + std::to_string(tag));
+        }
+        views.push_back(v);
+    }
+    return views;
+}
+
+} // namespace bytecode
+
 // ============================================================================
 // Graph executor — run an entire computation graph in a single C++ call
 // ============================================================================
@@ -224,55 +471,90 @@ constexpr int64_t TAG_TENSOR_REF = 10;   // Look up tensor by name in values map
 constexpr int64_t TAG_BEGIN_OP   = 20;   // Start of an op: string_val=target, child_count=num_args
 constexpr int64_t TAG_OUTPUT     = 21;   // Output name: string_val=name
 constexpr int64_t TAG_OVERLOAD   = 22;   // Overload name: string_val=overload
+constexpr int64_t TAG_ARG_NAME   = 23;   // Argument name: string_val=schema arg name
+
+// An argument of an encoded op. Refs are interned to value slots; lists
+// keep the typed-list choice made from their element tags at encode time.
+struct EncodedArg {
+    enum Kind { SLOT, LITERAL, TENSOR_LIST, INT_LIST, FLOAT_LIST,
+                BOOL_LIST, GENERIC_LIST };
+    Kind kind = LITERAL;
+    size_t slot = 0;                 // for SLOT
+    c10::IValue literal;             // for LITERAL
+    std::vector<int64_t> ints;       // for INT_LIST
+    std::vector<EncodedArg> items;   // for the remaining list kinds
+};
+
+struct EncodedOp {
+    c10::OperatorHandle handle;
+    // Arguments in stream order, followed by any schema defaults the
+    // name-based reordering had to insert.
+    std::vector<EncodedArg> args;
+    // For each stack position, the index into `args` to pass.
+    std::vector<size_t> plan;
+    std::vector<size_t> output_slots;
+};
 
 // Read one argument from the instruction stream.
 // Regular IValue tags (0-9) are handled as literals.
-// TAG_TENSOR_REF (10) looks up the name in the values map.
+// TAG_TENSOR_REF (10) is interned to the slot currently bound to the name.
 // TAG 7 (list) reads child_count sub-arguments.
-static c10::IValue read_arg(
-    const rust::Vec<IValueNode> &graph,
+static EncodedArg encode_arg(
+    const std::vector<InstView> &graph,
     size_t &pc,
-    const std::unordered_map<std::string, c10::IValue> &values)
+    const std::unordered_map<std::string_view, size_t> &name_to_slot)
 {
+    if (pc >= graph.size()) {
+        throw std::runtime_error("execute_graph: unexpected end of instruction stream");
+    }
     const auto &node = graph[pc];
     pc++;
 
+    EncodedArg arg;
     switch (node.tag) {
     case 0: // inline tensor
-        return c10::IValue(*node.tensor);
+        arg.literal = c10::IValue(*node.tensor);
+        break;
     case 1: // int
-        return c10::IValue(node.int_val);
+        arg.literal = c10::IValue(node.int_val);
+        break;
     case 2: // float
-        return c10::IValue(node.float_val);
+        arg.literal = c10::IValue(node.float_val);
+        break;
     case 3: // bool
-        return c10::IValue(node.bool_val);
+        arg.literal = c10::IValue(node.bool_val);
+        break;
     case 4: // string
-        return c10::IValue(std::string(node.string_val));
+        arg.literal = c10::IValue(std::string(node.str));
+        break;
     case 5: // none
-        return c10::IValue();
+        break;
     case 9: { // device
-        std::string dev_str(node.string_val);
-        if (node.int_val >= 0) {
-            return c10::IValue(c10::Device(dev_str + ":" + std::to_string(node.int_val)));
-        }
-        return c10::IValue(c10::Device(dev_str));
+        std::string dev_str(node.str);
+        arg.literal = (node.int_val >= 0)
+            ? c10::IValue(c10::Device(dev_str + ":" + std::to_string(node.int_val)))
+            : c10::IValue(c10::Device(dev_str));
+        break;
     }
-    case TAG_TENSOR_REF: { // look up tensor in values map
-        std::string ref(node.string_val);
-        auto it = values.find(ref);
-        if (it == values.end()) {
-            throw std::runtime_error("execute_graph: unknown ref '" + ref + "'");
+    case TAG_TENSOR_REF: {
+        auto it = name_to_slot.find(node.str);
+        if (it == name_to_slot.end()) {
+            throw std::runtime_error(
+                "execute_graph: unknown ref '" + std::string(node.str) + "'");
         }
-        return it->second;
+        arg.kind = EncodedArg::SLOT;
+        arg.slot = it->second;
+        break;
     }
-    case 7: { // list — create typed lists for the dispatcher
+    case 7: { // list — typed lists for the dispatcher
         if (node.child_count == 0) {
             // Empty list — the dispatcher typically expects int[] for
             // empty padding/stride args.
-            {
-                std::vector<int64_t> empty;
-                return c10::IValue(std::move(empty));
-            }
+            arg.kind = EncodedArg::INT_LIST;
+            break;
+        }
+        if (pc + static_cast<size_t>(node.child_count) > graph.size()) {
+            throw std::runtime_error("execute_graph: unexpected end of instruction stream");
         }
 
         // Peek at child tags to determine element type
@@ -284,245 +566,355 @@ static c10::IValue read_arg(
             }
         }
 
-        if (homogeneous && (first_tag == 0 || first_tag == TAG_TENSOR_REF)) {
-            c10::List<at::Tensor> tlist;
-            tlist.reserve(static_cast<size_t>(node.child_count));
+        if (homogeneous && first_tag == 1) {
+            arg.kind = EncodedArg::INT_LIST;
+            arg.ints.reserve(static_cast<size_t>(node.child_count));
             for (int64_t i = 0; i < node.child_count; i++) {
-                tlist.push_back(read_arg(graph, pc, values).toTensor());
-            }
-            return c10::IValue(std::move(tlist));
-        } else if (homogeneous && first_tag == 1) {
-            // Read raw int values directly into a vector, then move
-            // into IValue. This produces a proper IntList tag.
-            std::vector<int64_t> ivec;
-            ivec.reserve(static_cast<size_t>(node.child_count));
-            for (int64_t i = 0; i < node.child_count; i++) {
-                const auto &child = graph[pc];
+                arg.ints.push_back(graph[pc].int_val);
                 pc++;
-                ivec.push_back(child.int_val);
             }
-            return c10::IValue(std::move(ivec));
+            break;
+        }
+
+        if (homogeneous && (first_tag == 0 || first_tag == TAG_TENSOR_REF)) {
+            arg.kind = EncodedArg::TENSOR_LIST;
         } else if (homogeneous && first_tag == 2) {
-            c10::List<double> flist;
-            flist.reserve(static_cast<size_t>(node.child_count));
-            for (int64_t i = 0; i < node.child_count; i++) {
-                flist.push_back(read_arg(graph, pc, values).toDouble());
-            }
-            return c10::IValue(std::move(flist));
+            arg.kind = EncodedArg::FLOAT_LIST;
         } else if (homogeneous && first_tag == 3) {
-            c10::List<bool> blist;
-            blist.reserve(static_cast<size_t>(node.child_count));
-            for (int64_t i = 0; i < node.child_count; i++) {
-                blist.push_back(read_arg(graph, pc, values).toBool());
-            }
-            return c10::IValue(std::move(blist));
+            arg.kind = EncodedArg::BOOL_LIST;
         } else {
-            c10::impl::GenericList list(c10::AnyType::get());
-            for (int64_t i = 0; i < node.child_count; i++) {
-                list.push_back(read_arg(graph, pc, values));
-            }
-            return c10::IValue(std::move(list));
+            arg.kind = EncodedArg::GENERIC_LIST;
         }
+        arg.items.reserve(static_cast<size_t>(node.child_count));
+        for (int64_t i = 0; i < node.child_count; i++) {
+            arg.items.push_back(encode_arg(graph, pc, name_to_slot));
+        }
+        break;
     }
     default:
         throw std::runtime_error(
             "execute_graph: unknown arg tag " + std::to_string(node.tag));
     }
+    return arg;
 }
 
-IValueFlat execute_graph(
-    rust::Vec<IValueNode> graph,
-    rust::Vec<rust::String> initial_names,
-    TensorList initial_tensors,
-    rust::Vec<rust::String> output_names)
+// Build the runtime IValue for an encoded argument.
+static c10::IValue materialize_arg(
+    const EncodedArg &arg,
+    const std::vector<c10::IValue> &values)
 {
-    // Build the initial values map from names + tensors
-    auto tensors = unpack_tensor_list(std::move(initial_tensors));
-    std::unordered_map<std::string, c10::IValue> values;
-    values.reserve(initial_names.size());
-    for (size_t i = 0; i < initial_names.size() && i < tensors.size(); i++) {
-        values[std::string(initial_names[i])] = c10::IValue(tensors[i]);
+    switch (arg.kind) {
+    case EncodedArg::SLOT:
+        return values[arg.slot];
+    case EncodedArg::LITERAL:
+        return arg.literal;
+    case EncodedArg::TENSOR_LIST: {
+        c10::List<at::Tensor> tlist;
+        tlist.reserve(arg.items.size());
+        for (const auto &item : arg.items) {
+            tlist.push_back(materialize_arg(item, values).toTensor());
+        }
+        return c10::IValue(std::move(tlist));
+    }
+    case EncodedArg::INT_LIST: {
+        // Copy into a fresh vector so this produces a proper IntList tag.
+        std::vector<int64_t> ivec(arg.ints);
+        return c10::IValue(std::move(ivec));
+    }
+    case EncodedArg::FLOAT_LIST: {
+        c10::List<double> flist;
+        flist.reserve(arg.items.size());
+        for (const auto &item : arg.items) {
+            flist.push_back(item.literal.toDouble());
+        }
+        return c10::IValue(std::move(flist));
+    }
+    case EncodedArg::BOOL_LIST: {
+        c10::List<bool> blist;
+        blist.reserve(arg.items.size());
+        for (const auto &item : arg.items) {
+            blist.push_back(item.literal.toBool());
+        }
+        return c10::IValue(std::move(blist));
+    }
+    case EncodedArg::GENERIC_LIST: {
+        c10::impl::GenericList list(c10::AnyType::get());
+        for (const auto &item : arg.items) {
+            list.push_back(materialize_arg(item, values));
+        }
+        return c10::IValue(std::move(list));
     }
+    }
+    return c10::IValue();
+}
 
-    auto &dispatcher = c10::Dispatcher::singleton();
-    size_t pc = 0;
-    size_t op_count = 0;
-    const size_t max_ops = graph.size(); // safety bound
+struct CrossEncodedGraphImpl {
+    std::vector<EncodedOp> ops;
+    size_t num_inputs = 0;
+    size_t num_slots = 0;
+    std::vector<size_t> output_slots;
+    // A single requested output is returned bare, several as a tuple.
+    bool tuple_output = false;
 
-    while (pc < graph.size()) {
-        if (++op_count > max_ops) {
-            throw std::runtime_error(
-                "execute_graph: exceeded max op count (" + std::to_string(max_ops) +
-                "), likely infinite loop at pc=" + std::to_string(pc));
+    IValueFlat run(std::vector<CrossTensor> initial_tensors) const {
+        std::vector<c10::IValue> values(num_slots);
+        for (size_t i = 0; i < num_inputs && i < initial_tensors.size(); i++) {
+            values[i] = c10::IValue(std::move(initial_tensors[i]));
         }
 
-        const auto &inst = graph[pc];
+        for (const auto &op : ops) {
+            std::vector<c10::IValue> args;
+            args.reserve(op.plan.size());
+            for (auto idx : op.plan) {
+                args.push_back(materialize_arg(op.args[idx], values));
+            }
 
+            // Type coercion: adapt IValue types to match the schema.
+            const auto &schema_args = op.handle.schema().arguments();
+            for (size_t ai = 0; ai < args.size() && ai < schema_args.size(); ai++) {
+                const auto &expected = schema_args[ai].type();
+                if (expected->isSubtypeOf(*c10::TensorType::get())) {
+                    if (args[ai].isDouble()) {
+                        args[ai] = c10::IValue(at::scalar_to_tensor(args[ai].toDouble()));
+                    } else if (args[ai].isInt()) {
+                        args[ai] = c10::IValue(at::scalar_to_tensor(args[ai].toInt()));
+                    } else if (args[ai].isBool()) {
+                        args[ai] = c10::IValue(at::scalar_to_tensor(args[ai].toBool()));
+                    }
+                }
+                if (expected->kind() == c10::TypeKind::OptionalType) {
+                    auto inner = expected->cast<c10::OptionalType>()->getElementType();
+                    if (inner->isSubtypeOf(*c10::DeviceObjType::get()) && args[ai].isDevice()) {
+                        args[ai] = c10::IValue(args[ai].toDevice());
+                    }
+                }
+            }
+
+            op.handle.callBoxed(&args);
+
+            // Store results by slot index
+            if (args.size() == 1 && op.output_slots.size() == 1) {
+                values[op.output_slots[0]] = std::move(args[0]);
+            } else if (args.size() == 1 && args[0].isTuple()) {
+                // Multi-output op returns a tuple
+                auto tuple = args[0].toTuple();
+                for (size_t i = 0; i < op.output_slots.size() &&
+                     i < tuple->elements().size(); i++) {
+                    values[op.output_slots[i]] = tuple->elements()[i];
+                }
+            } else {
+                // Multiple stack returns
+                for (size_t i = 0; i < op.output_slots.size() && i < args.size(); i++) {
+                    values[op.output_slots[i]] = std::move(args[i]);
+                }
+            }
+        }
+
+        // Collect requested outputs
+        if (!tuple_output) {
+            if (output_slots.empty()) {
+                return IValueFlat{};
+            }
+            return flatten_ivalue(values[output_slots[0]]);
+        }
+        std::vector<c10::IValue> outputs;
+        outputs.reserve(output_slots.size());
+        for (auto s : output_slots) {
+            outputs.push_back(values[s]);
+        }
+        return flatten_ivalue(c10::IValue(
+            c10::ivalue::Tuple::create(std::move(outputs))));
+    }
+};
+
+// Decode an instruction stream once: resolve every op schema through the
+// cache, intern value names to slots and fix each op's argument order.
+static std::shared_ptr<CrossEncodedGraphImpl> encode_instructions(
+    const std::vector<InstView> &graph,
+    const std::vector<std::string_view> &input_names,
+    const std::vector<std::string_view> &output_names)
+{
+    auto encoded = std::make_shared<CrossEncodedGraphImpl>();
+
+    std::unordered_map<std::string_view, size_t> name_to_slot;
+    name_to_slot.reserve(input_names.size() + graph.size());
+    for (size_t i = 0; i < input_names.size(); i++) {
+        name_to_slot[input_names[i]] = i;
+    }
+    encoded->num_inputs = input_names.size();
+    size_t next_slot = input_names.size();
+
+    size_t pc = 0;
+    while (pc < graph.size()) {
+        const auto &inst = graph[pc];
         if (inst.tag != TAG_BEGIN_OP) {
             throw std::runtime_error(
                 "execute_graph: expected BEGIN_OP (tag=20) at pc=" + std::to_string(pc) +
                 " but got tag=" + std::to_string(inst.tag));
         }
 
-        std::string target(inst.string_val);
+        std::string target(inst.str);
         int64_t num_args = inst.child_count;
-        size_t pc_before = pc;
         pc++;
 
         // Read overload (must follow BEGIN_OP)
         std::string overload;
         if (pc < graph.size() && graph[pc].tag == TAG_OVERLOAD) {
-            overload = std::string(graph[pc].string_val);
+            overload = std::string(graph[pc].str);
             pc++;
         }
 
         // Collect output names (follow overload)
-        std::vector<std::string> out_names;
+        std::vector<std::string_view> out_names;
         while (pc < graph.size() && graph[pc].tag == TAG_OUTPUT) {
-            out_names.push_back(std::string(graph[pc].string_val));
+            out_names.push_back(graph[pc].str);
             pc++;
         }
 
-        // Read arguments from instruction stream.
-        // Args may be preceded by ARG_NAME (tag=23) for schema-aware
-        // positional reordering.
-        constexpr int64_t TAG_ARG_NAME = 23;
-        std::vector<std::pair<std::string, c10::IValue>> named_args;
-        named_args.reserve(static_cast<size_t>(num_args));
+        EncodedOp op{resolve_schema(target, overload, "execute_graph"), {}, {}, {}};
+
+        // Read arguments. Args may be preceded by ARG_NAME for
+        // schema-aware positional reordering.
+        std::vector<std::string_view> arg_names;
+        arg_names.reserve(static_cast<size_t>(num_args));
+        op.args.reserve(static_cast<size_t>(num_args));
         for (int64_t i = 0; i < num_args; i++) {
-            std::string arg_name;
+            std::string_view arg_name;
             if (pc < graph.size() && graph[pc].tag == TAG_ARG_NAME) {
-                arg_name = std::string(graph[pc].string_val);
+                arg_name = graph[pc].str;
                 pc++;
             }
-            named_args.push_back({arg_name, read_arg(graph, pc, values)});
+            arg_names.push_back(arg_name);
+            op.args.push_back(encode_arg(graph, pc, name_to_slot));
         }
 
-        // Resolve schema for arg reordering and dispatch.
-        auto schema = dispatcher.findSchema({target.c_str(), overload.c_str()});
-        if (!schema.has_value() && overload == "default") {
-            schema = dispatcher.findSchema({target.c_str(), ""});
-        }
-        if (!schema.has_value()) {
-            throw std::runtime_error(
-                "execute_graph: no schema for " + target + "." + overload);
+        // Reorder args to match schema parameter positions. Unnamed args
+        // fill positions in order; named args are matched by name.
+        const auto &schema_params = op.handle.schema().arguments();
+        std::vector<size_t> remaining(op.args.size());
+        for (size_t i = 0; i < remaining.size(); i++) {
+            remaining[i] = i;
         }
 
-        // Reorder args to match schema parameter positions.
-        const auto &schema_params = schema->schema().arguments();
-        std::vector<c10::IValue> args;
-        args.reserve(schema_params.size());
+        auto push_default = [&op](const c10::Argument &param) {
+            EncodedArg def;
+            def.literal = param.default_value().value();
+            op.args.push_back(std::move(def));
+            op.plan.push_back(op.args.size() - 1);
+        };
 
         size_t named_idx = 0;
         for (size_t si = 0; si < schema_params.size(); si++) {
             const auto &param = schema_params[si];
-            // Try to match by name
             bool found = false;
-            if (named_idx < named_args.size()) {
-                if (named_args[named_idx].first.empty() ||
-                    named_args[named_idx].first == param.name()) {
-                    args.push_back(std::move(named_args[named_idx].second));
+            if (named_idx < remaining.size()) {
+                const auto &name = arg_names[remaining[named_idx]];
+                if (name.empty() || name == param.name()) {
+                    op.plan.push_back(remaining[named_idx]);
                     named_idx++;
                     found = true;
                 } else {
                     // Names don't match — look for this param in remaining named args
-                    for (size_t ni = named_idx; ni < named_args.size(); ni++) {
-                        if (named_args[ni].first == param.name()) {
-                            args.push_back(std::move(named_args[ni].second));
-                            // Shift remaining
-                            named_args.erase(named_args.begin() + ni);
+                    for (size_t ni = named_idx; ni < remaining.size(); ni++) {
+                        if (arg_names[remaining[ni]] == param.name()) {
+                            op.plan.push_back(remaining[ni]);
+                            remaining.erase(remaining.begin() + ni);
                             found = true;
                             break;
                         }
                     }
                 }
             }
-            if (!found) {
-                // Use schema default
-                if (param.default_value().has_value()) {
-                    args.push_back(param.default_value().value());
-                }
-                // else: skip (will fail at dispatch if required)
-            }
-        }
-
-        // Type coercion: adapt IValue types to match the schema.
-        const auto &schema_args = schema->schema().arguments();
-
-        for (size_t ai = 0; ai < args.size() && ai < schema_args.size(); ai++) {
-            const auto &expected = schema_args[ai].type();
-            if (expected->isSubtypeOf(*c10::TensorType::get())) {
-                if (args[ai].isDouble()) {
-                    args[ai] = c10::IValue(at::scalar_to_tensor(args[ai].toDouble()));
-                } else if (args[ai].isInt()) {
-                    args[ai] = c10::IValue(at::scalar_to_tensor(args[ai].toInt()));
-                } else if (args[ai].isBool()) {
-                    args[ai] = c10::IValue(at::scalar_to_tensor(args[ai].toBool()));
-                }
-            }
-            if (expected->kind() == c10::TypeKind::OptionalType) {
-                auto inner = expected->cast<c10::OptionalType>()->getElementType();
-                if (inner->isSubtypeOf(*c10::DeviceObjType::get()) && args[ai].isDevice()) {
-                    args[ai] = c10::IValue(args[ai].toDevice());
-                }
+            if (!found && param.default_value().has_value()) {
+                push_default(param);
             }
         }
 
         // Fill in missing arguments with schema defaults.
-        while (args.size() < schema_args.size()) {
-            size_t idx = args.size();
-            const auto &arg = schema_args[idx];
-            if (arg.default_value().has_value()) {
-                args.push_back(arg.default_value().value());
-            } else {
-                // No default — this is a required arg that's missing
+        while (op.plan.size() < schema_params.size()) {
+            const auto &param = schema_params[op.plan.size()];
+            if (!param.default_value().has_value()) {
                 throw std::runtime_error(
                     "execute_graph: missing required arg '" +
-                    arg.name() + "' for " + target);
+                    param.name() + "' for " + target);
             }
+            push_default(param);
         }
 
-        schema->callBoxed(&args);
-
-        // Store results in the values map
-        if (args.size() == 1 && out_names.size() == 1) {
-            values[out_names[0]] = std::move(args[0]);
-        } else if (args.size() == 1 && args[0].isTuple()) {
-            // Multi-output op returns a tuple
-            auto tuple = args[0].toTuple();
-            for (size_t i = 0; i < out_names.size() && i < tuple->elements().size(); i++) {
-                values[out_names[i]] = tuple->elements()[i];
-            }
-        } else {
-            // Multiple stack returns
-            for (size_t i = 0; i < out_names.size() && i < args.size(); i++) {
-                values[out_names[i]] = std::move(args[i]);
+        // Outputs are bound after the args are read, so an op may
+        // overwrite a name it also consumes.
+        for (const auto &oname : out_names) {
+            auto it = name_to_slot.find(oname);
+            size_t slot;
+            if (it != name_to_slot.end()) {
+                slot = it->second;
+            } else {
+                slot = next_slot++;
+                name_to_slot.emplace(oname, slot);
             }
+            op.output_slots.push_back(slot);
         }
+
+        encoded->ops.push_back(std::move(op));
     }
 
-    // Collect requested outputs
-    IValueFlat result;
-    if (output_names.size() == 1) {
-        std::string name(output_names[0]);
-        auto it = values.find(name);
-        if (it != values.end()) {
-            result = flatten_ivalue(it->second);
-        }
-    } else {
-        // Multiple outputs → return as tuple
-        std::vector<c10::IValue> outputs;
-        for (const auto &name : output_names) {
-            std::string n(name);
-            auto it = values.find(n);
-            if (it != values.end()) {
-                outputs.push_back(it->second);
-            }
+    encoded->num_slots = next_slot;
+    encoded->tuple_output = output_names.size() != 1;
+    for (const auto &name : output_names) {
+        auto it = name_to_slot.find(name);
+        if (it != name_to_slot.end()) {
+            encoded->output_slots.push_back(it->second);
         }
-        result = flatten_ivalue(c10::IValue(
-            c10::ivalue::Tuple::create(std::move(outputs))));
     }
-    return result;
+    return encoded;
+}
+
+IValueFlat execute_graph(
+    rust::Vec<IValueNode> graph,
+    rust::Vec<rust::String> initial_names,
+    TensorList initial_tensors,
+    rust::Vec<rust::String> output_names)
+{
+    auto tensors = unpack_tensor_list(std::move(initial_tensors));
+    auto names = view_names(initial_names);
+    if (names.size() > tensors.size()) {
+        names.resize(tensors.size());
+    }
+
+    auto encoded = encode_instructions(
+        view_nodes(graph), names, view_names(output_names));
+    return encoded->run(std::move(tensors));
+}
+
+std::shared_ptr<CrossEncodedGraph> encode_graph(
+    rust::Vec<IValueNode> graph,
+    rust::Vec<rust::String> input_names,
+    rust::Vec<rust::String> output_names)
+{
+    return encode_instructions(
+        view_nodes(graph), view_names(input_names), view_names(output_names));
+}
+
+std::shared_ptr<CrossEncodedGraph> encode_graph_bytecode(
+    rust::Slice<const uint8_t> code,
+    rust::Vec<rust::String> input_names,
+    rust::Vec<rust::String> output_names)
+{
+    return encode_instructions(
+        bytecode::parse(code), view_names(input_names), view_names(output_names));
+}
+
+IValueFlat run_encoded_graph(
+    const std::shared_ptr<CrossEncodedGraph> &encoded,
+    TensorList tensors)
+{
+    auto input_tensors = unpack_tensor_list(std::move(tensors));
+    if (input_tensors.size() != encoded->num_inputs) {
+        throw std::runtime_error(
+            "run_encoded_graph: expected " + std::to_string(encoded->num_inputs) +
+            " tensors, got " + std::to_string(input_tensors.size()));
+    }
+    return encoded->run(std::move(input_tensors));
 }
 
 // ============================================================================
@@ -550,20 +942,142 @@ struct CompiledOp {
     std::vector<ArgDesc> args;
     std::vector<size_t> output_slots;
     size_t num_schema_args;
+    // Graph node name (its first output), only used to report profiles.
+    std::string node;
+};
+
+// ----------------------------------------------------------------------------
+// Per-op profiling
+// ----------------------------------------------------------------------------
+
+// One profiled op execution, guarded by a seqlock. `seq` is odd
+// (2 * claim + 1) while the sample of `claim` is being written and even
+// (2 * claim + 2) once it is published; zero means never written. The
+// fields are atomics so that a reader racing with a writer is well defined;
+// the seq check tells it to drop what it read.
+struct OpSample {
+    std::atomic<uint64_t> seq{0};
+    std::atomic<uint32_t> op{0};
+    std::atomic<int64_t> wall_ns{0};
+    std::atomic<int64_t> output_bytes{0};
+    std::atomic<int64_t> allocated_bytes{0};
+    std::atomic<int64_t> freed_bytes{0};
+};
+
+// Ring of op samples, allocated when profiling starts. Each sample claims
+// a number with one atomic increment, so concurrent runs of a graph can be
+// profiled; once the ring is full the oldest samples are overwritten.
+struct GraphProfile {
+    std::vector<OpSample> samples;
+    std::atomic<uint64_t> claimed{0};
+    std::atomic<uint64_t> runs{0};
+
+    explicit GraphProfile(size_t capacity) : samples(capacity) {}
+
+    void record(uint32_t op, int64_t wall_ns, int64_t output_bytes,
+                int64_t allocated_bytes, int64_t freed_bytes) {
+        const uint64_t claim = claimed.fetch_add(1, std::memory_order_relaxed);
+        OpSample &sample = samples[claim % samples.size()];
+
+        // Take the slot by moving its seq to our odd value. When another
+        // writer holds it, or a later claim already wrapped onto it, the
+        // sample is dropped rather than waited for: it is counted as such
+        // by compiled_graph_profile_stats.
+        uint64_t seen = sample.seq.load(std::memory_order_relaxed);
+        do {
+            if ((seen & 1) != 0 || seen >= 2 * claim + 2) {
+                return;
+            }
+        } while (!sample.seq.compare_exchange_weak(
+            seen, 2 * claim + 1, std::memory_order_relaxed, std::memory_order_relaxed));
+        std::atomic_thread_fence(std::memory_order_release);
+
+        sample.op.store(op, std::memory_order_relaxed);
+        sample.wall_ns.store(wall_ns, std::memory_order_relaxed);
+        sample.output_bytes.store(output_bytes, std::memory_order_relaxed);
+        sample.allocated_bytes.store(allocated_bytes, std::memory_order_relaxed);
+        sample.freed_bytes.store(freed_bytes, std::memory_order_relaxed);
+        sample.seq.store(2 * claim + 2, std::memory_order_release);
+    }
 };
 
+static int64_t output_nbytes(const c10::IValue &value) {
+    if (value.isTensor()) {
+        const auto &tensor = value.toTensor();
+        return tensor.defined() ? static_cast<int64_t>(tensor.nbytes()) : 0;
+    }
+    int64_t total = 0;
+    if (value.isTuple()) {
+        for (const auto &element : value.toTupleRef().elements()) {
+            total += output_nbytes(element);
+        }
+    } else if (value.isTensorList()) {
+        for (const at::Tensor &tensor : value.toTensorList()) {
+            total += tensor.defined() ? static_cast<int64_t>(tensor.nbytes()) : 0;
+        }
+    }
+    return total;
+}
+
 struct CrossCompiledGraphImpl {
     std::vector<CompiledOp> ops;
     size_t num_slots;
     std::vector<size_t> output_slots;
 
+    // Input names, in slot order (slot i holds input_names[i]).
+    std::vector<std::string> input_names;
+    // Input slots still fed by run(), in call order. Inputs bound with
+    // bind_graph_constants move from here to `constants`.
+    std::vector<size_t> free_input_slots;
+    // Graph-owned values (parameters, buffers) preloaded into their slot
+    // on every run.
+    std::vector<std::pair<size_t, c10::IValue>> constants;
+
+    // Samples of the runs being profiled, null when profiling is off, and
+    // of the last profiling session (kept after it is stopped). Both are
+    // only accessed through std::atomic_load / std::atomic_store.
+    std::shared_ptr<GraphProfile> profile;
+    std::shared_ptr<GraphProfile> last_profile;
+
+    // CPU memory allocated by the runs of this graph.
+    std::shared_ptr<MemoryAccount> memory = std::make_shared<MemoryAccount>();
+
     std::vector<CrossTensor> run(std::vector<CrossTensor> initial_tensors) const {
+        if (initial_tensors.size() != free_input_slots.size()) {
+            throw std::runtime_error(
+                "run_compiled_graph: expected " + std::to_string(free_input_slots.size()) +
+                " tensors, got " + std::to_string(initial_tensors.size()));
+        }
+        MemoryScope memory_scope(memory);
         std::vector<c10::IValue> values(num_slots);
+        for (const auto &constant : constants) {
+            values[constant.first] = constant.second;
+        }
         for (size_t i = 0; i < initial_tensors.size(); i++) {
-            values[i] = c10::IValue(std::move(initial_tensors[i]));
+            values[free_input_slots[i]] = c10::IValue(std::move(initial_tensors[i]));
         }
 
-        for (const auto &op : ops) {
+        // Unprofiled runs only pay for this load and a branch per op.
+        const auto run_profile = std::atomic_load(&profile);
+        std::optional<AllocationTally> allocations;
+        if (run_profile) {
+            run_profile->runs.fetch_add(1, std::memory_order_relaxed);
+            allocations.emplace();
+        }
+
+        // Under a profiler (see trace_compiled_graph), each op also runs in
+        // a range named after its graph node.
+        const bool record_nodes = at::hasCallbacks();
+
+        for (size_t op_index = 0; op_index < ops.size(); op_index++) {
+            const auto &op = ops[op_index];
+            std::optional<at::RecordFunction> node_range;
+            if (record_nodes) {
+                node_range.emplace(at::RecordScope::USER_SCOPE);
+                if (node_range->isActive()) {
+                    node_range->before(op.node.c_str());
+                }
+            }
             std::vector<c10::IValue> args;
             args.reserve(op.args.size());
             for (const auto &desc : op.args) {
@@ -639,7 +1153,26 @@ struct CrossCompiledGraphImpl {
                 }
             }
 
-            op.handle.callBoxed(&args);
+            if (!run_profile) {
+                op.handle.callBoxed(&args);
+            } else {
+                const int64_t allocated = allocations->allocated;
+                const int64_t freed = allocations->freed;
+                const auto start = std::chrono::steady_clock::now();
+                op.handle.callBoxed(&args);
+                const auto wall = std::chrono::steady_clock::now() - start;
+
+                int64_t output_bytes = 0;
+                for (const auto &output : args) {
+                    output_bytes += output_nbytes(output);
+                }
+                run_profile->record(
+                    static_cast<uint32_t>(op_index),
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(wall).count(),
+                    output_bytes,
+                    allocations->allocated - allocated,
+                    allocations->freed - freed);
+            }
 
             // Store results by slot index
             if (args.size() == 1 && op.output_slots.size() == 1) {
@@ -666,80 +1199,69 @@ struct CrossCompiledGraphImpl {
     }
 };
 
-static c10::OperatorHandle resolve_schema(
-    c10::Dispatcher &dispatcher,
-    const std::string &target,
-    const std::string &overload)
-{
-    auto schema = dispatcher.findSchema({target.c_str(), overload.c_str()});
-    if (!schema.has_value() && overload == "default") {
-        schema = dispatcher.findSchema({target.c_str(), ""});
-    }
-    if (!schema.has_value()) {
-        throw std::runtime_error("compile_graph: no schema for " + target + "." + overload);
-    }
-    return *schema;
-}
-
-std::shared_ptr<CrossCompiledGraph> compile_graph(
-    rust::Vec<IValueNode> graph,
-    rust::Vec<rust::String> value_names,
-    rust::Vec<rust::String> output_names)
+// Compile a decoded instruction stream: resolve schemas, assign slots and
+// build the per-op argument templates.
+static std::shared_ptr<CrossCompiledGraphImpl> compile_instructions(
+    const std::vector<InstView> &graph,
+    const std::vector<std::string_view> &value_names,
+    const std::vector<std::string_view> &output_names)
 {
     auto compiled = std::make_shared<CrossCompiledGraphImpl>();
 
-    std::unordered_map<std::string, size_t> name_to_slot;
+    std::unordered_map<std::string_view, size_t> name_to_slot;
     for (size_t i = 0; i < value_names.size(); i++) {
-        name_to_slot[std::string(value_names[i])] = i;
+        name_to_slot[value_names[i]] = i;
+        compiled->input_names.emplace_back(value_names[i]);
+        compiled->free_input_slots.push_back(i);
     }
     size_t next_slot = value_names.size();
 
-    auto &dispatcher = c10::Dispatcher::singleton();
     size_t pc = 0;
 
     while (pc < graph.size()) {
         if (graph[pc].tag != 20)
             throw std::runtime_error("compile_graph: expected BEGIN_OP at pc=" + std::to_string(pc));
 
-        std::string target(graph[pc].string_val);
+        std::string target(graph[pc].str);
         int64_t num_args = graph[pc].child_count;
         pc++;
 
         std::string overload;
         if (pc < graph.size() && graph[pc].tag == 22) {
-            overload = std::string(graph[pc].string_val);
+            overload = std::string(graph[pc].str);
             pc++;
         }
 
-        std::vector<size_t> out_slots;
+        // Output slots are bound after the args are read, so an op may
+        // overwrite a name it also consumes (e.g. x = f(x)).
+        std::vector<std::string_view> out_names;
         while (pc < graph.size() && graph[pc].tag == 21) {
-            std::string oname(graph[pc].string_val);
-            size_t slot = next_slot++;
-            name_to_slot[oname] = slot;
-            out_slots.push_back(slot);
+            out_names.push_back(graph[pc].str);
             pc++;
         }
 
-        auto handle = resolve_schema(dispatcher, target, overload);
+        auto handle = resolve_schema(target, overload, "compile_graph");
 
         // Read named args from instruction stream
         constexpr int64_t TAG_ARG_NAME_COMPILE = 23;
-        std::vector<std::pair<std::string, ArgDesc>> named_descs;
+        std::vector<std::pair<std::string_view, ArgDesc>> named_descs;
         for (int64_t i = 0; i < num_args; i++) {
-            std::string aname;
+            std::string_view aname;
             if (pc < graph.size() && graph[pc].tag == TAG_ARG_NAME_COMPILE) {
-                aname = std::string(graph[pc].string_val);
+                aname = graph[pc].str;
                 pc++;
             }
+            if (pc >= graph.size())
+                throw std::runtime_error("compile_graph: unexpected end of instruction stream");
             ArgDesc desc;
             const auto &node = graph[pc];
 
             switch (node.tag) {
             case 10: { // ref
-                std::string ref(node.string_val);
-                auto it = name_to_slot.find(ref);
+                auto it = name_to_slot.find(node.str);
                 if (it == name_to_slot.end())
-                    throw std::runtime_error("compile_graph: unknown ref '" + ref + "'");
+                    throw std::runtime_error(
+                        "compile_graph: unknown ref '" + std::string(node.str) + "'");
                 desc.kind = ArgDesc::SLOT;
                 desc.slot = it->second;
                 pc++;
@@ -749,10 +1271,10 @@ std::shared_ptr<CrossCompiledGraph> compile_graph(
             case 1: desc.kind = ArgDesc::LITERAL; desc.literal = c10::IValue(node.int_val); pc++; break;
             case 2: desc.kind = ArgDesc::LITERAL; desc.literal = c10::IValue(node.float_val); pc++; break;
             case 3: desc.kind = ArgDesc::LITERAL; desc.literal = c10::IValue(node.bool_val); pc++; break;
-            case 4: desc.kind = ArgDesc::LITERAL; desc.literal = c10::IValue(std::string(node.string_val)); pc++; break;
+            case 4: desc.kind = ArgDesc::LITERAL; desc.literal = c10::IValue(std::string(node.str)); pc++; break;
             case 5: desc.kind = ArgDesc::LITERAL; desc.literal = c10::IValue(); pc++; break;
             case 9: {
-                std::string dev(node.string_val);
+                std::string dev(node.str);
                 desc.kind = ArgDesc::LITERAL;
                 desc.literal = (node.int_val >= 0)
                     ? c10::IValue(c10::Device(dev + ":" + std::to_string(node.int_val)))
@@ -765,6 +1287,8 @@ std::shared_ptr<CrossCompiledGraph> compile_graph(
                 pc++;
 
                 if (count == 0) { desc.kind = ArgDesc::INT_LIST_LITERAL; break; }
+                if (pc + static_cast<size_t>(count) > graph.size())
+                    throw std::runtime_error("compile_graph: unexpected end of instruction stream");
 
                 int64_t first_tag = graph[pc].tag;
                 bool homo = true;
@@ -774,8 +1298,11 @@ std::shared_ptr<CrossCompiledGraph> compile_graph(
                 if (homo && first_tag == 10) {
                     desc.kind = ArgDesc::TENSOR_LIST_SLOTS;
                     for (int64_t j = 0; j < count; j++) {
-                        std::string ref(graph[pc].string_val);
-                        desc.slot_list.push_back(name_to_slot.at(ref));
+                        auto it = name_to_slot.find(graph[pc].str);
+                        if (it == name_to_slot.end())
+                            throw std::runtime_error(
+                                "compile_graph: unknown ref '" + std::string(graph[pc].str) + "'");
+                        desc.slot_list.push_back(it->second);
                         pc++;
                     }
                 } else if (homo && first_tag == 1) {
@@ -842,14 +1369,23 @@ std::shared_ptr<CrossCompiledGraph> compile_graph(
             }
         }
 
+        std::vector<size_t> out_slots;
+        out_slots.reserve(out_names.size());
+        for (const auto &oname : out_names) {
+            size_t slot = next_slot++;
+            name_to_slot[oname] = slot;
+            out_slots.push_back(slot);
+        }
+
         compiled->ops.push_back(CompiledOp{
             handle, std::move(arg_descs), std::move(out_slots),
-            handle.schema().arguments().size()
+            handle.schema().arguments().size(),
+            out_names.empty() ? target : std::string(out_names[0])
         });
     }
 
     for (const auto &name : output_names) {
-        auto it = name_to_slot.find(std::string(name));
+        auto it = name_to_slot.find(name);
         if (it != name_to_slot.end())
             compiled->output_slots.push_back(it->second);
     }
@@ -857,6 +1393,508 @@ std::shared_ptr<CrossCompiledGraph> compile_graph(
     return compiled;
 }
 
+std::shared_ptr<CrossCompiledGraph> compile_graph(
+    rust::Vec<IValueNode> graph,
+    rust::Vec<rust::String> value_names,
+    rust::Vec<rust::String> output_names)
+{
+    return compile_instructions(
+        view_nodes(graph), view_names(value_names), view_names(output_names));
+}
+
+std::shared_ptr<CrossCompiledGraph> compile_graph_bytecode(
+    rust::Slice<const uint8_t> code,
+    rust::Vec<rust::String> value_names,
+    rust::Vec<rust::String> output_names)
+{
+    return compile_instructions(
+        bytecode::parse(code), view_names(value_names), view_names(output_names));
+}
+
+// ============================================================================
+// Compiled graph cache — CrossCompiledGraphImpl serialized to bytes
+// ============================================================================
+
+// Layout (all integers little-endian):
+//
+//   header   "EXTC" | u32 version | u64 source_tag | str libtorch version
+//   graph    u64 num_slots | u32 n | n x u64 output slot |
+//            u32 n | n x str input name
+//   ops      u32 n_ops, then per op:
+//              str name | str overload | str node | u64 num_schema_args |
+//              u32 n | n x u64 output slot | u32 n_args | n_args x arg
+//   literals u64 length | pickled GenericList of every LITERAL value
+//
+//   str      u32 length | bytes
+//   arg      u8 kind, then per kind:
+//              SLOT               u64 slot
+//              LITERAL            u32 index into the literal list
+//              TENSOR_LIST_SLOTS  u32 n | n x u64 slot
+//              INT_LIST_LITERAL   u32 n | n x i64
+//              FLOAT_LIST_LITERAL u32 n | n x f64 bits
+//              BOOL_LIST_LITERAL  u32 n | n x u8
+//
+// Operator handles are stored by qualified name and resolved again on
+// load, so a cache written by one process is valid in another as long as
+// the same libtorch (and op libraries) are loaded. Blobs written by a
+// different libtorch build are rejected. Bound constants are not part of
+// the blob; they are bound again after loading.
+namespace graph_cache {
+
+constexpr uint32_t kVersion = 3;
+
+struct Writer {
+    rust::Vec<uint8_t> out;
+
+    void u8(uint8_t v) { out.push_back(v); }
+    void u32(uint32_t v) {
+        for (int i = 0; i < 4; i++) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    }
+    void u64(uint64_t v) {
+        for (int i = 0; i < 8; i++) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    }
+    void bytes(const char *data, size_t len) {
+        out.reserve(out.size() + len);
+        for (size_t i = 0; i < len; i++) out.push_back(static_cast<uint8_t>(data[i]));
+    }
+    void str(const std::string &s) {
+        u32(static_cast<uint32_t>(s.size()));
+        bytes(s.data(), s.size());
+    }
+    void slots(const std::vector<size_t> &v) {
+        u32(static_cast<uint32_t>(v.size()));
+        for (auto s : v) u64(s);
+    }
+};
+
+struct Reader {
+    const uint8_t *data;
+    size_t size;
+    size_t pos = 0;
+
+    const uint8_t *take(size_t n) {
+        if (n > size - pos) {
+            throw std::runtime_error("compiled graph cache: truncated data");
+        }
+        const uint8_t *p = data + pos;
+        pos += n;
+        return p;
+    }
+    uint8_t u8() { return *take(1); }
+    uint32_t u32() { return bytecode::read_u32(take(4)); }
+    uint64_t u64() { return bytecode::read_u64(take(8)); }
+    std::string str() {
+        uint32_t len = u32();
+        return std::string(reinterpret_cast<const char *>(take(len)), len);
+    }
+    size_t slot(size_t num_slots) {
+        uint64_t s = u64();
+        if (s >= num_slots) {
+            throw std::runtime_error("compiled graph cache: slot out of range");
+        }
+        return static_cast<size_t>(s);
+    }
+    std::vector<size_t> slots(size_t num_slots) {
+        uint32_t n = u32();
+        std::vector<size_t> v;
+        v.reserve(n);
+        for (uint32_t i = 0; i < n; i++) v.push_back(slot(num_slots));
+        return v;
+    }
+};
+
+} // namespace graph_cache
+
+rust::Vec<uint8_t> serialize_compiled_graph(
+    const std::shared_ptr<CrossCompiledGraph> &compiled,
+    uint64_t source_tag)
+{
+    if (!compiled->constants.empty()) {
+        throw std::runtime_error(
+            "serialize_compiled_graph: graph has bound constants; serialize it before binding");
+    }
+
+    graph_cache::Writer w;
+    w.bytes("EXTC", 4);
+    w.u32(graph_cache::kVersion);
+    w.u64(source_tag);
+    w.str(TORCH_VERSION);
+
+    w.u64(compiled->num_slots);
+    w.slots(compiled->output_slots);
+    w.u32(static_cast<uint32_t>(compiled->input_names.size()));
+    for (const auto &name : compiled->input_names) w.str(name);
+
+    auto literals = c10::impl::GenericList(c10::AnyType::get());
+    w.u32(static_cast<uint32_t>(compiled->ops.size()));
+    for (const auto &op : compiled->ops) {
+        const auto &name = op.handle.operator_name();
+        w.str(name.name);
+        w.str(name.overload_name);
+        w.str(op.node);
+        w.u64(op.num_schema_args);
+        w.slots(op.output_slots);
+
+        w.u32(static_cast<uint32_t>(op.args.size()));
+        for (const auto &desc : op.args) {
+            w.u8(static_cast<uint8_t>(desc.kind));
+            switch (desc.kind) {
+            case ArgDesc::SLOT:
+                w.u64(desc.slot);
+                break;
+            case ArgDesc::LITERAL:
+                w.u32(static_cast<uint32_t>(literals.size()));
+                literals.push_back(desc.literal);
+                break;
+            case ArgDesc::TENSOR_LIST_SLOTS:
+                w.slots(desc.slot_list);
+                break;
+            case ArgDesc::INT_LIST_LITERAL:
+                w.u32(static_cast<uint32_t>(desc.int_list.size()));
+                for (auto v : desc.int_list) w.u64(static_cast<uint64_t>(v));
+                break;
+            case ArgDesc::FLOAT_LIST_LITERAL:
+                w.u32(static_cast<uint32_t>(desc.float_list.size()));
+                for (auto v : desc.float_list) {
+                    uint64_t bits;
+                    std::memcpy(&bits, &v, sizeof(bits));
+                    w.u64(bits);
+                }
+                break;
+            case ArgDesc::BOOL_LIST_LITERAL:
+                w.u32(static_cast<uint32_t>(desc.bool_list.size()));
+                for (bool v : desc.bool_list) w.u8(v ? 1 : 0);
+                break;
+            }
+        }
+    }
+
+    // All literals (scalars, schema defaults, inline tensors) are pickled
+    // together, so each value type round-trips exactly as libtorch saves it.
+    auto pickled = torch::jit::pickle_save(c10::IValue(std::move(literals)));
+    w.u64(pickled.size());
+    w.bytes(pickled.data(), pickled.size());
+    return std::move(w.out);
+}
+
+std::shared_ptr<CrossCompiledGraph> deserialize_compiled_graph(
+    rust::Slice<const uint8_t> data,
+    uint64_t source_tag)
+{
+    graph_cache::Reader r{data.data(), data.size()};
+    if (std::memcmp(r.take(4), "EXTC", 4) != 0) {
+        throw std::runtime_error("compiled graph cache: bad magic");
+    }
+    uint32_t version = r.u32();
+    if (version != graph_cache::kVersion) {
+        throw std::runtime_error(
+            "compiled graph cache: unsupported version " + std::to_string(version));
+    }
+    if (r.u64() != source_tag) {
+        throw std::runtime_error("compiled graph cache: source tag mismatch");
+    }
+    std::string torch_version = r.str();
+    if (torch_version != TORCH_VERSION) {
+        throw std::runtime_error(
+            "compiled graph cache: written by libtorch " + torch_version +
+            ", running " + TORCH_VERSION);
+    }
+
+    auto compiled = std::make_shared<CrossCompiledGraphImpl>();
+    compiled->num_slots = static_cast<size_t>(r.u64());
+    compiled->output_slots = r.slots(compiled->num_slots);
+    uint32_t n_inputs = r.u32();
+    if (n_inputs > compiled->num_slots) {
+        throw std::runtime_error("compiled graph cache: too many inputs");
+    }
+    for (uint32_t i = 0; i < n_inputs; i++) {
+        compiled->input_names.push_back(r.str());
+        compiled->free_input_slots.push_back(i);
+    }
+
+    // LITERAL args are numbered in write order; their values are filled in
+    // from the trailing pickled list once every op has been read.
+    uint32_t num_literals = 0;
+    uint32_t n_ops = r.u32();
+    compiled->ops.reserve(n_ops);
+    for (uint32_t i = 0; i < n_ops; i++) {
+        std::string name = r.str();
+        std::string overload = r.str();
+        auto handle = resolve_schema(name, overload, "deserialize_compiled_graph");
+        std::string node = r.str();
+        size_t num_schema_args = static_cast<size_t>(r.u64());
+        auto out_slots = r.slots(compiled->num_slots);
+
+        uint32_t n_args = r.u32();
+        std::vector<ArgDesc> args(n_args);
+        for (auto &desc : args) {
+            uint8_t kind = r.u8();
+            switch (kind) {
+            case ArgDesc::SLOT:
+                desc.kind = ArgDesc::SLOT;
+                desc.slot = r.slot(compiled->num_slots);
+                break;
+            case ArgDesc::LITERAL:
+                desc.kind = ArgDesc::LITERAL;
+                if (r.u32() != num_literals++) {
+                    throw std::runtime_error("compiled graph cache: literal out of order");
+                }
+                break;
+            case ArgDesc::TENSOR_LIST_SLOTS:
+                desc.kind = ArgDesc::TENSOR_LIST_SLOTS;
+                desc.slot_list = r.slots(compiled->num_slots);
+                break;
+            case ArgDesc::INT_LIST_LITERAL: {
+                desc.kind = ArgDesc::INT_LIST_LITERAL;
+                uint32_t n = r.u32();
+                for (uint32_t j = 0; j < n; j++)
+                    desc.int_list.push_back(static_cast<int64_t>(r.u64()));
+                break;
+            }
+            case ArgDesc::FLOAT_LIST_LITERAL: {
+                desc.kind = ArgDesc::FLOAT_LIST_LITERAL;
+                uint32_t n = r.u32();
+                for (uint32_t j = 0; j < n; j++) {
+                    uint64_t bits = r.u64();
+                    double v;
+                    std::memcpy(&v, &bits, sizeof(v));
+                    desc.float_list.push_back(v);
+                }
+                break;
+            }
+            case ArgDesc::BOOL_LIST_LITERAL: {
+                desc.kind = ArgDesc::BOOL_LIST_LITERAL;
+                uint32_t n = r.u32();
+                for (uint32_t j = 0; j < n; j++) desc.bool_list.push_back(r.u8() != 0);
+                break;
+            }
+            default:
+                throw std::runtime_error(
+                    "compiled graph cache: unknown arg kind " + std::to_string(kind));
+            }
+        }
+
+        compiled->ops.push_back(CompiledOp{
+            handle, std::move(args), std::move(out_slots), num_schema_args, std::move(node)
+        });
+    }
+
+    uint64_t pickled_size = r.u64();
+    const uint8_t *pickled = r.take(static_cast<size_t>(pickled_size));
+    if (r.pos != r.size) {
+        throw std::runtime_error("compiled graph cache: trailing data");
+    }
+    auto literals = torch::jit::pickle_load(
+        std::vector<char>(pickled, pickled + pickled_size)).toList();
+    if (literals.size() != num_literals) {
+        throw std::runtime_error("compiled graph cache: literal count mismatch");
+    }
+
+    size_t next_literal = 0;
+    for (auto &op : compiled->ops) {
+        for (auto &desc : op.args) {
+            if (desc.kind == ArgDesc::LITERAL) {
+                desc.literal = literals.get(next_literal++);
+            }
+        }
+    }
+    return compiled;
+}
+
+rust::String libtorch_version() {
+    return rust::String(TORCH_VERSION);
+}
+
+// ============================================================================
+// Graph dumps and native benchmarking
+// ============================================================================
+
+// A dump is a compiled graph together with the constants bound to it and
+// a set of inputs, so the executor can be driven outside of the BEAM:
+//
+//   "EXTD" | u32 version | u64 n | n bytes of serialize_compiled_graph
+//          | u64 m | m bytes of pickle([constant names, constants, inputs])
+//
+// The graph blob is the unbound graph (source tag 0), and the constants
+// are bound again by name on load.
+namespace graph_dump {
+
+constexpr uint32_t kVersion = 1;
+
+} // namespace graph_dump
+
+void dump_compiled_graph(
+    const std::shared_ptr<CrossCompiledGraph> &compiled,
+    TensorList inputs,
+    rust::String path)
+{
+    auto unbound = std::make_shared<CrossCompiledGraphImpl>(*compiled);
+    unbound->constants.clear();
+    unbound->free_input_slots.resize(unbound->input_names.size());
+    std::iota(unbound->free_input_slots.begin(), unbound->free_input_slots.end(), 0);
+    auto blob = serialize_compiled_graph(unbound, 0);
+
+    c10::List<std::string> names;
+    c10::List<at::Tensor> constants;
+    for (const auto &constant : compiled->constants) {
+        names.push_back(compiled->input_names[constant.first]);
+        constants.push_back(constant.second.toTensor());
+    }
+    c10::List<at::Tensor> input_list;
+    for (auto &tensor : unpack_tensor_list(std::move(inputs))) {
+        input_list.push_back(std::move(tensor));
+    }
+    auto tensors = torch::jit::pickle_save(c10::ivalue::Tuple::create(
+        c10::IValue(names), c10::IValue(constants), c10::IValue(input_list)));
+
+    graph_cache::Writer w;
+    w.bytes("EXTD", 4);
+    w.u32(graph_dump::kVersion);
+    w.u64(blob.size());
+    w.bytes(reinterpret_cast<const char *>(blob.data()), blob.size());
+    w.u64(tensors.size());
+    w.bytes(tensors.data(), tensors.size());
+
+    std::string path_str(path);
+    std::ofstream out(path_str, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(w.out.data()), static_cast<std::streamsize>(w.out.size()));
+    if (!out) {
+        throw std::runtime_error("dump_compiled_graph: cannot write " + path_str);
+    }
+}
+
+CompiledGraphDump load_compiled_graph_dump(rust::String path) {
+    std::string path_str(path);
+    std::ifstream in(path_str, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("load_compiled_graph_dump: cannot read " + path_str);
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    graph_cache::Reader r{data.data(), data.size()};
+    if (std::memcmp(r.take(4), "EXTD", 4) != 0) {
+        throw std::runtime_error("load_compiled_graph_dump: not a graph dump");
+    }
+    uint32_t version = r.u32();
+    if (version != graph_dump::kVersion) {
+        throw std::runtime_error(
+            "load_compiled_graph_dump: unsupported version " + std::to_string(version));
+    }
+    size_t blob_size = static_cast<size_t>(r.u64());
+    const uint8_t *blob = r.take(blob_size);
+    auto unbound = deserialize_compiled_graph(rust::Slice<const uint8_t>(blob, blob_size), 0);
+
+    size_t pickled_size = static_cast<size_t>(r.u64());
+    const uint8_t *pickled = r.take(pickled_size);
+    auto tensors = torch::jit::pickle_load(
+        std::vector<char>(pickled, pickled + pickled_size)).toTuple();
+
+    rust::Vec<rust::String> names;
+    for (const auto &name : tensors->elements()[0].toList()) {
+        names.push_back(rust::String(name.toStringRef()));
+    }
+    std::vector<CrossTensor> constants = tensors->elements()[1].toTensorVector();
+    std::vector<CrossTensor> inputs = tensors->elements()[2].toTensorVector();
+
+    CompiledGraphDump dump;
+    dump.graph = bind_graph_constants(unbound, std::move(names), pack_tensor_list(std::move(constants)));
+    dump.inputs = pack_tensor_list(std::move(inputs));
+    return dump;
+}
+
+GraphBenchResult benchmark_compiled_graph(
+    const std::shared_ptr<CrossCompiledGraph> &compiled,
+    TensorList inputs,
+    uint64_t warmup,
+    uint64_t iterations)
+{
+    const auto input_tensors = unpack_tensor_list(std::move(inputs));
+    // CUDA kernels run asynchronously: without a synchronization the timed
+    // runs would only measure their launches.
+    const bool on_cuda = std::any_of(
+        input_tensors.begin(), input_tensors.end(),
+        [](const CrossTensor &tensor) { return tensor.defined() && tensor.is_cuda(); });
+    auto synchronize = [on_cuda]() {
+        if (on_cuda) {
+            torch::cuda::synchronize();
+        }
+    };
+
+    for (uint64_t i = 0; i < warmup; i++) {
+        compiled->run(input_tensors);
+    }
+    synchronize();
+
+    GraphBenchResult result;
+    result.latencies_ns.reserve(iterations);
+    for (uint64_t i = 0; i < iterations; i++) {
+        const auto start = std::chrono::steady_clock::now();
+        compiled->run(input_tensors);
+        synchronize();
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        result.latencies_ns.push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    // Allocations are counted on one extra run, under the counting CPU
+    // allocator, so that the timed runs only measure the graph.
+    const bool was_tracking = cpu_memory_stats().enabled;
+    cpu_memory_tracking(true);
+    {
+        AllocationTally allocations;
+        compiled->run(input_tensors);
+        result.allocations = allocations.allocations;
+        result.allocated_bytes = allocations.allocated;
+        result.freed_bytes = allocations.freed;
+    }
+    cpu_memory_tracking(was_tracking);
+    return result;
+}
+
+std::shared_ptr<CrossCompiledGraph> bind_graph_constants(
+    const std::shared_ptr<CrossCompiledGraph> &compiled,
+    rust::Vec<rust::String> names,
+    TensorList tensors)
+{
+    auto values = unpack_tensor_list(std::move(tensors));
+    if (values.size() != names.size()) {
+        throw std::invalid_argument(
+            "bind_graph_constants: got " + std::to_string(names.size()) +
+            " names but " + std::to_string(values.size()) + " tensors");
+    }
+
+    // The unbound graph stays usable (e.g. for serialization); its ops
+    // and literals are copied once here, never per run.
+    auto bound = std::make_shared<CrossCompiledGraphImpl>(*compiled);
+    bound->profile.reset();
+    bound->last_profile.reset();
+    bound->memory = std::make_shared<MemoryAccount>();
+    for (size_t i = 0; i < names.size(); i++) {
+        std::string_view name = as_view(names[i]);
+        auto it = std::find_if(
+            bound->free_input_slots.begin(), bound->free_input_slots.end(),
+            [&](size_t slot) { return bound->input_names[slot] == name; });
+        if (it == bound->free_input_slots.end()) {
+            throw std::invalid_argument(
+                "bind_graph_constants: '" + std::string(name) +
+                "' is not an unbound input of the graph");
+        }
+        bound->constants.emplace_back(*it, c10::IValue(std::move(values[i])));
+        bound->free_input_slots.erase(it);
+    }
+    return bound;
+}
+
+rust::Vec<rust::String> compiled_graph_inputs(
+    const std::shared_ptr<CrossCompiledGraph> &compiled)
+{
+    rust::Vec<rust::String> names;
+    for (auto slot : compiled->free_input_slots) {
+        names.push_back(rust::String(compiled->input_names[slot]));
+    }
+    return names;
+}
+
 TensorList run_compiled_graph(
     const std::shared_ptr<CrossCompiledGraph> &compiled,
     TensorList tensors)
@@ -865,3 +1903,268 @@ TensorList run_compiled_graph(
     auto output_tensors = compiled->run(std::move(input_tensors));
     return pack_tensor_list(output_tensors);
 }
+
+ModelMemoryStats compiled_graph_memory_stats(
+    const std::shared_ptr<CrossCompiledGraph> &compiled)
+{
+    std::vector<torch::Tensor> weights;
+    for (const auto &constant : compiled->constants) {
+        if (constant.second.isTensor()) {
+            weights.push_back(constant.second.toTensor());
+        }
+    }
+    return model_memory_stats(*compiled->memory, storage_bytes(weights));
+}
+
+// ============================================================================
+// Graph sessions — compiled graphs with state carried across runs
+// ============================================================================
+
+// A compiled graph whose state inputs are fed from its own outputs of the
+// previous run. Inputs are indexed in the graph's call order
+// (free_input_slots), outputs in output_slots order.
+//
+// Export graphs are functional, so a run never writes into its inputs:
+// the state tensors can be handed over as they are, and the initial ones
+// reused by reset without copying.
+struct CrossGraphSessionImpl {
+    std::shared_ptr<CrossCompiledGraphImpl> graph;
+    // Inputs passed to each step, and inputs fed from the state.
+    std::vector<size_t> step_inputs;
+    std::vector<size_t> state_inputs;
+    // Output that becomes state_inputs[i] on the next step.
+    std::vector<size_t> state_outputs;
+    // Outputs returned by each step (every output not carried as state).
+    std::vector<size_t> step_outputs;
+
+    std::vector<CrossTensor> initial;
+    // Guarded by `mutex`: steps of one session run one at a time.
+    std::vector<CrossTensor> state;
+    std::mutex mutex;
+};
+
+std::shared_ptr<CrossGraphSession> create_graph_session(
+    const std::shared_ptr<CrossCompiledGraph> &compiled,
+    rust::Vec<rust::String> state_inputs,
+    rust::Vec<uint64_t> state_outputs,
+    TensorList initial)
+{
+    auto initial_tensors = unpack_tensor_list(std::move(initial));
+    if (state_inputs.size() != state_outputs.size() ||
+        state_inputs.size() != initial_tensors.size()) {
+        throw std::invalid_argument(
+            "create_graph_session: got " + std::to_string(state_inputs.size()) +
+            " state inputs, " + std::to_string(state_outputs.size()) + " state outputs and " +
+            std::to_string(initial_tensors.size()) + " initial tensors");
+    }
+
+    auto session = std::make_shared<CrossGraphSessionImpl>();
+    session->graph = compiled;
+    const auto &free_slots = compiled->free_input_slots;
+    std::vector<bool> is_state_input(free_slots.size(), false);
+    std::vector<bool> is_state_output(compiled->output_slots.size(), false);
+    for (size_t i = 0; i < state_inputs.size(); i++) {
+        std::string_view name = as_view(state_inputs[i]);
+        auto it = std::find_if(free_slots.begin(), free_slots.end(), [&](size_t slot) {
+            return compiled->input_names[slot] == name;
+        });
+        if (it == free_slots.end()) {
+            throw std::invalid_argument(
+                "create_graph_session: '" + std::string(name) +
+                "' is not an unbound input of the graph");
+        }
+        const size_t position = static_cast<size_t>(it - free_slots.begin());
+        if (is_state_input[position]) {
+            throw std::invalid_argument(
+                "create_graph_session: '" + std::string(name) + "' is declared twice");
+        }
+        if (state_outputs[i] >= compiled->output_slots.size()) {
+            throw std::out_of_range(
+                "create_graph_session: output " + std::to_string(state_outputs[i]) +
+                " out of range for a graph with " +
+                std::to_string(compiled->output_slots.size()) + " outputs");
+        }
+        is_state_input[position] = true;
+        is_state_output[state_outputs[i]] = true;
+        session->state_inputs.push_back(position);
+        session->state_outputs.push_back(state_outputs[i]);
+    }
+    for (size_t i = 0; i < free_slots.size(); i++) {
+        if (!is_state_input[i]) {
+            session->step_inputs.push_back(i);
+        }
+    }
+    for (size_t i = 0; i < compiled->output_slots.size(); i++) {
+        if (!is_state_output[i]) {
+            session->step_outputs.push_back(i);
+        }
+    }
+
+    session->initial = std::move(initial_tensors);
+    session->state = session->initial;
+    return session;
+}
+
+TensorList graph_session_step(
+    const std::shared_ptr<CrossGraphSession> &session,
+    TensorList tensors)
+{
+    auto step_tensors = unpack_tensor_list(std::move(tensors));
+    if (step_tensors.size() != session->step_inputs.size()) {
+        throw std::runtime_error(
+            "graph_session_step: expected " + std::to_string(session->step_inputs.size()) +
+            " tensors, got " + std::to_string(step_tensors.size()));
+    }
+
+    std::lock_guard<std::mutex> lock(session->mutex);
+    std::vector<CrossTensor> inputs(session->graph->free_input_slots.size());
+    for (size_t i = 0; i < step_tensors.size(); i++) {
+        inputs[session->step_inputs[i]] = std::move(step_tensors[i]);
+    }
+    for (size_t i = 0; i < session->state.size(); i++) {
+        inputs[session->state_inputs[i]] = session->state[i];
+    }
+
+    // The state only advances when the whole run succeeded.
+    auto outputs = session->graph->run(std::move(inputs));
+    for (size_t i = 0; i < session->state.size(); i++) {
+        session->state[i] = outputs[session->state_outputs[i]];
+    }
+
+    std::vector<CrossTensor> result;
+    result.reserve(session->step_outputs.size());
+    for (auto index : session->step_outputs) {
+        result.push_back(std::move(outputs[index]));
+    }
+    return pack_tensor_list(result);
+}
+
+void graph_session_reset(const std::shared_ptr<CrossGraphSession> &session) {
+    std::lock_guard<std::mutex> lock(session->mutex);
+    session->state = session->initial;
+}
+
+TensorList graph_session_state(const std::shared_ptr<CrossGraphSession> &session) {
+    std::lock_guard<std::mutex> lock(session->mutex);
+    return pack_tensor_list(session->state);
+}
+
+void compiled_graph_profile_start(
+    const std::shared_ptr<CrossCompiledGraph> &compiled,
+    uint64_t capacity)
+{
+    if (capacity == 0) {
+        throw std::invalid_argument("compiled_graph_profile_start: capacity must be positive");
+    }
+    auto profile = std::make_shared<GraphProfile>(static_cast<size_t>(capacity));
+    std::atomic_store(&compiled->last_profile, profile);
+    std::atomic_store(&compiled->profile, profile);
+}
+
+void compiled_graph_profile_stop(
+    const std::shared_ptr<CrossCompiledGraph> &compiled)
+{
+    std::atomic_store(&compiled->profile, std::shared_ptr<GraphProfile>());
+}
+
+namespace {
+
+// Samples of one node or target, reduced to OpProfileStats.
+struct SampleTotals {
+    std::vector<int64_t> wall_ns;
+    int64_t output_bytes = 0;
+    int64_t allocated_bytes = 0;
+    int64_t freed_bytes = 0;
+
+    void add(const SampleTotals &other) {
+        wall_ns.insert(wall_ns.end(), other.wall_ns.begin(), other.wall_ns.end());
+        output_bytes += other.output_bytes;
+        allocated_bytes += other.allocated_bytes;
+        freed_bytes += other.freed_bytes;
+    }
+
+    OpProfileStats summarize(const std::string &name, const std::string &target) {
+        std::sort(wall_ns.begin(), wall_ns.end());
+        const size_t last = wall_ns.size() - 1;
+        OpProfileStats stats;
+        stats.name = rust::String(name);
+        stats.target = rust::String(target);
+        stats.count = wall_ns.size();
+        stats.total_ns = std::accumulate(wall_ns.begin(), wall_ns.end(), int64_t{0});
+        stats.min_ns = wall_ns.front();
+        stats.p50_ns = wall_ns[last * 50 / 100];
+        stats.p99_ns = wall_ns[last * 99 / 100];
+        stats.max_ns = wall_ns.back();
+        stats.output_bytes = output_bytes;
+        stats.allocated_bytes = allocated_bytes;
+        stats.freed_bytes = freed_bytes;
+        return stats;
+    }
+};
+
+std::string op_target(const c10::OperatorHandle &handle) {
+    const auto &name = handle.operator_name();
+    return name.name + "." + (name.overload_name.empty() ? "default" : name.overload_name);
+}
+
+} // namespace
+
+GraphProfileStats compiled_graph_profile_stats(
+    const std::shared_ptr<CrossCompiledGraph> &compiled)
+{
+    const auto profile = std::atomic_load(&compiled->last_profile);
+    if (!profile) {
+        throw std::runtime_error("compiled_graph_profile_stats: the graph was never profiled");
+    }
+
+    // Only the samples still in the ring, and completely written, count.
+    const uint64_t claimed = profile->claimed.load(std::memory_order_acquire);
+    const uint64_t capacity = profile->samples.size();
+    const uint64_t first = claimed > capacity ? claimed - capacity : 0;
+
+    std::vector<SampleTotals> per_node(compiled->ops.size());
+    uint64_t collected = 0;
+    for (uint64_t claim = first; claim < claimed; claim++) {
+        const OpSample &sample = profile->samples[claim % capacity];
+        const uint64_t published = 2 * claim + 2;
+        if (sample.seq.load(std::memory_order_acquire) != published) {
+            continue;
+        }
+        const uint32_t op = sample.op.load(std::memory_order_relaxed);
+        const int64_t wall_ns = sample.wall_ns.load(std::memory_order_relaxed);
+        const int64_t output_bytes = sample.output_bytes.load(std::memory_order_relaxed);
+        const int64_t allocated_bytes = sample.allocated_bytes.load(std::memory_order_relaxed);
+        const int64_t freed_bytes = sample.freed_bytes.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sample.seq.load(std::memory_order_relaxed) != published || op >= per_node.size()) {
+            continue;
+        }
+
+        auto &totals = per_node[op];
+        totals.wall_ns.push_back(wall_ns);
+        totals.output_bytes += output_bytes;
+        totals.allocated_bytes += allocated_bytes;
+        totals.freed_bytes += freed_bytes;
+        collected++;
+    }
+
+    GraphProfileStats stats;
+    stats.runs = profile->runs.load(std::memory_order_relaxed);
+    stats.samples = collected;
+    stats.dropped = claimed - collected;
+
+    std::map<std::string, SampleTotals> per_target;
+    for (size_t i = 0; i < per_node.size(); i++) {
+        if (per_node[i].wall_ns.empty()) {
+            continue;
+        }
+        const auto &op = compiled->ops[i];
+        const std::string target = op_target(op.handle);
+        per_target[target].add(per_node[i]);
+        stats.nodes.push_back(per_node[i].summarize(op.node, target));
+    }
+    for (auto &entry : per_target) {
+        stats.targets.push_back(entry.second.summarize(entry.first, entry.first));
+    }
+    return stats;
+}
@@ -0,0 +1,304 @@
+#include "extorch/src/native.rs.h"
+#include "extorch/include/fused_pointwise.h"
+
+#include <ATen/TensorIterator.h>
+#include <ATen/cpu/vec/vec.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+// ============================================================================
+// Fused pointwise programs
+// ============================================================================
+
+namespace {
+
+// Binary opcodes are below kFirstUnary. Keep in sync with ExTorch.Tensor.Lazy.
+enum Opcode : int64_t {
+    kAdd = 0,
+    kSub = 1,
+    kMul = 2,
+    kDiv = 3,
+    kMaximum = 4,
+    kMinimum = 5,
+    kPow = 6,
+    kFirstUnary = 10,
+    kNeg = 10,
+    kAbs = 11,
+    kExp = 12,
+    kLog = 13,
+    kSqrt = 14,
+    kRsqrt = 15,
+    kSigmoid = 16,
+    kTanh = 17,
+    kRelu = 18,
+    kReciprocal = 19,
+    kLastOpcode = 19,
+};
+
+// Elements per register block. Small enough that the registers of a
+// typical program stay cache resident, and a multiple of every vector width.
+constexpr int64_t kBlock = 512;
+
+struct Instruction {
+    Opcode op;
+    int64_t a;
+    int64_t b;
+};
+
+struct Program {
+    size_t num_inputs = 0;
+    std::vector<double> consts;
+    std::vector<Instruction> insts;
+
+    size_t first_temp() const { return num_inputs + consts.size(); }
+    size_t num_registers() const { return first_temp() + insts.size(); }
+};
+
+bool is_binary(Opcode op) { return op < kFirstUnary; }
+
+Program parse_program(
+    size_t num_inputs,
+    const rust::Vec<double> &consts,
+    const rust::Vec<int64_t> &program)
+{
+    if (program.empty() || program.size() % 3 != 0) {
+        throw std::invalid_argument(
+            "Fused pointwise program must be a non-empty list of (op, a, b) triples");
+    }
+
+    Program p;
+    p.num_inputs = num_inputs;
+    p.consts.assign(consts.begin(), consts.end());
+
+    auto check_register = [](int64_t reg, size_t defined) {
+        if (reg < 0 || static_cast<size_t>(reg) >= defined) {
+            throw std::invalid_argument(
+                "Fused pointwise program reads undefined register " + std::to_string(reg));
+        }
+    };
+
+    size_t defined = p.first_temp();
+    for (size_t i = 0; i < program.size(); i += 3) {
+        int64_t code = program[i];
+        bool known = (code >= kAdd && code <= kPow) || (code >= kFirstUnary && code <= kLastOpcode);
+        if (!known) {
+            throw std::invalid_argument("Unknown fused pointwise opcode " + std::to_string(code));
+        }
+
+        Instruction inst{static_cast<Opcode>(code), program[i + 1], program[i + 2]};
+        check_register(inst.a, defined);
+        if (is_binary(inst.op)) {
+            check_register(inst.b, defined);
+        }
+        p.insts.push_back(inst);
+        defined++;
+    }
+    return p;
+}
+
+// ----------------------------------------------------------------------------
+// Vectorized CPU kernel
+// ----------------------------------------------------------------------------
+
+template <typename T>
+using Vec = at::vec::Vectorized<T>;
+
+template <typename T>
+inline Vec<T> apply_binary(Opcode op, const Vec<T> &x, const Vec<T> &y) {
+    switch (op) {
+        case kAdd: return x + y;
+        case kSub: return x - y;
+        case kMul: return x * y;
+        case kDiv: return x / y;
+        case kMaximum: return at::vec::maximum(x, y);
+        case kMinimum: return at::vec::minimum(x, y);
+        default: return x.pow(y);
+    }
+}
+
+template <typename T>
+inline Vec<T> apply_unary(Opcode op, const Vec<T> &x) {
+    switch (op) {
+        case kNeg: return x.neg();
+        case kAbs: return x.abs();
+        case kExp: return x.exp();
+        case kLog: return x.log();
+        case kSqrt: return x.sqrt();
+        case kRsqrt: return x.rsqrt();
+        case kSigmoid: {
+            const Vec<T> one(T(1));
+            return one / (one + x.neg().exp());
+        }
+        case kTanh: return x.tanh();
+        case kRelu: return at::vec::clamp_min(x, Vec<T>(T(0)));
+        default: return x.reciprocal();
+    }
+}
+
+// Run the program over one TensorIterator loop: operand 0 is the output,
+// operands 1..num_inputs the (broadcast) inputs. Each block of up to
+// kBlock elements is gathered into registers, evaluated instruction by
+// instruction, and the last register scattered to the output.
+template <typename T>
+void run_program(const Program &p, char **data, const int64_t *strides, int64_t n) {
+    thread_local std::vector<T> regs;
+    regs.resize(p.num_registers() * kBlock);
+
+    for (size_t c = 0; c < p.consts.size(); c++) {
+        T *reg = regs.data() + (p.num_inputs + c) * kBlock;
+        std::fill(reg, reg + kBlock, static_cast<T>(p.consts[c]));
+    }
+
+    const size_t result = p.num_registers() - 1;
+    for (int64_t start = 0; start < n; start += kBlock) {
+        const int64_t len = std::min(kBlock, n - start);
+        // Tail lanes past `len` hold stale but finite values and are never stored.
+        const int64_t padded = (len + Vec<T>::size() - 1) / Vec<T>::size() * Vec<T>::size();
+
+        for (size_t i = 0; i < p.num_inputs; i++) {
+            T *dst = regs.data() + i * kBlock;
+            const int64_t stride = strides[i + 1];
+            const char *src = data[i + 1] + start * stride;
+            if (stride == static_cast<int64_t>(sizeof(T))) {
+                std::memcpy(dst, src, len * sizeof(T));
+            } else if (stride == 0) {
+                std::fill(dst, dst + len, *reinterpret_cast<const T *>(src));
+            } else {
+                for (int64_t j = 0; j < len; j++) {
+                    dst[j] = *reinterpret_cast<const T *>(src + j * stride);
+                }
+            }
+        }
+
+        size_t reg = p.first_temp();
+        for (const auto &inst : p.insts) {
+            T *out = regs.data() + reg * kBlock;
+            const T *x = regs.data() + inst.a * kBlock;
+            if (is_binary(inst.op)) {
+                const T *y = regs.data() + inst.b * kBlock;
+                for (int64_t j = 0; j < padded; j += Vec<T>::size()) {
+                    apply_binary(inst.op, Vec<T>::loadu(x + j), Vec<T>::loadu(y + j)).store(out + j);
+                }
+            } else {
+                for (int64_t j = 0; j < padded; j += Vec<T>::size()) {
+                    apply_unary(inst.op, Vec<T>::loadu(x + j)).store(out + j);
+                }
+            }
+            reg++;
+        }
+
+        const T *src = regs.data() + result * kBlock;
+        const int64_t out_stride = strides[0];
+        char *dst = data[0] + start * out_stride;
+        if (out_stride == static_cast<int64_t>(sizeof(T))) {
+            std::memcpy(dst, src, len * sizeof(T));
+        } else {
+            for (int64_t j = 0; j < len; j++) {
+                *reinterpret_cast<T *>(dst + j * out_stride) = src[j];
+            }
+        }
+    }
+}
+
+torch::Tensor eval_fused(const Program &p, const std::vector<torch::Tensor> &inputs) {
+    at::TensorIteratorConfig config;
+    config.add_owned_output(torch::Tensor())
+        .promote_inputs_to_common_dtype(true)
+        .promote_integer_inputs_to_float(true);
+    for (const auto &input : inputs) {
+        config.add_input(input);
+    }
+    auto iter = config.build();
+
+    if (iter.common_dtype() == torch::kFloat) {
+        iter.for_each([&](char **data, const int64_t *strides, int64_t n) {
+            run_program<float>(p, data, strides, n);
+        });
+    } else {
+        iter.for_each([&](char **data, const int64_t *strides, int64_t n) {
+            run_program<double>(p, data, strides, n);
+        });
+    }
+    return iter.output();
+}
+
+// ----------------------------------------------------------------------------
+// Op-by-op fallback
+// ----------------------------------------------------------------------------
+
+torch::Tensor eval_eager(const Program &p, const std::vector<torch::Tensor> &inputs) {
+    std::vector<torch::Tensor> regs;
+    regs.reserve(p.num_registers());
+    for (const auto &input : inputs) {
+        bool integral = at::isIntegralType(input.scalar_type(), /*includeBool=*/true);
+        regs.push_back(integral ? input.to(torch::get_default_dtype_as_scalartype()) : input);
+    }
+    for (double value : p.consts) {
+        // Wrapped numbers take part in broadcasting without affecting the
+        // result dtype, the same as a Python scalar operand.
+        auto scalar = c10::scalar_to_tensor(value);
+        scalar.unsafeGetTensorImpl()->set_wrapped_number(true);
+        regs.push_back(std::move(scalar));
+    }
+
+    for (const auto &inst : p.insts) {
+        const auto &x = regs[inst.a];
+        torch::Tensor out;
+        switch (inst.op) {
+            case kAdd: out = at::add(x, regs[inst.b]); break;
+            case kSub: out = at::sub(x, regs[inst.b]); break;
+            case kMul: out = at::mul(x, regs[inst.b]); break;
+            case kDiv: out = at::div(x, regs[inst.b]); break;
+            case kMaximum: out = at::maximum(x, regs[inst.b]); break;
+            case kMinimum: out = at::minimum(x, regs[inst.b]); break;
+            case kPow: out = at::pow(x, regs[inst.b]); break;
+            case kNeg: out = at::neg(x); break;
+            case kAbs: out = at::abs(x); break;
+            case kExp: out = at::exp(x); break;
+            case kLog: out = at::log(x); break;
+            case kSqrt: out = at::sqrt(x); break;
+            case kRsqrt: out = at::rsqrt(x); break;
+            case kSigmoid: out = at::sigmoid(x); break;
+            case kTanh: out = at::tanh(x); break;
+            case kRelu: out = at::relu(x); break;
+            default: out = at::reciprocal(x); break;
+        }
+        regs.push_back(std::move(out));
+    }
+    return regs.back();
+}
+
+bool can_fuse(const std::vector<torch::Tensor> &inputs) {
+    if (inputs.empty()) {
+        return false;
+    }
+    for (const auto &input : inputs) {
+        if (!input.device().is_cpu() || input.layout() != torch::kStrided) {
+            return false;
+        }
+        if (torch::GradMode::is_enabled() && input.requires_grad()) {
+            return false;
+        }
+    }
+    auto dtype = at::result_type(at::TensorList(inputs));
+    if (at::isIntegralType(dtype, /*includeBool=*/true)) {
+        dtype = torch::get_default_dtype_as_scalartype();
+    }
+    return dtype == torch::kFloat || dtype == torch::kDouble;
+}
+
+} // namespace
+
+std::shared_ptr<CrossTensor> fused_pointwise(
+    TensorList inputs,
+    rust::Vec<double> consts,
+    rust::Vec<int64_t> program)
+{
+    auto input_vec = unpack_tensor_list(std::move(inputs));
+    auto p = parse_program(input_vec.size(), consts, program);
+
+    torch::Tensor result = can_fuse(input_vec) ? eval_fused(p, input_vec) : eval_eager(p, input_vec);
+    return std::make_shared<CrossTensor>(std::move(result));
+}
@@ -2,6 +2,8 @@
 #include "extorch/include/info.h"
 #include "extorch/include/printing.h"
 
+#include <fstream>
+
 
 rust::Slice<const int64_t> size(const std::shared_ptr<CrossTensor> &tensor)
 {
@@ -343,6 +345,40 @@ std::shared_ptr<CrossTensor> from_binary(
     return std::make_shared<CrossTensor>(std::move(tensor));
 }
 
+std::shared_ptr<CrossTensor> from_file(
+    rust::String path,
+    int64_t offset,
+    rust::Vec<int64_t> shape,
+    rust::String s_dtype)
+{
+    std::string dtype_str(s_dtype);
+    auto dtype = type_mapping[dtype_str];
+    auto opts = torch::TensorOptions().dtype(dtype);
+
+    const int64_t *shape_ptr = shape.data();
+    auto shape_ref = torch::IntArrayRef{shape_ptr, shape.size()};
+
+    // Read straight into libtorch memory, so the bytes are never staged in
+    // an Erlang binary first.
+    std::string path_str(path);
+    std::ifstream in(path_str, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open " + path_str);
+    }
+
+    auto tensor = torch::empty(shape_ref, opts);
+    auto nbytes = static_cast<std::streamsize>(tensor.nbytes());
+    in.seekg(offset);
+    in.read(static_cast<char *>(tensor.data_ptr()), nbytes);
+    if (in.gcount() != nbytes) {
+        throw std::runtime_error(
+            "Unexpected end of file reading " + std::to_string(nbytes) +
+            " bytes at offset " + std::to_string(offset) + " of " + path_str);
+    }
+
+    return std::make_shared<CrossTensor>(std::move(tensor));
+}
+
 std::shared_ptr<CrossTensor> from_blob(
     int64_t ptr,
     rust::Vec<int64_t> shape,
@@ -92,3 +92,126 @@ IValueFlat flatten_ivalue(const c10::IValue &ivalue) {
     flatten_ivalue_recursive(ivalue, result.nodes, -1);
     return result;
 }
+
+// ============================================================================
+// Compact encoding
+// ============================================================================
+
+// Dicts from str or int keys to int or float values are written as packed
+// arrays (tags 14-17): the keys to `strings` or `list_ints`, then the values
+// to `list_ints` or `list_floats`. Returns false for any other dict type.
+static bool pack_scalar_dict(const c10::impl::GenericDict &dict, IValuePacked &out) {
+    const auto key_kind = dict.keyType()->kind();
+    const auto value_kind = dict.valueType()->kind();
+    const bool str_keys = key_kind == c10::TypeKind::StringType;
+    const bool float_values = value_kind == c10::TypeKind::FloatType;
+    if ((!str_keys && key_kind != c10::TypeKind::IntType) ||
+        (!float_values && value_kind != c10::TypeKind::IntType)) {
+        return false;
+    }
+
+    const auto size = static_cast<int64_t>(dict.size());
+    out.tags.push_back(static_cast<uint8_t>(14 + (str_keys ? 0 : 2) + (float_values ? 1 : 0)));
+    out.values.push_back(size);
+    if (str_keys) {
+        out.strings.reserve(out.strings.size() + size);
+        for (const auto &entry : dict) out.strings.push_back(rust::String(entry.key().toStringRef()));
+    } else {
+        out.list_ints.reserve(out.list_ints.size() + size);
+        for (const auto &entry : dict) out.list_ints.push_back(entry.key().toInt());
+    }
+    if (float_values) {
+        out.list_floats.reserve(out.list_floats.size() + size);
+        for (const auto &entry : dict) out.list_floats.push_back(entry.value().toDouble());
+    } else {
+        out.list_ints.reserve(out.list_ints.size() + size);
+        for (const auto &entry : dict) out.list_ints.push_back(entry.value().toInt());
+    }
+    return true;
+}
+
+static void pack_ivalue_recursive(const c10::IValue &ivalue, IValuePacked &out) {
+    if (ivalue.isTensor()) {
+        out.tags.push_back(0);
+        out.values.push_back(static_cast<int64_t>(out.tensors.values.size()));
+        TensorOut t;
+        t.tensor = std::make_shared<CrossTensor>(ivalue.toTensor());
+        t.used = true;
+        out.tensors.values.push_back(std::move(t));
+    } else if (ivalue.isInt()) {
+        out.tags.push_back(1);
+        out.values.push_back(ivalue.toInt());
+    } else if (ivalue.isDouble()) {
+        out.tags.push_back(2);
+        out.values.push_back(0);
+        out.floats.push_back(ivalue.toDouble());
+    } else if (ivalue.isBool()) {
+        out.tags.push_back(3);
+        out.values.push_back(ivalue.toBool() ? 1 : 0);
+    } else if (ivalue.isString()) {
+        out.tags.push_back(4);
+        out.values.push_back(0);
+        out.strings.push_back(rust::String(ivalue.toStringRef()));
+    } else if (ivalue.isNone()) {
+        out.tags.push_back(5);
+        out.values.push_back(0);
+    } else if (ivalue.isDevice()) {
+        auto dev = ivalue.toDevice();
+        out.tags.push_back(9);
+        out.values.push_back(dev.has_index() ? dev.index() : -1);
+        out.strings.push_back(rust::String(c10::DeviceTypeName(dev.type())));
+    } else if (ivalue.isIntList()) {
+        auto list = ivalue.toIntList();
+        out.tags.push_back(11);
+        out.values.push_back(static_cast<int64_t>(list.size()));
+        for (int64_t v : list) out.list_ints.push_back(v);
+    } else if (ivalue.isDoubleList()) {
+        auto list = ivalue.toDoubleList();
+        out.tags.push_back(12);
+        out.values.push_back(static_cast<int64_t>(list.size()));
+        for (double v : list) out.list_floats.push_back(v);
+    } else if (ivalue.isBoolList()) {
+        auto list = ivalue.toBoolList();
+        out.tags.push_back(13);
+        out.values.push_back(static_cast<int64_t>(list.size()));
+        for (bool v : list) out.list_ints.push_back(v ? 1 : 0);
+    } else if (ivalue.isTuple()) {
+        auto tuple = ivalue.toTuple();
+        out.tags.push_back(6);
+        out.values.push_back(static_cast<int64_t>(tuple->elements().size()));
+        for (const auto &elem : tuple->elements()) {
+            pack_ivalue_recursive(elem, out);
+        }
+    } else if (ivalue.isList()) {
+        auto list = ivalue.toList();
+        out.tags.push_back(7);
+        out.values.push_back(static_cast<int64_t>(list.size()));
+        for (const auto &elem : list) {
+            pack_ivalue_recursive(elem, out);
+        }
+    } else if (ivalue.isGenericDict()) {
+        auto dict = ivalue.toGenericDict();
+        if (pack_scalar_dict(dict, out)) return;
+        // Unlike IValueFlat, the value is the number of entries.
+        out.tags.push_back(8);
+        out.values.push_back(static_cast<int64_t>(dict.size()));
+        for (const auto &entry : dict) {
+            pack_ivalue_recursive(entry.key(), out);
+            pack_ivalue_recursive(entry.value(), out);
+        }
+    } else {
+        // Fallback: represent as string
+        std::ostringstream oss;
+        oss << ivalue;
+        out.tags.push_back(4);
+        out.values.push_back(0);
+        out.strings.push_back(rust::String(oss.str()));
+    }
+}
+
+IValuePacked pack_ivalue(const c10::IValue &ivalue) {
+    IValuePacked result;
+    result.tensors.used = true;
+    pack_ivalue_recursive(ivalue, result);
+    return result;
+}
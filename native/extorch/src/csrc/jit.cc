@@ -2,6 +2,11 @@
 #include "extorch/include/jit.h"
 #include "extorch/include/ivalue_utils.h"
 
+#include <torch/csrc/jit/codegen/fuser/interface.h>
+#include <torch/csrc/jit/passes/tensorexpr_fuser.h>
+#include <torch/csrc/jit/runtime/graph_executor.h>
+#include <torch/csrc/jit/runtime/profiling_graph_executor_impl.h>
+
 
 // Helper: convert Device struct to torch::Device
 static torch::Device make_torch_device(const Device &s_device) {
@@ -54,25 +59,27 @@ void jit_save(
 // Forward / Invoke
 // ============================================================================
 
-IValueFlat jit_forward(
+IValuePacked jit_forward(
     const std::shared_ptr<CrossModule> &module,
     TensorList inputs)
 {
+    MemoryScope memory_scope(module->memory);
     auto ivalue_inputs = make_inputs(std::move(inputs));
     auto result = module->module.forward(ivalue_inputs);
-    return flatten_ivalue(result);
+    return pack_ivalue(result);
 }
 
-IValueFlat jit_invoke_method(
+IValuePacked jit_invoke_method(
     const std::shared_ptr<CrossModule> &module,
     rust::String method_name,
     TensorList inputs)
 {
+    MemoryScope memory_scope(module->memory);
     std::string name_str(method_name);
     auto ivalue_inputs = make_inputs(std::move(inputs));
     auto method = module->module.get_method(name_str);
     auto result = method(ivalue_inputs);
-    return flatten_ivalue(result);
+    return pack_ivalue(result);
 }
 
 // ============================================================================
@@ -128,6 +135,19 @@ rust::Vec<rust::String> jit_named_modules(
     return names;
 }
 
+ModelMemoryStats jit_memory_stats(
+    const std::shared_ptr<CrossModule> &module)
+{
+    std::vector<torch::Tensor> weights;
+    for (const auto &param : module->module.parameters()) {
+        weights.push_back(param);
+    }
+    for (const auto &buf : module->module.buffers()) {
+        weights.push_back(buf);
+    }
+    return model_memory_stats(*module->memory, storage_bytes(weights));
+}
+
 // ============================================================================
 // Mode setting
 // ============================================================================
@@ -154,6 +174,158 @@ std::shared_ptr<CrossModule> jit_to_device(
     return std::make_shared<CrossModule>(std::move(cloned));
 }
 
+// Resolve an optional dtype name ("" keeps each tensor's dtype).
+static c10::optional<torch::ScalarType> parse_optional_dtype(const rust::String &s_dtype) {
+    std::string dtype_str(s_dtype);
+    if (dtype_str.empty()) {
+        return c10::nullopt;
+    }
+    auto it = type_mapping.find(dtype_str);
+    if (it == type_mapping.end()) {
+        throw std::invalid_argument("Unknown dtype: " + dtype_str);
+    }
+    return it->second;
+}
+
+// Convert one parameter or buffer in place. Its autograd identity (and
+// slot in the module) is kept; only the data is swapped, so the old
+// storage is released as soon as nothing else references it. Like
+// nn.Module.to, dtype conversion only applies to floating point tensors,
+// leaving e.g. integer BatchNorm counters untouched.
+static void state_tensor_to(
+    torch::Tensor tensor,
+    const torch::Device &device,
+    const c10::optional<torch::ScalarType> &dtype,
+    bool non_blocking)
+{
+    auto target_dtype = (dtype.has_value() && tensor.is_floating_point())
+        ? *dtype : tensor.scalar_type();
+    if (tensor.device() == device && tensor.scalar_type() == target_dtype) {
+        return;
+    }
+    torch::NoGradGuard no_grad;
+    tensor.set_data(tensor.to(device, target_dtype, non_blocking));
+}
+
+void jit_to_inplace(
+    const std::shared_ptr<CrossModule> &module,
+    Device s_device,
+    rust::String s_dtype,
+    bool non_blocking)
+{
+    auto device = make_torch_device(s_device);
+    auto dtype = parse_optional_dtype(s_dtype);
+    for (const auto &param : module->module.named_parameters(/*recurse=*/true)) {
+        state_tensor_to(param.value, device, dtype, non_blocking);
+    }
+    for (const auto &buf : module->module.named_buffers(/*recurse=*/true)) {
+        state_tensor_to(buf.value, device, dtype, non_blocking);
+    }
+}
+
+rust::Vec<rust::String> jit_state_names(
+    const std::shared_ptr<CrossModule> &module)
+{
+    rust::Vec<rust::String> names;
+    for (const auto &param : module->module.named_parameters(/*recurse=*/true)) {
+        names.push_back(rust::String(param.name));
+    }
+    for (const auto &buf : module->module.named_buffers(/*recurse=*/true)) {
+        names.push_back(rust::String(buf.name));
+    }
+    return names;
+}
+
+void jit_state_to(
+    const std::shared_ptr<CrossModule> &module,
+    rust::String name,
+    Device s_device,
+    rust::String s_dtype,
+    bool non_blocking)
+{
+    auto device = make_torch_device(s_device);
+    auto dtype = parse_optional_dtype(s_dtype);
+
+    // Walk "sub.module.weight" down to the owning submodule.
+    std::string path(name);
+    torch::jit::Module owner = module->module;
+    size_t start = 0;
+    size_t dot;
+    while ((dot = path.find('.', start)) != std::string::npos) {
+        auto child = path.substr(start, dot - start);
+        if (!owner.hasattr(child) || !owner.attr(child).isModule()) {
+            throw std::invalid_argument("jit_state_to: no submodule for " + path);
+        }
+        owner = owner.attr(child).toModule();
+        start = dot + 1;
+    }
+    auto attr = path.substr(start);
+    if (!owner.hasattr(attr) || !owner.attr(attr).isTensor()) {
+        throw std::invalid_argument("jit_state_to: no parameter or buffer " + path);
+    }
+    state_tensor_to(owner.attr(attr).toTensor(), device, dtype, non_blocking);
+}
+
+// ============================================================================
+// Inference optimization
+// ============================================================================
+
+std::shared_ptr<CrossModule> jit_freeze(
+    const std::shared_ptr<CrossModule> &module,
+    bool optimize)
+{
+    // freeze() requires eval mode; work on a clone so the caller's module
+    // keeps its training flag and attributes.
+    auto cloned = module->module.clone();
+    cloned.eval();
+    auto frozen = torch::jit::freeze(cloned);
+    if (optimize) {
+        frozen = torch::jit::optimize_for_inference(frozen);
+    }
+    return std::make_shared<CrossModule>(std::move(frozen));
+}
+
+JitExecutorOptions jit_get_executor_options() {
+    JitExecutorOptions options;
+    options.profiling_executor = torch::jit::getProfilingMode();
+    size_t runs = torch::jit::getNumProfiledRuns();
+    options.num_profiled_runs = static_cast<int64_t>(runs);
+    for (const auto &entry : torch::jit::getFusionStrategy()) {
+        options.fusion_behaviors.push_back(
+            entry.first == torch::jit::FusionBehavior::STATIC ? 0 : 1);
+        options.fusion_depths.push_back(static_cast<int64_t>(entry.second));
+    }
+    options.cpu_fusion = torch::jit::canFuseOnCPU();
+    options.texpr_fuser = torch::jit::tensorExprFuserEnabled();
+    return options;
+}
+
+void jit_set_executor_options(JitExecutorOptions options) {
+    if (options.num_profiled_runs < 0) {
+        throw std::invalid_argument("jit_set_executor_options: num_profiled_runs must be >= 0");
+    }
+    if (options.fusion_behaviors.size() != options.fusion_depths.size()) {
+        throw std::invalid_argument("jit_set_executor_options: malformed fusion strategy");
+    }
+
+    torch::jit::FusionStrategy strategy;
+    for (size_t i = 0; i < options.fusion_behaviors.size(); i++) {
+        if (options.fusion_depths[i] < 0) {
+            throw std::invalid_argument("jit_set_executor_options: fusion depth must be >= 0");
+        }
+        auto behavior = options.fusion_behaviors[i] == 0
+            ? torch::jit::FusionBehavior::STATIC
+            : torch::jit::FusionBehavior::DYNAMIC;
+        strategy.emplace_back(behavior, static_cast<size_t>(options.fusion_depths[i]));
+    }
+
+    torch::jit::getProfilingMode() = options.profiling_executor;
+    torch::jit::getNumProfiledRuns() = static_cast<size_t>(options.num_profiled_runs);
+    torch::jit::setFusionStrategy(strategy);
+    torch::jit::overrideCanFuseOnCPU(options.cpu_fusion);
+    torch::jit::setTensorExprFuserEnabled(options.texpr_fuser);
+}
+
 // ============================================================================
 // IR Introspection
 // ============================================================================
@@ -0,0 +1,346 @@
+#include "extorch/src/native.rs.h"
+#include "extorch/include/kv_cache.h"
+
+#include <torch/library.h>
+
+#include <algorithm>
+#include <numeric>
+#include <optional>
+
+// ============================================================================
+// Paged KV cache
+// ============================================================================
+
+namespace {
+
+using Cache = CrossKVCacheImpl;
+
+// Live caches by id, for the dispatcher op.
+std::mutex registry_mutex;
+std::unordered_map<int64_t, std::weak_ptr<Cache>> registry;
+int64_t next_cache_id = 0;
+
+std::shared_ptr<Cache> lookup_cache(int64_t id) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto it = registry.find(id);
+    std::shared_ptr<Cache> cache = it == registry.end() ? nullptr : it->second.lock();
+    if (!cache) {
+        throw std::invalid_argument("kv_cache: no live cache with id " + std::to_string(id));
+    }
+    return cache;
+}
+
+int64_t blocks_for(const Cache &cache, int64_t tokens) {
+    return (tokens + cache.block_size - 1) / cache.block_size;
+}
+
+Cache::Sequence &find_sequence(Cache &cache, int64_t sequence, int64_t layer, const char *caller) {
+    auto it = cache.sequences.find(sequence);
+    if (it == cache.sequences.end()) {
+        throw std::invalid_argument(
+            std::string(caller) + ": unknown sequence " + std::to_string(sequence));
+    }
+    if (layer < 0 || layer >= cache.num_layers) {
+        throw std::out_of_range(
+            std::string(caller) + ": layer " + std::to_string(layer) +
+            " out of range for a cache of " + std::to_string(cache.num_layers) + " layers");
+    }
+    return it->second;
+}
+
+// `[num_heads, n, head_dim]` view of a step's keys or values, converted
+// to the pool's dtype and device.
+torch::Tensor step_tensor(const Cache &cache, const torch::Tensor &tensor, const char *caller) {
+    torch::Tensor step = tensor.dim() == 4 && tensor.size(0) == 1 ? tensor.squeeze(0) : tensor;
+    if (step.dim() != 3 || step.size(0) != cache.num_heads || step.size(2) != cache.head_dim) {
+        throw std::invalid_argument(
+            std::string(caller) + ": expected [" + std::to_string(cache.num_heads) +
+            ", n, " + std::to_string(cache.head_dim) + "] keys and values");
+    }
+    return step.to(cache.keys.options());
+}
+
+// Checks that `query` holds the `[1, num_heads, n, head_dim]` queries of
+// the `n` new tokens and converts it to the dtype and device of the pools.
+torch::Tensor query_tensor(const Cache &cache, const torch::Tensor &query, int64_t n) {
+    if (query.dim() != 4 || query.size(0) != 1 || query.size(1) != cache.num_heads ||
+        query.size(2) != n || query.size(3) != cache.head_dim) {
+        throw std::invalid_argument(
+            "kv_cache_attention: expected a [1, " + std::to_string(cache.num_heads) + ", " +
+            std::to_string(n) + ", " + std::to_string(cache.head_dim) + "] query");
+    }
+    return query.to(cache.keys.options());
+}
+
+// Writes the new tokens into the blocks of `seq`, which must already hold
+// room for them. Runs under the cache mutex.
+void append_locked(
+    Cache &cache, Cache::Sequence &seq, int64_t layer,
+    const torch::Tensor &key, const torch::Tensor &value)
+{
+    const int64_t start = seq.lengths[layer];
+    const int64_t end = start + key.size(1);
+
+    const int64_t needed = blocks_for(cache, end) - static_cast<int64_t>(seq.blocks.size());
+    if (needed > static_cast<int64_t>(cache.free_blocks.size())) {
+        throw std::runtime_error(
+            "kv_cache_append: out of blocks (" + std::to_string(needed) + " needed, " +
+            std::to_string(cache.free_blocks.size()) + " free)");
+    }
+    for (int64_t i = 0; i < needed; i++) {
+        seq.blocks.push_back(cache.free_blocks.back());
+        cache.free_blocks.pop_back();
+    }
+    cache.peak_used_blocks = std::max<int64_t>(
+        cache.peak_used_blocks, cache.num_blocks - static_cast<int64_t>(cache.free_blocks.size()));
+
+    torch::NoGradGuard no_grad;
+    torch::Tensor layer_keys = cache.keys[layer];
+    torch::Tensor layer_values = cache.values[layer];
+    for (int64_t pos = start; pos < end;) {
+        const int64_t block = seq.blocks[pos / cache.block_size];
+        const int64_t offset = pos % cache.block_size;
+        const int64_t count = std::min(cache.block_size - offset, end - pos);
+        layer_keys.select(1, block).narrow(1, offset, count)
+            .copy_(key.narrow(1, pos - start, count));
+        layer_values.select(1, block).narrow(1, offset, count)
+            .copy_(value.narrow(1, pos - start, count));
+        pos += count;
+    }
+    seq.lengths[layer] = end;
+}
+
+// The keys and values of `layer` of `seq` as two `[1, num_heads, length,
+// head_dim]` tensors. The blocks are copied out with one index_select per
+// pool, after which the reshape is a view; with `allow_view`, blocks that
+// sit next to each other in the pool (a sequence that grew alone) are
+// returned as a view of the pool instead. Runs under the cache mutex; a
+// copy stays valid after it is released, a view until the sequence is
+// freed.
+std::pair<torch::Tensor, torch::Tensor> gather_locked(
+    const Cache &cache, const Cache::Sequence &seq, int64_t layer, bool allow_view)
+{
+    const int64_t length = seq.lengths[layer];
+    const int64_t num_blocks = blocks_for(cache, length);
+    const auto first = seq.blocks.begin();
+    const bool adjacent = num_blocks > 0 && std::adjacent_find(
+        first, first + num_blocks,
+        [](int64_t a, int64_t b) { return b != a + 1; }) == first + num_blocks;
+
+    std::optional<torch::Tensor> ids;
+    auto gather = [&](const torch::Tensor &pool) {
+        torch::Tensor blocks;
+        if (allow_view && adjacent) {
+            blocks = pool[layer].narrow(1, seq.blocks[0], num_blocks);
+        } else {
+            if (!ids) {
+                ids = torch::tensor(
+                    std::vector<int64_t>(first, first + num_blocks),
+                    torch::TensorOptions().dtype(torch::kLong)).to(pool.device());
+            }
+            blocks = pool[layer].index_select(1, *ids);
+        }
+        return blocks
+            .reshape({cache.num_heads, num_blocks * cache.block_size, cache.head_dim})
+            .narrow(1, 0, length)
+            .unsqueeze(0);
+    };
+    return {gather(cache.keys), gather(cache.values)};
+}
+
+torch::Tensor attention(
+    const std::shared_ptr<Cache> &cache, int64_t sequence, int64_t layer,
+    const torch::Tensor &query, const torch::Tensor &key, const torch::Tensor &value,
+    std::optional<double> scale)
+{
+    // Everything is checked before the cache advances, so a call that
+    // throws leaves the sequence as it was.
+    torch::Tensor step_key = step_tensor(*cache, key, "kv_cache_attention");
+    torch::Tensor step_value = step_tensor(*cache, value, "kv_cache_attention");
+    if (step_key.sizes() != step_value.sizes()) {
+        throw std::invalid_argument("kv_cache_attention: keys and values differ in shape");
+    }
+    torch::Tensor step_query = query_tensor(*cache, query, step_key.size(1));
+
+    std::pair<torch::Tensor, torch::Tensor> cached;
+    {
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        auto &seq = find_sequence(*cache, sequence, layer, "kv_cache_attention");
+        append_locked(*cache, seq, layer, step_key, step_value);
+        cached = gather_locked(*cache, seq, layer, true);
+    }
+
+    // The new tokens are the last ones of the cache: token i of the query
+    // sees every cached token up to its own position.
+    std::optional<torch::Tensor> mask;
+    const int64_t n = step_query.size(2);
+    if (n > 1) {
+        const int64_t length = cached.first.size(2);
+        auto options = torch::TensorOptions().dtype(torch::kLong).device(step_query.device());
+        mask = torch::arange(length, options).unsqueeze(0) <=
+               (torch::arange(n, options) + (length - n)).unsqueeze(1);
+    }
+    return at::scaled_dot_product_attention(
+        step_query, cached.first, cached.second, mask, 0.0, false, scale);
+}
+
+// extorch::kv_cache_attention, for graphs run by the compiled graph
+// executor. `sequence` is a 0-dim integer tensor so that it can be a graph
+// input.
+at::Tensor kv_cache_attention_op(
+    const at::Tensor &query,
+    const at::Tensor &key,
+    const at::Tensor &value,
+    int64_t cache,
+    const at::Tensor &sequence,
+    int64_t layer,
+    std::optional<double> scale)
+{
+    return attention(lookup_cache(cache), sequence.item<int64_t>(), layer, query, key, value, scale);
+}
+
+}  // namespace
+
+TORCH_LIBRARY(extorch, m) {
+    m.def(
+        "kv_cache_attention(Tensor query, Tensor key, Tensor value, int cache, "
+        "Tensor sequence, int layer, float? scale=None) -> Tensor",
+        &kv_cache_attention_op);
+}
+
+CrossKVCacheImpl::~CrossKVCacheImpl() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto it = registry.find(id);
+    if (it != registry.end() && it->second.expired()) {
+        registry.erase(it);
+    }
+}
+
+std::shared_ptr<CrossKVCache> kv_cache_new(KVCacheOptions options) {
+    if (options.num_layers <= 0 || options.num_heads <= 0 || options.head_dim <= 0 ||
+        options.block_size <= 0 || options.num_blocks <= 0) {
+        throw std::invalid_argument("kv_cache_new: every dimension must be positive");
+    }
+
+    auto cache = std::make_shared<Cache>();
+    cache->num_layers = options.num_layers;
+    cache->num_heads = options.num_heads;
+    cache->head_dim = options.head_dim;
+    cache->block_size = options.block_size;
+    cache->num_blocks = options.num_blocks;
+
+    auto tensor_options = get_tensor_options(
+        options.dtype, "strided", options.device, false, false, "contiguous");
+    // Heads come before blocks so that the blocks of a head, once
+    // gathered, are already laid out as `[length, head_dim]`.
+    const std::vector<int64_t> shape = {
+        options.num_layers, options.num_heads, options.num_blocks,
+        options.block_size, options.head_dim};
+    cache->keys = torch::zeros(shape, tensor_options);
+    cache->values = torch::zeros(shape, tensor_options);
+
+    // Blocks are taken from the back, lowest index first.
+    cache->free_blocks.resize(options.num_blocks);
+    std::iota(cache->free_blocks.rbegin(), cache->free_blocks.rend(), 0);
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    int64_t id = options.id;
+    if (id < 0) {
+        while (registry.count(next_cache_id) && !registry[next_cache_id].expired()) {
+            next_cache_id++;
+        }
+        id = next_cache_id++;
+    } else if (registry.count(id) && !registry[id].expired()) {
+        throw std::invalid_argument("kv_cache_new: id " + std::to_string(id) + " is taken");
+    }
+    cache->id = id;
+    registry[id] = cache;
+    return cache;
+}
+
+int64_t kv_cache_add_sequence(const std::shared_ptr<CrossKVCache> &cache) {
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    const int64_t sequence = cache->next_sequence++;
+    cache->sequences[sequence].lengths.assign(cache->num_layers, 0);
+    return sequence;
+}
+
+void kv_cache_free_sequence(const std::shared_ptr<CrossKVCache> &cache, int64_t sequence) {
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    auto &seq = find_sequence(*cache, sequence, 0, "kv_cache_free_sequence");
+    cache->free_blocks.insert(cache->free_blocks.end(), seq.blocks.rbegin(), seq.blocks.rend());
+    cache->sequences.erase(sequence);
+}
+
+int64_t kv_cache_sequence_length(
+    const std::shared_ptr<CrossKVCache> &cache,
+    int64_t sequence,
+    int64_t layer)
+{
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    return find_sequence(*cache, sequence, layer, "kv_cache_sequence_length").lengths[layer];
+}
+
+void kv_cache_append(
+    const std::shared_ptr<CrossKVCache> &cache,
+    int64_t sequence,
+    int64_t layer,
+    const std::shared_ptr<CrossTensor> &key,
+    const std::shared_ptr<CrossTensor> &value)
+{
+    torch::Tensor step_key = step_tensor(*cache, *key, "kv_cache_append");
+    torch::Tensor step_value = step_tensor(*cache, *value, "kv_cache_append");
+    if (step_key.sizes() != step_value.sizes()) {
+        throw std::invalid_argument("kv_cache_append: keys and values differ in shape");
+    }
+
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    auto &seq = find_sequence(*cache, sequence, layer, "kv_cache_append");
+    append_locked(*cache, seq, layer, step_key, step_value);
+}
+
+TensorList kv_cache_gather(
+    const std::shared_ptr<CrossKVCache> &cache,
+    int64_t sequence,
+    int64_t layer)
+{
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    auto &seq = find_sequence(*cache, sequence, layer, "kv_cache_gather");
+    auto gathered = gather_locked(*cache, seq, layer, false);
+    return pack_tensor_list({gathered.first, gathered.second});
+}
+
+std::shared_ptr<CrossTensor> kv_cache_attention(
+    const std::shared_ptr<CrossKVCache> &cache,
+    int64_t sequence,
+    int64_t layer,
+    const std::shared_ptr<CrossTensor> &query,
+    const std::shared_ptr<CrossTensor> &key,
+    const std::shared_ptr<CrossTensor> &value,
+    double scale,
+    bool has_scale)
+{
+    std::optional<double> scale_opt;
+    if (has_scale) scale_opt = scale;
+    return std::make_shared<CrossTensor>(
+        attention(cache, sequence, layer, *query, *key, *value, scale_opt));
+}
+
+KVCacheStats kv_cache_stats(const std::shared_ptr<CrossKVCache> &cache) {
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    KVCacheStats stats;
+    stats.id = cache->id;
+    stats.num_blocks = cache->num_blocks;
+    stats.free_blocks = static_cast<int64_t>(cache->free_blocks.size());
+    stats.used_blocks = cache->num_blocks - stats.free_blocks;
+    stats.peak_used_blocks = cache->peak_used_blocks;
+    stats.block_size = cache->block_size;
+    stats.sequences = static_cast<int64_t>(cache->sequences.size());
+    stats.tokens = 0;
+    for (const auto &entry : cache->sequences) {
+        const auto &lengths = entry.second.lengths;
+        stats.tokens += *std::max_element(lengths.begin(), lengths.end());
+    }
+    stats.pool_bytes = static_cast<int64_t>(cache->keys.nbytes() + cache->values.nbytes());
+    return stats;
+}
@@ -0,0 +1,236 @@
+#include "extorch/src/native.rs.h"
+#include "extorch/include/memory_stats.h"
+
+#include <c10/core/Allocator.h>
+#include <c10/core/CPUAllocator.h>
+#include <c10/core/alignment.h>
+#include <c10/core/impl/alloc_cpu.h>
+
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <unordered_set>
+
+// ============================================================================
+// Counting CPU allocator
+// ============================================================================
+
+namespace {
+
+std::atomic<int64_t> live_bytes{0};
+std::atomic<int64_t> peak_bytes{0};
+std::atomic<int64_t> allocations{0};
+std::atomic<int64_t> frees{0};
+std::atomic<bool> tracking{false};
+
+std::atomic<uint64_t> next_request{1};
+thread_local MemoryScope *current_scope = nullptr;
+thread_local AllocationTally *current_tally = nullptr;
+
+void raise_peak(std::atomic<int64_t> &peak, int64_t value) {
+    int64_t seen = peak.load(std::memory_order_relaxed);
+    while (value > seen &&
+           !peak.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+// Every block starts with a header recording what its free has to undo.
+// The header takes a whole alignment unit, so the data keeps the
+// alignment of c10::alloc_cpu, and the context pointer of the DataPtr is
+// the data itself, so raw_allocate / raw_deallocate keep working.
+struct AllocationHeader {
+    size_t nbytes;
+    uint64_t request;
+    std::shared_ptr<MemoryAccount> account;
+};
+
+constexpr size_t kHeaderSize = c10::gAlignment;
+static_assert(sizeof(AllocationHeader) <= kHeaderSize, "allocation header too large");
+
+AllocationHeader *header_of(void *data) {
+    return reinterpret_cast<AllocationHeader *>(static_cast<char *>(data) - kHeaderSize);
+}
+
+void counted_delete(void *data) {
+    if (data == nullptr) {
+        return;
+    }
+    AllocationHeader *header = header_of(data);
+    const int64_t nbytes = static_cast<int64_t>(header->nbytes);
+
+    const int64_t live = live_bytes.fetch_sub(nbytes, std::memory_order_relaxed) - nbytes;
+    frees.fetch_add(1, std::memory_order_relaxed);
+    if (header->account) {
+        header->account->live_bytes.fetch_sub(nbytes, std::memory_order_relaxed);
+        header->account->frees.fetch_add(1, std::memory_order_relaxed);
+        MemoryScope *scope = current_scope;
+        if (scope != nullptr && scope->request == header->request) {
+            scope->live_bytes -= nbytes;
+        }
+    }
+    if (AllocationTally *tally = current_tally) {
+        tally->freed += nbytes;
+    }
+    c10::reportMemoryUsageToProfiler(
+        data, -nbytes, static_cast<size_t>(live), static_cast<size_t>(live),
+        c10::Device(c10::DeviceType::CPU));
+
+    header->~AllocationHeader();
+    c10::free_cpu(header);
+}
+
+// Allocates like the default CPU allocator and counts the live and peak
+// bytes of the process, and of the model whose MemoryScope is active on
+// the allocating thread. Allocations are still reported to the profiler.
+class CountingCPUAllocator final : public c10::Allocator {
+public:
+    c10::DataPtr allocate(size_t nbytes) override {
+        const c10::Device device(c10::DeviceType::CPU);
+        if (nbytes == 0) {
+            return {nullptr, nullptr, &counted_delete, device};
+        }
+
+        void *block = c10::alloc_cpu(nbytes + kHeaderSize);
+        void *data = static_cast<char *>(block) + kHeaderSize;
+        auto *header = new (block) AllocationHeader{nbytes, 0, nullptr};
+
+        const int64_t size = static_cast<int64_t>(nbytes);
+        const int64_t live = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+        raise_peak(peak_bytes, live);
+        allocations.fetch_add(1, std::memory_order_relaxed);
+
+        MemoryScope *scope = current_scope;
+        if (scope != nullptr && scope->account) {
+            header->account = scope->account;
+            header->request = scope->request;
+            MemoryAccount &account = *scope->account;
+            const int64_t model_live =
+                account.live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+            raise_peak(account.peak_bytes, model_live);
+            account.allocations.fetch_add(1, std::memory_order_relaxed);
+            scope->live_bytes += size;
+            scope->peak_bytes = std::max(scope->peak_bytes, scope->live_bytes);
+        }
+
+        if (AllocationTally *tally = current_tally) {
+            tally->allocations++;
+            tally->allocated += size;
+        }
+
+        c10::reportMemoryUsageToProfiler(
+            data, size, static_cast<size_t>(live), static_cast<size_t>(live), device);
+        return {data, data, &counted_delete, device};
+    }
+
+    c10::DeleterFnPtr raw_deleter() const override {
+        return &counted_delete;
+    }
+
+    void copy_data(void *dest, const void *src, std::size_t count) const override {
+        std::memcpy(dest, src, count);
+    }
+};
+
+// Highest priority, so the allocator registered at startup is replaced
+// and can be put back at the same priority.
+constexpr uint8_t kAllocatorPriority = std::numeric_limits<uint8_t>::max();
+
+std::mutex install_mutex;
+c10::Allocator *replaced_allocator = nullptr;
+
+CountingCPUAllocator *counting_allocator() {
+    // Intentionally leaked: blocks can still be freed while static
+    // destructors run at VM shutdown.
+    static auto *allocator = new CountingCPUAllocator();
+    return allocator;
+}
+
+} // namespace
+
+MemoryScope::MemoryScope(const std::shared_ptr<MemoryAccount> &account)
+    : previous(current_scope)
+{
+    if (tracking.load(std::memory_order_relaxed)) {
+        this->account = account;
+        request = next_request.fetch_add(1, std::memory_order_relaxed);
+    }
+    current_scope = this;
+}
+
+MemoryScope::~MemoryScope() {
+    current_scope = previous;
+    if (account) {
+        account->requests.fetch_add(1, std::memory_order_relaxed);
+        account->last_request_peak_bytes.store(peak_bytes, std::memory_order_relaxed);
+        raise_peak(account->max_request_peak_bytes, peak_bytes);
+    }
+}
+
+AllocationTally::AllocationTally() : previous(current_tally) {
+    current_tally = this;
+}
+
+AllocationTally::~AllocationTally() {
+    current_tally = previous;
+    if (previous != nullptr) {
+        previous->allocations += allocations;
+        previous->allocated += allocated;
+        previous->freed += freed;
+    }
+}
+
+int64_t storage_bytes(const std::vector<torch::Tensor> &tensors) {
+    std::unordered_set<const c10::StorageImpl *> seen;
+    int64_t total = 0;
+    for (const auto &tensor : tensors) {
+        if (!tensor.defined() || !tensor.has_storage()) {
+            continue;
+        }
+        const c10::StorageImpl *storage = tensor.storage().unsafeGetStorageImpl();
+        if (seen.insert(storage).second) {
+            total += static_cast<int64_t>(storage->nbytes());
+        }
+    }
+    return total;
+}
+
+ModelMemoryStats model_memory_stats(const MemoryAccount &account, int64_t weight_bytes) {
+    ModelMemoryStats stats;
+    stats.live_bytes = account.live_bytes.load(std::memory_order_relaxed);
+    stats.peak_bytes = account.peak_bytes.load(std::memory_order_relaxed);
+    stats.allocations = account.allocations.load(std::memory_order_relaxed);
+    stats.frees = account.frees.load(std::memory_order_relaxed);
+    stats.requests = account.requests.load(std::memory_order_relaxed);
+    stats.last_request_peak_bytes = account.last_request_peak_bytes.load(std::memory_order_relaxed);
+    stats.max_request_peak_bytes = account.max_request_peak_bytes.load(std::memory_order_relaxed);
+    stats.weight_bytes = weight_bytes;
+    return stats;
+}
+
+void cpu_memory_tracking(bool enabled) {
+    std::lock_guard<std::mutex> guard(install_mutex);
+    if (enabled == tracking.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if (enabled) {
+        replaced_allocator = c10::GetCPUAllocator();
+        c10::SetCPUAllocator(counting_allocator(), kAllocatorPriority);
+    } else {
+        c10::SetCPUAllocator(replaced_allocator, kAllocatorPriority);
+    }
+    tracking.store(enabled, std::memory_order_relaxed);
+}
+
+CpuMemoryStats cpu_memory_stats() {
+    CpuMemoryStats stats;
+    stats.enabled = tracking.load(std::memory_order_relaxed);
+    stats.live_bytes = live_bytes.load(std::memory_order_relaxed);
+    stats.peak_bytes = peak_bytes.load(std::memory_order_relaxed);
+    stats.allocations = allocations.load(std::memory_order_relaxed);
+    stats.frees = frees.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void cpu_memory_reset_peak() {
+    peak_bytes.store(live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
@@ -406,6 +406,53 @@ void nn_copy_parameters(
     }
 }
 
+void nn_bind_parameters(
+    const std::shared_ptr<CrossNNModule> &dst,
+    rust::Vec<NamedTensor> params)
+{
+    auto base = dst->module.ptr();
+    auto param_dict = base->named_parameters();
+    auto buffer_dict = base->named_buffers();
+
+    // Every name and shape is checked, and every conversion made, before
+    // the first parameter is rebound, so a failing call leaves the module
+    // as it was.
+    std::vector<std::pair<torch::Tensor *, torch::Tensor>> bindings;
+    bindings.reserve(params.size());
+    for (const auto &nt : params) {
+        std::string name(nt.name);
+        auto target = param_dict.find(name);
+        if (target == nullptr) {
+            target = buffer_dict.find(name);
+        }
+        if (target == nullptr) {
+            continue;
+        }
+
+        auto source = *nt.tensor;
+        if (source.sizes() != target->sizes()) {
+            throw std::invalid_argument(
+                "Shape mismatch binding " + name + " of " + dst->type_name);
+        }
+        bindings.emplace_back(target, std::move(source));
+    }
+
+    // Swap the incoming storage into each parameter/buffer instead of
+    // copying it; the module then shares memory with the source tensor.
+    torch::NoGradGuard no_grad;
+    for (auto &binding : bindings) {
+        torch::Tensor *target = binding.first;
+        // Only convert (and therefore copy) when dtype or device differ.
+        if (binding.second.scalar_type() != target->scalar_type() ||
+            binding.second.device() != target->device()) {
+            binding.second = binding.second.to(target->device(), target->scalar_type());
+        }
+    }
+    for (auto &binding : bindings) {
+        binding.first->set_data(binding.second);
+    }
+}
+
 std::shared_ptr<CrossNNModule> nn_to_device(
     const std::shared_ptr<CrossNNModule> &module,
     Device s_device)
@@ -418,6 +465,177 @@ std::shared_ptr<CrossNNModule> nn_to_device(
         std::move(cloned), module->type_name);
 }
 
+// ============================================================================
+// Multi-value forward and whole-model pipelines
+// ============================================================================
+
+// Apply a module to one or more tensors through AnyModule's type-erased
+// forward, flattening the tuple outputs of recurrent and attention layers.
+static std::vector<torch::Tensor> apply_module(
+    CrossNNModule &module,
+    const std::vector<torch::Tensor> &args)
+{
+    using TensorPair = std::tuple<torch::Tensor, torch::Tensor>;
+    auto &any = module.module;
+    bool is_lstm = module.type_name == "LSTM";
+
+    torch::nn::AnyValue result = [&]() {
+        switch (args.size()) {
+            case 1:
+                return any.any_forward(args[0]);
+            case 2:
+                if (is_lstm) {
+                    throw std::invalid_argument(
+                        "LSTM takes either the input alone or the input with both h_0 and c_0");
+                }
+                return any.any_forward(args[0], args[1]);
+            case 3:
+                if (is_lstm) {
+                    return any.any_forward(
+                        args[0], torch::optional<TensorPair>(std::make_tuple(args[1], args[2])));
+                }
+                return any.any_forward(args[0], args[1], args[2]);
+            default:
+                throw std::invalid_argument(
+                    module.type_name + " cannot take " + std::to_string(args.size()) + " inputs");
+        }
+    }();
+
+    if (auto *tensor = result.try_get<torch::Tensor>()) {
+        return {*tensor};
+    }
+    if (auto *pair = result.try_get<TensorPair>()) {
+        return {std::get<0>(*pair), std::get<1>(*pair)};
+    }
+    if (auto *nested = result.try_get<std::tuple<torch::Tensor, TensorPair>>()) {
+        const auto &state = std::get<1>(*nested);
+        return {std::get<0>(*nested), std::get<0>(state), std::get<1>(state)};
+    }
+    throw std::runtime_error("Unsupported output type from " + module.type_name);
+}
+
+TensorList nn_forward_many(
+    const std::shared_ptr<CrossNNModule> &module,
+    TensorList inputs)
+{
+    auto args = unpack_tensor_list(std::move(inputs));
+    return pack_tensor_list(apply_module(*module, args));
+}
+
+std::shared_ptr<CrossNNPipeline> nn_pipeline_new(
+    rust::Vec<NNPipelineStep> steps,
+    uint64_t num_inputs,
+    rust::Vec<uint64_t> outputs)
+{
+    auto pipeline = std::make_shared<CrossNNPipeline>();
+    pipeline->num_inputs = num_inputs;
+
+    // Slots must be written before they are read, and written only once.
+    std::vector<bool> defined(num_inputs, true);
+    auto check_read = [&](uint64_t slot) {
+        if (slot >= defined.size() || !defined[slot]) {
+            throw std::invalid_argument(
+                "Pipeline reads slot " + std::to_string(slot) + " before it is written");
+        }
+    };
+
+    for (const auto &s_step : steps) {
+        CrossNNPipelineImpl::Step step;
+        step.module = s_step.module;
+        for (auto slot : s_step.inputs) {
+            check_read(slot);
+            step.inputs.push_back(slot);
+        }
+        for (auto slot : s_step.outputs) {
+            if (slot < defined.size() && defined[slot]) {
+                throw std::invalid_argument(
+                    "Pipeline writes slot " + std::to_string(slot) + " twice");
+            }
+            if (slot >= defined.size()) {
+                defined.resize(slot + 1, false);
+            }
+            defined[slot] = true;
+            step.outputs.push_back(slot);
+        }
+        pipeline->steps.push_back(std::move(step));
+    }
+
+    for (auto slot : outputs) {
+        check_read(slot);
+        pipeline->outputs.push_back(slot);
+    }
+    pipeline->num_slots = defined.size();
+
+    // Release every non-output slot right after the step that last touches
+    // it, so intermediate activations (and unused tuple members such as an
+    // LSTM's c_n) do not outlive their consumers.
+    std::vector<int64_t> last_read(pipeline->num_slots, -1);
+    for (size_t i = 0; i < pipeline->steps.size(); i++) {
+        for (auto slot : pipeline->steps[i].inputs) {
+            last_read[slot] = static_cast<int64_t>(i);
+        }
+        for (auto slot : pipeline->steps[i].outputs) {
+            last_read[slot] = static_cast<int64_t>(i);
+        }
+    }
+    for (auto slot : pipeline->outputs) {
+        last_read[slot] = -1;
+    }
+    for (size_t slot = 0; slot < last_read.size(); slot++) {
+        if (last_read[slot] >= 0) {
+            pipeline->steps[last_read[slot]].release.push_back(slot);
+        }
+    }
+
+    return pipeline;
+}
+
+TensorList nn_pipeline_run(
+    const std::shared_ptr<CrossNNPipeline> &pipeline,
+    TensorList inputs)
+{
+    auto input_vec = unpack_tensor_list(std::move(inputs));
+    if (input_vec.size() != pipeline->num_inputs) {
+        throw std::invalid_argument(
+            "Pipeline expects " + std::to_string(pipeline->num_inputs) +
+            " inputs, got " + std::to_string(input_vec.size()));
+    }
+
+    std::vector<torch::Tensor> slots(pipeline->num_slots);
+    std::move(input_vec.begin(), input_vec.end(), slots.begin());
+
+    std::vector<torch::Tensor> args;
+    for (const auto &step : pipeline->steps) {
+        args.clear();
+        for (auto slot : step.inputs) {
+            args.push_back(slots[slot]);
+        }
+        auto results = apply_module(*step.module, args);
+        if (results.size() != step.outputs.size()) {
+            throw std::runtime_error(
+                step.module->type_name + " returned " + std::to_string(results.size()) +
+                " values, pipeline expected " + std::to_string(step.outputs.size()));
+        }
+        for (size_t i = 0; i < results.size(); i++) {
+            slots[step.outputs[i]] = std::move(results[i]);
+        }
+        for (auto slot : step.release) {
+            slots[slot] = torch::Tensor();
+        }
+    }
+
+    std::vector<CrossTensor> outputs;
+    outputs.reserve(pipeline->outputs.size());
+    for (auto slot : pipeline->outputs) {
+        outputs.push_back(slots[slot]);
+    }
+    return pack_tensor_list(std::move(outputs));
+}
+
+uint64_t nn_pipeline_num_steps(const std::shared_ptr<CrossNNPipeline> &pipeline) {
+    return pipeline->steps.size();
+}
+
 // ============================================================================
 // Direct ATen functional ops (Phase A)
 // ============================================================================
@@ -0,0 +1,301 @@
+#include "extorch/src/native.rs.h"
+#include "extorch/include/pinned_pool.h"
+
+#include <c10/core/Event.h>
+#include <c10/core/impl/VirtualGuardImpl.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <vector>
+
+// ============================================================================
+// Host staging pool
+// ============================================================================
+
+namespace {
+
+// Smallest block handed out by the pool. Requests are rounded up to the
+// next power of two from here, the same bucketing the CUDA caching host
+// allocator uses, so a block can serve any request of its bucket.
+constexpr size_t kMinBlockSize = 4096;
+
+// Default upper bound on bytes kept in the free lists.
+constexpr size_t kDefaultMaxCachedBytes = size_t(1) << 30;
+
+// A cached block, with the events recorded when it was released. A
+// `non_blocking` copy from the block can still be running on a device
+// stream after its tensor is dropped, so the block is only handed out
+// again, or freed, once every event has completed, like the CUDA caching
+// host allocator does. Nothing waits on the events: they are polled.
+struct FreeBlock {
+    torch::Tensor block;
+    std::vector<c10::Event> events;
+
+    bool ready() const {
+        for (const auto &event : events) {
+            if (!event.query()) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+size_t bucket_for(size_t nbytes) {
+    size_t capacity = kMinBlockSize;
+    while (capacity < nbytes) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+class PinnedPool {
+public:
+    static PinnedPool &instance() {
+        // Intentionally leaked: tensor deleters can still fire while static
+        // destructors run at VM shutdown.
+        static PinnedPool *pool = new PinnedPool();
+        return *pool;
+    }
+
+    // Hand out a tensor of `shape` backed by a pooled block of at least
+    // `nbytes`. The block goes back to the free list when the tensor's
+    // storage is released.
+    torch::Tensor allocate(
+        torch::IntArrayRef shape,
+        const torch::TensorOptions &opts,
+        size_t nbytes)
+    {
+        size_t capacity = bucket_for(nbytes);
+        torch::Tensor block;
+        // Declared before the guard so that reclaimed blocks are freed
+        // after the mutex is released.
+        std::vector<FreeBlock> reclaimed;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            reclaim_locked(reclaimed);
+            requests_++;
+            auto it = free_blocks_.find(capacity);
+            if (it != free_blocks_.end()) {
+                // Most recently released blocks last: older ones are the
+                // likeliest to have finished their copies.
+                auto &bucket = it->second;
+                for (auto free = bucket.begin(); free != bucket.end(); ++free) {
+                    if (free->ready()) {
+                        block = std::move(free->block);
+                        bucket.erase(free);
+                        break;
+                    }
+                }
+            }
+            if (block.defined()) {
+                bytes_cached_ -= capacity;
+                blocks_cached_--;
+                hits_++;
+            } else {
+                misses_++;
+            }
+            bytes_in_use_ += nbytes;
+            capacity_in_use_ += capacity;
+            blocks_in_use_++;
+        }
+
+        if (!block.defined()) {
+            // Page-locking is expensive, so allocate outside the lock.
+            try {
+                block = new_block(capacity);
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(mutex_);
+                bytes_in_use_ -= nbytes;
+                capacity_in_use_ -= capacity;
+                blocks_in_use_--;
+                throw;
+            }
+            std::lock_guard<std::mutex> guard(mutex_);
+            bytes_reserved_ += capacity;
+        }
+
+        void *data = block.data_ptr();
+        return torch::from_blob(
+            data, shape,
+            [block, capacity, nbytes](void *) {
+                PinnedPool::instance().release(block, capacity, nbytes);
+            },
+            opts);
+    }
+
+    int64_t empty_cache() {
+        std::vector<FreeBlock> reclaimed;
+        std::lock_guard<std::mutex> guard(mutex_);
+        const size_t released = bytes_cached_;
+        for (auto &bucket : free_blocks_) {
+            for (auto &free : bucket.second) {
+                pending_.push_back(std::move(free));
+            }
+        }
+        free_blocks_.clear();
+        bytes_cached_ = 0;
+        blocks_cached_ = 0;
+        reclaim_locked(reclaimed);
+        return static_cast<int64_t>(released);
+    }
+
+    void set_max_cached_bytes(size_t max_bytes) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        max_cached_bytes_ = max_bytes;
+    }
+
+    PinnedPoolStats stats() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        PinnedPoolStats s;
+        s.pinned = pinned_;
+        s.requests = static_cast<int64_t>(requests_);
+        s.hits = static_cast<int64_t>(hits_);
+        s.misses = static_cast<int64_t>(misses_);
+        s.releases = static_cast<int64_t>(releases_);
+        s.blocks_in_use = static_cast<int64_t>(blocks_in_use_);
+        s.blocks_cached = static_cast<int64_t>(blocks_cached_);
+        s.bytes_in_use = static_cast<int64_t>(bytes_in_use_);
+        s.capacity_in_use = static_cast<int64_t>(capacity_in_use_);
+        s.bytes_cached = static_cast<int64_t>(bytes_cached_);
+        s.bytes_reserved = static_cast<int64_t>(bytes_reserved_);
+        s.max_cached_bytes = static_cast<int64_t>(max_cached_bytes_);
+        return s;
+    }
+
+private:
+    PinnedPool() : pinned_(torch::cuda::is_available()) {}
+
+    torch::Tensor new_block(size_t capacity) {
+        auto opts = torch::TensorOptions()
+            .dtype(torch::kByte)
+            .pinned_memory(pinned_);
+        return torch::empty({static_cast<int64_t>(capacity)}, opts);
+    }
+
+    // Record an event on the current stream of every device, which
+    // completes once the copies enqueued so far from the block are done.
+    std::vector<c10::Event> record_events() const {
+        std::vector<c10::Event> events;
+        if (!pinned_) {
+            return events;
+        }
+        c10::impl::VirtualGuardImpl impl(c10::DeviceType::CUDA);
+        const auto devices = impl.deviceCount();
+        events.reserve(devices);
+        for (c10::DeviceIndex index = 0; index < devices; index++) {
+            c10::Event event(c10::DeviceType::CUDA);
+            event.record(impl.getStream(c10::Device(c10::DeviceType::CUDA, index)));
+            events.push_back(std::move(event));
+        }
+        return events;
+    }
+
+    // Runs in the tensor deleter, on whichever thread drops the last
+    // reference (a scheduler or the GC), so it never waits for a device.
+    void release(torch::Tensor block, size_t capacity, size_t nbytes) {
+        FreeBlock free{std::move(block), record_events()};
+        // Declared before the guard so that reclaimed blocks are freed
+        // after the mutex is released.
+        std::vector<FreeBlock> reclaimed;
+        std::lock_guard<std::mutex> guard(mutex_);
+        releases_++;
+        bytes_in_use_ -= nbytes;
+        capacity_in_use_ -= capacity;
+        blocks_in_use_--;
+
+        if (bytes_cached_ + capacity > max_cached_bytes_) {
+            pending_.push_back(std::move(free));
+        } else {
+            free_blocks_[capacity].push_back(std::move(free));
+            bytes_cached_ += capacity;
+            blocks_cached_++;
+        }
+        reclaim_locked(reclaimed);
+    }
+
+    // Move the evicted blocks whose copies are done from `pending_` to
+    // `reclaimed`, for the caller to free once it drops the mutex. Blocks
+    // still being read stay pending until a later call.
+    void reclaim_locked(std::vector<FreeBlock> &reclaimed) {
+        auto ready = std::stable_partition(
+            pending_.begin(), pending_.end(),
+            [](const FreeBlock &free) { return !free.ready(); });
+        for (auto it = ready; it != pending_.end(); ++it) {
+            bytes_reserved_ -= static_cast<size_t>(it->block.nbytes());
+            reclaimed.push_back(std::move(*it));
+        }
+        pending_.erase(ready, pending_.end());
+    }
+
+    std::mutex mutex_;
+    std::map<size_t, std::vector<FreeBlock>> free_blocks_;
+    // Evicted blocks waiting for their copies, still counted as reserved.
+    std::vector<FreeBlock> pending_;
+    const bool pinned_;
+    size_t max_cached_bytes_ = kDefaultMaxCachedBytes;
+
+    uint64_t requests_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t releases_ = 0;
+    size_t blocks_in_use_ = 0;
+    size_t blocks_cached_ = 0;
+    size_t bytes_in_use_ = 0;
+    size_t capacity_in_use_ = 0;
+    size_t bytes_cached_ = 0;
+    size_t bytes_reserved_ = 0;
+};
+
+} // namespace
+
+std::shared_ptr<CrossTensor> pinned_from_binary(
+    rust::Slice<const uint8_t> data,
+    rust::Vec<int64_t> shape,
+    rust::String s_dtype)
+{
+    std::string dtype_str(s_dtype);
+    auto type_search = type_mapping.find(dtype_str);
+    if (type_search == type_mapping.end()) {
+        throw std::invalid_argument("pinned_from_binary: unknown dtype " + dtype_str);
+    }
+    auto scalar_type = type_search->second;
+    auto opts = torch::TensorOptions().dtype(scalar_type);
+
+    const int64_t *shape_ptr = shape.data();
+    auto shape_ref = torch::IntArrayRef{shape_ptr, shape.size()};
+
+    size_t nbytes = static_cast<size_t>(c10::multiply_integers(shape_ref)) *
+                    c10::elementSize(scalar_type);
+    if (nbytes != data.size()) {
+        std::stringstream ss;
+        ss << "pinned_from_binary: binary has " << data.size()
+           << " bytes, but shape and dtype require " << nbytes;
+        throw std::invalid_argument(ss.str());
+    }
+
+    if (nbytes == 0) {
+        return std::make_shared<CrossTensor>(torch::empty(shape_ref, opts));
+    }
+
+    // Copy the data: the Erlang binary may be GC'd once the NIF returns.
+    auto tensor = PinnedPool::instance().allocate(shape_ref, opts, nbytes);
+    memcpy(tensor.data_ptr(), data.data(), nbytes);
+    return std::make_shared<CrossTensor>(std::move(tensor));
+}
+
+PinnedPoolStats pinned_pool_stats() {
+    return PinnedPool::instance().stats();
+}
+
+int64_t pinned_pool_empty_cache() {
+    return PinnedPool::instance().empty_cache();
+}
+
+void pinned_pool_set_max_cached_bytes(int64_t max_bytes) {
+    if (max_bytes < 0) {
+        throw std::invalid_argument("pinned_pool_set_max_cached_bytes: limit must be >= 0");
+    }
+    PinnedPool::instance().set_max_cached_bytes(static_cast<size_t>(max_bytes));
+}
@@ -16,75 +16,238 @@ std::shared_ptr<CrossTensor> imag(const std::shared_ptr<CrossTensor> &input) {
 
 // Arithmetic
 
-std::shared_ptr<CrossTensor> add(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other, Scalar alpha) {
+std::shared_ptr<CrossTensor> add(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other, Scalar alpha, TensorOut out) {
     auto a = get_scalar_type(alpha);
-    torch::Tensor tensor = torch::add(*input, *other, a);
+    torch::Tensor tensor;
+    if (out.used) {
+        tensor = *out.tensor;
+        torch::add_out(tensor, *input, *other, a);
+    } else {
+        tensor = torch::add(*input, *other, a);
+    }
     return std::make_shared<CrossTensor>(std::move(tensor));
 }
 
-std::shared_ptr<CrossTensor> sub(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other, Scalar alpha) {
+std::shared_ptr<CrossTensor> sub(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other, Scalar alpha, TensorOut out) {
     auto a = get_scalar_type(alpha);
-    torch::Tensor tensor = torch::sub(*input, *other, a);
+    torch::Tensor tensor;
+    if (out.used) {
+        tensor = *out.tensor;
+        torch::sub_out(tensor, *input, *other, a);
+    } else {
+        tensor = torch::sub(*input, *other, a);
+    }
     return std::make_shared<CrossTensor>(std::move(tensor));
 }
 
-std::shared_ptr<CrossTensor> mul(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other) {
-    torch::Tensor tensor = torch::mul(*input, *other);
+std::shared_ptr<CrossTensor> mul(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other, TensorOut out) {
+    torch::Tensor tensor;
+    if (out.used) {
+        tensor = *out.tensor;
+        torch::mul_out(tensor, *input, *other);
+    } else {
+        tensor = torch::mul(*input, *other);
+    }
     return std::make_shared<CrossTensor>(std::move(tensor));
 }
 
-std::shared_ptr<CrossTensor> tensor_div(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other) {
-    torch::Tensor tensor = torch::div(*input, *other);
+std::shared_ptr<CrossTensor> tensor_div(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other, TensorOut out) {
+    torch::Tensor tensor;
+    if (out.used) {
+        tensor = *out.tensor;
+        torch::div_out(tensor, *input, *other);
+    } else {
+        tensor = torch::div(*input, *other);
+    }
     return std::make_shared<CrossTensor>(std::move(tensor));
 }
 
-std::shared_ptr<CrossTensor> neg(const std::shared_ptr<CrossTensor> &input) {
-    torch::Tensor tensor = torch::neg(*input);
+std::shared_ptr<CrossTensor> neg(const std::shared_ptr<CrossTensor> &input, TensorOut out) {
+    torch::Tensor tensor;
+    if (out.used) {
+        tensor = *out.tensor;
+        torch::neg_out(tensor, *input);
+    } else {
+        tensor = torch::neg(*input);
+    }
     return std::make_shared<CrossTensor>(std::move(tensor));
 }
 
-std::shared_ptr<CrossTensor> tensor_abs(const std::shared_ptr<CrossTensor> &input) {
-    torch::Tensor tensor = torch::abs(*input);
+std::shared_ptr<CrossTensor> tensor_abs(const std::shared_ptr<CrossTensor> &input, TensorOut out) {
+    torch::Tensor tensor;
+    if (out.used) {
+        tensor = *out.tensor;
+        torch::abs_out(tensor, *input);
+    } else {
+        tensor = torch::abs(*input);
+    }
     return std::make_shared<CrossTensor>(std::move(tensor));
 }
 
-std::shared_ptr<CrossTensor> pow_tensor(const std::shared_ptr<CrossTensor> &input, Scalar exponent) {
+std::shared_ptr<CrossTensor> pow_tensor(const std::shared_ptr<CrossTensor> &input, Scalar exponent, TensorOut out) {
     auto e = get_scalar_type(exponent);
-    torch::Tensor tensor = torch::pow(*input, e);
+    torch::Tensor tensor;
+    if (out.used) {
+        tensor = *out.tensor;
+        torch::pow_out(tensor, *input, e);
+    } else {
+        tensor = torch::pow(*input, e);
+    }
+    return std::make_shared<CrossTensor>(std::move(tensor));
+}
+
+std::shared_ptr<CrossTensor> clamp(const std::shared_ptr<CrossTensor> &input, Scalar min_val, Scalar max_val, TensorOut out) {
+    auto mn = get_scalar_type(min_val);
+    auto mx = get_scalar_type(max_val);
+    torch::Tensor tensor;
+    if (out.used) {
+        tensor = *out.tensor;
+        torch::clamp_out(tensor, *input, mn, mx);
+    } else {
+        tensor = torch::clamp(*input, mn, mx);
+    }
     return std::make_shared<CrossTensor>(std::move(tensor));
 }
 
 // Math
 
-std::shared_ptr<CrossTensor> tensor_exp(const std::shared_ptr<CrossTensor> &input) {
-    torch::Tensor tensor = torch::exp(*input);
+std::shared_ptr<CrossTensor> tensor_exp(const std::shared_ptr<CrossTensor> &input, TensorOut out) {
+    torch::Tensor tensor;
+    if (out.used) {
+        tensor = *out.tensor;
+        torch::exp_out(tensor, *input);
+    } else {
+        tensor = torch::exp(*input);
+    }
+    return std::make_shared<CrossTensor>(std::move(tensor));
+}
+
+std::shared_ptr<CrossTensor> tensor_log(const std::shared_ptr<CrossTensor> &input, TensorOut out) {
+    torch::Tensor tensor;
+    if (out.used) {
+        tensor = *out.tensor;
+        torch::log_out(tensor, *input);
+    } else {
+        tensor = torch::log(*input);
+    }
+    return std::make_shared<CrossTensor>(std::move(tensor));
+}
+
+std::shared_ptr<CrossTensor> tensor_sqrt(const std::shared_ptr<CrossTensor> &input, TensorOut out) {
+    torch::Tensor tensor;
+    if (out.used) {
+        tensor = *out.tensor;
+        torch::sqrt_out(tensor, *input);
+    } else {
+        tensor = torch::sqrt(*input);
+    }
+    return std::make_shared<CrossTensor>(std::move(tensor));
+}
+
+std::shared_ptr<CrossTensor> tensor_sin(const std::shared_ptr<CrossTensor> &input, TensorOut out) {
+    torch::Tensor tensor;
+    if (out.used) {
+        tensor = *out.tensor;
+        torch::sin_out(tensor, *input);
+    } else {
+        tensor = torch::sin(*input);
+    }
+    return std::make_shared<CrossTensor>(std::move(tensor));
+}
+
+std::shared_ptr<CrossTensor> tensor_cos(const std::shared_ptr<CrossTensor> &input, TensorOut out) {
+    torch::Tensor tensor;
+    if (out.used) {
+        tensor = *out.tensor;
+        torch::cos_out(tensor, *input);
+    } else {
+        tensor = torch::cos(*input);
+    }
+    return std::make_shared<CrossTensor>(std::move(tensor));
+}
+
+// In-place variants
+
+std::shared_ptr<CrossTensor> add_(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other, Scalar alpha) {
+    auto a = get_scalar_type(alpha);
+    torch::Tensor tensor = *input;
+    tensor.add_(*other, a);
+    return std::make_shared<CrossTensor>(std::move(tensor));
+}
+
+std::shared_ptr<CrossTensor> sub_(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other, Scalar alpha) {
+    auto a = get_scalar_type(alpha);
+    torch::Tensor tensor = *input;
+    tensor.sub_(*other, a);
+    return std::make_shared<CrossTensor>(std::move(tensor));
+}
+
+std::shared_ptr<CrossTensor> mul_(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other) {
+    torch::Tensor tensor = *input;
+    tensor.mul_(*other);
     return std::make_shared<CrossTensor>(std::move(tensor));
 }
 
-std::shared_ptr<CrossTensor> tensor_log(const std::shared_ptr<CrossTensor> &input) {
-    torch::Tensor tensor = torch::log(*input);
+std::shared_ptr<CrossTensor> tensor_div_(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &other) {
+    torch::Tensor tensor = *input;
+    tensor.div_(*other);
     return std::make_shared<CrossTensor>(std::move(tensor));
 }
 
-std::shared_ptr<CrossTensor> tensor_sqrt(const std::shared_ptr<CrossTensor> &input) {
-    torch::Tensor tensor = torch::sqrt(*input);
+std::shared_ptr<CrossTensor> neg_(const std::shared_ptr<CrossTensor> &input) {
+    torch::Tensor tensor = *input;
+    tensor.neg_();
     return std::make_shared<CrossTensor>(std::move(tensor));
 }
 
-std::shared_ptr<CrossTensor> tensor_sin(const std::shared_ptr<CrossTensor> &input) {
-    torch::Tensor tensor = torch::sin(*input);
+std::shared_ptr<CrossTensor> tensor_abs_(const std::shared_ptr<CrossTensor> &input) {
+    torch::Tensor tensor = *input;
+    tensor.abs_();
     return std::make_shared<CrossTensor>(std::move(tensor));
 }
 
-std::shared_ptr<CrossTensor> tensor_cos(const std::shared_ptr<CrossTensor> &input) {
-    torch::Tensor tensor = torch::cos(*input);
+std::shared_ptr<CrossTensor> pow_tensor_(const std::shared_ptr<CrossTensor> &input, Scalar exponent) {
+    auto e = get_scalar_type(exponent);
+    torch::Tensor tensor = *input;
+    tensor.pow_(e);
     return std::make_shared<CrossTensor>(std::move(tensor));
 }
 
-std::shared_ptr<CrossTensor> clamp(const std::shared_ptr<CrossTensor> &input, Scalar min_val, Scalar max_val) {
+std::shared_ptr<CrossTensor> clamp_(const std::shared_ptr<CrossTensor> &input, Scalar min_val, Scalar max_val) {
     auto mn = get_scalar_type(min_val);
     auto mx = get_scalar_type(max_val);
-    torch::Tensor tensor = torch::clamp(*input, mn, mx);
+    torch::Tensor tensor = *input;
+    tensor.clamp_(mn, mx);
+    return std::make_shared<CrossTensor>(std::move(tensor));
+}
+
+std::shared_ptr<CrossTensor> tensor_exp_(const std::shared_ptr<CrossTensor> &input) {
+    torch::Tensor tensor = *input;
+    tensor.exp_();
+    return std::make_shared<CrossTensor>(std::move(tensor));
+}
+
+std::shared_ptr<CrossTensor> tensor_log_(const std::shared_ptr<CrossTensor> &input) {
+    torch::Tensor tensor = *input;
+    tensor.log_();
+    return std::make_shared<CrossTensor>(std::move(tensor));
+}
+
+std::shared_ptr<CrossTensor> tensor_sqrt_(const std::shared_ptr<CrossTensor> &input) {
+    torch::Tensor tensor = *input;
+    tensor.sqrt_();
+    return std::make_shared<CrossTensor>(std::move(tensor));
+}
+
+std::shared_ptr<CrossTensor> tensor_sin_(const std::shared_ptr<CrossTensor> &input) {
+    torch::Tensor tensor = *input;
+    tensor.sin_();
+    return std::make_shared<CrossTensor>(std::move(tensor));
+}
+
+std::shared_ptr<CrossTensor> tensor_cos_(const std::shared_ptr<CrossTensor> &input) {
+    torch::Tensor tensor = *input;
+    tensor.cos_();
     return std::make_shared<CrossTensor>(std::move(tensor));
 }
 
@@ -136,6 +299,12 @@ std::shared_ptr<CrossTensor> detach(const std::shared_ptr<CrossTensor> &input) {
     return std::make_shared<CrossTensor>(std::move(tensor));
 }
 
+std::shared_ptr<CrossTensor> copy_(const std::shared_ptr<CrossTensor> &input, const std::shared_ptr<CrossTensor> &src, bool non_blocking) {
+    torch::Tensor tensor = *input;
+    tensor.copy_(*src, non_blocking);
+    return std::make_shared<CrossTensor>(std::move(tensor));
+}
+
 std::shared_ptr<CrossTensor> view(const std::shared_ptr<CrossTensor> &input, rust::Vec<int64_t> shape) {
     const int64_t *ptr = shape.data();
     torch::Tensor tensor = input->view(torch::IntArrayRef{ptr, shape.size()});
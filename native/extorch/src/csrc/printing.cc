@@ -1,451 +1,334 @@
 #include "extorch/src/native.rs.h"
 #include "extorch/include/printing.h"
 
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
 
-inline torch::Tensor tensor_totype(torch::Tensor tensor) {
-    torch::ScalarType dtype = tensor.is_mps() ? torch::kFloat : torch::kDouble;
-    return tensor.to(dtype);
+
+// Large enough for any double printed with "%.0f" (309 digits) or "%.Ne".
+constexpr size_t kMaxElementLength = 512;
+
+inline std::string printf_format(int64_t precision, char conversion) {
+    return "%." + std::to_string(precision) + conversion;
 }
 
+// Computes the column width and notation (integer, fixed or scientific)
+// of a tensor's printed elements, and formats them.
+//
+// Formatters are built from the elements that will actually be printed
+// (see `summarize_edges`), so their cost depends on the edge items and
+// not on the size of the tensor.
 struct Formatter {
+    enum class Kind { Bool, Integral, Floating };
+
     PrintOptions opts;
-    bool floating_dtype;
-    bool int_mode;
-    bool sci_mode;
-    int64_t max_width;
-
-    Formatter(torch::Tensor tensor, const PrintOptions opts) {
-        this->opts = opts;
-        floating_dtype = tensor.is_floating_point();
-        int_mode = true;
-        sci_mode = false;
-        max_width = 1;
-
-        torch::NoGradGuard guard;
-        tensor = tensor.to(torch::kCPU);
-        torch::Tensor tensor_view = tensor.reshape(-1);
-
-        if(!floating_dtype) {
-            AT_DISPATCH_SWITCH(tensor.scalar_type(), "repr_len",
-                AT_DISPATCH_CASE_INTEGRAL_TYPES(tensor_view.scalar_type(), "max_repr_len", [&] {
-                    auto data_ptr = tensor_view.data_ptr<scalar_t>();
-                    for(int i = 0; i < tensor_view.numel(); i++) {
-                        // char placeholder[64] = {0};
-                        std::stringstream ss;
-                        ss << data_ptr[i];
-                        auto sz = ss.str().size();
-                        // snprintf(placeholder, 64, "%lld", data_ptr[i]);
-                        // auto sz = strlen(placeholder);
-                        max_width = sz > max_width ? sz : max_width;
-                    }
-                })
-                AT_DISPATCH_CASE(torch::ScalarType::Bool, [&] {
-                    auto data_ptr = tensor_view.data_ptr<bool>();
-                    for(int i = 0; i < tensor_view.numel(); i++) {
-                        // char placeholder[64] = {0};
-                        auto sz = data_ptr[i] ? 4 : 5;
-                        // snprintf(placeholder, 64, "%lld", data_ptr[i]);
-                        max_width = sz > max_width ? sz : max_width;
-                    }
-                })
-            );
-        } else {
-            torch::Tensor nonzero_finite_vals = torch::masked_select(
-                tensor_view, torch::isfinite(tensor_view) & tensor_view.ne(0)
-            );
-
-            if(nonzero_finite_vals.numel() == 0) {
-                max_width = 3;
-                if((tensor_view < 0).numel() > 0) {
-                    max_width++;
-                }
-                return;
-            } else if(nonzero_finite_vals.numel() != tensor_view.numel()) {
+    Kind kind;
+    bool int_mode = true;
+    bool sci_mode = false;
+    int64_t max_width = 1;
+    std::string float_format;
+
+    // The printed elements, flattened and converted to bool, int64 or double.
+    torch::Tensor values;
+
+    Formatter(const torch::Tensor &tensor, const PrintOptions opts) : opts(opts) {
+        char buf[kMaxElementLength];
+
+        if(tensor.scalar_type() == torch::kBool) {
+            kind = Kind::Bool;
+            values = tensor.reshape(-1).contiguous();
+            const bool *data = values.data_ptr<bool>();
+            for(int64_t i = 0; i < values.numel(); i++) {
+                max_width = std::max<int64_t>(max_width, data[i] ? 4 : 5);
+            }
+            return;
+        }
+
+        if(!tensor.is_floating_point()) {
+            kind = Kind::Integral;
+            values = tensor.reshape(-1).to(torch::kLong).contiguous();
+            for(int64_t i = 0; i < values.numel(); i++) {
+                max_width = std::max<int64_t>(max_width, format(i, buf));
+            }
+            return;
+        }
+
+        kind = Kind::Floating;
+        values = tensor.reshape(-1).to(torch::kDouble).contiguous();
+        const double *data = values.data_ptr<double>();
+        const int64_t numel = values.numel();
+
+        int64_t num_nonzero_finite = 0;
+        double min_abs = std::numeric_limits<double>::infinity();
+        double max_abs = 0.0;
+        for(int64_t i = 0; i < numel; i++) {
+            const double value = data[i];
+            if(!std::isfinite(value) || value == 0) {
+                continue;
+            }
+            num_nonzero_finite++;
+            min_abs = std::min(min_abs, std::abs(value));
+            max_abs = std::max(max_abs, std::abs(value));
+            if(value != std::ceil(value)) {
                 int_mode = false;
-            } else {
-                for(int i = 0; i < nonzero_finite_vals.numel(); i++) {
-                    auto value = nonzero_finite_vals[i];
-                    auto diff = value != torch::ceil(value);
-                    bool is_diff = *(diff.data_ptr<bool>());
-                    if(is_diff) {
-                        int_mode = false;
-                        break;
-                    }
-                }
             }
+        }
 
-            auto nonzero_finite_abs = tensor_totype(nonzero_finite_vals.abs());
-            auto nonzero_finite_min = tensor_totype(nonzero_finite_abs.min());
-            auto nonzero_finite_max = tensor_totype(nonzero_finite_abs.max());
-
-            if(int_mode) {
-                if(*(nonzero_finite_max / nonzero_finite_min > 1000.0).data_ptr<bool>()
-                        || *(nonzero_finite_max > 1.0e8).data_ptr<bool>()) {
-                    sci_mode = true;
-                    std::stringstream fmt_ss;
-                    fmt_ss << "%." << opts.precision << "e";
-                    auto format = fmt_ss.str();
-                    AT_DISPATCH_FLOATING_TYPES(nonzero_finite_vals.scalar_type(), "max_repr_len", [&] {
-                        auto data_ptr = nonzero_finite_vals.data_ptr<scalar_t>();
-                        for(int i = 0; i < nonzero_finite_vals.numel(); i++) {
-                            char placeholder[64] = {0};
-                            snprintf(placeholder, 64, format.c_str(), data_ptr[i]);
-                            auto sz = strlen(placeholder);
-                            max_width = sz > max_width ? sz : max_width;
-                        }
-                    });
-                } else {
-                    AT_DISPATCH_FLOATING_TYPES(nonzero_finite_vals.scalar_type(), "max_repr_len", [&] {
-                        auto data_ptr = nonzero_finite_vals.data_ptr<scalar_t>();
-                        for(int i = 0; i < nonzero_finite_vals.numel(); i++) {
-                            char placeholder[64] = {0};
-                            snprintf(placeholder, 64, "%.0f", data_ptr[i]);
-                            auto sz = strlen(placeholder);
-                            max_width = sz > max_width ? sz : max_width;
-                        }
-                    });
-                }
-            } else {
-                if (*(nonzero_finite_max / nonzero_finite_min > 1000.0).data_ptr<bool>()
-                        || *(nonzero_finite_max > 1.0e8).data_ptr<bool>()
-                            || *(nonzero_finite_min < 1.0e-4).data_ptr<bool>()) {
-
-                    sci_mode = true;
-                    std::stringstream fmt_ss;
-                    fmt_ss << "%." << opts.precision << "e";
-                    auto format = fmt_ss.str();
-                    AT_DISPATCH_FLOATING_TYPES(nonzero_finite_vals.scalar_type(), "max_repr_len", [&] {
-                        auto data_ptr = nonzero_finite_vals.data_ptr<scalar_t>();
-                        for(int i = 0; i < nonzero_finite_vals.numel(); i++) {
-                            char placeholder[64] = {0};
-                            snprintf(placeholder, 64, format.c_str(), data_ptr[i]);
-                            auto sz = strlen(placeholder);
-                            max_width = sz > max_width ? sz : max_width;
-                        }
-                    });
-                } else {
-                    std::stringstream fmt_ss;
-                    fmt_ss << "%." << opts.precision << "f";
-                    auto format = fmt_ss.str();
-                    AT_DISPATCH_FLOATING_TYPES(nonzero_finite_vals.scalar_type(), "max_repr_len", [&] {
-                        auto data_ptr = nonzero_finite_vals.data_ptr<scalar_t>();
-                        for(int i = 0; i < nonzero_finite_vals.numel(); i++) {
-                            char placeholder[64] = {0};
-                            snprintf(placeholder, 64, format.c_str(), data_ptr[i]);
-                            auto sz = strlen(placeholder);
-                            max_width = sz > max_width ? sz : max_width;
-                        }
-                    });
-                }
+        if(num_nonzero_finite == 0) {
+            max_width = 3;
+            if(numel > 0) {
+                max_width++;
+            }
+            float_format = "%.0f";
+            return;
+        } else if(num_nonzero_finite != numel) {
+            int_mode = false;
+        }
+
+        const bool wide_range = max_abs / min_abs > 1000.0 || max_abs > 1.0e8;
+        sci_mode = int_mode ? wide_range : wide_range || min_abs < 1.0e-4;
+
+        const std::string width_format =
+            sci_mode ? printf_format(opts.precision, 'e')
+                     : int_mode ? "%.0f" : printf_format(opts.precision, 'f');
+        for(int64_t i = 0; i < numel; i++) {
+            const double value = data[i];
+            if(std::isfinite(value) && value != 0) {
+                const int len = snprintf(buf, kMaxElementLength, width_format.c_str(), value);
+                max_width = std::max<int64_t>(max_width, len);
             }
         }
 
         if(opts.sci_mode != 0) {
             sci_mode = opts.sci_mode - 1;
         }
+        float_format = sci_mode ? printf_format(opts.precision, 'e')
+                                : int_mode ? "%.0f" : printf_format(opts.precision, 'f');
     }
 
-    int64_t width() {
+    int64_t width() const {
         return max_width;
     }
 
-    template<typename T>
-    std::string format(T value) {
-        std::string format;
-        std::string ret(max_width, ' ');
-        bool add_dot = false;
-        size_t sz;
-
-        if(floating_dtype) {
-            if(sci_mode) {
-                std::stringstream fmt_ss;
-                fmt_ss << "%" << max_width << "." << opts.precision << "e";
-                format = fmt_ss.str();
-            } else if(int_mode) {
-                if(std::isinf(value) || std::isnan(value)) {
-                    format = "%f";
+    // Writes element `i` into `buf` without padding and returns its length.
+    size_t format(int64_t i, char *buf) const {
+        int len = 0;
+        switch(kind) {
+            case Kind::Bool:
+                len = snprintf(buf, kMaxElementLength, "%s", values.data_ptr<bool>()[i] ? "true" : "false");
+                break;
+            case Kind::Integral:
+                len = snprintf(buf, kMaxElementLength, "%lld",
+                               static_cast<long long>(values.data_ptr<int64_t>()[i]));
+                break;
+            case Kind::Floating: {
+                const double value = values.data_ptr<double>()[i];
+                if(int_mode && !sci_mode) {
+                    if(!std::isfinite(value)) {
+                        len = snprintf(buf, kMaxElementLength, "%f", value);
+                    } else {
+                        len = snprintf(buf, kMaxElementLength - 1, "%.0f", value);
+                        len = std::min<int>(len, kMaxElementLength - 2);
+                        buf[len++] = '.';
+                        buf[len] = '\0';
+                    }
                 } else {
-                    format = "%.0f";
-                    add_dot = true;
+                    len = snprintf(buf, kMaxElementLength, float_format.c_str(), value);
                 }
-            } else {
-                std::stringstream fmt_ss;
-                fmt_ss << "%" << "." << opts.precision << "f";
-                format = fmt_ss.str();
+                break;
             }
-
-            snprintf(ret.data(), max_width + 1, format.c_str(), value);
-            sz = strlen(ret.c_str());
-            ret = ret.substr(0, sz);
-
-        } else {
-            std::stringstream ss;
-            ss << value;
-            ret = ss.str();
-            sz = ret.size();
-        }
-
-        if(add_dot) {
-            ret += ".";
-        }
-
-        std::string padding(max_width - sz, ' ');
-        return padding + ret;
-    }
-
-};
-
-template<>
-std::string Formatter::format(uint8_t value) {
-    std::string ret(max_width, ' ');
-    size_t sz;
-
-    std::stringstream ss;
-    ss << ((int64_t) value);
-    ret = ss.str();
-    sz = ret.size();
-
-    std::string padding(max_width - sz, ' ');
-    return padding + ret;
-}
-
-template<>
-std::string Formatter::format(bool value) {
-    std::string ret = value ? "true" : "false";
-    auto sz = ret.size();
-    std::string padding(max_width - sz, ' ');
-    return padding + ret;
-}
-
-template <std::ctype_base::mask mask>
-class IsNot
-{
-    std::locale myLocale;       // To ensure lifetime of facet...
-    std::ctype<char> const* myCType;
-public:
-    IsNot( std::locale const& l = std::locale() )
-        : myLocale( l )
-        , myCType( &std::use_facet<std::ctype<char> >( l ) )
-    {
-    }
-    bool operator()( char ch ) const
-    {
-        return ! myCType->is( mask, ch );
-    }
-};
-
-typedef IsNot<std::ctype_base::space> IsNotSpace;
-
-torch::Tensor get_summarized_data(torch::Tensor tensor, const PrintOptions opts) {
-    auto dim = tensor.dim();
-    if(dim == 0) {
-        return tensor;
-    } else if(dim == 1) {
-        if(tensor.size(0) > 2 * opts.edgeitems) {
-            return torch::cat({tensor.index({at::indexing::Slice(c10::nullopt, opts.edgeitems)}),
-                               tensor.index({at::indexing::Slice(-opts.edgeitems)}) });
         }
-        return tensor;
+        return std::min<size_t>(len, kMaxElementLength - 1);
     }
 
-    if(!opts.edgeitems) {
-        std::vector<int64_t> size(dim, 0);
-        return tensor.new_empty(size);
-    } else if(tensor.size(0) > 2 * opts.edgeitems) {
-        auto dim_size = tensor.size(0);
-        std::vector<torch::Tensor> values;
-        for(int i = 0; i < opts.edgeitems; i++) {
-            values.push_back(get_summarized_data(tensor[i], opts));
+    // Appends element `i`, right-aligned to the column width. The trailing
+    // dot of integer-valued floats is not counted in the width.
+    void write(std::string &out, int64_t i) const {
+        char buf[kMaxElementLength];
+        const size_t len = format(i, buf);
+        size_t text_len = len;
+        if(kind == Kind::Floating && int_mode && !sci_mode && buf[len - 1] == '.') {
+            text_len--;
         }
-        for(int i = dim_size - opts.edgeitems; i < dim_size; i++) {
-            values.push_back(get_summarized_data(tensor[i], opts));
+        if(static_cast<int64_t>(text_len) < max_width) {
+            out.append(max_width - text_len, ' ');
         }
-        return torch::stack(values);
-    } else {
-        auto dim_size = tensor.size(0);
-        std::vector<torch::Tensor> values;
-        for(int i = 0; i < dim_size; i++) {
-            values.push_back(get_summarized_data(tensor[i], opts));
-        }
-        return torch::stack(values);
+        out.append(buf, len);
     }
+};
 
-}
-
-std::string lstrip(std::string const& original) {
-    std::string::const_iterator left = std::find_if(original.begin(), original.end(), IsNotSpace() );
-    return std::string(left, original.end());
-}
-
-std::string _scalar_str(torch::Tensor tensor, Formatter* formatter1, Formatter* formatter2 = nullptr) {
-    if(formatter2 != nullptr) {
-        auto real_str = _scalar_str(torch::real(tensor), formatter1);
-        auto imag_str = lstrip(_scalar_str(torch::imag(tensor), formatter2)) + "j";
-        if(imag_str[0] == '+' || imag_str[0] == '-') {
-            return real_str + imag_str;
-        } else {
-            return real_str + "+" + imag_str;
-        }
-    } else {
-        std::string result;
-        AT_DISPATCH_ALL_TYPES_AND(torch::ScalarType::Bool, tensor.scalar_type(), "repr_value", [&] {
-            scalar_t value = *tensor.data_ptr<scalar_t>();
-            result = formatter1->format<scalar_t>(value);
-        });
-        return result;
+// Gathers the elements that a summarized repr prints: every dimension
+// longer than `2 * edgeitems` is reduced to its first and last `edgeitems`
+// entries, in a single indexing call, so a large (or device) tensor is
+// never copied or converted as a whole.
+torch::Tensor summarize_edges(
+        const torch::Tensor &tensor, const std::vector<bool> &summarized, int64_t edgeitems) {
+    const int64_t dim = tensor.dim();
+    auto index_options = torch::TensorOptions().dtype(torch::kLong).device(tensor.device());
+
+    std::vector<torch::indexing::TensorIndex> indices;
+    for(int64_t d = 0; d < dim; d++) {
+        const int64_t size = tensor.size(d);
+        torch::Tensor index = summarized[d]
+            ? torch::cat({torch::arange(edgeitems, index_options),
+                          torch::arange(size - edgeitems, size, index_options)})
+            : torch::arange(size, index_options);
+
+        std::vector<int64_t> shape(dim, 1);
+        shape[d] = -1;
+        indices.emplace_back(index.view(shape));
     }
+    return tensor.index(indices);
 }
 
-std::string _vector_str(
-        torch::Tensor tensor, size_t indent, bool summarize,
-        Formatter* formatter1, Formatter* formatter2 = nullptr) {
-
-    auto element_length = formatter1->width() + 2;
-    if(formatter2 != nullptr) {
-      element_length += formatter2->width() + 1;
+// Writes the nested-list repr of a summarized tensor into a single buffer.
+// `sizes` and `strides` describe the contiguous tensor of printed elements;
+// `summarized` marks the dimensions where "..." stands for the elided
+// entries between the first and last `edgeitems`.
+struct Printer {
+    const PrintOptions opts;
+    const Formatter &real_formatter;
+    const Formatter *imag_formatter;
+    std::vector<int64_t> sizes;
+    std::vector<int64_t> strides;
+    std::vector<bool> summarized;
+    std::string out;
+
+    int64_t num_items(size_t d) const {
+        return sizes[d] + (summarized[d] ? 1 : 0);
     }
 
-    auto opts = formatter1->opts;
-    auto elements_per_line = (int) floor((opts.linewidth - indent) / ((double) element_length));
-    elements_per_line = 1 > elements_per_line ? 1 : elements_per_line;
-
-    std::vector<std::string> data;
-    if(summarize && !opts.edgeitems) {
-        data.push_back("...");
-    } else if(summarize && tensor.size(0) > 2 * opts.edgeitems) {
-        auto left_slice = tensor.index({torch::indexing::Slice(c10::nullopt, opts.edgeitems)});
-        auto right_slice = tensor.index({torch::indexing::Slice(-opts.edgeitems)});
-
-        for(int i = 0; i < left_slice.numel(); i++) {
-            data.push_back(_scalar_str(left_slice[i], formatter1, formatter2));
+    // Position of `item` along dimension `d`, or -1 for the "..." marker.
+    int64_t item_index(size_t d, int64_t item) const {
+        if(!summarized[d] || item < opts.edgeitems) {
+            return item;
         }
+        return item == opts.edgeitems ? -1 : item - 1;
+    }
 
-        data.push_back("...");
-        for(int i = 0; i < right_slice.numel(); i++) {
-            data.push_back(_scalar_str(right_slice[i], formatter1, formatter2));
-        }
-    } else {
-        for(int i = 0; i < tensor.numel(); i++) {
-            data.push_back(_scalar_str(tensor[i], formatter1, formatter2));
+    void element(int64_t offset) {
+        real_formatter.write(out, offset);
+        if(imag_formatter != nullptr) {
+            char buf[kMaxElementLength];
+            const size_t len = imag_formatter->format(offset, buf);
+            if(buf[0] != '+' && buf[0] != '-') {
+                out += '+';
+            }
+            out.append(buf, len);
+            out += 'j';
         }
     }
 
-    std::ostringstream ss;
-    ss << "[";
-
-    int last_chunk = std::max((int)(data.size() - elements_per_line), 0);
-    for(int i = 0; i < data.size(); i += elements_per_line) {
-        int left_ending = std::min((int) data.size(), i + elements_per_line);
-        for(int j = i; j < left_ending; j++) {
-            ss << data[j];
-            if(j < left_ending - 1) {
-                ss << ", ";
-            }
+    void vector(int64_t offset, size_t indent) {
+        const size_t d = sizes.size() - 1;
+        int64_t element_length = real_formatter.width() + 2;
+        if(imag_formatter != nullptr) {
+            element_length += imag_formatter->width() + 1;
         }
+        const int64_t elements_per_line = std::max<int64_t>(
+            1, (opts.linewidth - static_cast<int64_t>(indent)) / element_length);
+
+        out += '[';
+        for(int64_t item = 0; item < num_items(d); item++) {
+            if(item > 0 && item % elements_per_line == 0) {
+                out += ",\n";
+                out.append(indent + 1, ' ');
+            } else if(item > 0) {
+                out += ", ";
+            }
 
-        if(i < last_chunk) {
-            ss << ",\n" << std::string(indent + 1, ' ');
+            const int64_t index = item_index(d, item);
+            if(index < 0) {
+                out += "...";
+            } else {
+                element(offset + index * strides[d]);
+            }
         }
+        out += ']';
     }
-    ss << "]";
-    auto result = ss.str();
-    return result;
-}
-
-std::string _tensor_str_with_formatter(
-        torch::Tensor tensor, size_t indent, bool summarize,
-        Formatter* formatter1, Formatter* formatter2 = nullptr) {
 
-    auto dim = tensor.dim();
-    auto opts = formatter1->opts;
-    if(dim == 0) {
-        return _scalar_str(tensor.to(torch::kCPU), formatter1, formatter2);
-    } else if(dim == 1) {
-        return _vector_str(tensor.to(torch::kCPU), indent, summarize, formatter1, formatter2);
-    } else {
-        std::vector<std::string> slices;
-        if(summarize && tensor.size(0) > 2 * opts.edgeitems) {
-            for(int i = 0; i < opts.edgeitems; i++) {
-                slices.push_back(_tensor_str_with_formatter(
-                    tensor[i].to(torch::kCPU), indent + 1, summarize, formatter1, formatter2));
-            }
-            slices.push_back("...");
+    void tensor(size_t d, int64_t offset, size_t indent) {
+        const size_t remaining = sizes.size() - d;
+        if(remaining == 0) {
+            element(offset);
+            return;
+        } else if(remaining == 1) {
+            vector(offset, indent);
+            return;
+        }
 
-            for(int i = tensor.size(0) - opts.edgeitems; i < tensor.size(0); i++) {
-                slices.push_back(_tensor_str_with_formatter(
-                    tensor[i].to(torch::kCPU), indent + 1, summarize, formatter1, formatter2));
-            }
-        } else {
-            for(int i = 0; i < tensor.size(0); i++) {
-                slices.push_back(_tensor_str_with_formatter(
-                    tensor[i].to(torch::kCPU), indent + 1, summarize, formatter1, formatter2));
+        out += '[';
+        for(int64_t item = 0; item < num_items(d); item++) {
+            if(item > 0) {
+                out += ',';
+                out.append(remaining - 1, '\n');
+                out.append(indent + 1, ' ');
             }
-        }
 
-        std::ostringstream ss;
-        ss << "[";
-        for(int i = 0; i < slices.size(); i++) {
-            ss << slices[i];
-            if(i < slices.size() - 1) {
-                ss << ",";
-                ss << std::string(dim - 1, '\n');
-                ss << std::string(indent + 1, ' ');
+            const int64_t index = item_index(d, item);
+            if(index < 0) {
+                out += "...";
+            } else {
+                tensor(d + 1, offset + index * strides[d], indent + 1);
             }
         }
-
-        ss << "]";
-        return ss.str();
+        out += ']';
     }
-}
+};
 
 std::string _tensor_str(torch::Tensor& tensor, const PrintOptions opts, size_t indent) {
     if(tensor.numel() == 0) {
         return "[]";
-    } else {
-        if(tensor.has_names()) {
-            tensor = tensor.rename(c10::nullopt);
-        }
+    }
 
-        bool summarize = tensor.numel() > opts.threshold;
+    torch::NoGradGuard guard;
+    if(tensor.has_names()) {
+        tensor = tensor.rename(c10::nullopt);
+    }
 
-        if(tensor._is_zerotensor()) {
-            tensor = tensor.clone();
+    const bool summarize = tensor.numel() > opts.threshold;
+    std::vector<bool> summarized(tensor.dim(), false);
+    std::vector<int64_t> sizes = tensor.sizes().vec();
+    bool any_summarized = false;
+    for(int64_t d = 0; d < tensor.dim(); d++) {
+        if(summarize && sizes[d] > 2 * opts.edgeitems) {
+            summarized[d] = true;
+            sizes[d] = 2 * opts.edgeitems;
+            any_summarized = true;
         }
+    }
 
-        if(!tensor.is_contiguous()) {
-            tensor = tensor.contiguous();
-        }
+    torch::Tensor data;
+    if(tensor._is_zerotensor()) {
+        data = torch::zeros(sizes, tensor.options().device(torch::kCPU));
+    } else {
+        data = any_summarized ? summarize_edges(tensor, summarized, opts.edgeitems) : tensor;
+        data = data.to(torch::kCPU);
+    }
+    data = data.resolve_conj().resolve_neg().contiguous();
 
-        if(tensor.is_neg()) {
-            tensor = tensor.resolve_neg();
-        }
-        if(tensor.scalar_type() == torch::kHalf || tensor.scalar_type() == torch::kBFloat16) {
-           tensor = tensor.to(torch::kFloat);
-        }
+    std::vector<int64_t> strides(sizes.size(), 1);
+    for(int64_t d = static_cast<int64_t>(sizes.size()) - 2; d >= 0; d--) {
+        strides[d] = strides[d + 1] * sizes[d + 1];
+    }
 
-        if(tensor.scalar_type() == torch::kComplexFloat) {
-            tensor = tensor.to(torch::kComplexDouble);
-        }
+    std::unique_ptr<Formatter> real_formatter;
+    std::unique_ptr<Formatter> imag_formatter;
+    if(data.is_complex()) {
+        real_formatter = std::make_unique<Formatter>(torch::real(data), opts);
+        imag_formatter = std::make_unique<Formatter>(torch::imag(data), opts);
+    } else {
+        real_formatter = std::make_unique<Formatter>(data, opts);
+    }
 
-        if(tensor.is_complex()) {
-            tensor = tensor.resolve_conj();
-            auto real_part = torch::real(tensor);
-            auto real_formatter = new Formatter(
-                summarize ? get_summarized_data(real_part, opts) : real_part,
-                opts);
-
-            auto imag_part = torch::imag(tensor);
-            auto imag_formatter = new Formatter(
-                summarize ? get_summarized_data(imag_part, opts) : imag_part,
-                opts);
-
-            return _tensor_str_with_formatter(
-                tensor, indent, summarize, real_formatter, imag_formatter);
-        } else {
-            auto in_tensor = summarize ? get_summarized_data(tensor, opts) : tensor;
-            auto formatter = new Formatter(in_tensor, opts);
-            return _tensor_str_with_formatter(
-                tensor, indent, summarize, formatter);
-        }
+    Printer printer{opts, *real_formatter, imag_formatter.get(), sizes, strides, summarized, {}};
+    int64_t element_length = real_formatter->width() + 2;
+    if(imag_formatter) {
+        element_length += imag_formatter->width() + 2;
     }
+    printer.out.reserve(data.numel() * (element_length + 1) + 16 * tensor.dim() + 2);
+    printer.tensor(0, 0, indent);
+    return std::move(printer.out);
 }
@@ -53,7 +53,7 @@ std::shared_ptr<CrossTensor> any(
 
 std::shared_ptr<CrossTensor> argmax(
         const std::shared_ptr<CrossTensor> &input,
-        OptionalInt opt_dim, bool keepdim) {
+        OptionalInt opt_dim, bool keepdim, TensorOut opt_out) {
 
     CrossTensor out_tensor;
     CrossTensor in_tensor = *input.get();
@@ -61,14 +61,20 @@ std::shared_ptr<CrossTensor> argmax(
     if(opt_dim.used) {
         dim = opt_dim.value;
     }
-    out_tensor = torch::argmax(in_tensor, dim, keepdim);
+
+    if(opt_out.used) {
+        out_tensor = *opt_out.tensor.get();
+        out_tensor = torch::argmax_out(out_tensor, in_tensor, dim, keepdim);
+    } else {
+        out_tensor = torch::argmax(in_tensor, dim, keepdim);
+    }
     return std::make_shared<CrossTensor>(std::move(out_tensor));
 }
 
 
 std::shared_ptr<CrossTensor> argmin(
         const std::shared_ptr<CrossTensor> &input,
-        OptionalInt opt_dim, bool keepdim) {
+        OptionalInt opt_dim, bool keepdim, TensorOut opt_out) {
 
     CrossTensor out_tensor;
     CrossTensor in_tensor = *input.get();
@@ -76,7 +82,13 @@ std::shared_ptr<CrossTensor> argmin(
     if(opt_dim.used) {
         dim = opt_dim.value;
     }
-    out_tensor = torch::argmin(in_tensor, dim, keepdim);
+
+    if(opt_out.used) {
+        out_tensor = *opt_out.tensor.get();
+        out_tensor = torch::argmin_out(out_tensor, in_tensor, dim, keepdim);
+    } else {
+        out_tensor = torch::argmin(in_tensor, dim, keepdim);
+    }
     return std::make_shared<CrossTensor>(std::move(out_tensor));
 }
 
@@ -263,26 +275,38 @@ std::shared_ptr<CrossTensor> logsumexp(
 
 std::shared_ptr<CrossTensor> sum(
         const std::shared_ptr<CrossTensor> &input,
-        rust::Vec<int64_t> dims, bool keepdim) {
+        rust::Vec<int64_t> dims, bool keepdim, TensorOut opt_out) {
 
     CrossTensor out_tensor;
     CrossTensor in_tensor = *input.get();
     const int64_t *ptr = dims.data();
 
-    out_tensor = torch::sum(in_tensor, torch::IntArrayRef{ptr, dims.size()}, keepdim);
+    if(opt_out.used) {
+        out_tensor = *opt_out.tensor.get();
+        out_tensor = torch::sum_out(
+            out_tensor, in_tensor, torch::IntArrayRef{ptr, dims.size()}, keepdim);
+    } else {
+        out_tensor = torch::sum(in_tensor, torch::IntArrayRef{ptr, dims.size()}, keepdim);
+    }
     return std::make_shared<CrossTensor>(std::move(out_tensor));
 }
 
 std::shared_ptr<CrossTensor> nansum(
         const std::shared_ptr<CrossTensor> &input,
-        rust::Vec<int64_t> dims, bool keepdim) {
+        rust::Vec<int64_t> dims, bool keepdim, TensorOut opt_out) {
 
     CrossTensor out_tensor;
     CrossTensor in_tensor = *input.get();
     const int64_t *ptr = dims.data();
 
-    out_tensor = torch::nansum(
-        in_tensor, torch::IntArrayRef{ptr, dims.size()}, keepdim);
+    if(opt_out.used) {
+        out_tensor = *opt_out.tensor.get();
+        out_tensor = torch::nansum_out(
+            out_tensor, in_tensor, torch::IntArrayRef{ptr, dims.size()}, keepdim);
+    } else {
+        out_tensor = torch::nansum(
+            in_tensor, torch::IntArrayRef{ptr, dims.size()}, keepdim);
+    }
     return std::make_shared<CrossTensor>(std::move(out_tensor));
 }
 
@@ -422,11 +446,20 @@ TensorTuple mode(
 
 std::shared_ptr<CrossTensor> prod(
         const std::shared_ptr<CrossTensor> &input,
-        OptionalInt opt_dim, bool keepdim) {
+        OptionalInt opt_dim, bool keepdim, TensorOut opt_out) {
 
     CrossTensor out_tensor;
     CrossTensor in_tensor = *input.get();
-    if(opt_dim.used) {
+    if(opt_out.used) {
+        out_tensor = *opt_out.tensor.get();
+        // The full reduction has no dim-less out overload in every libtorch
+        // release; reducing the flattened tensor over dim 0 is equivalent.
+        if(opt_dim.used) {
+            out_tensor = torch::prod_out(out_tensor, in_tensor, opt_dim.value, keepdim);
+        } else {
+            out_tensor = torch::prod_out(out_tensor, in_tensor.flatten(), 0, false);
+        }
+    } else if(opt_dim.used) {
         out_tensor = torch::prod(in_tensor, opt_dim.value, keepdim);
     } else {
         out_tensor = torch::prod(in_tensor);
@@ -0,0 +1,247 @@
+#include "extorch/src/native.rs.h"
+#include "extorch/include/top_k.h"
+
+#include <ATen/Dispatch.h>
+#include <ATen/NumericUtils.h>
+#include <ATen/Parallel.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// Chunked top-k
+// ============================================================================
+
+namespace {
+
+template <typename T>
+using Candidate = std::pair<T, int64_t>;
+
+// Ranks candidates the way torch::topk does: NaN compares greater than
+// every number, so it is selected first by `largest` and never otherwise.
+template <typename T>
+struct Ranking {
+    bool largest;
+
+    bool better(T a, T b) const {
+        if (largest) {
+            return at::_isnan(a) ? !at::_isnan(b) : a > b;
+        }
+        return at::_isnan(b) ? !at::_isnan(a) : a < b;
+    }
+
+    bool operator()(const Candidate<T> &a, const Candidate<T> &b) const {
+        return better(a.first, b.first);
+    }
+};
+
+// Bounded heap whose front is the worst of the (at most k) candidates kept.
+template <typename T>
+struct TopKHeap {
+    int64_t k;
+    Ranking<T> rank;
+    std::vector<Candidate<T>> items;
+
+    TopKHeap(int64_t k, bool largest) : k(k), rank{largest} {
+        items.reserve(k);
+    }
+
+    void push(T value, int64_t index) {
+        if (static_cast<int64_t>(items.size()) < k) {
+            items.emplace_back(value, index);
+            std::push_heap(items.begin(), items.end(), rank);
+        } else if (k > 0 && rank.better(value, items.front().first)) {
+            std::pop_heap(items.begin(), items.end(), rank);
+            items.back() = {value, index};
+            std::push_heap(items.begin(), items.end(), rank);
+        }
+    }
+};
+
+template <typename T>
+void topk_row(
+    const T *row, int64_t n, int64_t k, bool largest, int64_t chunk_size,
+    T *values, int64_t *indices)
+{
+    const int64_t num_chunks = (n + chunk_size - 1) / chunk_size;
+
+    // One slot per parallel_for invocation, keyed by the first chunk it
+    // receives; each invocation scans its chunks into a single heap.
+    std::vector<std::vector<Candidate<T>>> partial(num_chunks);
+    at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+        TopKHeap<T> heap(k, largest);
+        for (int64_t i = begin * chunk_size; i < std::min(end * chunk_size, n); i++) {
+            heap.push(row[i], i);
+        }
+        partial[begin] = std::move(heap.items);
+    });
+
+    std::vector<Candidate<T>> merged;
+    for (auto &items : partial) {
+        merged.insert(merged.end(), items.begin(), items.end());
+    }
+    Ranking<T> rank{largest};
+    std::partial_sort(merged.begin(), merged.begin() + k, merged.end(), rank);
+
+    for (int64_t j = 0; j < k; j++) {
+        values[j] = merged[j].first;
+        indices[j] = merged[j].second;
+    }
+}
+
+SortResult wrap_result(torch::Tensor values, torch::Tensor indices) {
+    auto values_out = std::make_shared<CrossTensor>(std::move(values));
+    auto indices_out = std::make_shared<CrossTensor>(std::move(indices));
+    return SortResult{values_out, indices_out, true};
+}
+
+std::tuple<torch::Tensor, torch::Tensor> chunked_topk_impl(
+    const torch::Tensor &input, int64_t k, int64_t dim, bool largest, int64_t chunk_size)
+{
+    if (!use_chunked_topk(input, k, dim, chunk_size)) {
+        return torch::topk(input, k, dim, largest, /*sorted=*/true);
+    }
+
+    dim = at::maybe_wrap_dim(dim, input.dim());
+    auto rows = input.movedim(dim, -1).contiguous();
+    const int64_t n = rows.size(-1);
+    const int64_t num_rows = rows.numel() / n;
+
+    auto out_sizes = rows.sizes().vec();
+    out_sizes.back() = k;
+    auto values = torch::empty(out_sizes, rows.options());
+    auto indices = torch::empty(out_sizes, rows.options().dtype(torch::kLong));
+
+    AT_DISPATCH_ALL_TYPES(rows.scalar_type(), "chunked_topk", [&] {
+        const scalar_t *data = rows.data_ptr<scalar_t>();
+        scalar_t *value_data = values.data_ptr<scalar_t>();
+        int64_t *index_data = indices.data_ptr<int64_t>();
+        for (int64_t r = 0; r < num_rows; r++) {
+            topk_row<scalar_t>(
+                data + r * n, n, k, largest, chunk_size,
+                value_data + r * k, index_data + r * k);
+        }
+    });
+
+    return {values.movedim(-1, dim), indices.movedim(-1, dim)};
+}
+
+} // namespace
+
+bool use_chunked_topk(const torch::Tensor &input, int64_t k, int64_t dim, int64_t chunk_size) {
+    if (input.dim() == 0 || !input.device().is_cpu() || input.layout() != torch::kStrided) {
+        return false;
+    }
+    if (input.requires_grad() && torch::GradMode::is_enabled()) {
+        return false;
+    }
+    if (!at::isIntegralType(input.scalar_type(), /*includeBool=*/false) &&
+        input.scalar_type() != torch::kFloat && input.scalar_type() != torch::kDouble) {
+        return false;
+    }
+
+    const int64_t n = input.size(at::maybe_wrap_dim(dim, input.dim()));
+    // Splitting only pays off when there are several chunks to scan in
+    // parallel and each keeps far fewer candidates than it reads.
+    return chunk_size > 0 && k >= 0 && k <= n && n >= 2 * chunk_size && 4 * k <= chunk_size;
+}
+
+bool topk_chunked_path(const std::shared_ptr<CrossTensor> &input, int64_t k, int64_t dim) {
+    const torch::Tensor &tensor = *input;
+    // torch::topk already gives each thread whole rows, and the chunked
+    // path scans rows one after the other, so it only helps while there
+    // are fewer rows than threads.
+    return use_chunked_topk(tensor, k, dim, kTopKChunkSize) &&
+           tensor.numel() / tensor.size(dim) < at::get_num_threads();
+}
+
+SortResult chunked_topk(
+    const std::shared_ptr<CrossTensor> &input,
+    int64_t k,
+    int64_t dim,
+    bool largest,
+    int64_t chunk_size)
+{
+    torch::Tensor values, indices;
+    std::tie(values, indices) = chunked_topk_impl(*input, k, dim, largest, chunk_size);
+    return wrap_result(std::move(values), std::move(indices));
+}
+
+SortResult topk_matmul(
+    const std::shared_ptr<CrossTensor> &query,
+    const std::shared_ptr<CrossTensor> &keys,
+    int64_t k,
+    bool largest,
+    int64_t chunk_size)
+{
+    const torch::Tensor &q = *query;
+    const torch::Tensor &key_tensor = *keys;
+    TORCH_CHECK(q.dim() == 2 && key_tensor.dim() == 2,
+                "topk_matmul expects a 2-D query and 2-D keys");
+    TORCH_CHECK(chunk_size > 0, "chunk_size must be positive");
+
+    const int64_t n = key_tensor.size(0);
+    TORCH_CHECK(k >= 0 && k <= n, "selected index k out of range");
+
+    const int64_t num_chunks = (n + chunk_size - 1) / chunk_size;
+    std::vector<torch::Tensor> chunk_values(num_chunks);
+    std::vector<torch::Tensor> chunk_indices(num_chunks);
+
+    auto score_chunk = [&](int64_t c) {
+        const int64_t start = c * chunk_size;
+        const int64_t len = std::min(chunk_size, n - start);
+        auto scores = torch::mm(q, key_tensor.narrow(0, start, len).t());
+        torch::Tensor values, indices;
+        std::tie(values, indices) = torch::topk(scores, std::min(k, len), 1, largest, false);
+        chunk_values[c] = values;
+        chunk_indices[c] = indices.add_(start);
+    };
+
+    if (q.device().is_cpu()) {
+        // Inside a parallel region mm and topk run single-threaded, so every
+        // thread works on its own cache-sized block of keys.
+        at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+            for (int64_t c = begin; c < end; c++) {
+                score_chunk(c);
+            }
+        });
+    } else {
+        for (int64_t c = 0; c < num_chunks; c++) {
+            score_chunk(c);
+        }
+    }
+
+    auto candidates = torch::cat(chunk_values, 1);
+    auto candidate_indices = torch::cat(chunk_indices, 1);
+    torch::Tensor values, positions;
+    std::tie(values, positions) = torch::topk(candidates, k, 1, largest, true);
+    return wrap_result(std::move(values), candidate_indices.gather(1, positions));
+}
+
+SortResult topk_merge(
+    SortResult state,
+    const std::shared_ptr<CrossTensor> &chunk,
+    int64_t offset,
+    int64_t k,
+    bool largest)
+{
+    const torch::Tensor &scores = *chunk;
+    TORCH_CHECK(scores.dim() > 0, "topk_merge expects at least a 1-D chunk");
+
+    const int64_t len = scores.size(-1);
+    torch::Tensor values, indices;
+    std::tie(values, indices) = chunked_topk_impl(
+        scores, std::min(k, len), -1, largest, kTopKChunkSize);
+    indices.add_(offset);
+
+    if (state.used) {
+        auto candidates = torch::cat({*state.values, values}, -1);
+        auto candidate_indices = torch::cat({*state.indices, indices}, -1);
+        torch::Tensor positions;
+        std::tie(values, positions) = torch::topk(
+            candidates, std::min(k, candidates.size(-1)), -1, largest, true);
+        indices = candidate_indices.gather(-1, positions);
+    }
+    return wrap_result(std::move(values), std::move(indices));
+}
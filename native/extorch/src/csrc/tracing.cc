@@ -0,0 +1,93 @@
+#include "extorch/src/native.rs.h"
+#include "extorch/include/tracing.h"
+#include "extorch/include/aoti.h"
+#include "extorch/include/dispatcher.h"
+#include "extorch/include/jit.h"
+
+#include <ATen/record_function.h>
+#include <torch/csrc/autograd/profiler_kineto.h>
+
+#include <set>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+namespace profiler = torch::autograd::profiler;
+namespace profiler_impl = torch::profiler::impl;
+
+// Runs `run` once per request with the Kineto profiler enabled on this
+// thread, then saves the trace. The profiler is always disabled again,
+// also when a request throws.
+template <typename Run>
+void trace_requests(
+        int64_t requests, const rust::String &path,
+        bool record_shapes, bool profile_memory, Run run) {
+    if (requests < 1) {
+        throw std::invalid_argument("trace: requests must be positive");
+    }
+
+    const profiler_impl::ProfilerConfig config(
+        profiler_impl::ProfilerState::KINETO, record_shapes, profile_memory);
+    const std::set<profiler_impl::ActivityType> activities{profiler_impl::ActivityType::CPU};
+    profiler::prepareProfiler(config, activities);
+    profiler::enableProfiler(config, activities);
+
+    try {
+        for (int64_t i = 0; i < requests; i++) {
+            const std::string name = "request#" + std::to_string(i);
+            at::RecordFunction range(at::RecordScope::USER_SCOPE);
+            if (range.isActive()) {
+                range.before(name.c_str());
+            }
+            run();
+        }
+    } catch (...) {
+        profiler::disableProfiler();
+        throw;
+    }
+
+    auto result = profiler::disableProfiler();
+    result->save(std::string(path));
+}
+
+} // namespace
+
+void trace_compiled_graph(
+    const std::shared_ptr<CrossCompiledGraph> &compiled,
+    TensorList inputs,
+    int64_t requests,
+    rust::String path,
+    bool record_shapes,
+    bool profile_memory)
+{
+    trace_requests(requests, path, record_shapes, profile_memory, [&]() {
+        run_compiled_graph(compiled, inputs);
+    });
+}
+
+void trace_aoti(
+    const std::shared_ptr<CrossAOTILoader> &loader,
+    TensorList inputs,
+    int64_t requests,
+    rust::String path,
+    bool record_shapes,
+    bool profile_memory)
+{
+    trace_requests(requests, path, record_shapes, profile_memory, [&]() {
+        aoti_forward(loader, inputs);
+    });
+}
+
+void trace_jit(
+    const std::shared_ptr<CrossModule> &module,
+    TensorList inputs,
+    int64_t requests,
+    rust::String path,
+    bool record_shapes,
+    bool profile_memory)
+{
+    trace_requests(requests, path, record_shapes, profile_memory, [&]() {
+        jit_forward(module, inputs);
+    });
+}
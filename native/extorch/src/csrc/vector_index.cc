@@ -0,0 +1,760 @@
+#include "extorch/src/native.rs.h"
+#include "extorch/include/vector_index.h"
+
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec/vec.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <queue>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <process.h>
+#define getpid _getpid
+#endif
+
+// ============================================================================
+// Vector index
+// ============================================================================
+
+namespace {
+
+using Index = CrossVectorIndexImpl;
+
+// A (distance, id) pair. Smaller distances are better for every metric:
+// inner products are negated.
+using Neighbour = std::pair<float, int64_t>;
+
+using Vec = at::vec::Vectorized<float>;
+
+float reduce_lanes(const Vec &acc) {
+    float lanes[Vec::size()];
+    acc.store(lanes);
+    float sum = 0.0f;
+    for (int64_t i = 0; i < Vec::size(); i++) {
+        sum += lanes[i];
+    }
+    return sum;
+}
+
+float dot_kernel(const float *a, const float *b, int64_t dim) {
+    Vec acc(0.0f);
+    int64_t i = 0;
+    for (; i + Vec::size() <= dim; i += Vec::size()) {
+        acc = at::vec::fmadd(Vec::loadu(a + i), Vec::loadu(b + i), acc);
+    }
+    float sum = reduce_lanes(acc);
+    for (; i < dim; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+float l2_kernel(const float *a, const float *b, int64_t dim) {
+    Vec acc(0.0f);
+    int64_t i = 0;
+    for (; i + Vec::size() <= dim; i += Vec::size()) {
+        auto diff = Vec::loadu(a + i) - Vec::loadu(b + i);
+        acc = at::vec::fmadd(diff, diff, acc);
+    }
+    float sum = reduce_lanes(acc);
+    for (; i < dim; i++) {
+        const float diff = a[i] - b[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+float distance(const Index &index, const float *a, const float *b) {
+    if (index.metric == Index::Metric::L2) {
+        return l2_kernel(a, b, index.dim);
+    }
+    return -dot_kernel(a, b, index.dim);
+}
+
+torch::Tensor as_matrix(const torch::Tensor &input, int64_t dim, const char *name) {
+    TORCH_CHECK(input.dim() == 2 && input.size(1) == dim,
+                "expected ", name, " of shape [n, ", dim, "], got ", input.sizes());
+    return input.to(torch::kCPU, torch::kFloat).contiguous();
+}
+
+// Grow the storage to hold at least `needed` rows, doubling its capacity
+// so that repeated small inserts stay amortized O(1) per row.
+void reserve(Index &index, int64_t needed) {
+    const int64_t capacity = index.storage.defined() ? index.storage.size(0) : 0;
+    if (needed <= capacity) {
+        return;
+    }
+    const int64_t grown_capacity = std::max<int64_t>({needed, 2 * capacity, 1024});
+    auto grown = torch::empty({grown_capacity, index.dim}, torch::kFloat);
+    if (index.count > 0) {
+        grown.narrow(0, 0, index.count).copy_(index.storage.narrow(0, 0, index.count));
+    }
+    index.storage = grown;
+}
+
+std::vector<Neighbour> drain_sorted(std::priority_queue<Neighbour> &heap) {
+    std::vector<Neighbour> sorted(heap.size());
+    for (auto it = sorted.rbegin(); it != sorted.rend(); ++it) {
+        *it = heap.top();
+        heap.pop();
+    }
+    return sorted;
+}
+
+// IVF-flat
+// ----------------------------------------------------------------------------
+
+torch::Tensor nearest_centroid(Index::Metric metric, const torch::Tensor &centroids, const torch::Tensor &x) {
+    auto scores = torch::mm(x, centroids.t());
+    if (metric == Index::Metric::L2) {
+        // |x - c|^2 = |x|^2 - 2 x.c + |c|^2, and |x|^2 does not change the argmin.
+        return (centroids.pow(2).sum(1).unsqueeze(0) - 2 * scores).argmin(1);
+    }
+    return scores.argmax(1);
+}
+
+std::vector<Neighbour> ivf_search(const Index &index, const float *query, int64_t k, int64_t nprobe) {
+    const float *centroid_data = index.centroids.data_ptr<float>();
+    std::vector<Neighbour> probes(index.nlist);
+    for (int64_t c = 0; c < index.nlist; c++) {
+        probes[c] = {distance(index, query, centroid_data + c * index.dim), c};
+    }
+    nprobe = std::min(nprobe, index.nlist);
+    std::partial_sort(probes.begin(), probes.begin() + nprobe, probes.end());
+
+    std::priority_queue<Neighbour> best;
+    for (int64_t p = 0; p < nprobe; p++) {
+        for (int64_t id : index.lists[probes[p].second]) {
+            const float d = distance(index, query, index.row(id));
+            if (static_cast<int64_t>(best.size()) < k) {
+                best.emplace(d, id);
+            } else if (d < best.top().first) {
+                best.pop();
+                best.emplace(d, id);
+            }
+        }
+    }
+    return drain_sorted(best);
+}
+
+// HNSW
+// ----------------------------------------------------------------------------
+
+// Visited marks for graph searches, reused across searches on a thread:
+// bumping the tag clears every mark at once.
+struct VisitedSet {
+    std::vector<uint32_t> marks;
+    uint32_t tag = 0;
+
+    void reset(int64_t size) {
+        if (static_cast<int64_t>(marks.size()) < size) {
+            marks.resize(size, 0);
+        }
+        if (++tag == 0) {
+            std::fill(marks.begin(), marks.end(), 0);
+            tag = 1;
+        }
+    }
+
+    bool insert(int64_t id) {
+        if (marks[id] == tag) {
+            return false;
+        }
+        marks[id] = tag;
+        return true;
+    }
+};
+
+VisitedSet &visited_set() {
+    thread_local VisitedSet visited;
+    return visited;
+}
+
+// Move to the closest neighbour on `level` until no neighbour is closer.
+Neighbour greedy_closest(const Index &index, const float *query, Neighbour current, int64_t level) {
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int64_t neighbour : index.links[current.second][level]) {
+            const float d = distance(index, query, index.row(neighbour));
+            if (d < current.first) {
+                current = {d, neighbour};
+                changed = true;
+            }
+        }
+    }
+    return current;
+}
+
+// Beam search on one layer, returning up to `ef` nodes, nearest first.
+std::vector<Neighbour> search_layer(
+    const Index &index, const float *query, const std::vector<Neighbour> &entry,
+    int64_t ef, int64_t level)
+{
+    auto &visited = visited_set();
+    visited.reset(index.count);
+
+    std::priority_queue<Neighbour, std::vector<Neighbour>, std::greater<Neighbour>> candidates;
+    std::priority_queue<Neighbour> results;
+    for (const auto &e : entry) {
+        if (visited.insert(e.second)) {
+            candidates.push(e);
+            results.push(e);
+        }
+    }
+    while (static_cast<int64_t>(results.size()) > ef) {
+        results.pop();
+    }
+
+    while (!candidates.empty()) {
+        const Neighbour current = candidates.top();
+        if (current.first > results.top().first && static_cast<int64_t>(results.size()) >= ef) {
+            break;
+        }
+        candidates.pop();
+
+        for (int64_t neighbour : index.links[current.second][level]) {
+            if (!visited.insert(neighbour)) {
+                continue;
+            }
+            const float d = distance(index, query, index.row(neighbour));
+            if (static_cast<int64_t>(results.size()) < ef || d < results.top().first) {
+                candidates.emplace(d, neighbour);
+                results.emplace(d, neighbour);
+                if (static_cast<int64_t>(results.size()) > ef) {
+                    results.pop();
+                }
+            }
+        }
+    }
+    return drain_sorted(results);
+}
+
+// The neighbour selection heuristic of the HNSW paper: a candidate is kept
+// only if it is closer to the base node than to every neighbour kept so
+// far, which spreads links across directions instead of clustering them.
+// Remaining slots are filled with the closest discarded candidates.
+// `candidates` must be sorted nearest first.
+std::vector<int64_t> select_neighbours(
+    const Index &index, const std::vector<Neighbour> &candidates, int64_t max_links)
+{
+    std::vector<int64_t> selected;
+    std::vector<int64_t> discarded;
+    for (const auto &candidate : candidates) {
+        if (static_cast<int64_t>(selected.size()) >= max_links) {
+            break;
+        }
+        const float *point = index.row(candidate.second);
+        bool keep = true;
+        for (int64_t other : selected) {
+            if (distance(index, point, index.row(other)) < candidate.first) {
+                keep = false;
+                break;
+            }
+        }
+        (keep ? selected : discarded).push_back(candidate.second);
+    }
+    for (int64_t id : discarded) {
+        if (static_cast<int64_t>(selected.size()) >= max_links) {
+            break;
+        }
+        selected.push_back(id);
+    }
+    return selected;
+}
+
+void hnsw_insert(Index &index, int64_t id) {
+    const float *query = index.row(id);
+
+    // Levels are geometrically distributed with ratio 1 / m.
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const double level_mult = 1.0 / std::log(static_cast<double>(index.m));
+    const int64_t level = static_cast<int64_t>(-std::log(1.0 - uniform(index.rng)) * level_mult);
+    index.levels[id] = level;
+    index.links[id].assign(level + 1, {});
+
+    if (index.entry_point < 0) {
+        index.entry_point = id;
+        index.max_level = level;
+        return;
+    }
+
+    Neighbour current{distance(index, query, index.row(index.entry_point)), index.entry_point};
+    for (int64_t lc = index.max_level; lc > level; lc--) {
+        current = greedy_closest(index, query, current, lc);
+    }
+
+    std::vector<Neighbour> entry{current};
+    for (int64_t lc = std::min(level, index.max_level); lc >= 0; lc--) {
+        auto candidates = search_layer(index, query, entry, index.ef_construction, lc);
+        const int64_t max_links = lc == 0 ? 2 * index.m : index.m;
+
+        index.links[id][lc] = select_neighbours(index, candidates, index.m);
+        for (int64_t neighbour : index.links[id][lc]) {
+            auto &links = index.links[neighbour][lc];
+            links.push_back(id);
+            if (static_cast<int64_t>(links.size()) > max_links) {
+                const float *base = index.row(neighbour);
+                std::vector<Neighbour> scored;
+                scored.reserve(links.size());
+                for (int64_t other : links) {
+                    scored.emplace_back(distance(index, base, index.row(other)), other);
+                }
+                std::sort(scored.begin(), scored.end());
+                links = select_neighbours(index, scored, max_links);
+            }
+        }
+        entry = std::move(candidates);
+    }
+
+    if (level > index.max_level) {
+        index.max_level = level;
+        index.entry_point = id;
+    }
+}
+
+std::vector<Neighbour> hnsw_search(const Index &index, const float *query, int64_t k, int64_t ef) {
+    Neighbour current{distance(index, query, index.row(index.entry_point)), index.entry_point};
+    for (int64_t lc = index.max_level; lc > 0; lc--) {
+        current = greedy_closest(index, query, current, lc);
+    }
+    auto found = search_layer(index, query, {current}, std::max(ef, k), 0);
+    if (static_cast<int64_t>(found.size()) > k) {
+        found.resize(k);
+    }
+    return found;
+}
+
+// Persistence
+// ----------------------------------------------------------------------------
+
+constexpr char kMagic[8] = {'E', 'X', 'T', 'V', 'I', 'D', 'X', '\0'};
+constexpr int64_t kFormatVersion = 1;
+constexpr int64_t kDataAlignment = 64;
+
+struct FileHeader {
+    char magic[8];
+    int64_t version;
+    int64_t kind;
+    int64_t metric;
+    int64_t dim;
+    int64_t count;
+    int64_t nlist;
+    int64_t nprobe;
+    int64_t m;
+    int64_t ef_construction;
+    int64_t ef_search;
+    int64_t seed;
+    int64_t max_level;
+    int64_t entry_point;
+    int64_t trained;
+    int64_t data_offset;
+};
+
+void write_i64(std::ostream &out, int64_t value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void write_ids(std::ostream &out, const std::vector<int64_t> &ids) {
+    write_i64(out, static_cast<int64_t>(ids.size()));
+    out.write(reinterpret_cast<const char *>(ids.data()), ids.size() * sizeof(int64_t));
+}
+
+int64_t read_i64(std::istream &in) {
+    int64_t value = 0;
+    in.read(reinterpret_cast<char *>(&value), sizeof(value));
+    return value;
+}
+
+std::vector<int64_t> read_ids(std::istream &in, int64_t count) {
+    const int64_t size = read_i64(in);
+    TORCH_CHECK(in && size >= 0 && size <= count, "corrupt vector index file");
+    std::vector<int64_t> ids(size);
+    in.read(reinterpret_cast<char *>(ids.data()), size * sizeof(int64_t));
+    for (int64_t id : ids) {
+        TORCH_CHECK(id >= 0 && id < count, "corrupt vector index file");
+    }
+    return ids;
+}
+
+// Map the vector block of an index file copy-on-write. Returns an
+// undefined tensor where mapping is not available.
+torch::Tensor map_vectors(const std::string &path, int64_t offset, int64_t count, int64_t dim) {
+#ifdef _WIN32
+    return torch::Tensor();
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    TORCH_CHECK(fd >= 0, "could not open vector index file ", path);
+    struct stat info;
+    const bool ok = ::fstat(fd, &info) == 0;
+    const size_t length = offset + count * dim * sizeof(float);
+    if (!ok || static_cast<size_t>(info.st_size) < length) {
+        ::close(fd);
+        TORCH_CHECK(false, "truncated vector index file ", path);
+    }
+    void *base = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    TORCH_CHECK(base != MAP_FAILED, "could not map vector index file ", path);
+
+    float *data = reinterpret_cast<float *>(static_cast<char *>(base) + offset);
+    return torch::from_blob(
+        data, {count, dim}, [base, length](void *) { ::munmap(base, length); }, torch::kFloat);
+#endif
+}
+
+const char *kind_name(Index::Kind kind) {
+    return kind == Index::Kind::IVFFlat ? "ivf_flat" : "hnsw";
+}
+
+const char *metric_name(Index::Metric metric) {
+    return metric == Index::Metric::L2 ? "l2" : "ip";
+}
+
+void check_parameters(const Index &index) {
+    TORCH_CHECK(index.dim > 0, "vector index dim must be positive, got ", index.dim);
+    if (index.kind == Index::Kind::IVFFlat) {
+        TORCH_CHECK(index.nlist > 0 && index.nprobe > 0, "nlist and nprobe must be positive");
+    } else {
+        TORCH_CHECK(index.m >= 2, "m must be at least 2, got ", index.m);
+        TORCH_CHECK(index.ef_construction > 0 && index.ef_search > 0,
+                    "ef_construction and ef_search must be positive");
+    }
+}
+
+SortResult wrap_result(torch::Tensor values, torch::Tensor indices) {
+    auto values_out = std::make_shared<CrossTensor>(std::move(values));
+    auto indices_out = std::make_shared<CrossTensor>(std::move(indices));
+    return SortResult{values_out, indices_out, true};
+}
+
+} // namespace
+
+std::shared_ptr<CrossVectorIndex> vector_index_new(VectorIndexOptions options) {
+    auto index = std::make_shared<CrossVectorIndex>();
+    const std::string kind(options.kind);
+    const std::string metric(options.metric);
+
+    if (kind == "ivf_flat") {
+        index->kind = Index::Kind::IVFFlat;
+    } else if (kind == "hnsw") {
+        index->kind = Index::Kind::HNSW;
+    } else {
+        TORCH_CHECK(false, "unknown vector index kind: ", kind);
+    }
+
+    if (metric == "l2") {
+        index->metric = Index::Metric::L2;
+    } else if (metric == "ip") {
+        index->metric = Index::Metric::InnerProduct;
+    } else {
+        TORCH_CHECK(false, "unknown vector index metric: ", metric);
+    }
+
+    index->dim = options.dim;
+    index->nlist = options.nlist;
+    index->nprobe = options.nprobe;
+    index->m = options.m;
+    index->ef_construction = options.ef_construction;
+    index->ef_search = options.ef_search;
+    index->seed = options.seed;
+    index->rng.seed(static_cast<uint64_t>(options.seed));
+    check_parameters(*index);
+    return index;
+}
+
+void vector_index_train(
+    const std::shared_ptr<CrossVectorIndex> &index,
+    const std::shared_ptr<CrossTensor> &sample,
+    int64_t iterations)
+{
+    Index &idx = *index;
+    std::unique_lock<std::shared_mutex> lock(idx.mutex);
+    if (idx.kind != Index::Kind::IVFFlat) {
+        return;
+    }
+    TORCH_CHECK(idx.count == 0, "cannot retrain an IVF index that already holds vectors");
+
+    auto x = as_matrix(*sample, idx.dim, "sample");
+    const int64_t n = x.size(0);
+    TORCH_CHECK(n >= idx.nlist, "training needs at least nlist = ", idx.nlist, " vectors, got ", n);
+
+    // k-means (Lloyd), seeded with distinct sample rows. Empty clusters
+    // keep their previous centroid.
+    std::vector<int64_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), idx.rng);
+    order.resize(idx.nlist);
+    auto centroids = x.index_select(0, torch::tensor(order, torch::kLong));
+
+    for (int64_t it = 0; it < iterations; it++) {
+        auto assignment = nearest_centroid(idx.metric, centroids, x);
+        auto sums = torch::zeros_like(centroids).index_add_(0, assignment, x);
+        auto counts = torch::bincount(assignment, {}, idx.nlist).to(torch::kFloat).unsqueeze(1);
+        centroids = torch::where(counts > 0, sums / counts.clamp_min(1), centroids);
+    }
+
+    idx.centroids = centroids.contiguous();
+    idx.lists.assign(idx.nlist, {});
+}
+
+int64_t vector_index_add(
+    const std::shared_ptr<CrossVectorIndex> &index,
+    const std::shared_ptr<CrossTensor> &vectors)
+{
+    Index &idx = *index;
+    std::unique_lock<std::shared_mutex> lock(idx.mutex);
+    TORCH_CHECK(idx.kind != Index::Kind::IVFFlat || idx.centroids.defined(),
+                "IVF index must be trained before adding vectors");
+
+    auto x = as_matrix(*vectors, idx.dim, "vectors");
+    const int64_t n = x.size(0);
+    const int64_t first = idx.count;
+
+    reserve(idx, first + n);
+    idx.storage.narrow(0, first, n).copy_(x);
+    idx.count += n;
+
+    if (idx.kind == Index::Kind::IVFFlat) {
+        auto assignment = nearest_centroid(idx.metric, idx.centroids, x).contiguous();
+        const int64_t *lists = assignment.data_ptr<int64_t>();
+        for (int64_t i = 0; i < n; i++) {
+            idx.lists[lists[i]].push_back(first + i);
+        }
+    } else {
+        idx.levels.resize(idx.count);
+        idx.links.resize(idx.count);
+        for (int64_t i = 0; i < n; i++) {
+            hnsw_insert(idx, first + i);
+        }
+    }
+    return first;
+}
+
+SortResult vector_index_search(
+    const std::shared_ptr<CrossVectorIndex> &index,
+    const std::shared_ptr<CrossTensor> &queries,
+    int64_t k,
+    int64_t effort)
+{
+    const Index &idx = *index;
+    std::shared_lock<std::shared_mutex> lock(idx.mutex);
+    TORCH_CHECK(k >= 0, "k must be non-negative, got ", k);
+
+    auto q = as_matrix(*queries, idx.dim, "queries");
+    const int64_t num_queries = q.size(0);
+    const bool l2 = idx.metric == Index::Metric::L2;
+    const float missing = l2 ? std::numeric_limits<float>::infinity()
+                             : -std::numeric_limits<float>::infinity();
+    auto scores = torch::full({num_queries, k}, missing, torch::kFloat);
+    auto ids = torch::full({num_queries, k}, -1, torch::kLong);
+    if (k == 0 || idx.count == 0) {
+        return wrap_result(std::move(scores), std::move(ids));
+    }
+
+    const bool ivf = idx.kind == Index::Kind::IVFFlat;
+    if (effort <= 0) {
+        effort = ivf ? idx.nprobe : idx.ef_search;
+    }
+
+    const float *query_data = q.data_ptr<float>();
+    float *score_data = scores.data_ptr<float>();
+    int64_t *id_data = ids.data_ptr<int64_t>();
+    at::parallel_for(0, num_queries, 1, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            const float *query = query_data + i * idx.dim;
+            auto found = ivf ? ivf_search(idx, query, k, effort) : hnsw_search(idx, query, k, effort);
+            for (size_t j = 0; j < found.size(); j++) {
+                score_data[i * k + j] = l2 ? found[j].first : -found[j].first;
+                id_data[i * k + j] = found[j].second;
+            }
+        }
+    });
+
+    return wrap_result(std::move(scores), std::move(ids));
+}
+
+int64_t vector_index_size(const std::shared_ptr<CrossVectorIndex> &index) {
+    std::shared_lock<std::shared_mutex> lock(index->mutex);
+    return index->count;
+}
+
+bool vector_index_is_trained(const std::shared_ptr<CrossVectorIndex> &index) {
+    std::shared_lock<std::shared_mutex> lock(index->mutex);
+    return index->kind != Index::Kind::IVFFlat || index->centroids.defined();
+}
+
+VectorIndexOptions vector_index_options(const std::shared_ptr<CrossVectorIndex> &index) {
+    const Index &idx = *index;
+    return VectorIndexOptions{
+        rust::String(kind_name(idx.kind)), rust::String(metric_name(idx.metric)),
+        idx.dim, idx.nlist, idx.nprobe, idx.m, idx.ef_construction, idx.ef_search, idx.seed};
+}
+
+std::shared_ptr<CrossTensor> vector_index_vectors(const std::shared_ptr<CrossVectorIndex> &index) {
+    std::shared_lock<std::shared_mutex> lock(index->mutex);
+    if (index->count == 0) {
+        return std::make_shared<CrossTensor>(torch::empty({0, index->dim}, torch::kFloat));
+    }
+    // Cloned under the lock: a view would alias storage that a later `add`
+    // can write into or reallocate.
+    return std::make_shared<CrossTensor>(index->storage.narrow(0, 0, index->count).clone());
+}
+
+void vector_index_save(const std::shared_ptr<CrossVectorIndex> &index, rust::String path) {
+    const Index &idx = *index;
+    std::shared_lock<std::shared_mutex> lock(idx.mutex);
+    const std::string file(path);
+    // The file is written next to its destination and renamed over it: an
+    // index loaded with mmap from the same path keeps reading its mapping,
+    // which truncating the file in place would invalidate. The temporary name
+    // is unique per process and call so that concurrent saves to the same
+    // path never write into each other's file.
+    static std::atomic<uint64_t> save_counter{0};
+    const std::string tmp_file = file + ".tmp" + std::to_string(getpid()) + "." +
+                                 std::to_string(save_counter.fetch_add(1, std::memory_order_relaxed));
+    std::ofstream out(tmp_file, std::ios::binary | std::ios::trunc);
+    TORCH_CHECK(out, "could not open ", tmp_file, " for writing");
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.kind = static_cast<int64_t>(idx.kind);
+    header.metric = static_cast<int64_t>(idx.metric);
+    header.dim = idx.dim;
+    header.count = idx.count;
+    header.nlist = idx.nlist;
+    header.nprobe = idx.nprobe;
+    header.m = idx.m;
+    header.ef_construction = idx.ef_construction;
+    header.ef_search = idx.ef_search;
+    header.seed = idx.seed;
+    header.max_level = idx.max_level;
+    header.entry_point = idx.entry_point;
+    header.trained = idx.centroids.defined();
+    header.data_offset = (sizeof(FileHeader) + kDataAlignment - 1) / kDataAlignment * kDataAlignment;
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    const std::vector<char> padding(header.data_offset - sizeof(header), 0);
+    out.write(padding.data(), padding.size());
+    if (idx.count > 0) {
+        out.write(reinterpret_cast<const char *>(idx.row(0)), idx.count * idx.dim * sizeof(float));
+    }
+
+    if (idx.kind == Index::Kind::IVFFlat) {
+        if (header.trained) {
+            out.write(reinterpret_cast<const char *>(idx.centroids.data_ptr<float>()),
+                      idx.nlist * idx.dim * sizeof(float));
+            for (const auto &list : idx.lists) {
+                write_ids(out, list);
+            }
+        }
+    } else {
+        for (int64_t id = 0; id < idx.count; id++) {
+            write_i64(out, idx.levels[id]);
+            for (const auto &links : idx.links[id]) {
+                write_ids(out, links);
+            }
+        }
+    }
+
+    out.flush();
+    out.close();
+    if (!out) {
+        std::remove(tmp_file.c_str());
+        TORCH_CHECK(false, "failed to write vector index to ", tmp_file);
+    }
+    if (std::rename(tmp_file.c_str(), file.c_str()) != 0) {
+        std::remove(tmp_file.c_str());
+        TORCH_CHECK(false, "could not move vector index to ", file);
+    }
+}
+
+std::shared_ptr<CrossVectorIndex> vector_index_load(rust::String path, bool mmap) {
+    const std::string file(path);
+    std::ifstream in(file, std::ios::binary);
+    TORCH_CHECK(in, "could not open vector index file ", file);
+
+    FileHeader header{};
+    in.read(reinterpret_cast<char *>(&header), sizeof(header));
+    TORCH_CHECK(in && std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0,
+                "not an ExTorch vector index: ", file);
+    TORCH_CHECK(header.version == kFormatVersion,
+                "unsupported vector index format version ", header.version);
+    TORCH_CHECK(header.kind >= 0 && header.kind <= 1 && header.metric >= 0 && header.metric <= 1 &&
+                header.count >= 0, "corrupt vector index file");
+
+    auto index = std::make_shared<CrossVectorIndex>();
+    Index &idx = *index;
+    idx.kind = static_cast<Index::Kind>(header.kind);
+    idx.metric = static_cast<Index::Metric>(header.metric);
+    idx.dim = header.dim;
+    idx.count = header.count;
+    idx.nlist = header.nlist;
+    idx.nprobe = header.nprobe;
+    idx.m = header.m;
+    idx.ef_construction = header.ef_construction;
+    idx.ef_search = header.ef_search;
+    idx.seed = header.seed;
+    idx.max_level = header.max_level;
+    idx.entry_point = header.entry_point;
+    // Continue with a different level sequence than the one that built the
+    // saved graph.
+    idx.rng.seed(static_cast<uint64_t>(header.seed) ^ static_cast<uint64_t>(header.count));
+    check_parameters(idx);
+
+    const int64_t data_bytes = idx.count * idx.dim * sizeof(float);
+    if (idx.count > 0) {
+        if (mmap) {
+            idx.storage = map_vectors(file, header.data_offset, idx.count, idx.dim);
+        }
+        if (!idx.storage.defined()) {
+            idx.storage = torch::empty({idx.count, idx.dim}, torch::kFloat);
+            in.seekg(header.data_offset);
+            in.read(reinterpret_cast<char *>(idx.storage.data_ptr<float>()), data_bytes);
+        }
+    }
+    in.seekg(header.data_offset + data_bytes);
+
+    if (idx.kind == Index::Kind::IVFFlat) {
+        if (header.trained) {
+            idx.centroids = torch::empty({idx.nlist, idx.dim}, torch::kFloat);
+            in.read(reinterpret_cast<char *>(idx.centroids.data_ptr<float>()),
+                    idx.nlist * idx.dim * sizeof(float));
+            idx.lists.resize(idx.nlist);
+            for (auto &list : idx.lists) {
+                list = read_ids(in, idx.count);
+            }
+        }
+    } else {
+        TORCH_CHECK(idx.count == 0 || (idx.entry_point >= 0 && idx.entry_point < idx.count),
+                    "corrupt vector index file");
+        idx.levels.resize(idx.count);
+        idx.links.resize(idx.count);
+        for (int64_t id = 0; id < idx.count; id++) {
+            idx.levels[id] = read_i64(in);
+            TORCH_CHECK(in && idx.levels[id] >= 0 && idx.levels[id] <= idx.max_level,
+                        "corrupt vector index file");
+            idx.links[id].resize(idx.levels[id] + 1);
+            for (auto &links : idx.links[id]) {
+                links = read_ids(in, idx.count);
+            }
+        }
+    }
+
+    TORCH_CHECK(in, "truncated vector index file ", file);
+    return index;
+}
@@ -2,3 +2,4 @@ mod info;
 pub mod jit;
 mod misc;
 mod tensor;
+pub mod tensor_data;
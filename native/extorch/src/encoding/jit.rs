@@ -110,6 +110,157 @@ fn ivalue_node_to_term<'a>(
     }
 }
 
+/// Convert a compactly encoded IValue tree into nested Elixir terms.
+///
+/// Produces the same terms as `ivalue_flat_to_term`. Nodes are walked in
+/// pre-order with one cursor per side array; packed int/float/bool lists
+/// are encoded straight from their backing slices.
+pub fn ivalue_packed_to_term<'a>(env: Env<'a>, packed: &torch::IValuePacked) -> Term<'a> {
+    if packed.tags.is_empty() {
+        return rustler::types::atom::nil().encode(env);
+    }
+    let mut cursor = PackedCursor::default();
+    packed_node_to_term(env, packed, &mut cursor)
+}
+
+/// Read positions into the node stream and each side array of an IValuePacked.
+#[derive(Default)]
+struct PackedCursor {
+    node: usize,
+    float: usize,
+    string: usize,
+    tensor: usize,
+    list_int: usize,
+    list_float: usize,
+}
+
+fn packed_node_to_term<'a>(
+    env: Env<'a>,
+    packed: &torch::IValuePacked,
+    cursor: &mut PackedCursor,
+) -> Term<'a> {
+    let tag = packed.tags[cursor.node];
+    let value = packed.values[cursor.node];
+    cursor.node += 1;
+
+    match tag {
+        // Tensor
+        0 => {
+            let tensor = packed.tensors.values[cursor.tensor].tensor.clone();
+            cursor.tensor += 1;
+            let tensor_struct: TensorStruct<'a> = tensor.into();
+            tensor_struct.encode(env)
+        }
+        // Int
+        1 => value.encode(env),
+        // Float
+        2 => {
+            let v = packed.floats[cursor.float];
+            cursor.float += 1;
+            v.encode(env)
+        }
+        // Bool
+        3 => (value != 0).encode(env),
+        // String
+        4 => {
+            let s: &str = packed.strings[cursor.string].as_str();
+            cursor.string += 1;
+            s.encode(env)
+        }
+        // None
+        5 => rustler::types::atom::nil().encode(env),
+        // Tuple
+        6 => {
+            let children: Vec<Term<'a>> = (0..value)
+                .map(|_| packed_node_to_term(env, packed, cursor))
+                .collect();
+            make_tuple(env, &children)
+        }
+        // List
+        7 => {
+            let children: Vec<Term<'a>> = (0..value)
+                .map(|_| packed_node_to_term(env, packed, cursor))
+                .collect();
+            children.encode(env)
+        }
+        // Dict (value is the number of entries)
+        8 => {
+            let mut keys: Vec<Term<'a>> = Vec::with_capacity(value as usize);
+            let mut vals: Vec<Term<'a>> = Vec::with_capacity(value as usize);
+            for _ in 0..value {
+                keys.push(packed_node_to_term(env, packed, cursor));
+                vals.push(packed_node_to_term(env, packed, cursor));
+            }
+            make_map(env, &keys, &vals)
+        }
+        // Device, encoded like ivalue_flat_to_term's unknown-tag fallback
+        9 => {
+            cursor.string += 1;
+            rustler::types::atom::nil().encode(env)
+        }
+        // Packed int list
+        11 => {
+            let n = value as usize;
+            let slice = &packed.list_ints[cursor.list_int..cursor.list_int + n];
+            cursor.list_int += n;
+            slice.encode(env)
+        }
+        // Packed float list
+        12 => {
+            let n = value as usize;
+            let slice = &packed.list_floats[cursor.list_float..cursor.list_float + n];
+            cursor.list_float += n;
+            slice.encode(env)
+        }
+        // Packed bool list
+        13 => {
+            let n = value as usize;
+            let bools: Vec<bool> = packed.list_ints[cursor.list_int..cursor.list_int + n]
+                .iter()
+                .map(|v| *v != 0)
+                .collect();
+            cursor.list_int += n;
+            bools.encode(env)
+        }
+        // Packed dicts: str (14, 15) or int (16, 17) keys to int (even) or
+        // float (odd) values
+        14..=17 => {
+            let n = value as usize;
+            let keys: Vec<Term<'a>> = if tag < 16 {
+                let keys = &packed.strings[cursor.string..cursor.string + n];
+                cursor.string += n;
+                keys.iter().map(|k| k.as_str().encode(env)).collect()
+            } else {
+                let keys = &packed.list_ints[cursor.list_int..cursor.list_int + n];
+                cursor.list_int += n;
+                keys.iter().map(|k| k.encode(env)).collect()
+            };
+            let vals: Vec<Term<'a>> = if tag % 2 == 1 {
+                let vals = &packed.list_floats[cursor.list_float..cursor.list_float + n];
+                cursor.list_float += n;
+                vals.iter().map(|v| v.encode(env)).collect()
+            } else {
+                let vals = &packed.list_ints[cursor.list_int..cursor.list_int + n];
+                cursor.list_int += n;
+                vals.iter().map(|v| v.encode(env)).collect()
+            };
+            make_map(env, &keys, &vals)
+        }
+        // Unknown - encode as nil
+        _ => rustler::types::atom::nil().encode(env),
+    }
+}
+
+/// Build a map from parallel key and value terms.
+fn make_map<'a>(env: Env<'a>, keys: &[Term<'a>], vals: &[Term<'a>]) -> Term<'a> {
+    // map_from_arrays rejects duplicate keys; fall back to puts.
+    Term::map_from_arrays(env, keys, vals).unwrap_or_else(|_| {
+        keys.iter().zip(vals.iter()).fold(Term::map_new(env), |map, (k, v)| {
+            map.map_put(*k, *v).unwrap_or(map)
+        })
+    })
+}
+
 /// Convert a Vec<NamedTensor> into an Elixir list of {name, tensor} tuples.
 pub fn named_tensors_to_term<'a>(env: Env<'a>, named: &[torch::NamedTensor]) -> Term<'a> {
     let tuples: Vec<Term<'a>> = named
@@ -1,9 +1,15 @@
 use crate::native::torch;
-use crate::shared_types::{AtomString, Reference, Size, TensorStruct};
+use crate::shared_types::{AtomString, Reference, Size, TensorResource, TensorStruct};
 
 use cxx::SharedPtr;
 use rustler::{ResourceArc, Decoder};
 
+mod atoms {
+    rustler::atoms! {
+        resource,
+    }
+}
+
 impl<'a> From<SharedPtr<torch::CrossTensor>> for TensorStruct<'a> {
     fn from(value: SharedPtr<torch::CrossTensor>) -> Self {
         let size = Size {
@@ -27,6 +33,16 @@ impl<'a> From<SharedPtr<torch::CrossTensor>> for TensorStruct<'a> {
     }
 }
 
+impl<'a> Decoder<'a> for TensorResource {
+    fn decode(term: rustler::Term<'a>) -> rustler::NifResult<Self> {
+        let resource: ResourceArc<torch::CrossTensorRef> =
+            term.map_get(atoms::resource())?.decode()?;
+        Ok(Self {
+            tensor: resource.tensor.clone(),
+        })
+    }
+}
+
 impl<'a> Decoder<'a> for torch::TensorOut {
     fn decode(term: rustler::Term<'a>) -> rustler::NifResult<Self> {
         match term.is_atom() {
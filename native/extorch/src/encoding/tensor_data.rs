@@ -0,0 +1,423 @@
+//! Single-pass decoding of nested lists of numbers into typed tensor buffers.
+//!
+//! `layout` finds the shape of the list, and its dtype when it has to be
+//! inferred, without storing any element. The tensor is then allocated in
+//! that dtype and `fill` walks the list once more, converting every element
+//! straight into the tensor's memory. libtorch receives neither one
+//! `torch::Scalar` per element nor a staging buffer to copy from.
+
+use std::mem::MaybeUninit;
+
+use rustler::types::atom::{false_, true_};
+use rustler::types::tuple::get_tuple;
+use rustler::{Atom, Error, ListIterator, NifResult, Term, TermType};
+
+use crate::shared_types::Complex;
+
+mod atoms {
+    rustler::atoms! {
+        nan,
+        inf,
+        ninf,
+    }
+}
+
+/// Largest finite float32 magnitude; larger values are inferred as float64.
+const F32_MAX: f64 = f32::MAX as f64;
+
+fn raise(msg: &str) -> Error {
+    Error::RaiseTerm(Box::new(msg.to_owned()))
+}
+
+fn size_mismatch() -> Error {
+    raise("all lists in a dimension must have the same size")
+}
+
+fn special_float(term: Term) -> NifResult<f64> {
+    let atom = Atom::from_term(term)?;
+    if atom == atoms::nan() {
+        Ok(f64::NAN)
+    } else if atom == atoms::inf() {
+        Ok(f64::INFINITY)
+    } else if atom == atoms::ninf() {
+        Ok(f64::NEG_INFINITY)
+    } else {
+        Err(raise("invalid tensor element"))
+    }
+}
+
+fn complex_part(term: Term) -> NifResult<f64> {
+    match term.get_type() {
+        TermType::Integer => Ok(term.decode::<i64>()? as f64),
+        TermType::Float => term.decode(),
+        _ => special_float(term),
+    }
+}
+
+/// Element kinds seen during the walk, used to infer the tensor dtype with
+/// the same rules as `ExTorch.Utils.Types`.
+#[derive(Default)]
+struct Seen {
+    bool: bool,
+    uint8: bool,
+    int32: bool,
+    int64: bool,
+    float: bool,
+    wide_float: bool,
+    complex: bool,
+    wide_complex: bool,
+}
+
+impl Seen {
+    fn add(&mut self, value: Value) {
+        match value {
+            Value::Bool(_) => self.bool = true,
+            Value::Int(value) => {
+                if (0..=255).contains(&value) {
+                    self.uint8 = true;
+                } else if i32::try_from(value).is_ok() {
+                    self.int32 = true;
+                } else {
+                    self.int64 = true;
+                }
+            }
+            Value::Float(value) => {
+                self.float = true;
+                self.wide_float |= value.abs() > F32_MAX;
+            }
+            Value::Complex(parts) => {
+                self.complex = true;
+                self.wide_complex |= parts
+                    .iter()
+                    .any(|part| part.is_finite() && part.abs() > F32_MAX);
+            }
+        }
+    }
+
+    fn infer(&self, float_dtype: &str) -> &'static str {
+        let double = float_dtype == "float64";
+        if self.complex {
+            if self.wide_complex || double {
+                "complex128"
+            } else {
+                "complex64"
+            }
+        } else if self.float {
+            if self.wide_float || double || self.int32 || self.int64 {
+                "float64"
+            } else {
+                "float32"
+            }
+        } else if self.int64 {
+            "int64"
+        } else if self.int32 {
+            "int32"
+        } else if self.uint8 {
+            "uint8"
+        } else if self.bool {
+            "bool"
+        } else if double {
+            "float64"
+        } else {
+            "float32"
+        }
+    }
+}
+
+/// A decoded list element.
+#[derive(Clone, Copy)]
+enum Value {
+    Bool(bool),
+    Int(i64),
+    Float(f64),
+    Complex([f64; 2]),
+}
+
+fn value(term: Term) -> NifResult<Value> {
+    match term.get_type() {
+        TermType::Integer => term
+            .decode()
+            .map(Value::Int)
+            .map_err(|_| raise("integer out of the int64 range")),
+        TermType::Float => term.decode().map(Value::Float),
+        TermType::Atom => {
+            let atom = Atom::from_term(term)?;
+            if atom == true_() || atom == false_() {
+                Ok(Value::Bool(atom == true_()))
+            } else {
+                special_float(term).map(Value::Float)
+            }
+        }
+        TermType::Map => {
+            let value: Complex = term.decode()?;
+            Ok(Value::Complex([
+                complex_part(value.real)?,
+                complex_part(value.imaginary)?,
+            ]))
+        }
+        _ => Err(raise("invalid tensor element")),
+    }
+}
+
+fn complex_into_real() -> Error {
+    raise("complex values require a complex dtype")
+}
+
+/// Element type of a tensor buffer, converted from each decoded value.
+trait Element: Sized {
+    fn convert(value: Value) -> NifResult<Self>;
+}
+
+macro_rules! real_element {
+    ($($t:ty),*) => {
+        $(impl Element for $t {
+            fn convert(value: Value) -> NifResult<Self> {
+                match value {
+                    Value::Bool(value) => Ok(value as u8 as $t),
+                    Value::Int(value) => Ok(value as $t),
+                    Value::Float(value) => Ok(value as $t),
+                    Value::Complex(_) => Err(complex_into_real()),
+                }
+            }
+        })*
+    };
+}
+
+real_element!(u8, i8, i16, i32, i64, f32, f64);
+
+macro_rules! complex_element {
+    ($($t:ty),*) => {
+        $(impl Element for [$t; 2] {
+            fn convert(value: Value) -> NifResult<Self> {
+                match value {
+                    Value::Bool(value) => Ok([value as u8 as $t, 0.0]),
+                    Value::Int(value) => Ok([value as $t, 0.0]),
+                    Value::Float(value) => Ok([value as $t, 0.0]),
+                    Value::Complex([re, im]) => Ok([re as $t, im as $t]),
+                }
+            }
+        })*
+    };
+}
+
+complex_element!(f32, f64);
+
+/// A libtorch bool: one byte holding 0 or 1, whatever the value's type.
+#[repr(transparent)]
+struct Truth(#[allow(dead_code)] u8);
+
+impl Element for Truth {
+    fn convert(value: Value) -> NifResult<Self> {
+        match value {
+            Value::Bool(value) => Ok(Truth(value as u8)),
+            Value::Int(value) => Ok(Truth((value != 0) as u8)),
+            Value::Float(value) => Ok(Truth((value != 0.0) as u8)),
+            Value::Complex(_) => Err(complex_into_real()),
+        }
+    }
+}
+
+/// Walks a nested list (or tuple), checking that it is rectangular and
+/// handing every element to `leaf` in row-major order.
+#[derive(Default)]
+struct Walker {
+    shape: Vec<i64>,
+    leaf_depth: Option<usize>,
+}
+
+impl Walker {
+    /// A walker that checks the list against a known shape.
+    fn with_shape(shape: &[i64]) -> Self {
+        Walker {
+            shape: shape.to_vec(),
+            leaf_depth: Some(shape.len()),
+        }
+    }
+
+    fn walk(
+        &mut self,
+        term: Term,
+        depth: usize,
+        leaf: &mut impl FnMut(Term) -> NifResult<()>,
+    ) -> NifResult<()> {
+        match term.get_type() {
+            TermType::List => {
+                self.enter(depth, term.list_length()?)?;
+                let items: ListIterator = term.decode()?;
+                for item in items {
+                    self.walk(item, depth + 1, leaf)?;
+                }
+                Ok(())
+            }
+            TermType::Tuple => {
+                let items = get_tuple(term)?;
+                self.enter(depth, items.len())?;
+                for item in items {
+                    self.walk(item, depth + 1, leaf)?;
+                }
+                Ok(())
+            }
+            _ => {
+                self.leaf(depth)?;
+                leaf(term)
+            }
+        }
+    }
+
+    /// Record (or check) the size of dimension `depth`.
+    fn enter(&mut self, depth: usize, len: usize) -> NifResult<()> {
+        let len = len as i64;
+        if depth < self.shape.len() {
+            if self.shape[depth] != len {
+                return Err(size_mismatch());
+            }
+        } else if self.leaf_depth.is_none() {
+            self.shape.push(len);
+        } else {
+            return Err(size_mismatch());
+        }
+        Ok(())
+    }
+
+    /// The first element fixes the number of dimensions.
+    fn leaf(&mut self, depth: usize) -> NifResult<()> {
+        match self.leaf_depth {
+            Some(leaf_depth) if leaf_depth == depth => Ok(()),
+            None if depth == self.shape.len() => {
+                self.leaf_depth = Some(depth);
+                Ok(())
+            }
+            _ => Err(size_mismatch()),
+        }
+    }
+}
+
+/// Sizes along the first element of every dimension. `fill` checks that
+/// the rest of the list agrees.
+fn probe_shape(mut term: Term) -> NifResult<Vec<i64>> {
+    let mut shape = Vec::new();
+    loop {
+        let first = match term.get_type() {
+            TermType::List => {
+                shape.push(term.list_length()? as i64);
+                let mut items: ListIterator = term.decode()?;
+                items.next()
+            }
+            TermType::Tuple => {
+                let items = get_tuple(term)?;
+                shape.push(items.len() as i64);
+                items.first().copied()
+            }
+            _ => return Ok(shape),
+        };
+        match first {
+            Some(item) => term = item,
+            None => return Ok(shape),
+        }
+    }
+}
+
+/// Shape and dtype of the tensor a nested list decodes to.
+pub struct TensorLayout {
+    /// Sizes of the nested list; empty for a scalar.
+    dims: Vec<i64>,
+    /// Shape of the tensor to create. Scalars become one-element vectors.
+    pub shape: Vec<i64>,
+    /// dtype of the tensor to create.
+    pub dtype: String,
+    /// dtype of the elements written by `fill`. Half precision dtypes are
+    /// written in single precision and converted by libtorch.
+    pub buffer_dtype: &'static str,
+}
+
+impl TensorLayout {
+    pub fn numel(&self) -> usize {
+        self.shape.iter().product::<i64>() as usize
+    }
+}
+
+/// Find the layout of a number, boolean, `ExTorch.Complex` or a nested
+/// list (or tuple) of them for a tensor of `dtype`. An `auto` dtype is
+/// inferred from the elements, which takes a walk over the whole list; a
+/// `nil` one is `float_dtype`, the default floating point type. Otherwise
+/// only the first element of each dimension is looked at.
+pub fn layout(data: Term, dtype: &str, float_dtype: &str) -> NifResult<TensorLayout> {
+    let (dims, dtype) = match dtype {
+        "auto" => {
+            let mut walker = Walker::default();
+            let mut seen = Seen::default();
+            walker.walk(data, 0, &mut |term| {
+                seen.add(value(term)?);
+                Ok(())
+            })?;
+            (walker.shape, seen.infer(float_dtype).to_owned())
+        }
+        "nil" => (probe_shape(data)?, float_dtype.to_owned()),
+        _ => (probe_shape(data)?, dtype.to_owned()),
+    };
+
+    let buffer_dtype = match dtype.as_str() {
+        "bool" => "bool",
+        "uint8" | "byte" => "uint8",
+        "int8" | "char" => "int8",
+        "int16" | "short" => "int16",
+        "int32" | "int" => "int32",
+        "int64" | "long" => "int64",
+        "float32" | "float" | "float16" | "half" | "bfloat16" => "float32",
+        "float64" | "double" => "float64",
+        "complex64" | "complex_float" | "complex32" | "complex_half" => "complex64",
+        "complex128" | "complex_double" => "complex128",
+        _ => return Err(raise("unsupported tensor dtype")),
+    };
+
+    let shape = if dims.is_empty() {
+        vec![1]
+    } else {
+        dims.clone()
+    };
+    Ok(TensorLayout {
+        dims,
+        shape,
+        dtype,
+        buffer_dtype,
+    })
+}
+
+unsafe fn fill_as<T: Element>(data: Term, layout: &TensorLayout, buffer: *mut u8) -> NifResult<()> {
+    let numel = layout.numel();
+    if numel == 0 {
+        return Walker::with_shape(&layout.dims).walk(data, 0, &mut |_| Ok(()));
+    }
+    // SAFETY: the caller hands over a buffer of `numel` elements of `T`,
+    // aligned by the allocator; it is only written to.
+    let elements = unsafe { std::slice::from_raw_parts_mut(buffer as *mut MaybeUninit<T>, numel) };
+    let mut index = 0;
+    Walker::with_shape(&layout.dims).walk(data, 0, &mut |term| {
+        let element = elements.get_mut(index).ok_or_else(size_mismatch)?;
+        element.write(T::convert(value(term)?)?);
+        index += 1;
+        Ok(())
+    })
+}
+
+/// Walk `data` once, converting each element to `layout.buffer_dtype` and
+/// writing it to `buffer` in row-major order.
+///
+/// # Safety
+/// `buffer` must point to `layout.numel()` writable, suitably aligned
+/// elements of `layout.buffer_dtype`.
+pub unsafe fn fill(data: Term, layout: &TensorLayout, buffer: *mut u8) -> NifResult<()> {
+    match layout.buffer_dtype {
+        "bool" => fill_as::<Truth>(data, layout, buffer),
+        "uint8" => fill_as::<u8>(data, layout, buffer),
+        "int8" => fill_as::<i8>(data, layout, buffer),
+        "int16" => fill_as::<i16>(data, layout, buffer),
+        "int32" => fill_as::<i32>(data, layout, buffer),
+        "int64" => fill_as::<i64>(data, layout, buffer),
+        "float32" => fill_as::<f32>(data, layout, buffer),
+        "float64" => fill_as::<f64>(data, layout, buffer),
+        "complex64" => fill_as::<[f32; 2]>(data, layout, buffer),
+        "complex128" => fill_as::<[f64; 2]>(data, layout, buffer),
+        _ => Err(raise("unsupported tensor dtype")),
+    }
+}
@@ -30,15 +30,25 @@ use rustler::{Env, Term};
 impl rustler::Resource for torch::CrossTensorRef {}
 impl rustler::Resource for torch::CrossModuleRef {}
 impl rustler::Resource for torch::CrossNNModuleRef {}
+impl rustler::Resource for torch::CrossNNPipelineRef {}
 impl rustler::Resource for torch::CrossAOTILoaderRef {}
 impl rustler::Resource for torch::CrossCompiledGraphRef {}
+impl rustler::Resource for torch::CrossGraphSessionRef {}
+impl rustler::Resource for torch::CrossEncodedGraphRef {}
+impl rustler::Resource for torch::CrossVectorIndexRef {}
+impl rustler::Resource for torch::CrossKVCacheRef {}
 
 fn load(env: Env, _: Term) -> bool {
     env.register::<torch::CrossTensorRef>().is_ok()
         && env.register::<torch::CrossModuleRef>().is_ok()
         && env.register::<torch::CrossNNModuleRef>().is_ok()
+        && env.register::<torch::CrossNNPipelineRef>().is_ok()
         && env.register::<torch::CrossAOTILoaderRef>().is_ok()
         && env.register::<torch::CrossCompiledGraphRef>().is_ok()
+        && env.register::<torch::CrossGraphSessionRef>().is_ok()
+        && env.register::<torch::CrossEncodedGraphRef>().is_ok()
+        && env.register::<torch::CrossVectorIndexRef>().is_ok()
+        && env.register::<torch::CrossKVCacheRef>().is_ok()
 }
 
 rustler::init!("Elixir.ExTorch.Native", load = load);
@@ -10,3 +10,10 @@ mod comparison;
 mod tensor_ops;
 mod reduction;
 pub mod dispatcher;
+mod pinned_pool;
+mod fused_pointwise;
+mod top_k;
+mod vector_index;
+mod kv_cache;
+mod tracing;
+mod memory_stats;
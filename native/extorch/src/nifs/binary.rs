@@ -15,3 +15,17 @@ pub fn from_binary<'a>(data: Binary<'a>, shape: Size, dtype: AtomString) -> NifR
         }
     }
 }
+
+/// Create a tensor by reading `shape`/`dtype` worth of raw bytes from `path`
+/// at `offset`, without staging them in an Erlang binary.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn from_file<'a>(path: String, offset: i64, shape: Size, dtype: AtomString) -> NifResult<TensorStruct<'a>> {
+    let result = torch::from_file(path, offset, shape.size, dtype.name);
+    match result {
+        Ok(tensor) => Ok(tensor.into()),
+        Err(err) => {
+            let msg = err.what().to_owned();
+            Err(Error::RaiseTerm(Box::new(msg)))
+        }
+    }
+}
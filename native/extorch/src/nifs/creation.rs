@@ -1,9 +1,16 @@
 use crate::native::torch;
-use crate::shared_types::{Size, TensorOptions, TensorStruct};
-use crate::torch::{Scalar, ScalarList};
+use crate::encoding::tensor_data;
+use crate::shared_types::{Size, TensorData, TensorOptions, TensorStruct};
+use crate::torch::Scalar;
 
 use rustler::{Error, NifResult};
 
+fn cxx_err_to_nif(err: cxx::Exception) -> Error {
+    let err_msg = err.what().to_owned();
+    let err_parts: Vec<&str> = err_msg.split('\n').collect();
+    Error::RaiseTerm(Box::new(err_parts[0].to_owned()))
+}
+
 // trace_macros!(true);
 nif_impl!(empty, TensorStruct<'a>, size: Size, options: TensorOptions);
 nif_impl!(zeros, TensorStruct<'a>, size: Size, options: TensorOptions);
@@ -60,12 +67,33 @@ nif_impl!(
     options: TensorOptions
 );
 
-nif_impl!(
-    tensor,
-    TensorStruct<'a>,
-    list: ScalarList,
-    options: TensorOptions
-);
+/// Create a tensor from nested lists of numbers, decoded in a single pass
+/// straight into a tensor of the target dtype.
+#[rustler::nif]
+pub fn tensor<'a>(list: TensorData<'a>, options: TensorOptions) -> NifResult<TensorStruct<'a>> {
+    let layout = tensor_data::layout(list.data, &options.dtype.name, &list.float_dtype.name)?;
+    let buffer = torch::tensor_buffer(
+        layout.shape.clone(),
+        layout.buffer_dtype.to_owned(),
+        options.pin_memory,
+    )
+    .map_err(cxx_err_to_nif)?;
+    // SAFETY: `buffer` holds `layout.numel()` contiguous elements of
+    // `layout.buffer_dtype`, and nothing else refers to it yet.
+    unsafe { tensor_data::fill(list.data, &layout, torch::tensor_buffer_data(&buffer))? };
+
+    torch::tensor_from_buffer(
+        &buffer,
+        layout.dtype,
+        options.layout.name,
+        options.device,
+        options.requires_grad,
+        options.pin_memory,
+        options.memory_format.name,
+    )
+    .map(|tensor| tensor.into())
+    .map_err(cxx_err_to_nif)
+}
 
 nif_impl!(
     complex,
@@ -1,9 +1,12 @@
 use crate::encoding::jit::ivalue_flat_to_term;
 use crate::native::torch;
-use crate::shared_types::{TensorStruct, CompiledGraphStruct, Reference};
+use crate::shared_types::{
+    TensorResource, TensorStruct, CompiledGraphStruct, EncodedGraphStruct, GraphSessionStruct,
+    Reference,
+};
 
 use cxx::SharedPtr;
-use rustler::{Atom, Env, Error, NifResult, Term};
+use rustler::{Atom, Binary, Encoder, Env, Error, NifResult, OwnedBinary, Term};
 
 mod atoms {
     rustler::atoms! {
@@ -189,11 +192,59 @@ pub fn compile_graph<'a>(
     })
 }
 
+/// Compile a graph from packed bytecode built by `ExTorch.Export.Bytecode`.
+/// The binary is parsed in place, without decoding a term per instruction.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn compile_graph_bytecode<'a>(
+    code: Binary<'a>,
+    value_names: Vec<String>,
+    output_names: Vec<String>,
+) -> NifResult<CompiledGraphStruct<'a>> {
+    let compiled = torch::compile_graph_bytecode(code.as_slice(), value_names, output_names)
+        .map_err(cxx_err_to_nif)?;
+
+    let wrapped = torch::CrossCompiledGraphRef { graph: compiled };
+    let resource = rustler::ResourceArc::new(wrapped);
+    Ok(CompiledGraphStruct {
+        resource,
+        reference: Reference::new(),
+    })
+}
+
+/// Bind named inputs of a compiled graph (parameters, buffers) as constants
+/// held by the graph. Returns a new compiled graph that only takes the
+/// remaining inputs.
+#[rustler::nif]
+pub fn bind_graph_constants<'a>(
+    compiled: CompiledGraphStruct<'a>,
+    names: Vec<String>,
+    tensors: Vec<TensorResource>,
+) -> NifResult<CompiledGraphStruct<'a>> {
+    let tensor_list = make_tensor_list(&tensors);
+    let bound = torch::bind_graph_constants(&compiled.resource.graph, names, tensor_list)
+        .map_err(cxx_err_to_nif)?;
+
+    let wrapped = torch::CrossCompiledGraphRef { graph: bound };
+    let resource = rustler::ResourceArc::new(wrapped);
+    Ok(CompiledGraphStruct {
+        resource,
+        reference: Reference::new(),
+    })
+}
+
+/// Names of the inputs a compiled graph still expects, in call order.
+#[rustler::nif]
+pub fn compiled_graph_inputs<'a>(compiled: CompiledGraphStruct<'a>) -> NifResult<Vec<String>> {
+    let names = torch::compiled_graph_inputs(&compiled.resource.graph)
+        .map_err(cxx_err_to_nif)?;
+    Ok(names.into_iter().map(|s| s.to_string()).collect())
+}
+
 /// Run a pre-compiled graph. Tensors in, tensors out — no encoding overhead.
 #[rustler::nif(schedule = "DirtyCpu")]
 pub fn run_compiled_graph<'a>(
     compiled: CompiledGraphStruct<'a>,
-    tensors: Vec<TensorStruct<'a>>,
+    tensors: Vec<TensorResource>,
 ) -> NifResult<Vec<TensorStruct<'a>>> {
     let tensor_list = make_tensor_list(&tensors);
     let result = torch::run_compiled_graph(&compiled.resource.graph, tensor_list)
@@ -205,6 +256,186 @@ pub fn run_compiled_graph<'a>(
         .collect())
 }
 
+/// Create a session that feeds outputs `state_outputs` of a compiled graph
+/// back as its inputs `state_inputs` on the next step, starting from
+/// `initial`.
+#[rustler::nif]
+pub fn create_graph_session<'a>(
+    compiled: CompiledGraphStruct<'a>,
+    state_inputs: Vec<String>,
+    state_outputs: Vec<u64>,
+    initial: Vec<TensorResource>,
+) -> NifResult<GraphSessionStruct<'a>> {
+    let session = torch::create_graph_session(
+        &compiled.resource.graph,
+        state_inputs.clone(),
+        state_outputs,
+        make_tensor_list(&initial),
+    )
+    .map_err(cxx_err_to_nif)?;
+
+    Ok(GraphSessionStruct {
+        resource: rustler::ResourceArc::new(torch::CrossGraphSessionRef { session }),
+        reference: Reference::new(),
+        state_inputs,
+    })
+}
+
+/// Run one step of a graph session: only the inputs and outputs that are
+/// not carried as state cross the NIF boundary.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn graph_session_step<'a>(
+    session: GraphSessionStruct<'a>,
+    tensors: Vec<TensorResource>,
+) -> NifResult<Vec<TensorStruct<'a>>> {
+    let result = torch::graph_session_step(&session.resource.session, make_tensor_list(&tensors))
+        .map_err(cxx_err_to_nif)?;
+
+    Ok(result.values.into_iter()
+        .filter(|t| t.used)
+        .map(|t| t.tensor.into())
+        .collect())
+}
+
+/// Restore the initial state of a graph session.
+#[rustler::nif]
+pub fn graph_session_reset<'a>(session: GraphSessionStruct<'a>) -> NifResult<Atom> {
+    torch::graph_session_reset(&session.resource.session).map_err(cxx_err_to_nif)?;
+    Ok(rustler::types::atom::ok())
+}
+
+/// Current state tensors of a graph session.
+#[rustler::nif]
+pub fn graph_session_state<'a>(session: GraphSessionStruct<'a>) -> NifResult<Vec<TensorStruct<'a>>> {
+    let result = torch::graph_session_state(&session.resource.session).map_err(cxx_err_to_nif)?;
+
+    Ok(result.values.into_iter()
+        .filter(|t| t.used)
+        .map(|t| t.tensor.into())
+        .collect())
+}
+
+/// Start recording per-op samples of a compiled graph's runs into a ring
+/// of `capacity` samples.
+#[rustler::nif]
+pub fn compiled_graph_profile_start<'a>(
+    compiled: CompiledGraphStruct<'a>,
+    capacity: u64,
+) -> NifResult<Atom> {
+    torch::compiled_graph_profile_start(&compiled.resource.graph, capacity)
+        .map_err(cxx_err_to_nif)?;
+    Ok(rustler::types::atom::ok())
+}
+
+/// Stop recording per-op samples of a compiled graph's runs.
+#[rustler::nif]
+pub fn compiled_graph_profile_stop<'a>(compiled: CompiledGraphStruct<'a>) -> NifResult<Atom> {
+    torch::compiled_graph_profile_stop(&compiled.resource.graph).map_err(cxx_err_to_nif)?;
+    Ok(rustler::types::atom::ok())
+}
+
+fn op_profile_stats_to_term<'a>(env: Env<'a>, stats: &torch::OpProfileStats) -> Term<'a> {
+    let keys = [
+        "name", "target", "count", "total_ns", "min_ns", "p50_ns", "p99_ns", "max_ns",
+        "output_bytes", "allocated_bytes", "freed_bytes",
+    ]
+    .map(|key| Atom::from_str(env, key).unwrap().encode(env));
+    let values = [
+        stats.name.as_str().encode(env),
+        stats.target.as_str().encode(env),
+        stats.count.encode(env),
+        stats.total_ns.encode(env),
+        stats.min_ns.encode(env),
+        stats.p50_ns.encode(env),
+        stats.p99_ns.encode(env),
+        stats.max_ns.encode(env),
+        stats.output_bytes.encode(env),
+        stats.allocated_bytes.encode(env),
+        stats.freed_bytes.encode(env),
+    ];
+    Term::map_from_arrays(env, &keys, &values).unwrap()
+}
+
+/// Aggregate the samples of a compiled graph's last profiling session.
+/// Returns a map with the `runs`, `samples` and `dropped` counts and the
+/// `nodes` and `targets` lists of per-node and per-op-target stats maps.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn compiled_graph_profile_stats<'a>(
+    env: Env<'a>,
+    compiled: CompiledGraphStruct<'a>,
+) -> NifResult<Term<'a>> {
+    let stats = torch::compiled_graph_profile_stats(&compiled.resource.graph)
+        .map_err(cxx_err_to_nif)?;
+
+    let nodes: Vec<Term<'a>> = stats.nodes.iter().map(|s| op_profile_stats_to_term(env, s)).collect();
+    let targets: Vec<Term<'a>> =
+        stats.targets.iter().map(|s| op_profile_stats_to_term(env, s)).collect();
+    let keys = ["runs", "samples", "dropped", "nodes", "targets"]
+        .map(|key| Atom::from_str(env, key).unwrap().encode(env));
+    let values = [
+        stats.runs.encode(env),
+        stats.samples.encode(env),
+        stats.dropped.encode(env),
+        nodes.encode(env),
+        targets.encode(env),
+    ];
+    Ok(Term::map_from_arrays(env, &keys, &values).unwrap())
+}
+
+/// Serialize a compiled graph into a binary for the on-disk compile cache.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn serialize_compiled_graph<'a>(
+    env: Env<'a>,
+    compiled: CompiledGraphStruct<'a>,
+    source_tag: u64,
+) -> NifResult<Binary<'a>> {
+    let data = torch::serialize_compiled_graph(&compiled.resource.graph, source_tag)
+        .map_err(cxx_err_to_nif)?;
+
+    let mut binary = OwnedBinary::new(data.len()).ok_or_else(|| {
+        Error::RaiseTerm(Box::new("failed to allocate compiled graph binary".to_owned()))
+    })?;
+    binary.as_mut_slice().copy_from_slice(&data);
+    Ok(binary.release(env))
+}
+
+/// Rebuild a compiled graph from `serialize_compiled_graph` output.
+/// Only the op schemas are resolved again.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn deserialize_compiled_graph<'a>(
+    data: Binary<'a>,
+    source_tag: u64,
+) -> NifResult<CompiledGraphStruct<'a>> {
+    let compiled = torch::deserialize_compiled_graph(data.as_slice(), source_tag)
+        .map_err(cxx_err_to_nif)?;
+
+    let wrapped = torch::CrossCompiledGraphRef { graph: compiled };
+    let resource = rustler::ResourceArc::new(wrapped);
+    Ok(CompiledGraphStruct {
+        resource,
+        reference: Reference::new(),
+    })
+}
+
+/// Version of the libtorch build the NIF is linked against.
+#[rustler::nif]
+pub fn libtorch_version() -> NifResult<String> {
+    torch::libtorch_version().map_err(cxx_err_to_nif)
+}
+
+/// Write a compiled graph, its bound constants and `inputs` to `path`, to
+/// be replayed by the native `graph_executor` benchmark.
+#[rustler::nif(schedule = "DirtyIo")]
+pub fn dump_compiled_graph<'a>(
+    compiled: CompiledGraphStruct<'a>,
+    inputs: Vec<TensorResource>,
+    path: String,
+) -> NifResult<Atom> {
+    torch::dump_compiled_graph(&compiled.resource.graph, make_tensor_list(&inputs), path)
+        .map_err(cxx_err_to_nif)?;
+    Ok(rustler::types::atom::ok())
+}
+
 /// Execute an entire computation graph in a single NIF call.
 ///
 /// Eliminates per-node NIF boundary crossings by running the full graph
@@ -220,7 +451,7 @@ pub fn execute_graph<'a>(
     env: Env<'a>,
     graph: Vec<Term<'a>>,
     initial_names: Vec<String>,
-    initial_tensors: Vec<TensorStruct<'a>>,
+    initial_tensors: Vec<TensorResource>,
     output_names: Vec<String>,
 ) -> NifResult<Term<'a>> {
     // Build the instruction stream
@@ -242,12 +473,69 @@ pub fn execute_graph<'a>(
     Ok(ivalue_flat_to_term(env, &result))
 }
 
-/// Build a TensorList from a slice of TensorStructs.
-fn make_tensor_list(inputs: &[TensorStruct]) -> torch::TensorList {
+/// Decode a graph instruction stream once so it can be executed repeatedly
+/// without re-sending, re-decoding or re-resolving the instructions.
+#[rustler::nif]
+pub fn encode_graph<'a>(
+    env: Env<'a>,
+    graph: Vec<Term<'a>>,
+    input_names: Vec<String>,
+    output_names: Vec<String>,
+) -> NifResult<EncodedGraphStruct<'a>> {
+    let mut instructions: Vec<torch::IValueNode> = Vec::new();
+    for term in &graph {
+        decode_graph_instruction(env, *term, &mut instructions)?;
+    }
+
+    let encoded = torch::encode_graph(instructions, input_names, output_names)
+        .map_err(cxx_err_to_nif)?;
+
+    let wrapped = torch::CrossEncodedGraphRef { graph: encoded };
+    let resource = rustler::ResourceArc::new(wrapped);
+    Ok(EncodedGraphStruct {
+        resource,
+        reference: Reference::new(),
+    })
+}
+
+/// Encode a graph from packed bytecode built by `ExTorch.Export.Bytecode`.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn encode_graph_bytecode<'a>(
+    code: Binary<'a>,
+    input_names: Vec<String>,
+    output_names: Vec<String>,
+) -> NifResult<EncodedGraphStruct<'a>> {
+    let encoded = torch::encode_graph_bytecode(code.as_slice(), input_names, output_names)
+        .map_err(cxx_err_to_nif)?;
+
+    let wrapped = torch::CrossEncodedGraphRef { graph: encoded };
+    let resource = rustler::ResourceArc::new(wrapped);
+    Ok(EncodedGraphStruct {
+        resource,
+        reference: Reference::new(),
+    })
+}
+
+/// Run an encoded graph. Only the input tensors cross the NIF boundary.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn run_encoded_graph<'a>(
+    env: Env<'a>,
+    encoded: EncodedGraphStruct<'a>,
+    tensors: Vec<TensorResource>,
+) -> NifResult<Term<'a>> {
+    let tensor_list = make_tensor_list(&tensors);
+    let result = torch::run_encoded_graph(&encoded.resource.graph, tensor_list)
+        .map_err(cxx_err_to_nif)?;
+
+    Ok(ivalue_flat_to_term(env, &result))
+}
+
+/// Build a TensorList from a slice of decoded tensor resources.
+fn make_tensor_list(inputs: &[TensorResource]) -> torch::TensorList {
     let values: Vec<torch::TensorOut> = inputs
         .iter()
         .map(|t| torch::TensorOut {
-            tensor: t.resource.tensor.clone(),
+            tensor: t.tensor.clone(),
             used: true,
         })
         .collect();
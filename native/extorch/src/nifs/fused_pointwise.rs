@@ -0,0 +1,23 @@
+use crate::native::torch;
+use crate::shared_types::TensorStruct;
+use crate::torch::TensorList;
+
+use rustler::{Error, NifResult};
+
+/// Evaluate a lazily built pointwise expression in a single call.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn fused_pointwise<'a>(
+    inputs: TensorList,
+    consts: Vec<f64>,
+    program: Vec<i64>,
+) -> NifResult<TensorStruct<'a>> {
+    let result = torch::fused_pointwise(inputs, consts, program);
+    match result {
+        Ok(tensor) => Ok(tensor.into()),
+        Err(err) => {
+            let msg = err.what().to_owned();
+            let parts: Vec<&str> = msg.split('\n').collect();
+            Err(Error::RaiseTerm(Box::new(parts[0].to_owned())))
+        }
+    }
+}
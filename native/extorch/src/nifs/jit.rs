@@ -1,9 +1,16 @@
-use crate::encoding::jit::{ivalue_flat_to_term, named_tensors_to_term};
+use crate::encoding::jit::{ivalue_packed_to_term, named_tensors_to_term};
 use crate::native::torch;
-use crate::shared_types::{JitModuleStruct, Reference, TensorStruct};
+use crate::shared_types::{AtomString, JitModuleStruct, Reference, TensorStruct};
 
 use rustler::{Atom, Encoder, Env, Error, NifResult, ResourceArc, Term};
 
+mod atoms {
+    rustler::atoms! {
+        static_behavior = "static",
+        dynamic_behavior = "dynamic",
+    }
+}
+
 /// Build a TensorList from a slice of TensorStructs.
 fn make_tensor_list(inputs: &[TensorStruct]) -> torch::TensorList {
     let values: Vec<torch::TensorOut> = inputs
@@ -62,8 +69,8 @@ pub fn jit_forward<'a>(
     inputs: Vec<TensorStruct<'a>>,
 ) -> NifResult<Term<'a>> {
     let input_list = make_tensor_list(&inputs);
-    let flat = torch::jit_forward(&model.resource.module, input_list).map_err(cxx_err_to_nif)?;
-    Ok(ivalue_flat_to_term(env, &flat))
+    let packed = torch::jit_forward(&model.resource.module, input_list).map_err(cxx_err_to_nif)?;
+    Ok(ivalue_packed_to_term(env, &packed))
 }
 
 /// Invoke a named method on a JIT model.
@@ -75,9 +82,9 @@ pub fn jit_invoke_method<'a>(
     inputs: Vec<TensorStruct<'a>>,
 ) -> NifResult<Term<'a>> {
     let input_list = make_tensor_list(&inputs);
-    let flat = torch::jit_invoke_method(&model.resource.module, method_name, input_list)
+    let packed = torch::jit_invoke_method(&model.resource.module, method_name, input_list)
         .map_err(cxx_err_to_nif)?;
-    Ok(ivalue_flat_to_term(env, &flat))
+    Ok(ivalue_packed_to_term(env, &packed))
 }
 
 /// Get names of all methods on a JIT model.
@@ -140,6 +147,143 @@ pub fn jit_to_device<'a>(
     })
 }
 
+/// Move/cast all parameters and buffers of a JIT model in place, without
+/// cloning the module. Returns the model struct with its device updated.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn jit_to_inplace<'a>(
+    model: JitModuleStruct<'a>,
+    device: torch::Device,
+    dtype: Option<AtomString>,
+    non_blocking: bool,
+) -> NifResult<JitModuleStruct<'a>> {
+    let elixir_device = clone_device(&device);
+    let dtype_name = dtype.map(|d| d.name).unwrap_or_default();
+    torch::jit_to_inplace(&model.resource.module, device, dtype_name, non_blocking)
+        .map_err(cxx_err_to_nif)?;
+    Ok(JitModuleStruct {
+        resource: model.resource,
+        reference: model.reference,
+        device: elixir_device,
+    })
+}
+
+/// Get the qualified names of all parameters and buffers of a JIT model.
+#[rustler::nif]
+pub fn jit_state_names(model: JitModuleStruct) -> NifResult<Vec<String>> {
+    let names = torch::jit_state_names(&model.resource.module).map_err(cxx_err_to_nif)?;
+    Ok(names.into_iter().map(|s| s.to_string()).collect())
+}
+
+/// Move/cast a single parameter or buffer of a JIT model in place.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn jit_state_to(
+    model: JitModuleStruct,
+    name: String,
+    device: torch::Device,
+    dtype: Option<AtomString>,
+    non_blocking: bool,
+) -> NifResult<()> {
+    let dtype_name = dtype.map(|d| d.name).unwrap_or_default();
+    torch::jit_state_to(&model.resource.module, name, device, dtype_name, non_blocking)
+        .map_err(cxx_err_to_nif)
+}
+
+// ============================================================================
+// Inference optimization
+// ============================================================================
+
+/// Freeze a JIT model for inference (and optionally run
+/// `optimize_for_inference`). Returns a new model; the input is unchanged.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn jit_freeze<'a>(model: JitModuleStruct<'a>, optimize: bool) -> NifResult<JitModuleStruct<'a>> {
+    let elixir_device = clone_device(&model.device);
+    let module = torch::jit_freeze(&model.resource.module, optimize).map_err(cxx_err_to_nif)?;
+    let wrapped = torch::CrossModuleRef { module };
+    let resource = ResourceArc::new(wrapped);
+    Ok(JitModuleStruct {
+        resource,
+        reference: Reference::new(),
+        device: elixir_device,
+    })
+}
+
+/// Get the graph executor settings.
+/// Returns a map: %{profiling_executor, num_profiled_runs, fusion_strategy,
+/// cpu_fusion, texpr_fuser}, with `fusion_strategy` a list of
+/// `{:static | :dynamic, depth}` tuples.
+#[rustler::nif]
+pub fn jit_get_executor_options<'a>(env: Env<'a>) -> NifResult<Term<'a>> {
+    let options = torch::jit_get_executor_options().map_err(cxx_err_to_nif)?;
+
+    let strategy: Vec<(Atom, i64)> = options
+        .fusion_behaviors
+        .iter()
+        .zip(options.fusion_depths.iter())
+        .map(|(behavior, depth)| {
+            let atom = if *behavior == 0 {
+                atoms::static_behavior()
+            } else {
+                atoms::dynamic_behavior()
+            };
+            (atom, *depth)
+        })
+        .collect();
+
+    let keys = vec![
+        Atom::from_str(env, "profiling_executor").unwrap().encode(env),
+        Atom::from_str(env, "num_profiled_runs").unwrap().encode(env),
+        Atom::from_str(env, "fusion_strategy").unwrap().encode(env),
+        Atom::from_str(env, "cpu_fusion").unwrap().encode(env),
+        Atom::from_str(env, "texpr_fuser").unwrap().encode(env),
+    ];
+    let values = vec![
+        options.profiling_executor.encode(env),
+        options.num_profiled_runs.encode(env),
+        strategy.encode(env),
+        options.cpu_fusion.encode(env),
+        options.texpr_fuser.encode(env),
+    ];
+
+    Ok(Term::map_from_arrays(env, &keys, &values).unwrap())
+}
+
+/// Set the graph executor settings. `fusion_strategy` is a list of
+/// `{:static | :dynamic, depth}` tuples.
+#[rustler::nif]
+pub fn jit_set_executor_options(
+    profiling_executor: bool,
+    num_profiled_runs: i64,
+    fusion_strategy: Vec<(Atom, i64)>,
+    cpu_fusion: bool,
+    texpr_fuser: bool,
+) -> NifResult<()> {
+    let mut fusion_behaviors = Vec::with_capacity(fusion_strategy.len());
+    let mut fusion_depths = Vec::with_capacity(fusion_strategy.len());
+    for (behavior, depth) in fusion_strategy {
+        let kind = if behavior == atoms::static_behavior() {
+            0
+        } else if behavior == atoms::dynamic_behavior() {
+            1
+        } else {
+            return Err(Error::RaiseTerm(Box::new(
+                "fusion behavior must be :static or :dynamic".to_owned(),
+            )));
+        };
+        fusion_behaviors.push(kind);
+        fusion_depths.push(depth);
+    }
+
+    let options = torch::JitExecutorOptions {
+        profiling_executor,
+        num_profiled_runs,
+        fusion_behaviors,
+        fusion_depths,
+        cpu_fusion,
+        texpr_fuser,
+    };
+    torch::jit_set_executor_options(options).map_err(cxx_err_to_nif)
+}
+
 // ============================================================================
 // IR Introspection
 // ============================================================================
@@ -0,0 +1,151 @@
+use crate::native::torch;
+use crate::shared_types::{KVCacheStruct, Reference, TensorStruct};
+
+use rustler::{Atom, Encoder, Env, Error, NifResult, ResourceArc, Term};
+
+/// Helper to convert a cxx error into a NifResult error.
+fn cxx_err_to_nif(err: cxx::Exception) -> Error {
+    let err_msg = err.what().to_owned();
+    let err_parts: Vec<&str> = err_msg.split('\n').collect();
+    Error::RaiseTerm(Box::new(err_parts[0].to_owned()))
+}
+
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn kv_cache_new<'a>(
+    id: i64,
+    num_layers: i64,
+    num_heads: i64,
+    head_dim: i64,
+    block_size: i64,
+    num_blocks: i64,
+    dtype: String,
+    device: torch::Device,
+) -> NifResult<KVCacheStruct<'a>> {
+    let options = torch::KVCacheOptions {
+        id,
+        num_layers,
+        num_heads,
+        head_dim,
+        block_size,
+        num_blocks,
+        dtype,
+        device,
+    };
+    let cache = torch::kv_cache_new(options).map_err(cxx_err_to_nif)?;
+    let stats = torch::kv_cache_stats(&cache).map_err(cxx_err_to_nif)?;
+
+    Ok(KVCacheStruct {
+        resource: ResourceArc::new(torch::CrossKVCacheRef { cache }),
+        reference: Reference::new(),
+        id: stats.id,
+        num_layers,
+        num_heads,
+        head_dim,
+        block_size,
+        num_blocks,
+    })
+}
+
+#[rustler::nif]
+pub fn kv_cache_add_sequence<'a>(cache: KVCacheStruct<'a>) -> NifResult<i64> {
+    torch::kv_cache_add_sequence(&cache.resource.cache).map_err(cxx_err_to_nif)
+}
+
+#[rustler::nif]
+pub fn kv_cache_free_sequence<'a>(cache: KVCacheStruct<'a>, sequence: i64) -> NifResult<()> {
+    torch::kv_cache_free_sequence(&cache.resource.cache, sequence).map_err(cxx_err_to_nif)
+}
+
+#[rustler::nif]
+pub fn kv_cache_sequence_length<'a>(
+    cache: KVCacheStruct<'a>,
+    sequence: i64,
+    layer: i64,
+) -> NifResult<i64> {
+    torch::kv_cache_sequence_length(&cache.resource.cache, sequence, layer).map_err(cxx_err_to_nif)
+}
+
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn kv_cache_append<'a>(
+    cache: KVCacheStruct<'a>,
+    sequence: i64,
+    layer: i64,
+    key: TensorStruct<'a>,
+    value: TensorStruct<'a>,
+) -> NifResult<()> {
+    torch::kv_cache_append(
+        &cache.resource.cache,
+        sequence,
+        layer,
+        &key.resource.tensor,
+        &value.resource.tensor,
+    )
+    .map_err(cxx_err_to_nif)
+}
+
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn kv_cache_gather<'a>(
+    cache: KVCacheStruct<'a>,
+    sequence: i64,
+    layer: i64,
+) -> NifResult<(TensorStruct<'a>, TensorStruct<'a>)> {
+    let result =
+        torch::kv_cache_gather(&cache.resource.cache, sequence, layer).map_err(cxx_err_to_nif)?;
+    let mut tensors = result.values.into_iter().map(|t| t.tensor.into());
+
+    Ok((tensors.next().unwrap(), tensors.next().unwrap()))
+}
+
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn kv_cache_attention<'a>(
+    cache: KVCacheStruct<'a>,
+    sequence: i64,
+    layer: i64,
+    query: TensorStruct<'a>,
+    key: TensorStruct<'a>,
+    value: TensorStruct<'a>,
+    scale: f64,
+    has_scale: bool,
+) -> NifResult<TensorStruct<'a>> {
+    let result = torch::kv_cache_attention(
+        &cache.resource.cache,
+        sequence,
+        layer,
+        &query.resource.tensor,
+        &key.resource.tensor,
+        &value.resource.tensor,
+        scale,
+        has_scale,
+    )
+    .map_err(cxx_err_to_nif)?;
+    Ok(result.into())
+}
+
+/// Get the pool occupancy of a cache as a map.
+#[rustler::nif]
+pub fn kv_cache_stats<'a>(env: Env<'a>, cache: KVCacheStruct<'a>) -> NifResult<Term<'a>> {
+    let stats = torch::kv_cache_stats(&cache.resource.cache).map_err(cxx_err_to_nif)?;
+
+    let keys = vec![
+        Atom::from_str(env, "num_blocks").unwrap().encode(env),
+        Atom::from_str(env, "used_blocks").unwrap().encode(env),
+        Atom::from_str(env, "free_blocks").unwrap().encode(env),
+        Atom::from_str(env, "peak_used_blocks").unwrap().encode(env),
+        Atom::from_str(env, "block_size").unwrap().encode(env),
+        Atom::from_str(env, "sequences").unwrap().encode(env),
+        Atom::from_str(env, "tokens").unwrap().encode(env),
+        Atom::from_str(env, "pool_bytes").unwrap().encode(env),
+    ];
+    let values = vec![
+        stats.num_blocks.encode(env),
+        stats.used_blocks.encode(env),
+        stats.free_blocks.encode(env),
+        stats.peak_used_blocks.encode(env),
+        stats.block_size.encode(env),
+        stats.sequences.encode(env),
+        stats.tokens.encode(env),
+        stats.pool_bytes.encode(env),
+    ];
+
+    Ok(Term::map_from_arrays(env, &keys, &values).unwrap())
+}
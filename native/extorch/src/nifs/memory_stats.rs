@@ -0,0 +1,97 @@
+use crate::native::torch;
+use crate::shared_types::{AOTIModelStruct, CompiledGraphStruct, JitModuleStruct};
+
+use rustler::{Atom, Encoder, Env, Error, NifResult, Term};
+
+/// Helper to convert a cxx error into a NifResult error.
+fn cxx_err_to_nif(err: cxx::Exception) -> Error {
+    let err_msg = err.what().to_owned();
+    let err_parts: Vec<&str> = err_msg.split('\n').collect();
+    Error::RaiseTerm(Box::new(err_parts[0].to_owned()))
+}
+
+fn model_stats_to_term<'a>(env: Env<'a>, stats: torch::ModelMemoryStats) -> Term<'a> {
+    let keys = vec![
+        Atom::from_str(env, "live_bytes").unwrap().encode(env),
+        Atom::from_str(env, "peak_bytes").unwrap().encode(env),
+        Atom::from_str(env, "allocations").unwrap().encode(env),
+        Atom::from_str(env, "frees").unwrap().encode(env),
+        Atom::from_str(env, "requests").unwrap().encode(env),
+        Atom::from_str(env, "last_request_peak_bytes").unwrap().encode(env),
+        Atom::from_str(env, "max_request_peak_bytes").unwrap().encode(env),
+        Atom::from_str(env, "weight_bytes").unwrap().encode(env),
+    ];
+    let values = vec![
+        stats.live_bytes.encode(env),
+        stats.peak_bytes.encode(env),
+        stats.allocations.encode(env),
+        stats.frees.encode(env),
+        stats.requests.encode(env),
+        stats.last_request_peak_bytes.encode(env),
+        stats.max_request_peak_bytes.encode(env),
+        stats.weight_bytes.encode(env),
+    ];
+
+    Term::map_from_arrays(env, &keys, &values).unwrap()
+}
+
+/// Install or remove the counting CPU allocator.
+#[rustler::nif]
+pub fn cpu_memory_tracking(enabled: bool) -> Atom {
+    torch::cpu_memory_tracking(enabled);
+    rustler::types::atom::ok()
+}
+
+/// Get the process-wide CPU allocator counters as a map.
+#[rustler::nif]
+pub fn cpu_memory_stats<'a>(env: Env<'a>) -> NifResult<Term<'a>> {
+    let stats = torch::cpu_memory_stats();
+
+    let keys = vec![
+        Atom::from_str(env, "enabled").unwrap().encode(env),
+        Atom::from_str(env, "live_bytes").unwrap().encode(env),
+        Atom::from_str(env, "peak_bytes").unwrap().encode(env),
+        Atom::from_str(env, "allocations").unwrap().encode(env),
+        Atom::from_str(env, "frees").unwrap().encode(env),
+    ];
+    let values = vec![
+        stats.enabled.encode(env),
+        stats.live_bytes.encode(env),
+        stats.peak_bytes.encode(env),
+        stats.allocations.encode(env),
+        stats.frees.encode(env),
+    ];
+
+    Ok(Term::map_from_arrays(env, &keys, &values).unwrap())
+}
+
+/// Restart the process-wide CPU peak from the bytes currently live.
+#[rustler::nif]
+pub fn cpu_memory_reset_peak() -> Atom {
+    torch::cpu_memory_reset_peak();
+    rustler::types::atom::ok()
+}
+
+/// Get the CPU memory account of a compiled graph as a map.
+#[rustler::nif]
+pub fn compiled_graph_memory_stats<'a>(
+    env: Env<'a>,
+    compiled: CompiledGraphStruct<'a>,
+) -> NifResult<Term<'a>> {
+    let stats = torch::compiled_graph_memory_stats(&compiled.resource.graph);
+    Ok(model_stats_to_term(env, stats))
+}
+
+/// Get the CPU memory account of an AOTI model as a map.
+#[rustler::nif]
+pub fn aoti_memory_stats<'a>(env: Env<'a>, model: AOTIModelStruct<'a>) -> NifResult<Term<'a>> {
+    let stats = torch::aoti_memory_stats(&model.resource.loader).map_err(cxx_err_to_nif)?;
+    Ok(model_stats_to_term(env, stats))
+}
+
+/// Get the CPU memory account of a JIT module as a map.
+#[rustler::nif]
+pub fn jit_memory_stats<'a>(env: Env<'a>, model: JitModuleStruct<'a>) -> NifResult<Term<'a>> {
+    let stats = torch::jit_memory_stats(&model.resource.module);
+    Ok(model_stats_to_term(env, stats))
+}
@@ -1,6 +1,6 @@
 use crate::encoding::jit::named_tensors_to_term;
 use crate::native::torch;
-use crate::shared_types::{NNModuleStruct, Reference, TensorStruct};
+use crate::shared_types::{NNModuleStruct, NNPipelineStruct, Reference, TensorStruct};
 
 use rustler::{Encoder, Env, Error, NifResult, ResourceArc, Term};
 
@@ -286,16 +286,26 @@ pub fn nn_copy_parameters<'a>(dst: NNModuleStruct<'a>, params: Vec<(String, Tens
     torch::nn_copy_parameters(&dst.resource.module, named).map_err(cxx_err)
 }
 
+/// Bind a list of {name, tensor} as a module's parameters/buffers without copying.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn nn_bind_parameters<'a>(dst: NNModuleStruct<'a>, params: Vec<(String, TensorStruct<'a>)>) -> NifResult<()> {
+    let named: Vec<torch::NamedTensor> = params
+        .into_iter()
+        .map(|(name, t)| torch::NamedTensor {
+            name,
+            tensor: t.resource.tensor.clone(),
+        })
+        .collect();
+
+    torch::nn_bind_parameters(&dst.resource.module, named).map_err(cxx_err)
+}
+
 #[rustler::nif]
 pub fn nn_to_device<'a>(module: NNModuleStruct<'a>, device: torch::Device) -> NifResult<NNModuleStruct<'a>> {
     let result = torch::nn_to_device(&module.resource.module, device).map_err(cxx_err)?;
     wrap_nn_module(result)
 }
 
-// ============================================================================
-// Direct ATen functional ops (Phase A)
-// ============================================================================
-
 fn pack_inputs<'a>(tensors: &[TensorStruct<'a>]) -> torch::TensorList {
     let values: Vec<torch::TensorOut> = tensors
         .iter()
@@ -320,6 +330,61 @@ fn unpack_outputs<'a>(env: Env<'a>, list: torch::TensorList) -> Term<'a> {
     out.encode(env)
 }
 
+/// Forward several tensors through a layer; tuple outputs come back flattened.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn nn_forward_many<'a>(
+    env: Env<'a>,
+    module: NNModuleStruct<'a>,
+    inputs: Vec<TensorStruct<'a>>,
+) -> NifResult<Term<'a>> {
+    let result = torch::nn_forward_many(&module.resource.module, pack_inputs(&inputs)).map_err(cxx_err)?;
+    Ok(unpack_outputs(env, result))
+}
+
+// ============================================================================
+// Whole-model pipelines
+// ============================================================================
+
+/// Build a pipeline from `{layer, input_slots, output_slots}` steps.
+#[rustler::nif]
+pub fn nn_pipeline_new<'a>(
+    steps: Vec<(NNModuleStruct<'a>, Vec<u64>, Vec<u64>)>,
+    num_inputs: u64,
+    outputs: Vec<u64>,
+) -> NifResult<NNPipelineStruct<'a>> {
+    let steps: Vec<torch::NNPipelineStep> = steps
+        .into_iter()
+        .map(|(module, inputs, outputs)| torch::NNPipelineStep {
+            module: module.resource.module.clone(),
+            inputs,
+            outputs,
+        })
+        .collect();
+
+    let pipeline = torch::nn_pipeline_new(steps, num_inputs, outputs).map_err(cxx_err)?;
+    let num_steps = torch::nn_pipeline_num_steps(&pipeline).map_err(cxx_err)?;
+    Ok(NNPipelineStruct {
+        resource: ResourceArc::new(torch::CrossNNPipelineRef { pipeline }),
+        reference: Reference::new(),
+        num_steps,
+    })
+}
+
+/// Run a whole pipeline in one call, returning its output tensors.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn nn_pipeline_run<'a>(
+    env: Env<'a>,
+    pipeline: NNPipelineStruct<'a>,
+    inputs: Vec<TensorStruct<'a>>,
+) -> NifResult<Term<'a>> {
+    let result = torch::nn_pipeline_run(&pipeline.resource.pipeline, pack_inputs(&inputs)).map_err(cxx_err)?;
+    Ok(unpack_outputs(env, result))
+}
+
+// ============================================================================
+// Direct ATen functional ops (Phase A)
+// ============================================================================
+
 #[rustler::nif]
 pub fn aten_lstm<'a>(
     env: Env<'a>,
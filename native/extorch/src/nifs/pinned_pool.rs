@@ -0,0 +1,89 @@
+use crate::native::torch;
+use crate::shared_types::{AtomString, Size, TensorStruct};
+
+use rustler::{Atom, Binary, Encoder, Env, Error, NifResult, Term};
+
+/// Helper to convert a cxx error into a NifResult error.
+fn cxx_err_to_nif(err: cxx::Exception) -> Error {
+    let err_msg = err.what().to_owned();
+    let err_parts: Vec<&str> = err_msg.split('\n').collect();
+    Error::RaiseTerm(Box::new(err_parts[0].to_owned()))
+}
+
+/// Create a tensor from raw binary data, staged in a pooled host buffer.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn from_binary_pinned<'a>(
+    data: Binary<'a>,
+    shape: Size,
+    dtype: AtomString,
+) -> NifResult<TensorStruct<'a>> {
+    let tensor = torch::pinned_from_binary(data.as_slice(), shape.size, dtype.name)
+        .map_err(cxx_err_to_nif)?;
+    Ok(tensor.into())
+}
+
+/// Create several tensors from `{binary, shape, dtype}` tuples in a single
+/// NIF call, each staged in a pooled host buffer.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn from_binaries_pinned<'a>(
+    entries: Vec<(Binary<'a>, Size, AtomString)>,
+) -> NifResult<Vec<TensorStruct<'a>>> {
+    entries
+        .into_iter()
+        .map(|(data, shape, dtype)| {
+            torch::pinned_from_binary(data.as_slice(), shape.size, dtype.name)
+                .map(|tensor| tensor.into())
+                .map_err(cxx_err_to_nif)
+        })
+        .collect()
+}
+
+/// Get the staging pool counters as a map.
+#[rustler::nif]
+pub fn pinned_pool_stats<'a>(env: Env<'a>) -> NifResult<Term<'a>> {
+    let stats = torch::pinned_pool_stats();
+
+    let keys = vec![
+        Atom::from_str(env, "pinned").unwrap().encode(env),
+        Atom::from_str(env, "requests").unwrap().encode(env),
+        Atom::from_str(env, "hits").unwrap().encode(env),
+        Atom::from_str(env, "misses").unwrap().encode(env),
+        Atom::from_str(env, "releases").unwrap().encode(env),
+        Atom::from_str(env, "blocks_in_use").unwrap().encode(env),
+        Atom::from_str(env, "blocks_cached").unwrap().encode(env),
+        Atom::from_str(env, "bytes_in_use").unwrap().encode(env),
+        Atom::from_str(env, "capacity_in_use").unwrap().encode(env),
+        Atom::from_str(env, "bytes_cached").unwrap().encode(env),
+        Atom::from_str(env, "bytes_reserved").unwrap().encode(env),
+        Atom::from_str(env, "max_cached_bytes").unwrap().encode(env),
+    ];
+    let values = vec![
+        stats.pinned.encode(env),
+        stats.requests.encode(env),
+        stats.hits.encode(env),
+        stats.misses.encode(env),
+        stats.releases.encode(env),
+        stats.blocks_in_use.encode(env),
+        stats.blocks_cached.encode(env),
+        stats.bytes_in_use.encode(env),
+        stats.capacity_in_use.encode(env),
+        stats.bytes_cached.encode(env),
+        stats.bytes_reserved.encode(env),
+        stats.max_cached_bytes.encode(env),
+    ];
+
+    Ok(Term::map_from_arrays(env, &keys, &values).unwrap())
+}
+
+/// Free every cached pool block. Returns the number of bytes released.
+#[rustler::nif]
+pub fn pinned_pool_empty_cache() -> i64 {
+    torch::pinned_pool_empty_cache()
+}
+
+/// Bound the number of bytes the staging pool keeps cached.
+#[rustler::nif]
+pub fn pinned_pool_set_max_cached_bytes(max_bytes: i64) -> NifResult<i64> {
+    torch::pinned_pool_set_max_cached_bytes(max_bytes).map_err(cxx_err_to_nif)?;
+    Ok(max_bytes)
+}
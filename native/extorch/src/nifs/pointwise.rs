@@ -1,6 +1,6 @@
 use crate::native::torch;
 use crate::shared_types::{Size, TensorStruct};
-use crate::torch::Scalar;
+use crate::torch::{Scalar, TensorOut};
 
 use rustler::{Error, NifResult};
 
@@ -8,22 +8,36 @@ nif_impl!(real, TensorStruct<'a>, input: TensorStruct<'a>);
 nif_impl!(imag, TensorStruct<'a>, input: TensorStruct<'a>);
 
 // Arithmetic
-nif_impl!(add, TensorStruct<'a>, input: TensorStruct<'a>, other: TensorStruct<'a>, alpha: Scalar);
-nif_impl!(sub, TensorStruct<'a>, input: TensorStruct<'a>, other: TensorStruct<'a>, alpha: Scalar);
-nif_impl!(mul, TensorStruct<'a>, input: TensorStruct<'a>, other: TensorStruct<'a>);
-nif_impl!(tensor_div, TensorStruct<'a>, input: TensorStruct<'a>, other: TensorStruct<'a>);
-nif_impl!(neg, TensorStruct<'a>, input: TensorStruct<'a>);
-nif_impl!(tensor_abs, TensorStruct<'a>, input: TensorStruct<'a>);
-nif_impl!(pow_tensor, TensorStruct<'a>, input: TensorStruct<'a>, exponent: Scalar);
-
-nif_impl!(clamp, TensorStruct<'a>, input: TensorStruct<'a>, min_val: Scalar, max_val: Scalar);
+nif_impl!(add, TensorStruct<'a>, input: TensorStruct<'a>, other: TensorStruct<'a>, alpha: Scalar, out: TensorOut);
+nif_impl!(sub, TensorStruct<'a>, input: TensorStruct<'a>, other: TensorStruct<'a>, alpha: Scalar, out: TensorOut);
+nif_impl!(mul, TensorStruct<'a>, input: TensorStruct<'a>, other: TensorStruct<'a>, out: TensorOut);
+nif_impl!(tensor_div, TensorStruct<'a>, input: TensorStruct<'a>, other: TensorStruct<'a>, out: TensorOut);
+nif_impl!(neg, TensorStruct<'a>, input: TensorStruct<'a>, out: TensorOut);
+nif_impl!(tensor_abs, TensorStruct<'a>, input: TensorStruct<'a>, out: TensorOut);
+nif_impl!(pow_tensor, TensorStruct<'a>, input: TensorStruct<'a>, exponent: Scalar, out: TensorOut);
+nif_impl!(clamp, TensorStruct<'a>, input: TensorStruct<'a>, min_val: Scalar, max_val: Scalar, out: TensorOut);
 
 // Math
-nif_impl!(tensor_exp, TensorStruct<'a>, input: TensorStruct<'a>);
-nif_impl!(tensor_log, TensorStruct<'a>, input: TensorStruct<'a>);
-nif_impl!(tensor_sqrt, TensorStruct<'a>, input: TensorStruct<'a>);
-nif_impl!(tensor_sin, TensorStruct<'a>, input: TensorStruct<'a>);
-nif_impl!(tensor_cos, TensorStruct<'a>, input: TensorStruct<'a>);
+nif_impl!(tensor_exp, TensorStruct<'a>, input: TensorStruct<'a>, out: TensorOut);
+nif_impl!(tensor_log, TensorStruct<'a>, input: TensorStruct<'a>, out: TensorOut);
+nif_impl!(tensor_sqrt, TensorStruct<'a>, input: TensorStruct<'a>, out: TensorOut);
+nif_impl!(tensor_sin, TensorStruct<'a>, input: TensorStruct<'a>, out: TensorOut);
+nif_impl!(tensor_cos, TensorStruct<'a>, input: TensorStruct<'a>, out: TensorOut);
+
+// In-place variants
+nif_impl!(add_, TensorStruct<'a>, input: TensorStruct<'a>, other: TensorStruct<'a>, alpha: Scalar);
+nif_impl!(sub_, TensorStruct<'a>, input: TensorStruct<'a>, other: TensorStruct<'a>, alpha: Scalar);
+nif_impl!(mul_, TensorStruct<'a>, input: TensorStruct<'a>, other: TensorStruct<'a>);
+nif_impl!(tensor_div_, TensorStruct<'a>, input: TensorStruct<'a>, other: TensorStruct<'a>);
+nif_impl!(neg_, TensorStruct<'a>, input: TensorStruct<'a>);
+nif_impl!(tensor_abs_, TensorStruct<'a>, input: TensorStruct<'a>);
+nif_impl!(pow_tensor_, TensorStruct<'a>, input: TensorStruct<'a>, exponent: Scalar);
+nif_impl!(clamp_, TensorStruct<'a>, input: TensorStruct<'a>, min_val: Scalar, max_val: Scalar);
+nif_impl!(tensor_exp_, TensorStruct<'a>, input: TensorStruct<'a>);
+nif_impl!(tensor_log_, TensorStruct<'a>, input: TensorStruct<'a>);
+nif_impl!(tensor_sqrt_, TensorStruct<'a>, input: TensorStruct<'a>);
+nif_impl!(tensor_sin_, TensorStruct<'a>, input: TensorStruct<'a>);
+nif_impl!(tensor_cos_, TensorStruct<'a>, input: TensorStruct<'a>);
 
 // Linear algebra
 nif_impl!(matmul, TensorStruct<'a>, input: TensorStruct<'a>, other: TensorStruct<'a>);
@@ -38,6 +52,7 @@ nif_impl!(masked_fill, TensorStruct<'a>, input: TensorStruct<'a>, mask: TensorSt
 nif_impl!(contiguous, TensorStruct<'a>, input: TensorStruct<'a>);
 nif_impl!(clone, TensorStruct<'a>, input: TensorStruct<'a>);
 nif_impl!(detach, TensorStruct<'a>, input: TensorStruct<'a>);
+nif_impl!(copy_, TensorStruct<'a>, input: TensorStruct<'a>, src: TensorStruct<'a>, non_blocking: bool);
 nif_impl!(view, TensorStruct<'a>, input: TensorStruct<'a>, shape: Size);
 nif_impl!(expand, TensorStruct<'a>, input: TensorStruct<'a>, shape: Size);
 
@@ -27,7 +27,8 @@ nif_impl!(
     TensorStruct<'a>,
     input: TensorStruct<'a>,
     dim: OptionalInt,
-    keepdim: bool
+    keepdim: bool,
+    out: TensorOut
 );
 
 nif_impl!(
@@ -35,7 +36,8 @@ nif_impl!(
     TensorStruct<'a>,
     input: TensorStruct<'a>,
     dim: OptionalInt,
-    keepdim: bool
+    keepdim: bool,
+    out: TensorOut
 );
 
 nif_impl!(
@@ -105,7 +107,8 @@ nif_impl!(
     TensorStruct<'a>,
     input: TensorStruct<'a>,
     dim: Size,
-    keepdim: bool
+    keepdim: bool,
+    out: TensorOut
 );
 
 nif_impl!(
@@ -113,7 +116,8 @@ nif_impl!(
     TensorStruct<'a>,
     input: TensorStruct<'a>,
     dim: Size,
-    keepdim: bool
+    keepdim: bool,
+    out: TensorOut
 );
 
 nif_impl!(
@@ -166,7 +170,8 @@ nif_impl!(
     TensorStruct<'a>,
     input: TensorStruct<'a>,
     dim: OptionalInt,
-    keepdim: bool
+    keepdim: bool,
+    out: TensorOut
 );
 
 nif_impl!(
@@ -0,0 +1,51 @@
+use crate::native::torch;
+use crate::shared_types::TensorStruct;
+use crate::torch::SortResult;
+
+use rustler::{Error, NifResult};
+
+/// Helper to convert a cxx error into a NifResult error.
+fn cxx_err_to_nif(err: cxx::Exception) -> Error {
+    let err_msg = err.what().to_owned();
+    let err_parts: Vec<&str> = err_msg.split('\n').collect();
+    Error::RaiseTerm(Box::new(err_parts[0].to_owned()))
+}
+
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn chunked_topk<'a>(
+    input: TensorStruct<'a>,
+    k: i64,
+    dim: i64,
+    largest: bool,
+    chunk_size: i64,
+) -> NifResult<SortResult> {
+    torch::chunked_topk(&input.resource.tensor, k, dim, largest, chunk_size).map_err(cxx_err_to_nif)
+}
+
+#[rustler::nif]
+pub fn topk_chunked_path<'a>(input: TensorStruct<'a>, k: i64, dim: i64) -> NifResult<bool> {
+    torch::topk_chunked_path(&input.resource.tensor, k, dim).map_err(cxx_err_to_nif)
+}
+
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn topk_matmul<'a>(
+    query: TensorStruct<'a>,
+    keys: TensorStruct<'a>,
+    k: i64,
+    largest: bool,
+    chunk_size: i64,
+) -> NifResult<SortResult> {
+    torch::topk_matmul(&query.resource.tensor, &keys.resource.tensor, k, largest, chunk_size)
+        .map_err(cxx_err_to_nif)
+}
+
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn topk_merge<'a>(
+    state: SortResult,
+    chunk: TensorStruct<'a>,
+    offset: i64,
+    k: i64,
+    largest: bool,
+) -> NifResult<SortResult> {
+    torch::topk_merge(state, &chunk.resource.tensor, offset, k, largest).map_err(cxx_err_to_nif)
+}
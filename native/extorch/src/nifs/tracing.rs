@@ -0,0 +1,90 @@
+use crate::native::torch;
+use crate::shared_types::{AOTIModelStruct, CompiledGraphStruct, JitModuleStruct, TensorResource};
+
+use rustler::{Atom, Error, NifResult};
+
+fn cxx_err_to_nif(err: cxx::Exception) -> Error {
+    let err_msg = err.what().to_owned();
+    let err_parts: Vec<&str> = err_msg.split('\n').collect();
+    Error::RaiseTerm(Box::new(err_parts[0].to_owned()))
+}
+
+fn make_tensor_list(inputs: &[TensorResource]) -> torch::TensorList {
+    let values: Vec<torch::TensorOut> = inputs
+        .iter()
+        .map(|t| torch::TensorOut {
+            tensor: t.tensor.clone(),
+            used: true,
+        })
+        .collect();
+    torch::TensorList { values, used: true }
+}
+
+/// Run a compiled graph `requests` times under the profiler and write a
+/// Chrome trace to `path`.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn trace_compiled_graph<'a>(
+    compiled: CompiledGraphStruct<'a>,
+    inputs: Vec<TensorResource>,
+    requests: i64,
+    path: String,
+    record_shapes: bool,
+    profile_memory: bool,
+) -> NifResult<Atom> {
+    torch::trace_compiled_graph(
+        &compiled.resource.graph,
+        make_tensor_list(&inputs),
+        requests,
+        path,
+        record_shapes,
+        profile_memory,
+    )
+    .map_err(cxx_err_to_nif)?;
+    Ok(rustler::types::atom::ok())
+}
+
+/// Run an AOTI model `requests` times under the profiler and write a
+/// Chrome trace to `path`.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn trace_aoti<'a>(
+    model: AOTIModelStruct<'a>,
+    inputs: Vec<TensorResource>,
+    requests: i64,
+    path: String,
+    record_shapes: bool,
+    profile_memory: bool,
+) -> NifResult<Atom> {
+    torch::trace_aoti(
+        &model.resource.loader,
+        make_tensor_list(&inputs),
+        requests,
+        path,
+        record_shapes,
+        profile_memory,
+    )
+    .map_err(cxx_err_to_nif)?;
+    Ok(rustler::types::atom::ok())
+}
+
+/// Run a JIT model `requests` times under the profiler and write a Chrome
+/// trace to `path`.
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn trace_jit<'a>(
+    model: JitModuleStruct<'a>,
+    inputs: Vec<TensorResource>,
+    requests: i64,
+    path: String,
+    record_shapes: bool,
+    profile_memory: bool,
+) -> NifResult<Atom> {
+    torch::trace_jit(
+        &model.resource.module,
+        make_tensor_list(&inputs),
+        requests,
+        path,
+        record_shapes,
+        profile_memory,
+    )
+    .map_err(cxx_err_to_nif)?;
+    Ok(rustler::types::atom::ok())
+}
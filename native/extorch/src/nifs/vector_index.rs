@@ -0,0 +1,102 @@
+use crate::native::torch;
+use crate::shared_types::{Reference, TensorStruct, VectorIndexStruct};
+use crate::torch::SortResult;
+
+use cxx::SharedPtr;
+use rustler::{Error, NifResult, ResourceArc};
+
+/// Helper to convert a cxx error into a NifResult error.
+fn cxx_err_to_nif(err: cxx::Exception) -> Error {
+    let err_msg = err.what().to_owned();
+    let err_parts: Vec<&str> = err_msg.split('\n').collect();
+    Error::RaiseTerm(Box::new(err_parts[0].to_owned()))
+}
+
+fn wrap_index<'a>(index: SharedPtr<torch::CrossVectorIndex>) -> NifResult<VectorIndexStruct<'a>> {
+    let options = torch::vector_index_options(&index).map_err(cxx_err_to_nif)?;
+    Ok(VectorIndexStruct {
+        resource: ResourceArc::new(torch::CrossVectorIndexRef { index }),
+        reference: Reference::new(),
+        kind: options.kind,
+        metric: options.metric,
+        dim: options.dim,
+    })
+}
+
+#[rustler::nif]
+pub fn vector_index_new<'a>(
+    kind: String,
+    metric: String,
+    dim: i64,
+    nlist: i64,
+    nprobe: i64,
+    m: i64,
+    ef_construction: i64,
+    ef_search: i64,
+    seed: i64,
+) -> NifResult<VectorIndexStruct<'a>> {
+    let options = torch::VectorIndexOptions {
+        kind,
+        metric,
+        dim,
+        nlist,
+        nprobe,
+        m,
+        ef_construction,
+        ef_search,
+        seed,
+    };
+    wrap_index(torch::vector_index_new(options).map_err(cxx_err_to_nif)?)
+}
+
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn vector_index_train<'a>(
+    index: VectorIndexStruct<'a>,
+    sample: TensorStruct<'a>,
+    iterations: i64,
+) -> NifResult<()> {
+    torch::vector_index_train(&index.resource.index, &sample.resource.tensor, iterations)
+        .map_err(cxx_err_to_nif)
+}
+
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn vector_index_add<'a>(index: VectorIndexStruct<'a>, vectors: TensorStruct<'a>) -> NifResult<i64> {
+    torch::vector_index_add(&index.resource.index, &vectors.resource.tensor).map_err(cxx_err_to_nif)
+}
+
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn vector_index_search<'a>(
+    index: VectorIndexStruct<'a>,
+    queries: TensorStruct<'a>,
+    k: i64,
+    effort: i64,
+) -> NifResult<SortResult> {
+    torch::vector_index_search(&index.resource.index, &queries.resource.tensor, k, effort)
+        .map_err(cxx_err_to_nif)
+}
+
+#[rustler::nif]
+pub fn vector_index_size<'a>(index: VectorIndexStruct<'a>) -> NifResult<i64> {
+    torch::vector_index_size(&index.resource.index).map_err(cxx_err_to_nif)
+}
+
+#[rustler::nif]
+pub fn vector_index_is_trained<'a>(index: VectorIndexStruct<'a>) -> NifResult<bool> {
+    torch::vector_index_is_trained(&index.resource.index).map_err(cxx_err_to_nif)
+}
+
+#[rustler::nif(schedule = "DirtyCpu")]
+pub fn vector_index_vectors<'a>(index: VectorIndexStruct<'a>) -> NifResult<TensorStruct<'a>> {
+    let tensor = torch::vector_index_vectors(&index.resource.index).map_err(cxx_err_to_nif)?;
+    Ok(tensor.into())
+}
+
+#[rustler::nif(schedule = "DirtyIo")]
+pub fn vector_index_save<'a>(index: VectorIndexStruct<'a>, path: String) -> NifResult<()> {
+    torch::vector_index_save(&index.resource.index, path).map_err(cxx_err_to_nif)
+}
+
+#[rustler::nif(schedule = "DirtyIo")]
+pub fn vector_index_load<'a>(path: String, mmap: bool) -> NifResult<VectorIndexStruct<'a>> {
+    wrap_index(torch::vector_index_load(path, mmap).map_err(cxx_err_to_nif)?)
+}
@@ -4,6 +4,8 @@ use rustler::ResourceArc;
 use rustler::NifStruct;
 use rustler::Term;
 
+use cxx::SharedPtr;
+
 use crate::native::torch;
 
 pub struct Reference<'a> {
@@ -45,6 +47,13 @@ pub struct TensorStruct<'a> {
     pub device: torch::Device,
 }
 
+/// Tensor argument decoded from the `resource` field of an `%ExTorch.Tensor{}`
+/// only. Its size/dtype/device fields are never read, which saves decoding
+/// them on hot paths that just forward the tensor to libtorch.
+pub struct TensorResource {
+    pub tensor: SharedPtr<torch::CrossTensor>,
+}
+
 #[derive(NifStruct)]
 #[module = "ExTorch.Complex"]
 pub struct Complex<'a> {
@@ -60,6 +69,15 @@ pub struct ListWrapper<'a> {
     pub dtype: Term<'a>,
 }
 
+/// Nested list (or tuple) of numbers to decode into a tensor, along with
+/// the caller's default floating point type, which is only known to Elixir.
+#[derive(NifStruct)]
+#[module = "ExTorch.Utils.TensorData"]
+pub struct TensorData<'a> {
+    pub data: Term<'a>,
+    pub float_dtype: AtomString,
+}
+
 pub struct TensorIndex {
     pub indices: Vec<torch::TorchIndex>,
 }
@@ -106,6 +124,44 @@ pub struct CompiledGraphStruct<'a> {
     pub reference: Reference<'a>,
 }
 
+#[derive(NifStruct)]
+#[module = "ExTorch.Export.Session"]
+pub struct GraphSessionStruct<'a> {
+    pub resource: ResourceArc<torch::CrossGraphSessionRef>,
+    pub reference: Reference<'a>,
+    pub state_inputs: Vec<String>,
+}
+
+#[derive(NifStruct)]
+#[module = "ExTorch.Export.EncodedGraph"]
+pub struct EncodedGraphStruct<'a> {
+    pub resource: ResourceArc<torch::CrossEncodedGraphRef>,
+    pub reference: Reference<'a>,
+}
+
+#[derive(NifStruct)]
+#[module = "ExTorch.VectorIndex"]
+pub struct VectorIndexStruct<'a> {
+    pub resource: ResourceArc<torch::CrossVectorIndexRef>,
+    pub reference: Reference<'a>,
+    pub kind: String,
+    pub metric: String,
+    pub dim: i64,
+}
+
+#[derive(NifStruct)]
+#[module = "ExTorch.KVCache"]
+pub struct KVCacheStruct<'a> {
+    pub resource: ResourceArc<torch::CrossKVCacheRef>,
+    pub reference: Reference<'a>,
+    pub id: i64,
+    pub num_layers: i64,
+    pub num_heads: i64,
+    pub head_dim: i64,
+    pub block_size: i64,
+    pub num_blocks: i64,
+}
+
 #[derive(NifStruct)]
 #[module = "ExTorch.NN.Layer"]
 pub struct NNModuleStruct<'a> {
@@ -113,3 +169,11 @@ pub struct NNModuleStruct<'a> {
     pub reference: Reference<'a>,
     pub type_name: String,
 }
+
+#[derive(NifStruct)]
+#[module = "ExTorch.NN.Pipeline.Native"]
+pub struct NNPipelineStruct<'a> {
+    pub resource: ResourceArc<torch::CrossNNPipelineRef>,
+    pub reference: Reference<'a>,
+    pub num_steps: u64,
+}
@@ -0,0 +1,94 @@
+//! Round trip of a compiled graph through `dump_compiled_graph` and
+//! `load_compiled_graph_dump`, the files replayed by the graph executor
+//! benchmark.
+
+use extorch::torch;
+
+use cxx::SharedPtr;
+
+fn node(tag: i64, string_val: &str, child_count: i64) -> torch::IValueNode {
+    torch::IValueNode {
+        tag,
+        tensor: SharedPtr::null(),
+        int_val: 0,
+        float_val: 0.0,
+        bool_val: false,
+        string_val: string_val.to_owned(),
+        parent_idx: -1,
+        child_count,
+    }
+}
+
+fn randn(dims: Vec<i64>) -> SharedPtr<torch::CrossTensor> {
+    let device = torch::Device {
+        device: "cpu".to_owned(),
+        index: -1,
+    };
+    torch::randn(
+        dims,
+        "float32".to_owned(),
+        "strided".to_owned(),
+        device,
+        false,
+        false,
+        "contiguous".to_owned(),
+    )
+    .unwrap()
+}
+
+fn tensor_list(tensors: &[&SharedPtr<torch::CrossTensor>]) -> torch::TensorList {
+    let values = tensors
+        .iter()
+        .map(|tensor| torch::TensorOut {
+            tensor: (*tensor).clone(),
+            used: true,
+        })
+        .collect();
+    torch::TensorList { values, used: true }
+}
+
+#[test]
+fn dump_round_trip() {
+    // y = addmm(b, x, w), with b and w bound as constants.
+    let graph = vec![
+        node(20, "aten::addmm", 3),
+        node(22, "default", 0),
+        node(21, "y", 0),
+        node(23, "self", 0),
+        node(10, "b", 0),
+        node(23, "mat1", 0),
+        node(10, "x", 0),
+        node(23, "mat2", 0),
+        node(10, "w", 0),
+    ];
+    let names = vec!["b".to_owned(), "w".to_owned(), "x".to_owned()];
+    let compiled = torch::compile_graph(graph, names, vec!["y".to_owned()]).unwrap();
+
+    let (b, w, x) = (randn(vec![4]), randn(vec![3, 4]), randn(vec![2, 3]));
+    let bound = torch::bind_graph_constants(
+        &compiled,
+        vec!["b".to_owned(), "w".to_owned()],
+        tensor_list(&[&b, &w]),
+    )
+    .unwrap();
+    let expected = torch::run_compiled_graph(&bound, tensor_list(&[&x])).unwrap();
+
+    let path = std::env::temp_dir().join(format!("extorch_graph_dump_{}.bin", std::process::id()));
+    let path = path.to_str().unwrap().to_owned();
+    torch::dump_compiled_graph(&bound, tensor_list(&[&x]), path.clone()).unwrap();
+    let dump = torch::load_compiled_graph_dump(path.clone());
+    std::fs::remove_file(&path).unwrap();
+    let dump = dump.unwrap();
+
+    assert_eq!(dump.inputs.values.len(), 1);
+    assert!(torch::equal(&dump.inputs.values[0].tensor, &x).unwrap());
+
+    let inputs = tensor_list(&[&dump.inputs.values[0].tensor]);
+    let output = torch::run_compiled_graph(&dump.graph, inputs).unwrap();
+    assert_eq!(output.values.len(), 1);
+    assert!(torch::equal(&output.values[0].tensor, &expected.values[0].tensor).unwrap());
+
+    let result = torch::benchmark_compiled_graph(&dump.graph, tensor_list(&[&x]), 1, 3).unwrap();
+    assert_eq!(result.latencies_ns.len(), 3);
+    assert!(result.allocations > 0);
+}
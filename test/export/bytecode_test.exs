@@ -0,0 +1,120 @@
+defmodule ExTorchTest.Export.BytecodeTest do
+  use ExUnit.Case, async: true
+
+  alias ExTorch.Export.Bytecode
+
+  @fixtures_dir Path.join([__DIR__, "..", "fixtures"])
+  @simple_mlp_path Path.join(@fixtures_dir, "simple_mlp_exported.pt2")
+
+  @instructions [
+    {:begin_op, "aten::add", 3},
+    {:overload, "Tensor"},
+    {:output, "y"},
+    {:ref, "x"},
+    {:ref, "x"},
+    {:arg_name, "alpha"},
+    {:int, 2},
+    {:begin_op, "aten::sum", 3},
+    {:overload, "dim_IntList"},
+    {:output, "s"},
+    {:ref, "y"},
+    {:list, [{:int, 0}]},
+    {:bool, true}
+  ]
+
+  defp tmp_dir do
+    dir = Path.join(System.tmp_dir!(), "extorch_bytecode_#{System.unique_integer([:positive])}")
+    File.mkdir_p!(dir)
+    on_exit(fn -> File.rm_rf(dir) end)
+    dir
+  end
+
+  describe "encode/2" do
+    test "packs a header, string table, op table and fixed-width records" do
+      code = Bytecode.encode(@instructions, 42)
+
+      assert <<"EXTG", 1::little-32, 42::little-64, n_strings::little-32, n_ops::little-32,
+               n_records::little-32, _rest::binary>> = code
+
+      # x, y, s, alpha, aten::add, Tensor, aten::sum, dim_IntList
+      assert n_strings == 8
+      assert n_ops == 2
+      # Overloads live in the op table, so they take no record.
+      assert n_records == length(@instructions) - 2
+      assert Bytecode.source_tag(code) == 42
+    end
+
+    test "rejects inline tensors" do
+      assert_raise ArgumentError, fn ->
+        Bytecode.encode([{:begin_op, "aten::neg", 1}, {:tensor, ExTorch.ones({2})}])
+      end
+    end
+
+    test "compiles to the same graph as the tuple instruction stream" do
+      x = ExTorch.tensor([[1.0, 2.0], [3.0, 4.0]])
+      code = Bytecode.encode(@instructions)
+
+      from_bytecode = ExTorch.Native.compile_graph_bytecode(code, ["x"], ["y", "s"])
+      from_terms = ExTorch.Native.compile_graph(@instructions, ["x"], ["y", "s"])
+
+      [y1, s1] = ExTorch.Native.run_compiled_graph(from_bytecode, [x])
+      [y2, s2] = ExTorch.Native.run_compiled_graph(from_terms, [x])
+
+      assert ExTorch.allclose(y1, y2)
+      assert ExTorch.allclose(s1, s2)
+      assert ExTorch.allclose(s1, ExTorch.tensor([12.0, 18.0]))
+    end
+
+    test "malformed bytecode raises" do
+      assert_raise ErlangError, fn ->
+        ExTorch.Native.compile_graph_bytecode(<<"EXTG", 0::32>>, [], [])
+      end
+    end
+  end
+
+  describe "disk cache" do
+    test "load/2 writes bytecode next to the archive and reuses it" do
+      dir = tmp_dir()
+      path = Path.join(dir, "model.pt2")
+      File.cp!(@simple_mlp_path, path)
+      cache = Bytecode.cache_path(path, :cpu)
+
+      model = ExTorch.Export.load(path, bytecode_cache: true)
+      assert File.exists?(cache)
+      assert {:ok, _} = Bytecode.read_cache(cache, Bytecode.archive_tag(path, :cpu))
+
+      reloaded = ExTorch.Export.load(path, bytecode_cache: true)
+      input = ExTorch.randn({2, 10})
+
+      assert ExTorch.allclose(
+               ExTorch.Export.forward_compiled(model, [input]),
+               ExTorch.Export.forward_compiled(reloaded, [input])
+             )
+    end
+
+    test "the archive tag follows the contents, not the file times" do
+      dir = tmp_dir()
+      path = Path.join(dir, "model.pt2")
+      File.cp!(@simple_mlp_path, path)
+      %File.Stat{mtime: mtime} = File.stat!(path, time: :posix)
+      tag = Bytecode.archive_tag(path, :cpu)
+
+      # Same size and modification time, different contents.
+      contents = File.read!(path)
+      File.write!(path, :binary.part(contents, 1, byte_size(contents) - 1) <> "x")
+      File.touch!(path, mtime)
+
+      assert Bytecode.archive_tag(path, :cpu) != tag
+      assert Bytecode.archive_tag(path, :cuda) != Bytecode.archive_tag(path, :cpu)
+    end
+
+    test "stale cache entries are ignored" do
+      dir = tmp_dir()
+      cache = Path.join(dir, "model.cpu.extg")
+      Bytecode.write_cache(cache, Bytecode.encode(@instructions, 1))
+
+      assert {:ok, _} = Bytecode.read_cache(cache, 1)
+      assert :error = Bytecode.read_cache(cache, 2)
+    end
+  end
+end
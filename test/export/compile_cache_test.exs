@@ -0,0 +1,94 @@
+defmodule ExTorchTest.Export.CompileCacheTest do
+  use ExUnit.Case, async: true
+
+  alias ExTorch.Export.CompileCache
+
+  @fixtures_dir Path.join([__DIR__, "..", "fixtures"])
+  @simple_mlp_path Path.join(@fixtures_dir, "simple_mlp_exported.pt2")
+
+  defp tmp_dir do
+    dir = Path.join(System.tmp_dir!(), "extorch_compile_cache_#{System.unique_integer([:positive])}")
+    on_exit(fn -> File.rm_rf(dir) end)
+    dir
+  end
+
+  describe "serialize_compiled_graph/2" do
+    test "round-trips a compiled graph" do
+      instructions = [
+        {:begin_op, "aten::add", 3},
+        {:overload, "Tensor"},
+        {:output, "y"},
+        {:ref, "x"},
+        {:ref, "x"},
+        {:arg_name, "alpha"},
+        {:float, 0.5},
+        {:begin_op, "aten::sum", 2},
+        {:overload, "dim_IntList"},
+        {:output, "s"},
+        {:ref, "y"},
+        {:list, [{:int, 1}]}
+      ]
+
+      x = ExTorch.tensor([[1.0, 2.0], [3.0, 4.0]])
+      compiled = ExTorch.Native.compile_graph(instructions, ["x"], ["s"])
+      data = ExTorch.Native.serialize_compiled_graph(compiled, 7)
+      restored = ExTorch.Native.deserialize_compiled_graph(data, 7)
+
+      [expected] = ExTorch.Native.run_compiled_graph(compiled, [x])
+      [actual] = ExTorch.Native.run_compiled_graph(restored, [x])
+      assert ExTorch.allclose(expected, actual)
+    end
+
+    test "rejects a blob written for another source tag" do
+      compiled =
+        ExTorch.Native.compile_graph(
+          [{:begin_op, "aten::neg", 1}, {:overload, ""}, {:output, "y"}, {:ref, "x"}],
+          ["x"],
+          ["y"]
+        )
+
+      data = ExTorch.Native.serialize_compiled_graph(compiled, 1)
+
+      assert_raise ErlangError, fn -> ExTorch.Native.deserialize_compiled_graph(data, 2) end
+
+      assert_raise ErlangError, fn ->
+        ExTorch.Native.deserialize_compiled_graph(binary_part(data, 0, 20), 1)
+      end
+    end
+  end
+
+  describe "load/2 with :compile_cache" do
+    test "writes the cache on first load and reuses it afterwards" do
+      dir = tmp_dir()
+      {name, _tag} = CompileCache.key(@simple_mlp_path, :cpu)
+
+      model = ExTorch.Export.load(@simple_mlp_path, compile_cache: dir)
+      assert File.exists?(CompileCache.entry_path(dir, name, :compiled))
+      assert File.exists?(CompileCache.entry_path(dir, name, :bytecode))
+
+      cached = ExTorch.Export.load(@simple_mlp_path, compile_cache: dir)
+      assert cached.native_compiled != nil
+
+      input = ExTorch.randn({2, 10})
+      expected = ExTorch.Export.forward(model, [input])
+
+      assert ExTorch.allclose(ExTorch.Export.forward_compiled(cached, [input]), expected)
+      assert ExTorch.allclose(ExTorch.Export.forward_native(cached, [input]), expected)
+    end
+
+    test "a corrupt entry falls back to compiling" do
+      dir = tmp_dir()
+      {name, _tag} = CompileCache.key(@simple_mlp_path, :cpu)
+      File.mkdir_p!(dir)
+      File.write!(CompileCache.entry_path(dir, name, :compiled), "not a graph")
+
+      model = ExTorch.Export.load(@simple_mlp_path, compile_cache: dir)
+      input = ExTorch.randn({2, 10})
+
+      assert ExTorch.allclose(
+               ExTorch.Export.forward_compiled(model, [input]),
+               ExTorch.Export.forward(model, [input])
+             )
+    end
+  end
+end
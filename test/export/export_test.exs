@@ -11,8 +11,10 @@ defmodule ExTorchTest.ExportTest do
   @convnet_input_shape {1, 1, 8, 8}
   @convnet_output_shape {1, 3}
 
+  @recurrent_path Path.join(@fixtures_dir, "recurrent_cell_exported.pt2")
+
   setup_all do
-    unless File.exists?(@simple_mlp_path),
+    unless File.exists?(@simple_mlp_path) and File.exists?(@recurrent_path),
       do: flunk("Run: .venv/bin/python test/fixtures/generate_export_models.py")
 
     # Generated DSL tests recompile a fixed module name across runs.
@@ -103,6 +105,225 @@ defmodule ExTorchTest.ExportTest do
     end
   end
 
+  describe "forward_native/2" do
+    test "runs the load-time encoded graph" do
+      model = ExTorch.Export.load(@convnet_path)
+      assert %ExTorch.Export.EncodedGraph{} = model.native_encoded
+
+      input = load_reference("convnet_exported_input", @convnet_input_shape)
+      expected = load_reference("convnet_exported_output", @convnet_output_shape)
+
+      output = ExTorch.Export.forward_native(model, [input])
+      assert ExTorch.allclose(output, expected, 1.0e-5, 1.0e-6)
+    end
+
+    test "matches the per-call instruction path" do
+      model = ExTorch.Export.load(@simple_mlp_path)
+      input = ExTorch.randn({4, 10})
+
+      encoded = ExTorch.Export.forward_native(model, [input])
+      rebuilt = ExTorch.Export.forward_native(%{model | native_encoded: nil}, [input])
+
+      assert ExTorch.allclose(encoded, rebuilt)
+    end
+  end
+
+  describe "forward_compiled/2" do
+    test "takes only the user inputs" do
+      model = ExTorch.Export.load(@convnet_path)
+      assert ExTorch.Native.compiled_graph_inputs(model.native_compiled) == model.user_inputs
+
+      input = load_reference("convnet_exported_input", @convnet_input_shape)
+      expected = load_reference("convnet_exported_output", @convnet_output_shape)
+
+      output = ExTorch.Export.forward_compiled(model, [input])
+      assert ExTorch.allclose(output, expected, 1.0e-5, 1.0e-6)
+    end
+
+    test "rejects a wrong number of inputs" do
+      model = ExTorch.Export.load(@simple_mlp_path)
+      assert_raise ErlangError, fn -> ExTorch.Export.forward_compiled(model, []) end
+    end
+  end
+
+  describe "start_profiling/2" do
+    test "records per-node and per-target stats of forward_compiled/2" do
+      model = ExTorch.Export.load(@convnet_path)
+      input = load_reference("convnet_exported_input", @convnet_input_shape)
+
+      :ok = ExTorch.Export.start_profiling(model)
+      for _ <- 1..3, do: ExTorch.Export.forward_compiled(model, [input])
+      :ok = ExTorch.Export.stop_profiling(model)
+      ExTorch.Export.forward_compiled(model, [input])
+
+      stats = ExTorch.Export.profile_stats(model)
+      assert stats.runs == 3
+      assert stats.dropped == 0
+      assert stats.samples == 3 * length(stats.nodes)
+
+      assert Enum.all?(stats.nodes, &(&1.count == 3))
+      assert Enum.all?(stats.nodes, &(&1.min_ns <= &1.p50_ns and &1.p50_ns <= &1.max_ns))
+      assert Enum.sum(Enum.map(stats.targets, & &1.count)) == stats.samples
+      assert Enum.any?(stats.targets, &String.starts_with?(&1.target, "aten::conv"))
+      assert Enum.any?(stats.nodes, &(&1.output_bytes > 0))
+    end
+
+    test "keeps only the latest samples" do
+      model = ExTorch.Export.load(@simple_mlp_path)
+      input = load_reference("simple_mlp_exported_input", @simple_mlp_input_shape)
+
+      ExTorch.Export.start_profiling(model, capacity: 2)
+      for _ <- 1..5, do: ExTorch.Export.forward_compiled(model, [input])
+
+      stats = ExTorch.Export.profile_stats(model)
+      assert stats.samples == 2
+      assert stats.dropped > 0
+    end
+  end
+
+  describe "ExTorch.Export.Session" do
+    alias ExTorch.Export.Session
+
+    defp step_input(inputs, i), do: inputs |> ExTorch.narrow(0, i, 1) |> ExTorch.reshape({1, 8})
+
+    test "carries the hidden state across steps" do
+      model = ExTorch.Export.load(@recurrent_path)
+      inputs = load_reference("recurrent_cell_exported_inputs", {5, 1, 8})
+      expected = load_reference("recurrent_cell_exported_outputs", {5, 1, 4})
+
+      session = Session.new(model, [{"h", 1, ExTorch.zeros({1, 16})}])
+
+      for i <- 0..4 do
+        output = Session.step(session, [step_input(inputs, i)])
+        assert output.size == {1, 4}
+        reference = expected |> ExTorch.narrow(0, i, 1) |> ExTorch.reshape({1, 4})
+        assert ExTorch.allclose(output, reference, 1.0e-5, 1.0e-6)
+      end
+
+      # Same state as passing it through every forward_compiled/2 call.
+      h =
+        Enum.reduce(0..4, ExTorch.zeros({1, 16}), fn i, h ->
+          [_y, h] = ExTorch.Export.forward_compiled(model, [step_input(inputs, i), h])
+          h
+        end)
+
+      assert ExTorch.allclose(Session.state(session)["h"], h, 1.0e-5, 1.0e-6)
+    end
+
+    test "reset restores the initial state" do
+      model = ExTorch.Export.load(@recurrent_path)
+      inputs = load_reference("recurrent_cell_exported_inputs", {5, 1, 8})
+      h0 = ExTorch.zeros({1, 16})
+
+      [_name, output_name] = model.schema.outputs
+      session = Session.new(model, [{"h", output_name, h0}])
+
+      first = Session.step(session, [step_input(inputs, 0)])
+      Session.step(session, [step_input(inputs, 1)])
+      refute ExTorch.equal(Session.state(session)["h"], h0)
+
+      :ok = Session.reset(session)
+      assert ExTorch.equal(Session.state(session)["h"], h0)
+      assert ExTorch.equal(Session.step(session, [step_input(inputs, 0)]), first)
+    end
+
+    test "rejects unknown state inputs and outputs" do
+      model = ExTorch.Export.load(@recurrent_path)
+      h0 = ExTorch.zeros({1, 16})
+
+      assert_raise ErlangError, fn -> Session.new(model, [{"hidden", 1, h0}]) end
+      assert_raise ErlangError, fn -> Session.new(model, [{"h", 2, h0}]) end
+      assert_raise ArgumentError, fn -> Session.new(model, [{"h", "missing", h0}]) end
+    end
+  end
+
+  describe "dump_compiled/3" do
+    test "writes the graph, weights and inputs for the native benchmark" do
+      model = ExTorch.Export.load(@convnet_path)
+      input = load_reference("convnet_exported_input", @convnet_input_shape)
+      path = Path.join(System.tmp_dir!(), "extorch_dump_#{System.unique_integer([:positive])}.extd")
+      on_exit(fn -> File.rm(path) end)
+
+      :ok = ExTorch.Export.dump_compiled(model, [input], path)
+
+      assert <<"EXTD", 1::little-32, _::binary>> = File.read!(path)
+    end
+  end
+
+  describe "ExTorch.Trace.trace/4" do
+    test "writes a chrome trace with one range per request" do
+      model = ExTorch.Export.load(@convnet_path)
+      input = load_reference("convnet_exported_input", @convnet_input_shape)
+      path = Path.join(System.tmp_dir!(), "extorch_trace_#{System.unique_integer([:positive])}.json")
+      on_exit(fn -> File.rm(path) end)
+
+      :ok = ExTorch.Trace.trace(model, [input], path, requests: 3, record_shapes: true)
+
+      trace = File.read!(path)
+      assert trace =~ "traceEvents"
+      for i <- 0..2, do: assert(trace =~ "request##{i}")
+      refute trace =~ "request#3"
+      assert trace =~ "aten::conv"
+
+      [first_node | _] = model.schema.graph
+      assert trace =~ ~s("#{hd(first_node.outputs)}")
+    end
+
+    test "traces a model that is being profiled" do
+      model = ExTorch.Export.load(@simple_mlp_path)
+      input = load_reference("simple_mlp_exported_input", @simple_mlp_input_shape)
+      path = Path.join(System.tmp_dir!(), "extorch_trace_#{System.unique_integer([:positive])}.json")
+      on_exit(fn -> File.rm(path) end)
+
+      :ok = ExTorch.Export.start_profiling(model)
+      :ok = ExTorch.Trace.trace(model, [input], path, requests: 2)
+      :ok = ExTorch.Export.stop_profiling(model)
+
+      assert File.read!(path) =~ "aten::"
+      assert ExTorch.Export.profile_stats(model).runs == 2
+    end
+
+    test "rejects a non-positive number of requests" do
+      model = ExTorch.Export.load(@simple_mlp_path)
+      input = load_reference("simple_mlp_exported_input", @simple_mlp_input_shape)
+      path = Path.join(System.tmp_dir!(), "extorch_trace_empty.json")
+
+      assert_raise ErlangError, fn ->
+        ExTorch.Trace.trace(model, [input], path, requests: 0)
+      end
+    end
+  end
+
+  describe "bind_graph_constants/3" do
+    test "binds inputs by name, in any order" do
+      instructions = [
+        {:begin_op, "aten::addmm", 3},
+        {:overload, "default"},
+        {:output, "y"},
+        {:ref, "bias"},
+        {:ref, "x"},
+        {:ref, "weight"}
+      ]
+
+      compiled = ExTorch.Native.compile_graph(instructions, ["weight", "x", "bias"], ["y"])
+      weight = ExTorch.ones({3, 2})
+      bias = ExTorch.tensor([1.0, 2.0])
+      x = ExTorch.ones({4, 3})
+
+      bound = ExTorch.Native.bind_graph_constants(compiled, ["bias", "weight"], [bias, weight])
+      assert ExTorch.Native.compiled_graph_inputs(bound) == ["x"]
+      assert ExTorch.Native.compiled_graph_inputs(compiled) == ["weight", "x", "bias"]
+
+      [expected] = ExTorch.Native.run_compiled_graph(compiled, [weight, x, bias])
+      [output] = ExTorch.Native.run_compiled_graph(bound, [x])
+      assert ExTorch.allclose(output, expected)
+
+      assert_raise ErlangError, fn ->
+        ExTorch.Native.bind_graph_constants(bound, ["bias"], [bias])
+      end
+    end
+  end
+
   describe "to_elixir/2" do
     test "generates valid DSL source" do
       source = ExTorch.Export.to_elixir(@simple_mlp_path, "GeneratedMLP")
@@ -38,6 +38,19 @@ class ConvNet(nn.Module):
         return self.fc(x)
 
 
+class RecurrentCell(nn.Module):
+    """One step of a GRU: (x, h) -> (y, h'), for session tests."""
+
+    def __init__(self):
+        super().__init__()
+        self.cell = nn.GRUCell(8, 16)
+        self.fc = nn.Linear(16, 4)
+
+    def forward(self, x, h):
+        h = self.cell(x, h)
+        return self.fc(h), h
+
+
 def save_tensor_bin(name, tensor):
     """Save a tensor as raw contiguous float32 bytes (native endian)."""
     path = os.path.join(FIXTURES_DIR, f"{name}.bin")
@@ -61,10 +74,31 @@ def export_model(name, model, example_input):
     save_tensor_bin(f"{name}_output", reference_output)
 
 
+def export_recurrent_model(name, model, steps):
+    """Export a single recurrent step and write a reference rollout from a
+    zero state: the stacked step inputs and the stacked step outputs."""
+    path = os.path.join(FIXTURES_DIR, f"{name}.pt2")
+    model.eval()
+    xs = torch.randn(steps, 1, 8)
+    h = torch.zeros(1, 16)
+    with torch.no_grad():
+        exported = torch.export.export(model, (xs[0], h))
+        ys = []
+        for x in xs:
+            y, h = model(x, h)
+            ys.append(y)
+    torch.export.save(exported, path)
+    print(f"Saved {path}")
+
+    save_tensor_bin(f"{name}_inputs", xs)
+    save_tensor_bin(f"{name}_outputs", torch.stack(ys))
+
+
 if __name__ == "__main__":
     torch.manual_seed(42)
 
     export_model("simple_mlp_exported", SimpleMLP(), torch.randn(1, 10))
     export_model("convnet_exported", ConvNet(), torch.randn(1, 1, 8, 8))
+    export_recurrent_model("recurrent_cell_exported", RecurrentCell(), 5)
 
     print("\nAll torch.export models generated successfully.")
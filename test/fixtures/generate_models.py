@@ -3,6 +3,7 @@
 import torch
 import torch.nn as nn
 import os
+from typing import Dict, List, Tuple
 
 FIXTURES_DIR = os.path.dirname(os.path.abspath(__file__))
 
@@ -59,6 +60,30 @@ class MultiInputModel(nn.Module):
         return self.fc1(x) + self.fc2(y)
 
 
+class StructuredModel(nn.Module):
+    """A detection-style model returning nested lists, dicts and scalars."""
+
+    def forward(
+        self, x: torch.Tensor
+    ) -> Tuple[
+        List[Dict[str, torch.Tensor]],
+        List[int],
+        List[float],
+        List[bool],
+        Dict[str, float],
+        Dict[int, int],
+    ]:
+        detections = [{"boxes": x[:, :4], "scores": x[:, 4]}]
+        ids: List[int] = torch.argmax(x, dim=1).tolist()
+        scores: List[float] = x[:, 4].tolist()
+        keep: List[bool] = (x[:, 4] > 0).tolist()
+        stats: Dict[str, float] = {"max": float(x[:, 4].max()), "min": float(x[:, 4].min())}
+        counts: Dict[int, int] = {}
+        for i in ids:
+            counts[i] = counts.get(i, 0) + 1
+        return detections, ids, scores, keep, stats, counts
+
+
 def save_scripted(model, name, example_inputs):
     """Script and save a model."""
     model.eval()
@@ -74,7 +99,7 @@ def save_scripted(model, name, example_inputs):
     if isinstance(output, torch.Tensor):
         print(f"  Output shape: {output.shape}")
     elif isinstance(output, tuple):
-        print(f"  Output shapes: {[t.shape for t in output]}")
+        print(f"  Output shapes: {[getattr(t, 'shape', type(t).__name__) for t in output]}")
     elif isinstance(output, dict):
         print(f"  Output keys: {list(output.keys())}")
         print(f"  Output shapes: {[(k, v.shape) for k, v in output.items()]}")
@@ -99,4 +124,8 @@ if __name__ == "__main__":
     multi_model = MultiInputModel()
     save_scripted(multi_model, "multi_input_model", [torch.randn(1, 10), torch.randn(1, 8)])
 
+    # Structured model: single tensor input -> nested lists/dicts/scalars
+    structured_model = StructuredModel()
+    save_scripted(structured_model, "structured_model", [torch.randn(3, 6)])
+
     print("\nAll models generated successfully.")
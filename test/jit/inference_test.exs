@@ -5,8 +5,9 @@ defmodule ExTorch.JIT.InferenceTest do
 
   setup_all do
     mlp_path = Path.join(@fixtures_dir, "simple_mlp.pt")
+    structured_path = Path.join(@fixtures_dir, "structured_model.pt")
 
-    unless File.exists?(mlp_path) do
+    unless File.exists?(mlp_path) and File.exists?(structured_path) do
       {_, 0} = System.cmd("python", ["generate_models.py"], cd: @fixtures_dir)
     end
 
@@ -79,6 +80,30 @@ defmodule ExTorch.JIT.InferenceTest do
     end
   end
 
+  describe "forward/2 with structured output" do
+    test "decodes nested lists, dicts and packed scalar lists and dicts" do
+      path = Path.join(@fixtures_dir, "structured_model.pt")
+      model = ExTorch.JIT.load(path)
+
+      input =
+        ExTorch.tensor([
+          [0.0, 1.0, 2.0, 3.0, 0.5, -1.0],
+          [5.0, 1.0, 2.0, 3.0, -0.5, 0.0],
+          [0.0, 1.0, 9.0, 3.0, 0.25, 0.0]
+        ])
+
+      {[detection], ids, scores, keep, stats, counts} = ExTorch.JIT.forward(model, [input])
+
+      assert %ExTorch.Tensor{size: {3, 4}} = detection["boxes"]
+      assert %ExTorch.Tensor{size: {3}} = detection["scores"]
+      assert ids == [3, 0, 2]
+      assert scores == [0.5, -0.5, 0.25]
+      assert keep == [true, false, true]
+      assert stats == %{"max" => 0.5, "min" => -0.5}
+      assert counts == %{0 => 1, 2 => 1, 3 => 1}
+    end
+  end
+
   describe "forward/2 with multiple inputs" do
     test "passes multiple tensors to model" do
       path = Path.join(@fixtures_dir, "multi_input_model.pt")
@@ -117,4 +117,41 @@ defmodule ExTorch.JIT.LoadTest do
       assert moved.device == :cpu
     end
   end
+
+  describe "to_inplace/2" do
+    test "casts parameters without cloning the module" do
+      path = Path.join(@fixtures_dir, "simple_mlp.pt")
+      model = ExTorch.JIT.load(path)
+      ExTorch.JIT.eval(model)
+      input = ExTorch.randn({2, 10})
+      expected = ExTorch.JIT.forward(model, [input])
+
+      converted = ExTorch.JIT.to_inplace(model, dtype: :float64)
+      assert converted.resource == model.resource
+      assert Enum.all?(ExTorch.JIT.parameters(model), fn {_, t} -> t.dtype == :float64 end)
+
+      output = ExTorch.JIT.forward(converted, [ExTorch.Tensor.to(input, dtype: :float64)])
+      assert ExTorch.allclose(ExTorch.Tensor.to(output, dtype: :float32), expected)
+    end
+  end
+
+  describe "to_streaming/2" do
+    test "converts one tensor at a time" do
+      path = Path.join(@fixtures_dir, "simple_mlp.pt")
+      model = ExTorch.JIT.load(path)
+      test_pid = self()
+
+      converted =
+        ExTorch.JIT.to_streaming(model,
+          device: :cpu,
+          dtype: :float64,
+          on_tensor: fn name, index, total -> send(test_pid, {:converted, name, index, total}) end
+        )
+
+      assert converted.device == :cpu
+      assert_received {:converted, "fc1.weight", 1, 4}
+      assert_received {:converted, "fc2.bias", 4, 4}
+      assert Enum.all?(ExTorch.JIT.parameters(model), fn {_, t} -> t.dtype == :float64 end)
+    end
+  end
 end
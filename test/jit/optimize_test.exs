@@ -0,0 +1,79 @@
+defmodule ExTorch.JIT.OptimizeTest do
+  # Executor options are process-wide, so these tests must not run
+  # concurrently with each other.
+  use ExUnit.Case, async: false
+
+  @fixtures_dir Path.join([__DIR__, "..", "fixtures"])
+
+  setup_all do
+    mlp_path = Path.join(@fixtures_dir, "simple_mlp.pt")
+
+    unless File.exists?(mlp_path) do
+      {_, 0} = System.cmd("python", ["generate_models.py"], cd: @fixtures_dir)
+    end
+
+    :ok
+  end
+
+  describe "freeze/2" do
+    test "produces the same outputs as the eval-mode model" do
+      path = Path.join(@fixtures_dir, "simple_mlp.pt")
+      model = ExTorch.JIT.load(path)
+      ExTorch.JIT.eval(model)
+      frozen = ExTorch.JIT.freeze(model)
+
+      input = ExTorch.randn({4, 10})
+
+      assert ExTorch.allclose(
+               ExTorch.JIT.forward(frozen, [input]),
+               ExTorch.JIT.forward(model, [input])
+             )
+
+      # Parameters are inlined as constants; the original keeps them.
+      assert ExTorch.JIT.parameters(frozen) == []
+      assert ExTorch.JIT.parameters(model) != []
+    end
+
+    test "load/2 with optimize_for_inference and warmup" do
+      path = Path.join(@fixtures_dir, "simple_mlp.pt")
+      reference = ExTorch.JIT.load(path)
+      ExTorch.JIT.eval(reference)
+
+      input = ExTorch.randn({2, 10})
+      model = ExTorch.JIT.load(path, optimize_for_inference: true, warmup: [input])
+
+      assert ExTorch.allclose(
+               ExTorch.JIT.forward(model, [input]),
+               ExTorch.JIT.forward(reference, [input]),
+               1.0e-5,
+               1.0e-6
+             )
+    end
+  end
+
+  describe "set_executor_options/1" do
+    test "updates only the given keys and can be restored" do
+      original = ExTorch.JIT.executor_options()
+
+      try do
+        updated =
+          ExTorch.JIT.set_executor_options(num_profiled_runs: 1, fusion_strategy: [static: 3])
+
+        assert updated.num_profiled_runs == 1
+        assert updated.fusion_strategy == [static: 3]
+        assert updated.profiling_executor == original.profiling_executor
+        assert updated.cpu_fusion == original.cpu_fusion
+      after
+        ExTorch.JIT.set_executor_options(Map.to_list(original))
+      end
+
+      assert ExTorch.JIT.executor_options() == original
+    end
+
+    test "rejects unknown fusion behaviors" do
+      assert_raise ErlangError, fn ->
+        ExTorch.JIT.set_executor_options(fusion_strategy: [eager: 2])
+      end
+    end
+  end
+end
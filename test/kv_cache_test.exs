@@ -0,0 +1,173 @@
+defmodule ExTorchTest.KVCacheTest do
+  use ExUnit.Case, async: true
+
+  alias ExTorch.KVCache
+
+  @heads 2
+  @head_dim 8
+
+  defp new_cache(opts \\ []) do
+    KVCache.new(
+      Keyword.merge(
+        [num_layers: 2, num_heads: @heads, head_dim: @head_dim, block_size: 4, num_blocks: 8],
+        opts
+      )
+    )
+  end
+
+  defp tokens(n), do: ExTorch.randn({1, @heads, n, @head_dim})
+
+  defp sdpa(q, k, v, causal) do
+    ExTorch.Native.aten_scaled_dot_product_attention(q, k, v, 0.0, causal, 0.0, false)
+  end
+
+  test "gathers what was appended across block boundaries" do
+    cache = new_cache()
+    seq = KVCache.add_sequence(cache)
+
+    {k1, v1} = {tokens(3), tokens(3)}
+    {k2, v2} = {tokens(6), tokens(6)}
+    :ok = KVCache.append(cache, seq, 0, k1, v1)
+    :ok = KVCache.append(cache, seq, 0, k2, v2)
+
+    assert KVCache.length(cache, seq, 0) == 9
+    assert KVCache.length(cache, seq, 1) == 0
+
+    {keys, values} = KVCache.keys_values(cache, seq, 0)
+    assert keys.size == {1, @heads, 9, @head_dim}
+    assert ExTorch.allclose(keys, ExTorch.cat([k1, k2], 2))
+    assert ExTorch.allclose(values, ExTorch.cat([v1, v2], 2))
+  end
+
+  test "attends over the cached tokens" do
+    cache = new_cache()
+    seq = KVCache.add_sequence(cache)
+
+    # Prefill: the prompt tokens attend causally to each other.
+    {q, k, v} = {tokens(5), tokens(5), tokens(5)}
+    output = KVCache.attention(cache, seq, 1, q, k, v)
+    assert ExTorch.allclose(output, sdpa(q, k, v, true), 1.0e-5, 1.0e-6)
+
+    # Decode: the new token attends to the whole history.
+    {q1, k1, v1} = {tokens(1), tokens(1), tokens(1)}
+    output = KVCache.attention(cache, seq, 1, q1, k1, v1)
+    expected = sdpa(q1, ExTorch.cat([k, k1], 2), ExTorch.cat([v, v1], 2), false)
+    assert ExTorch.allclose(output, expected, 1.0e-5, 1.0e-6)
+    assert KVCache.length(cache, seq, 1) == 6
+  end
+
+  test "attends over blocks that are not adjacent in the pool" do
+    cache = new_cache()
+    a = KVCache.add_sequence(cache)
+    b = KVCache.add_sequence(cache)
+
+    # Growing both sequences in turns interleaves their blocks.
+    steps =
+      for _ <- 1..3 do
+        {k, v} = {tokens(4), tokens(4)}
+        :ok = KVCache.append(cache, a, 0, k, v)
+        :ok = KVCache.append(cache, b, 0, tokens(4), tokens(4))
+        {k, v}
+      end
+
+    {ks, vs} = Enum.unzip(steps)
+    {q, k1, v1} = {tokens(1), tokens(1), tokens(1)}
+    output = KVCache.attention(cache, a, 0, q, k1, v1)
+
+    expected = sdpa(q, ExTorch.cat(ks ++ [k1], 2), ExTorch.cat(vs ++ [v1], 2), false)
+    assert ExTorch.allclose(output, expected, 1.0e-5, 1.0e-6)
+  end
+
+  test "leaves the sequence unchanged when the query does not match" do
+    cache = new_cache()
+    seq = KVCache.add_sequence(cache)
+
+    assert_raise ErlangError, fn ->
+      KVCache.attention(cache, seq, 0, tokens(2), tokens(3), tokens(3))
+    end
+
+    assert_raise ErlangError, fn ->
+      KVCache.attention(cache, seq, 0, tokens(3), tokens(3), tokens(2))
+    end
+
+    assert KVCache.length(cache, seq, 0) == 0
+  end
+
+  test "attends through the extorch::kv_cache_attention operator" do
+    reference = new_cache()
+    cache = new_cache()
+    ref_seq = KVCache.add_sequence(reference)
+    seq = KVCache.add_sequence(cache)
+
+    for n <- [4, 1, 1] do
+      {q, k, v} = {tokens(n), tokens(n), tokens(n)}
+      expected = KVCache.attention(reference, ref_seq, 0, q, k, v)
+
+      output =
+        ExTorch.Native.dispatch_op("extorch::kv_cache_attention", "", [
+          {:tensor, q},
+          {:tensor, k},
+          {:tensor, v},
+          {:int, cache.id},
+          {:tensor, ExTorch.tensor(seq, dtype: :int64)},
+          {:int, 0},
+          nil
+        ])
+
+      assert ExTorch.allclose(output, expected, 1.0e-5, 1.0e-6)
+    end
+
+    assert KVCache.length(cache, seq, 0) == 6
+  end
+
+  test "freeing a sequence returns its blocks" do
+    cache = new_cache()
+    a = KVCache.add_sequence(cache)
+    b = KVCache.add_sequence(cache)
+    :ok = KVCache.append(cache, a, 0, tokens(5), tokens(5))
+    :ok = KVCache.append(cache, b, 0, tokens(4), tokens(4))
+
+    assert %{used_blocks: 3, free_blocks: 5, sequences: 2, tokens: 9} = KVCache.stats(cache)
+
+    :ok = KVCache.free_sequence(cache, a)
+    assert %{used_blocks: 1, peak_used_blocks: 3, sequences: 1} = KVCache.stats(cache)
+    assert_raise ErlangError, fn -> KVCache.length(cache, a, 0) end
+  end
+
+  test "raises when the pool runs out of blocks" do
+    cache = new_cache(num_blocks: 2)
+    seq = KVCache.add_sequence(cache)
+    :ok = KVCache.append(cache, seq, 0, tokens(6), tokens(6))
+
+    assert_raise ErlangError, fn -> KVCache.append(cache, seq, 0, tokens(3), tokens(3)) end
+    assert KVCache.length(cache, seq, 0) == 6
+  end
+
+  test "registers caches under unique ids" do
+    cache = new_cache()
+    assert_raise ErlangError, fn -> new_cache(id: cache.id) end
+    assert new_cache().id != cache.id
+  end
+
+  test "emits telemetry events" do
+    cache = new_cache()
+    pid = self()
+    handler_id = "kv-cache-test-#{inspect(make_ref())}"
+
+    :telemetry.attach(
+      handler_id,
+      [:extorch, :kv_cache, :pool],
+      fn event, measurements, metadata, _ -> send(pid, {event, measurements, metadata}) end,
+      nil
+    )
+
+    on_exit(fn -> :telemetry.detach(handler_id) end)
+
+    :ok = KVCache.emit_telemetry(decoder: cache)
+
+    pool_bytes = 2 * 2 * 8 * 4 * @heads * @head_dim * 4
+
+    assert_receive {[:extorch, :kv_cache, :pool], %{free_blocks: 8, pool_bytes: ^pool_bytes},
+                    %{cache: :decoder}}
+  end
+end
@@ -0,0 +1,120 @@
+defmodule ExTorchTest.LoadTestTest do
+  use ExUnit.Case, async: true
+
+  alias ExTorch.LoadTest
+
+  @fixtures_dir Path.join([__DIR__, "fixtures"])
+
+  # A target that serves one request at a time, each taking `ms`.
+  defp serial_target(ms) do
+    {:ok, agent} = Agent.start_link(fn -> 0 end)
+
+    target = fn _inputs ->
+      Agent.get_and_update(agent, fn calls ->
+        Process.sleep(ms)
+        {calls, calls + 1}
+      end)
+    end
+
+    {agent, target}
+  end
+
+  test "sends requests at the target rate" do
+    report = LoadTest.run(fn _inputs -> :ok end, [], rate: 500, duration: 400, generators: 2)
+
+    assert report.sent in 120..280
+    assert report.completed == report.sent
+    assert report.errors == 0 and report.timeouts == 0
+    assert report.latency_ms.p50 <= report.latency_ms.p99
+    assert report.latency_ms.p99 <= report.latency_ms.max
+  end
+
+  test "measures latency from the intended send time" do
+    # 200 req/s offered to a server that completes 100 req/s: a closed-loop
+    # caller would see 10 ms per request, the queue grows by ~50 requests.
+    {_agent, target} = serial_target(10)
+
+    report =
+      LoadTest.run(target, [], rate: 200, duration: 500, arrivals: :uniform, generators: 4)
+
+    assert report.sent in 95..105
+    assert report.latency_ms.min >= 10.0
+    assert report.latency_ms.p99 > 100.0
+    assert report.throughput < 150
+  end
+
+  test "does not record the warmup period" do
+    {agent, target} = serial_target(0)
+
+    report =
+      LoadTest.run(target, [], rate: 200, duration: 200, warmup: 200, arrivals: :uniform)
+
+    assert report.sent in 36..44
+    assert Agent.get(agent, & &1) in 76..84
+  end
+
+  test "waits for slow requests before reporting" do
+    slow = fn _inputs -> Process.sleep(1_200) end
+
+    for timeout <- [5_000, :infinity] do
+      report =
+        LoadTest.run(slow, [], rate: 20, duration: 100, arrivals: :uniform, timeout: timeout)
+
+      assert report.completed == report.sent
+      assert report.in_flight == 0
+      assert report.latency_ms.min >= 1_200.0
+    end
+  end
+
+  test "counts errors and timeouts" do
+    report = LoadTest.run(fn _inputs -> raise "boom" end, [], rate: 100, duration: 200)
+    assert report.errors == report.sent
+    assert report.completed == 0
+    assert report.latency_ms.p99 == nil
+
+    {:ok, pid} = ExTorch.JIT.Server.start_link(path: Path.join(@fixtures_dir, "simple_mlp.pt"))
+    :sys.suspend(pid)
+
+    report =
+      LoadTest.run({ExTorch.JIT.Server, pid}, [ExTorch.randn({1, 10})],
+        rate: 50,
+        duration: 100,
+        timeout: 50
+      )
+
+    assert report.timeouts == report.sent
+    :sys.resume(pid)
+  end
+
+  test "spreads requests over a pool" do
+    {a, target_a} = serial_target(0)
+    {b, target_b} = serial_target(0)
+
+    report = LoadTest.run([target_a, target_b], [], rate: 200, duration: 200, arrivals: :uniform)
+
+    calls_a = Agent.get(a, & &1)
+    calls_b = Agent.get(b, & &1)
+    assert calls_a + calls_b == report.sent
+    assert abs(calls_a - calls_b) <= 1
+  end
+
+  test "drives a model server and writes a JSON report" do
+    {:ok, pid} = ExTorch.JIT.Server.start_link(path: Path.join(@fixtures_dir, "simple_mlp.pt"))
+    path = Path.join(System.tmp_dir!(), "extorch_load_#{System.unique_integer([:positive])}.json")
+    on_exit(fn -> File.rm(path) end)
+
+    report =
+      LoadTest.run({ExTorch.JIT.Server, pid}, [ExTorch.randn({1, 10})],
+        rate: 100,
+        duration: 300,
+        output: path
+      )
+
+    assert report.completed == report.sent
+    assert report.completed > 0
+
+    decoded = path |> File.read!() |> Jason.decode!()
+    assert decoded["completed"] == report.completed
+    assert decoded["latency_ms"]["p99"] == report.latency_ms.p99
+  end
+end
@@ -0,0 +1,92 @@
+defmodule ExTorchTest.MemoryTest do
+  # Tracking swaps the process-wide CPU allocator.
+  use ExUnit.Case, async: false
+
+  alias ExTorch.Memory
+
+  @fixtures_dir Path.join([__DIR__, "fixtures"])
+  @mlp_path Path.join(@fixtures_dir, "simple_mlp.pt")
+  @exported_mlp_path Path.join(@fixtures_dir, "simple_mlp_exported.pt2")
+
+  # fc1 (10 -> 20) and fc2 (20 -> 5) weights and biases, in float32.
+  @mlp_weight_bytes (10 * 20 + 20 + 20 * 5 + 5) * 4
+
+  setup_all do
+    unless File.exists?(@mlp_path) do
+      {_, 0} = System.cmd("python", ["generate_models.py"], cd: @fixtures_dir)
+    end
+
+    :ok
+  end
+
+  setup do
+    Memory.enable_cpu_tracking()
+    on_exit(fn -> Memory.disable_cpu_tracking() end)
+  end
+
+  test "counts live and peak CPU bytes" do
+    assert %{enabled: true} = Memory.cpu_stats()
+    Memory.reset_cpu_peak()
+    before = Memory.cpu_stats()
+
+    tensor = ExTorch.empty({1024, 1024}, dtype: :float32)
+    during = Memory.cpu_stats()
+    assert during.live_bytes - before.live_bytes >= 4 * 1024 * 1024
+    assert during.allocations > before.allocations
+    assert during.peak_bytes >= during.live_bytes
+
+    assert tensor.size == {1024, 1024}
+  end
+
+  test "accounts forward passes to the model" do
+    model = ExTorch.JIT.load(@mlp_path)
+    ExTorch.JIT.eval(model)
+
+    stats = Memory.model_stats(model)
+    assert stats.weight_bytes == @mlp_weight_bytes
+    assert stats.requests == 0
+
+    output = ExTorch.JIT.forward(model, [ExTorch.randn({64, 10})])
+    stats = Memory.model_stats(model)
+
+    assert stats.requests == 1
+    assert stats.allocations > 0
+    # The output (64 x 5 floats) outlives the request.
+    assert stats.live_bytes >= 64 * 5 * 4
+    assert stats.last_request_peak_bytes >= 64 * 20 * 4
+    assert stats.max_request_peak_bytes == stats.last_request_peak_bytes
+    assert stats.peak_bytes >= stats.live_bytes
+    assert output.size == {64, 5}
+  end
+
+  test "counts the allocations of each profiled op" do
+    model = ExTorch.Export.load(@exported_mlp_path)
+
+    :ok = ExTorch.Export.start_profiling(model)
+    ExTorch.Export.forward_compiled(model, [ExTorch.randn({64, 10})])
+    :ok = ExTorch.Export.stop_profiling(model)
+
+    stats = ExTorch.Export.profile_stats(model)
+    assert Enum.any?(stats.nodes, &(&1.allocated_bytes >= 64 * 20 * 4))
+  end
+
+  test "emits telemetry events" do
+    model = ExTorch.JIT.load(@mlp_path)
+    pid = self()
+    handler_id = "memory-test-#{inspect(make_ref())}"
+
+    :telemetry.attach_many(
+      handler_id,
+      [[:extorch, :memory, :cpu], [:extorch, :memory, :model]],
+      fn event, measurements, metadata, _ -> send(pid, {event, measurements, metadata}) end,
+      nil
+    )
+
+    on_exit(fn -> :telemetry.detach(handler_id) end)
+
+    :ok = Memory.emit_telemetry(mlp: model)
+
+    assert_receive {[:extorch, :memory, :cpu], %{live_bytes: _, peak_bytes: _}, %{}}
+    assert_receive {[:extorch, :memory, :model], %{weight_bytes: @mlp_weight_bytes}, %{model: :mlp}}
+  end
+end
@@ -13,6 +13,14 @@ defmodule ExTorchTest.MetricsTest do
     :ok
   end
 
+  defp forward_stop(backend, path, microseconds) do
+    :telemetry.execute(
+      [:extorch, backend, :forward, :stop],
+      %{duration: System.convert_time_unit(microseconds, :microsecond, :native)},
+      %{path: path}
+    )
+  end
+
   setup do
     ExTorch.Metrics.setup()
     ExTorch.Metrics.reset_all()
@@ -88,6 +96,61 @@ defmodule ExTorchTest.MetricsTest do
     end
   end
 
+  describe "latency histograms" do
+    test "reports percentiles within the bucket precision" do
+      path = "histogram_model.pt2"
+      for us <- 1..1_000, do: forward_stop(:export, path, us * 100)
+
+      metrics = ExTorch.Metrics.get(path)
+      assert metrics.inference_count == 1_000
+      assert metrics.min_duration_ms == 0.1
+      assert metrics.max_duration_ms == 100.0
+
+      for {quantile, exact} <- [{0.5, 50.0}, {0.95, 95.0}, {0.99, 99.0}, {0.999, 99.9}] do
+        value = ExTorch.Metrics.percentile(path, quantile)
+        assert value >= exact and value <= exact * 1.04
+      end
+
+      assert metrics.p99_duration_ms == ExTorch.Metrics.percentile(path, 0.99)
+      assert Enum.sum(Enum.map(ExTorch.Metrics.histogram(path), &elem(&1, 1))) == 1_000
+    end
+
+    test "tracks every serving backend" do
+      for backend <- [:jit, :aoti, :export] do
+        path = "#{backend}_model"
+
+        :telemetry.execute([:extorch, backend, :load, :stop], %{duration: 1_000}, %{path: path})
+        forward_stop(backend, path, 250)
+        :telemetry.execute([:extorch, backend, :forward, :exception], %{}, %{path: path})
+
+        metrics = ExTorch.Metrics.get(path)
+        assert metrics.backend == backend
+        assert metrics.inference_count == 1
+        assert metrics.error_count == 1
+        assert metrics.p50_duration_ms == 0.25
+      end
+    end
+
+    test "counts concurrent events without losing updates" do
+      path = "concurrent_model"
+
+      1..16
+      |> Enum.map(fn _ -> Task.async(fn -> for _ <- 1..500, do: forward_stop(:jit, path, 10) end) end)
+      |> Enum.each(&Task.await/1)
+
+      assert ExTorch.Metrics.get(path).inference_count == 8_000
+    end
+
+    test "has no percentiles before the first inference" do
+      :telemetry.execute([:extorch, :aoti, :load, :stop], %{duration: 1_000}, %{path: "idle"})
+
+      metrics = ExTorch.Metrics.get("idle")
+      assert metrics.p50_duration_ms == nil
+      assert metrics.min_duration_ms == :infinity
+      assert ExTorch.Metrics.percentile("idle", 0.99) == nil
+    end
+  end
+
   describe "CUDA monitoring" do
     test "cuda_is_available returns boolean" do
       result = ExTorch.Native.cuda_is_available()
@@ -29,6 +29,54 @@ defmodule ExTorchTest.NN.ModuleDSLTest do
     end
   end
 
+  defmodule Encoder do
+    use ExTorch.NN.Module
+
+    deflayer :lstm, ExTorch.NN.LSTM, input_size: 4, hidden_size: 8, batch_first: true
+    deflayer :attention, ExTorch.NN.MultiheadAttention, embed_dim: 8, num_heads: 2
+    deflayer :head, ExTorch.NN.Linear, in_features: 8, out_features: 3
+
+    def forward(model, x) do
+      {seq, {h_n, _c_n}} = layer(x, model, :lstm)
+      {attn, _weights} = layer({seq, seq, seq}, model, :attention)
+      {layer(attn, model, :head), h_n}
+    end
+  end
+
+  defmodule Residual do
+    use ExTorch.NN.Module
+
+    deflayer :fc, ExTorch.NN.Linear, in_features: 6, out_features: 6
+
+    def forward(model, x) do
+      ExTorch.add(x, layer(x, model, :fc))
+    end
+  end
+
+  defmodule Throwing do
+    use ExTorch.NN.Module
+
+    deflayer :fc, ExTorch.NN.Linear, in_features: 6, out_features: 6
+
+    def forward(model, x) do
+      case x do
+        %ExTorch.Tensor{} -> layer(x, model, :fc)
+        _ -> throw(:untraceable)
+      end
+    end
+  end
+
+  defmodule Stacked do
+    use ExTorch.NN.Module
+
+    deflayer :mlp, ExTorchTest.NN.ModuleDSLTest.SimpleMLP
+    deflayer :out, ExTorch.NN.Sigmoid
+
+    def forward(model, x) do
+      x |> layer(model, :mlp) |> layer(model, :out)
+    end
+  end
+
   describe "__layers__/0" do
     test "returns layer specifications" do
       layers = SimpleMLP.__layers__()
@@ -129,4 +177,63 @@ defmodule ExTorchTest.NN.ModuleDSLTest do
       assert output.size == {1, 8, 6, 6}
     end
   end
+
+  describe "compile/2" do
+    test "runs a sequential model natively" do
+      model = SimpleMLP.new()
+      pipeline = SimpleMLP.compile(model)
+      assert ExTorch.NN.Pipeline.native?(pipeline)
+      assert pipeline.native.num_steps == 3
+
+      input = ExTorch.randn({4, 10})
+      expected = SimpleMLP.forward(model, input)
+      assert ExTorch.allclose(ExTorch.NN.Pipeline.run(pipeline, input), expected)
+      assert ExTorch.allclose(SimpleMLP.predict(pipeline, [input]), expected)
+    end
+
+    test "flattens nested modules into one pipeline" do
+      model = Stacked.new()
+      pipeline = Stacked.compile(model)
+      assert pipeline.native.num_steps == 4
+
+      input = ExTorch.randn({2, 10})
+      assert ExTorch.allclose(ExTorch.NN.Pipeline.run(pipeline, input), Stacked.forward(model, input))
+    end
+
+    test "handles tuple inputs and outputs of recurrent and attention layers" do
+      model = Encoder.new()
+      pipeline = Encoder.compile(model, strict: true)
+
+      input = ExTorch.randn({2, 5, 4})
+      {expected_out, expected_h} = Encoder.forward(model, input)
+      {out, h_n} = ExTorch.NN.Pipeline.run(pipeline, input)
+
+      assert out.size == {2, 5, 3}
+      assert h_n.size == {1, 2, 8}
+      assert ExTorch.allclose(out, expected_out, 1.0e-5, 1.0e-6)
+      assert ExTorch.allclose(h_n, expected_h)
+    end
+
+    test "falls back to per-layer forward when forward/2 cannot be traced" do
+      model = Residual.new()
+      pipeline = Residual.compile(model)
+      refute ExTorch.NN.Pipeline.native?(pipeline)
+      assert is_binary(pipeline.fallback_reason)
+
+      input = ExTorch.randn({3, 6})
+      assert ExTorch.allclose(ExTorch.NN.Pipeline.run(pipeline, input), Residual.forward(model, input))
+
+      assert_raise ArgumentError, fn -> Residual.compile(model, strict: true) end
+    end
+
+    test "falls back when tracing forward/2 throws" do
+      model = Throwing.new()
+      pipeline = Throwing.compile(model)
+      refute ExTorch.NN.Pipeline.native?(pipeline)
+      assert pipeline.fallback_reason =~ ":untraceable"
+
+      input = ExTorch.randn({3, 6})
+      assert ExTorch.allclose(ExTorch.NN.Pipeline.run(pipeline, input), Throwing.forward(model, input))
+    end
+  end
 end
@@ -0,0 +1,140 @@
+defmodule ExTorchTest.NN.WeightsTest do
+  use ExUnit.Case, async: true
+
+  alias ExTorch.NN.Weights
+
+  @fixtures_dir Path.join([__DIR__, "..", "fixtures"])
+  @simple_mlp_path Path.join(@fixtures_dir, "simple_mlp_exported.pt2")
+
+  defmodule TinyMLP do
+    use ExTorch.NN.Module
+
+    deflayer :fc1, ExTorch.NN.Linear, in_features: 2, out_features: 3
+    deflayer :fc2, ExTorch.NN.Linear, in_features: 3, out_features: 1
+
+    def forward(model, x) do
+      x |> layer(model, :fc1) |> layer(model, :fc2)
+    end
+  end
+
+  defp tmp_dir do
+    dir = Path.join(System.tmp_dir!(), "extorch_weights_#{System.unique_integer([:positive])}")
+    File.mkdir_p!(dir)
+    on_exit(fn -> File.rm_rf(dir) end)
+    dir
+  end
+
+  # Write float32 tensors, given as {name, shape, values}, to a safetensors file.
+  defp write_safetensors(path, tensors) do
+    {header, blobs, _offset} =
+      Enum.reduce(tensors, {%{}, [], 0}, fn {name, shape, values}, {header, blobs, offset} ->
+        blob = for v <- values, into: <<>>, do: <<v * 1.0::float-little-32>>
+        meta = %{"dtype" => "F32", "shape" => shape, "data_offsets" => [offset, offset + byte_size(blob)]}
+        {Map.put(header, name, meta), [blobs, blob], offset + byte_size(blob)}
+      end)
+
+    json = Jason.encode!(Map.put(header, "__metadata__", %{"format" => "pt"}))
+    File.write!(path, [<<byte_size(json)::little-64>>, json, blobs])
+  end
+
+  defp tiny_checkpoint(dir) do
+    path = Path.join(dir, "tiny.safetensors")
+
+    write_safetensors(path, [
+      {"fc1.weight", [3, 2], [1, 2, 3, 4, 5, 6]},
+      {"fc1.bias", [3], [0.5, -0.5, 1]},
+      {"fc2.weight", [1, 3], [1, 1, 1]},
+      {"fc2.bias", [1], [-2]},
+      {"unused.weight", [2], [9, 9]}
+    ])
+
+    path
+  end
+
+  describe "entries/1 and stream/1" do
+    test "read safetensors metadata and tensors" do
+      path = tiny_checkpoint(tmp_dir())
+
+      names = path |> Weights.entries() |> Enum.map(& &1.name)
+      assert names == ["fc1.weight", "fc1.bias", "fc2.weight", "fc2.bias", "unused.weight"]
+
+      tensors = path |> Weights.stream() |> Map.new()
+      assert tensors["fc1.weight"].size == {3, 2}
+      assert ExTorch.allclose(tensors["fc1.bias"], ExTorch.tensor([0.5, -0.5, 1.0]))
+    end
+
+    test "stream a .pt2 archive" do
+      weights = @simple_mlp_path |> Weights.stream() |> Map.new()
+      assert map_size(weights) == 4
+      assert weights["fc1.weight"].size == {20, 10}
+      assert weights["fc2.bias"].size == {5}
+    end
+  end
+
+  describe "bind/2" do
+    test "binds weights to the matching layers" do
+      path = tiny_checkpoint(tmp_dir())
+      model = TinyMLP.new() |> Weights.bind(path)
+
+      params = Map.new(TinyMLP.parameters(model))
+      assert ExTorch.allclose(params["fc1.weight"], ExTorch.tensor([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]]))
+      assert ExTorch.allclose(params["fc2.bias"], ExTorch.tensor([-2.0]))
+
+      # fc1(1, 1) = [3.5, 6.5, 12.0]; fc2 sums it and subtracts 2
+      output = TinyMLP.forward(model, ExTorch.tensor([[1.0, 1.0]]))
+      assert ExTorch.allclose(output, ExTorch.tensor([[20.0]]))
+    end
+
+    test "load_weights_from_safetensors/2 builds and binds a model" do
+      path = tiny_checkpoint(tmp_dir())
+      model = TinyMLP.load_weights_from_safetensors(path)
+
+      output = TinyMLP.forward(model, ExTorch.tensor([[1.0, 1.0]]))
+      assert ExTorch.allclose(output, ExTorch.tensor([[20.0]]))
+    end
+  end
+
+  describe "ExTorch.NN.bind_parameters/2" do
+    test "replaces parameters with the given tensors" do
+      layer = ExTorch.NN.linear(2, 2)
+      weight = ExTorch.ones({2, 2})
+      :ok = ExTorch.NN.bind_parameters(layer, [{"weight", weight}, {"missing", weight}])
+
+      params = Map.new(ExTorch.NN.parameters(layer))
+      assert ExTorch.allclose(params["weight"], weight)
+    end
+
+    test "shares storage with the given tensors" do
+      layer = ExTorch.NN.linear(2, 2)
+      weight = ExTorch.ones({2, 2})
+      bias = ExTorch.zeros({2})
+      :ok = ExTorch.NN.bind_parameters(layer, [{"weight", weight}, {"bias", bias}])
+
+      params = Map.new(ExTorch.NN.parameters(layer))
+      assert ExTorch.Native.data_ptr(params["weight"]) == ExTorch.Native.data_ptr(weight)
+      assert ExTorch.Native.data_ptr(params["bias"]) == ExTorch.Native.data_ptr(bias)
+    end
+
+    test "raises on a shape mismatch" do
+      layer = ExTorch.NN.linear(2, 2)
+
+      assert_raise ErlangError, fn ->
+        ExTorch.NN.bind_parameters(layer, [{"weight", ExTorch.ones({3, 2})}])
+      end
+    end
+
+    test "binds nothing when a later shape does not match" do
+      layer = ExTorch.NN.linear(2, 2)
+      before = Map.new(ExTorch.NN.parameters(layer))
+      weight = ExTorch.zeros({2, 2})
+
+      assert_raise ErlangError, fn ->
+        ExTorch.NN.bind_parameters(layer, [{"weight", weight}, {"bias", ExTorch.ones({3})}])
+      end
+
+      params = Map.new(ExTorch.NN.parameters(layer))
+      assert ExTorch.Native.data_ptr(params["weight"]) == ExTorch.Native.data_ptr(before["weight"])
+      refute ExTorch.Native.data_ptr(params["weight"]) == ExTorch.Native.data_ptr(weight)
+    end
+  end
+end
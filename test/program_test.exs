@@ -0,0 +1,77 @@
+defmodule ExTorchTest.ProgramTest do
+  use ExUnit.Case, async: true
+
+  alias ExTorch.Program
+
+  defp preprocess do
+    Program.new([:image, :mean])
+    |> Program.op(:x, "aten::permute", [:image, [2, 0, 1]])
+    |> Program.op(:x, "aten::sub.Tensor", [:x, :mean])
+    |> Program.op(:x, "aten::mul.Scalar", [:x, 0.5])
+    |> Program.op(:batch, "aten::unsqueeze", [:x, 0])
+  end
+
+  defp expected(image, mean) do
+    image
+    |> ExTorch.permute({2, 0, 1})
+    |> ExTorch.sub(mean)
+    |> ExTorch.mul(ExTorch.tensor(0.5))
+    |> ExTorch.unsqueeze(0)
+  end
+
+  describe "run/2" do
+    test "interprets the instruction stream without compiling" do
+      image = ExTorch.randn({4, 5, 3})
+      mean = ExTorch.randn({3, 1, 1})
+
+      result = Program.run(preprocess(), [image, mean])
+
+      assert result.size == {1, 3, 4, 5}
+      assert ExTorch.allclose(result, expected(image, mean))
+    end
+
+    test "runs a compiled program, reusing value names" do
+      image = ExTorch.randn({4, 5, 3})
+      mean = ExTorch.randn({3, 1, 1})
+      program = Program.compile(preprocess())
+
+      assert program.compiled != nil
+      assert ExTorch.allclose(Program.run(program, [image, mean]), expected(image, mean))
+
+      # The compiled program is reusable across calls.
+      other = ExTorch.randn({4, 5, 3})
+      assert ExTorch.allclose(Program.run(program, [other, mean]), expected(other, mean))
+    end
+
+    test "embeds constant tensors and keyword arguments" do
+      offset = ExTorch.tensor([1.0, 2.0])
+
+      program =
+        Program.new([:x])
+        |> Program.op(:y, "aten::add.Tensor", [:x, offset], alpha: 2)
+        |> Program.op(:s, "aten::sum.dim_IntList", [:y, [0]], keepdim: true)
+        |> Program.output([:y, :s])
+        |> Program.compile()
+
+      [y, s] = Program.run(program, [ExTorch.tensor([[0.0, 0.0], [1.0, 1.0]])])
+
+      assert ExTorch.allclose(y, ExTorch.tensor([[2.0, 4.0], [3.0, 5.0]]))
+      assert ExTorch.allclose(s, ExTorch.tensor([[5.0, 9.0]]))
+    end
+
+    test "casts with {:dtype, dtype} arguments" do
+      program =
+        Program.new([:x])
+        |> Program.op(:y, "aten::to.dtype", [:x, {:dtype, :float64}])
+
+      result = Program.run(program, [ExTorch.tensor([1, 2, 3])])
+      assert result.dtype == :double
+    end
+
+    test "raises on input count mismatch" do
+      assert_raise ArgumentError, ~r/expects 2 inputs/, fn ->
+        Program.run(preprocess(), [ExTorch.randn({2, 2, 3})])
+      end
+    end
+  end
+end
@@ -446,6 +446,36 @@ defmodule ExTorchTest.Tensor.CreationTest do
     assert ExTorch.Tensor.to_list(tensor) == expected_tensor
   end
 
+  test "tensor/1 with tuples and an explicit dtype" do
+    tensor = ExTorch.tensor({{1, 2.5}, {3, 4}}, dtype: :int64)
+    assert tensor.size == {2, 2}
+    assert tensor.dtype == :long
+    assert ExTorch.Tensor.to_list(tensor) == [[1, 2], [3, 4]]
+
+    tensor = ExTorch.tensor([[1, 0], [0, 1]], dtype: :half)
+    assert tensor.dtype == :half
+    assert ExTorch.Tensor.to_list(tensor) == [[1.0, 0.0], [0.0, 1.0]]
+
+    tensor = ExTorch.tensor([0, 2, 0.5], dtype: :bool)
+    assert ExTorch.Tensor.to_list(tensor) == [false, true, true]
+  end
+
+  test "tensor/1 with a large list" do
+    values = Enum.map(0..99_999, &(&1 / 4))
+    tensor = ExTorch.tensor(Enum.chunk_every(values, 100))
+    assert tensor.size == {1_000, 100}
+    assert tensor.dtype == :float
+    assert tensor |> ExTorch.Tensor.to_list() |> List.flatten() == values
+  end
+
+  test "tensor/1 with mismatched sizes" do
+    assert_raise ErlangError, fn -> ExTorch.tensor([[1, 2], [3]]) end
+    assert_raise ErlangError, fn -> ExTorch.tensor([[1, 2], 3]) end
+    assert_raise ErlangError, fn -> ExTorch.tensor([[1, 2], [3]], dtype: :int64) end
+    assert_raise ErlangError, fn -> ExTorch.tensor([[1], [2, 3]], dtype: :float32) end
+    assert_raise ErlangError, fn -> ExTorch.tensor([ExTorch.Complex.complex(1, 1)], dtype: :float32) end
+  end
+
   test "empty_like/1" do
     base = ExTorch.rand({4, 5, 6}, dtype: :complex128)
     deriv = ExTorch.empty_like(base)
@@ -56,6 +56,21 @@ defmodule ExTorchTest.Tensor.InfoTest do
     assert ExTorch.Tensor.repr(tensor) == "[ true, false]"
   end
 
+  test "repr/1 formats only the summarized edge items" do
+    tensor = ExTorch.arange(1_000_000, dtype: :int64)
+    assert ExTorch.Tensor.repr(tensor) == "[     0,      1,      2, ..., 999997, 999998, 999999]"
+
+    tensor =
+      2_000
+      |> ExTorch.arange(dtype: :int64)
+      |> ExTorch.reshape({2, 1_000})
+      |> ExTorch.transpose(0, 1)
+
+    assert ExTorch.Tensor.repr(tensor) ==
+             "[[   0, 1000],\n [   1, 1001],\n [   2, 1002],\n ...,\n" <>
+               " [ 997, 1997],\n [ 998, 1998],\n [ 999, 1999]]"
+  end
+
   test "to_list/1" do
     tensor_info = [[0, 1, 2], [3, 4, 5], [6, 7, 8]]
     tensor = ExTorch.tensor(tensor_info)
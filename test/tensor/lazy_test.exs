@@ -0,0 +1,88 @@
+defmodule ExTorchTest.Tensor.LazyTest do
+  use ExUnit.Case, async: true
+
+  alias ExTorch.Tensor.Lazy
+
+  describe "eval/1" do
+    test "fuses a normalization chain" do
+      images = ExTorch.rand({4, 3, 8, 8})
+      mean = ExTorch.tensor([[[0.485]], [[0.456]], [[0.406]]])
+      std = ExTorch.tensor([[[0.229]], [[0.224]], [[0.225]]])
+
+      fused =
+        images
+        |> Lazy.wrap()
+        |> Lazy.sub(mean)
+        |> Lazy.div(std)
+        |> Lazy.eval()
+
+      eager = images |> ExTorch.sub(mean) |> ExTorch.tensor_div(std)
+
+      assert fused.size == {4, 3, 8, 8}
+      assert ExTorch.allclose(fused, eager)
+    end
+
+    test "fuses unary ops with scalar constants" do
+      scores = ExTorch.randn({1000})
+
+      fused =
+        scores
+        |> Lazy.mul(2)
+        |> Lazy.add(-0.5)
+        |> Lazy.relu()
+        |> Lazy.clamp(0.1, 0.9)
+        |> Lazy.eval()
+
+      eager =
+        scores
+        |> ExTorch.mul(ExTorch.full({}, 2.0))
+        |> ExTorch.add(ExTorch.full({}, -0.5))
+        |> ExTorch.functional_relu()
+        |> ExTorch.clamp(0.1, 0.9)
+
+      assert ExTorch.allclose(fused, eager)
+    end
+
+    test "reuses repeated inputs and subexpressions" do
+      x = ExTorch.randn({16, 16})
+      square = Lazy.mul(x, x)
+
+      {inputs, consts, program} = Lazy.compile(Lazy.add(square, square).expr)
+      assert length(inputs) == 1
+      assert consts == []
+      assert length(program) == 6
+
+      fused = square |> Lazy.add(square) |> Lazy.eval()
+      assert ExTorch.allclose(fused, ExTorch.mul(ExTorch.mul(x, x), ExTorch.full({}, 2.0)))
+    end
+
+    test "broadcasts and promotes integer inputs" do
+      column = ExTorch.tensor([[1], [2], [3]], dtype: :int64)
+      row = ExTorch.tensor([0.5, 1.0], dtype: :float64)
+
+      result = column |> Lazy.add(row) |> Lazy.eval()
+
+      assert result.size == {3, 2}
+      assert result.dtype == :float64
+      assert ExTorch.Tensor.to_list(result) == [[1.5, 2.0], [2.5, 3.0], [3.5, 4.0]]
+    end
+
+    test "returns tensors unchanged" do
+      x = ExTorch.ones({2})
+      assert Lazy.eval(x) == x
+      assert Lazy.eval(Lazy.wrap(x)) == x
+    end
+
+    test "raises on an invalid program" do
+      x = ExTorch.ones({2})
+
+      assert_raise ErlangError, fn ->
+        ExTorch.Native.fused_pointwise([x], [], [0, 0, 5])
+      end
+
+      assert_raise ErlangError, fn ->
+        ExTorch.Native.fused_pointwise([x], [], [42, 0, 0])
+      end
+    end
+  end
+end
@@ -0,0 +1,114 @@
+defmodule ExTorchTest.Tensor.PinnedPoolTest do
+  # The pool is process-wide, so counter deltas are only meaningful serially.
+  use ExUnit.Case, async: false
+
+  alias ExTorch.Tensor.PinnedPool
+
+  defp float_binary(values) do
+    for v <- values, into: <<>>, do: <<v::float-32-native>>
+  end
+
+  # Allocate inside a short-lived process so the tensor is collected (and
+  # its block released) once the process is down.
+  defp stage_and_drop(bin, shape) do
+    parent = self()
+    %{releases: releases} = PinnedPool.stats()
+
+    {pid, ref} =
+      spawn_monitor(fn ->
+        send(parent, {:size, PinnedPool.from_binary(bin, shape, :float32).size})
+      end)
+
+    assert_receive {:size, size}
+    assert_receive {:DOWN, ^ref, :process, ^pid, :normal}
+    await_release(releases + 1)
+    size
+  end
+
+  # The DOWN message does not mean the tensor's destructor has run yet, so
+  # poll until the pool has seen the block come back.
+  defp await_release(releases, attempts \\ 100) do
+    cond do
+      PinnedPool.stats().releases >= releases ->
+        :ok
+
+      attempts == 0 ->
+        flunk("the staged block was not released")
+
+      true ->
+        Process.sleep(10)
+        await_release(releases, attempts - 1)
+    end
+  end
+
+  describe "from_binary/3" do
+    test "matches ExTorch.Native.from_binary/3" do
+      bin = float_binary([1.0, 2.0, 3.0, 4.0, 5.0, 6.0])
+      pooled = PinnedPool.from_binary(bin, {2, 3}, :float32)
+      expected = ExTorch.Native.from_binary(bin, {2, 3}, :float32)
+
+      assert pooled.size == {2, 3}
+      assert pooled.device == :cpu
+      assert ExTorch.equal(pooled, expected)
+    end
+
+    test "reuses blocks released by collected tensors" do
+      bin = float_binary(Enum.map(1..1024, &(&1 * 1.0)))
+      assert stage_and_drop(bin, {1024}) == {1024}
+      before = PinnedPool.stats()
+
+      for _ <- 1..5, do: stage_and_drop(bin, {1024})
+      after_stats = PinnedPool.stats()
+
+      assert after_stats.requests - before.requests == 5
+      assert after_stats.hits - before.hits == 5
+      assert after_stats.bytes_reserved == before.bytes_reserved
+    end
+
+    test "raises when the binary does not match shape and dtype" do
+      bin = float_binary([1.0, 2.0, 3.0])
+
+      assert_raise ErlangError, fn ->
+        PinnedPool.from_binary(bin, {2, 3}, :float32)
+      end
+    end
+
+    test "supports empty tensors" do
+      tensor = PinnedPool.from_binary(<<>>, {0, 4}, :float32)
+      assert tensor.size == {0, 4}
+    end
+  end
+
+  describe "from_binaries/1" do
+    test "stages a batch in one call" do
+      a = float_binary([1.0, 2.0])
+      b = <<1::64-signed-native, 2::64-signed-native, 3::64-signed-native>>
+
+      [ta, tb] = PinnedPool.from_binaries([{a, {2}, :float32}, {b, {3}, :int64}])
+
+      assert ExTorch.equal(ta, ExTorch.tensor([1.0, 2.0]))
+      assert tb.size == {3}
+      assert tb.dtype == :long
+    end
+  end
+
+  describe "stats/0" do
+    test "reports counters and derived ratios" do
+      _tensor = PinnedPool.from_binary(float_binary([1.0, 2.0, 3.0]), {3}, :float32)
+      stats = PinnedPool.stats()
+
+      assert is_boolean(stats.pinned)
+      assert stats.requests >= 1
+      assert stats.blocks_in_use >= 1
+      assert stats.capacity_in_use >= stats.bytes_in_use
+      assert stats.reuse_rate >= 0.0 and stats.reuse_rate <= 1.0
+      assert stats.fragmentation >= 0.0 and stats.fragmentation < 1.0
+    end
+
+    test "empty_cache/0 frees cached blocks" do
+      stage_and_drop(float_binary([1.0, 2.0]), {2})
+      assert PinnedPool.empty_cache() >= 0
+      assert PinnedPool.stats().bytes_cached == 0
+    end
+  end
+end
@@ -30,4 +30,47 @@ defmodule ExTorchTest.Tensor.PointWiseTest do
 
     assert complex_imag == imag_list
   end
+
+  test "add/4 writes into a pre-allocated out tensor" do
+    a = ExTorch.tensor([1.0, 2.0, 3.0])
+    b = ExTorch.tensor([10.0, 20.0, 30.0])
+    out = ExTorch.empty({3})
+
+    result = ExTorch.add(a, b, 2, out: out)
+
+    expected = ExTorch.tensor([21.0, 42.0, 63.0])
+    assert ExTorch.allclose(result, expected)
+    assert ExTorch.allclose(out, expected)
+  end
+
+  test "tensor_exp/2 writes into a pre-allocated out tensor" do
+    input = ExTorch.zeros({2, 2})
+    out = ExTorch.empty({2, 2})
+    ExTorch.tensor_exp(input, out: out)
+    assert ExTorch.allclose(out, ExTorch.ones({2, 2}))
+  end
+
+  test "in-place variants modify and return the input" do
+    input = ExTorch.tensor([1.0, -2.0, 3.0])
+
+    result =
+      input
+      |> ExTorch.mul_(ExTorch.tensor([2.0, 2.0, 2.0]))
+      |> ExTorch.add_(ExTorch.tensor([1.0, 1.0, 1.0]))
+      |> ExTorch.clamp_(0, 5)
+
+    expected = ExTorch.tensor([3.0, 0.0, 5.0])
+    assert ExTorch.allclose(result, expected)
+    assert ExTorch.allclose(input, expected)
+  end
+
+  test "copy_/2 copies into an existing tensor" do
+    dst = ExTorch.zeros({2, 3})
+    src = ExTorch.tensor([1, 2, 3], dtype: :int32)
+
+    ExTorch.copy_(dst, src)
+
+    assert dst.dtype == :float
+    assert ExTorch.Tensor.to_list(dst) == [[1.0, 2.0, 3.0], [1.0, 2.0, 3.0]]
+  end
 end
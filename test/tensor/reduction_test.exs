@@ -2788,4 +2788,25 @@ defmodule ExTorchTest.Tensor.ReductionTest do
     out = ExTorch.count_nonzero(input, -1)
     assert ExTorch.equal(expected, out)
   end
+
+  test "sum/5 writes into a pre-allocated out tensor" do
+    input = ExTorch.tensor([[1.0, 2.0], [3.0, 4.0]])
+    out = ExTorch.empty({2})
+    ExTorch.sum(input, -1, out: out)
+    assert ExTorch.allclose(out, ExTorch.tensor([3.0, 7.0]))
+  end
+
+  test "prod/5 with out and no dim" do
+    input = ExTorch.tensor([[1.0, 2.0], [3.0, 4.0]])
+    out = ExTorch.empty({})
+    ExTorch.prod(input, out: out)
+    assert ExTorch.allclose(out, ExTorch.tensor(24.0))
+  end
+
+  test "argmax/4 writes into a pre-allocated out tensor" do
+    input = ExTorch.tensor([[1, 5, 2], [7, 0, 3]])
+    out = ExTorch.empty({2}, dtype: :int64)
+    ExTorch.argmax(input, 1, out: out)
+    assert ExTorch.equal(out, ExTorch.tensor([1, 0], dtype: :int64))
+  end
 end
@@ -0,0 +1,75 @@
+defmodule ExTorchTest.Tensor.TopKTest do
+  use ExUnit.Case, async: true
+
+  alias ExTorch.Tensor.TopK
+
+  describe "chunked/3" do
+    test "matches topk on a long row" do
+      scores = ExTorch.randn({2, 10_000})
+
+      {values, indices} = TopK.chunked(scores, 10, chunk_size: 512)
+      {expected, _} = ExTorch.topk(scores, 10)
+
+      assert values.size == {2, 10}
+      assert ExTorch.equal(values, expected)
+      assert ExTorch.equal(ExTorch.gather(scores, 1, indices), values)
+    end
+
+    test "selects the smallest values along another dim" do
+      scores = ExTorch.randn({5_000, 3})
+
+      {values, _indices} = TopK.chunked(scores, 4, dim: 0, largest: false, chunk_size: 256)
+      {expected, _} = ExTorch.topk(scores, 4, 0, false)
+
+      assert ExTorch.equal(values, expected)
+    end
+
+    test "topk/2 takes the chunked path for long rows" do
+      scores = ExTorch.randn({200_000})
+      assert TopK.chunked_path?(scores, 5)
+
+      {values, indices} = ExTorch.topk(scores, 5)
+
+      assert ExTorch.equal(ExTorch.gather(scores, 0, indices), values)
+      assert ExTorch.equal(values, scores |> TopK.chunked(5) |> elem(0))
+    end
+
+    test "topk/2 keeps torch's path for short rows or many rows" do
+      refute TopK.chunked_path?(ExTorch.randn({1_000}), 5)
+
+      rows = ExTorch.Native.aten_get_num_threads()
+      refute TopK.chunked_path?(ExTorch.empty({rows, 200_000}), 5)
+    end
+  end
+
+  describe "matmul/4" do
+    test "matches topk over the full score matrix" do
+      query = ExTorch.randn({3, 8})
+      keys = ExTorch.randn({1_000, 8})
+
+      {values, indices} = TopK.matmul(query, keys, 7, chunk_size: 128)
+      scores = ExTorch.matmul(query, ExTorch.transpose(keys, 0, 1))
+      {expected_values, expected_indices} = ExTorch.topk(scores, 7)
+
+      assert ExTorch.allclose(values, expected_values)
+      assert ExTorch.equal(indices, expected_indices)
+    end
+  end
+
+  describe "stream/3" do
+    test "folds chunks into a running top-k" do
+      scores = ExTorch.randn({4, 3_000})
+      chunks = ExTorch.split(scores, 700, 1)
+
+      {values, indices} = TopK.stream(chunks, 6)
+      {expected_values, expected_indices} = ExTorch.topk(scores, 6)
+
+      assert ExTorch.equal(values, expected_values)
+      assert ExTorch.equal(indices, expected_indices)
+    end
+
+    test "raises on an empty sequence" do
+      assert_raise ArgumentError, fn -> TopK.stream([], 3) end
+    end
+  end
+end
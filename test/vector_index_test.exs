@@ -0,0 +1,145 @@
+defmodule ExTorchTest.VectorIndexTest do
+  use ExUnit.Case, async: true
+
+  alias ExTorch.VectorIndex
+
+  # Fraction of the exact top-k ids (from a brute-force scan) that the
+  # index returned.
+  defp recall(index, corpus, queries, k) do
+    {_, exact} = ExTorch.Tensor.TopK.matmul(queries, corpus, k)
+    {_, found} = VectorIndex.search(index, queries, k)
+
+    hits =
+      Enum.zip(ExTorch.Tensor.to_list(exact), ExTorch.Tensor.to_list(found))
+      |> Enum.map(fn {expected, actual} ->
+        MapSet.size(MapSet.intersection(MapSet.new(expected), MapSet.new(actual)))
+      end)
+      |> Enum.sum()
+
+    hits / (k * elem(queries.size, 0))
+  end
+
+  setup do
+    dir = Path.join(System.tmp_dir!(), "extorch_vector_index_#{System.unique_integer([:positive])}")
+    File.mkdir_p!(dir)
+    on_exit(fn -> File.rm_rf(dir) end)
+    {:ok, dir: dir}
+  end
+
+  describe "hnsw" do
+    test "finds the exact neighbours of indexed vectors" do
+      corpus = ExTorch.randn({2_000, 16})
+      index = VectorIndex.new(:hnsw, 16, metric: :ip, m: 8)
+
+      assert VectorIndex.add(index, corpus) == 0..1_999
+      assert VectorIndex.size(index) == 2_000
+      assert recall(index, corpus, ExTorch.randn({20, 16}), 10) >= 0.9
+    end
+
+    test "returns l2 distances closest first" do
+      corpus = ExTorch.randn({500, 8})
+      index = VectorIndex.new(:hnsw, 8)
+      VectorIndex.add(index, corpus)
+
+      query = ExTorch.narrow(corpus, 0, 3, 1)
+      {scores, ids} = VectorIndex.search(index, query, 5)
+
+      assert [[3 | _]] = ExTorch.Tensor.to_list(ids)
+      [[first | rest]] = ExTorch.Tensor.to_list(scores)
+      assert first == 0.0
+      assert rest == Enum.sort(rest)
+    end
+
+    test "pads results when the index holds fewer than k vectors" do
+      index = VectorIndex.new(:hnsw, 4)
+      VectorIndex.add(index, ExTorch.randn({2, 4}))
+
+      {_scores, ids} = VectorIndex.search(index, ExTorch.randn({1, 4}), 4)
+      assert [[a, b, -1, -1]] = ExTorch.Tensor.to_list(ids)
+      assert Enum.sort([a, b]) == [0, 1]
+    end
+
+    test "returns a copy of the indexed vectors" do
+      corpus = ExTorch.randn({3, 4})
+      index = VectorIndex.new(:hnsw, 4)
+      VectorIndex.add(index, corpus)
+
+      vectors = VectorIndex.vectors(index)
+      VectorIndex.add(index, ExTorch.randn({64, 4}))
+
+      assert ExTorch.equal(vectors, corpus)
+      refute ExTorch.Native.data_ptr(vectors) == ExTorch.Native.data_ptr(VectorIndex.vectors(index))
+    end
+  end
+
+  describe "ivf_flat" do
+    test "requires training before adding vectors" do
+      index = VectorIndex.new(:ivf_flat, 8, nlist: 4)
+      refute VectorIndex.trained?(index)
+      assert_raise ErlangError, fn -> VectorIndex.add(index, ExTorch.randn({10, 8})) end
+    end
+
+    test "scanning every cluster is exact" do
+      corpus = ExTorch.randn({1_000, 16})
+      index = VectorIndex.new(:ivf_flat, 16, metric: :ip, nlist: 16, nprobe: 16)
+
+      :ok = VectorIndex.train(index, corpus)
+      assert VectorIndex.trained?(index)
+      VectorIndex.add(index, ExTorch.narrow(corpus, 0, 0, 600))
+      assert VectorIndex.add(index, ExTorch.narrow(corpus, 0, 600, 400)) == 600..999
+
+      assert recall(index, corpus, ExTorch.randn({10, 16}), 10) == 1.0
+    end
+  end
+
+  describe "save/2 and load/2" do
+    test "round-trip with and without mmap", %{dir: dir} do
+      corpus = ExTorch.randn({300, 8})
+      queries = ExTorch.randn({5, 8})
+
+      for kind <- [:hnsw, :ivf_flat] do
+        index = VectorIndex.new(kind, 8, nlist: 8)
+        VectorIndex.train(index, corpus)
+        VectorIndex.add(index, corpus)
+        {_, expected} = VectorIndex.search(index, queries, 5)
+
+        path = Path.join(dir, "#{kind}.idx")
+        :ok = VectorIndex.save(index, path)
+
+        for mmap <- [false, true] do
+          loaded = VectorIndex.load(path, mmap: mmap)
+          assert loaded.kind == Atom.to_string(kind)
+          assert VectorIndex.size(loaded) == 300
+          assert ExTorch.equal(VectorIndex.vectors(loaded), corpus)
+
+          {_, ids} = VectorIndex.search(loaded, queries, 5)
+          assert ExTorch.equal(ids, expected)
+
+          assert VectorIndex.add(loaded, queries) == 300..304
+        end
+      end
+    end
+
+    test "saves a mapped index over the file it was loaded from", %{dir: dir} do
+      corpus = ExTorch.randn({200, 8})
+      index = VectorIndex.new(:hnsw, 8)
+      VectorIndex.add(index, corpus)
+
+      path = Path.join(dir, "mapped.idx")
+      :ok = VectorIndex.save(index, path)
+
+      loaded = VectorIndex.load(path, mmap: true)
+      :ok = VectorIndex.save(loaded, path)
+
+      assert ExTorch.equal(VectorIndex.vectors(loaded), corpus)
+      assert ExTorch.equal(VectorIndex.vectors(VectorIndex.load(path)), corpus)
+      assert Path.wildcard(path <> ".tmp*") == []
+    end
+
+    test "rejects other files", %{dir: dir} do
+      path = Path.join(dir, "bogus.idx")
+      File.write!(path, "not an index")
+      assert_raise ErlangError, fn -> VectorIndex.load(path) end
+    end
+  end
+end